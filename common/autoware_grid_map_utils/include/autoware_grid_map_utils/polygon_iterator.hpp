@@ -26,6 +26,7 @@
 
 namespace autoware::grid_map_utils
 {
+struct Span;
 
 /// @brief Representation of a polygon edge made of 2 vertices
 struct Edge
@@ -73,6 +74,11 @@ public:
   [[nodiscard]] bool isPastEnd() const;
 
 private:
+  /// rasterizePolygon() uses the same scan lines as the iterator
+  friend void rasterizePolygon(
+    const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon,
+    std::vector<Span> & spans);
+
   /** @brief Calculate sorted edges of the given polygon.
       @details Vertices in an edge are ordered from higher to lower x.
               Edges are sorted in reverse lexicographical order of x.
@@ -0,0 +1,114 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE_GRID_MAP_UTILS__POLYGON_RASTERIZER_HPP_
+#define AUTOWARE_GRID_MAP_UTILS__POLYGON_RASTERIZER_HPP_
+
+#include "grid_map_core/TypeDefs.hpp"
+
+#include <grid_map_core/GridMap.hpp>
+#include <grid_map_core/Polygon.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace autoware::grid_map_utils
+{
+
+/// @brief Run of consecutive cells [col_begin, col_end) of one row of a grid map layer.
+/// @details The row and columns are indexes of the layer matrix, i.e., the shift of the grid map
+/// circular buffer is already applied. A run crossing the end of the buffer is split in two spans.
+struct Span
+{
+  int row;
+  int col_begin;
+  int col_end;
+};
+
+/// @brief Calculate the spans of the cells whose center is inside a polygon.
+/// @details The spans cover the same cells in the same order as the PolygonIterator, but a span is
+/// calculated once per pair of intersections of a row instead of incrementing an iterator for
+/// each cell.
+/// @param grid_map the grid map to rasterize on.
+/// @param polygon the polygonal area to rasterize.
+/// @param spans [out] spans of the polygon, cleared before the rasterization.
+void rasterizePolygon(
+  const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon, std::vector<Span> & spans);
+
+/// @brief Calculate the spans of the cells whose center is inside a polygon.
+/// @param grid_map the grid map to rasterize on.
+/// @param polygon the polygonal area to rasterize.
+/// @return spans of the polygon.
+std::vector<Span> rasterizePolygon(
+  const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon);
+
+/// @brief Calculate the spans of several polygons.
+/// @param grid_map the grid map to rasterize on.
+/// @param polygons the polygonal areas to rasterize.
+/// @param num_threads number of threads used to rasterize the polygons.
+/// @return spans of each polygon, in the order of the polygons.
+std::vector<std::vector<Span>> rasterizePolygons(
+  const grid_map::GridMap & grid_map, const std::vector<grid_map::Polygon> & polygons,
+  const size_t num_threads = 1);
+
+/// @brief Set the cells of the spans to the given value.
+void setValue(grid_map::Matrix & layer, const std::vector<Span> & spans, const float value);
+
+/// @brief Set the cells of the spans to the maximum of their value and the given value.
+/// @details As with `if (value > cell) cell = value;`, NaN cells are kept.
+void setMaxValue(grid_map::Matrix & layer, const std::vector<Span> & spans, const float value);
+
+/// @brief Set the cells of the spans to the minimum of their value and the given value.
+/// @details As with `if (value < cell) cell = value;`, NaN cells are kept.
+void setMinValue(grid_map::Matrix & layer, const std::vector<Span> & spans, const float value);
+
+/// @brief Get the maximum value of the cells of the spans, ignoring NaN cells.
+/// @return the maximum value, or -infinity if there are no cells.
+float getMaxValue(const grid_map::Matrix & layer, const std::vector<Span> & spans);
+
+/// @brief Get the minimum value of the cells of the spans, ignoring NaN cells.
+/// @return the minimum value, or infinity if there are no cells.
+float getMinValue(const grid_map::Matrix & layer, const std::vector<Span> & spans);
+
+/// @brief Count the cells of the spans.
+size_t countCells(const std::vector<Span> & spans);
+
+/// @brief Count the cells of the spans equal to the given value.
+size_t countValue(
+  const grid_map::Matrix & layer, const std::vector<Span> & spans, const float value);
+
+/// @brief Set the cells of the spans of each polygon to the value of the polygon.
+/// @details Each thread writes a block of rows of the layer, so the result is the same as calling
+/// setValue() for each polygon in order.
+/// @param layer layer to update.
+/// @param spans_per_polygon spans of each polygon.
+/// @param values value of each polygon.
+/// @param num_threads number of threads used to update the layer.
+/// @throw std::invalid_argument if the numbers of polygons and values differ.
+void setValues(
+  grid_map::Matrix & layer, const std::vector<std::vector<Span>> & spans_per_polygon,
+  const std::vector<float> & values, const size_t num_threads = 1);
+
+/// @brief Apply setMaxValue() with the value of each polygon, using blocks of rows per thread.
+void setMaxValues(
+  grid_map::Matrix & layer, const std::vector<std::vector<Span>> & spans_per_polygon,
+  const std::vector<float> & values, const size_t num_threads = 1);
+
+/// @brief Apply setMinValue() with the value of each polygon, using blocks of rows per thread.
+void setMinValues(
+  grid_map::Matrix & layer, const std::vector<std::vector<Span>> & spans_per_polygon,
+  const std::vector<float> & values, const size_t num_threads = 1);
+}  // namespace autoware::grid_map_utils
+
+#endif  // AUTOWARE_GRID_MAP_UTILS__POLYGON_RASTERIZER_HPP_
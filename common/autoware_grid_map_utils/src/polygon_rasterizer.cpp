@@ -0,0 +1,243 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_grid_map_utils/polygon_rasterizer.hpp"
+
+#include "autoware_grid_map_utils/polygon_iterator.hpp"
+
+#include <grid_map_core/GridMapMath.hpp>
+
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace autoware::grid_map_utils
+{
+namespace
+{
+/// @brief add the span of the columns [col_begin, col_end) given without the shift of the map
+void addSpan(
+  std::vector<Span> & spans, const int row, const int col_begin, const int col_end,
+  const int nb_cols)
+{
+  if (col_begin >= nb_cols) {
+    spans.push_back({row, col_begin - nb_cols, col_end - nb_cols});
+  } else if (col_end > nb_cols) {
+    spans.push_back({row, col_begin, nb_cols});
+    spans.push_back({row, 0, col_end - nb_cols});
+  } else {
+    spans.push_back({row, col_begin, col_end});
+  }
+}
+
+/// @brief apply the operation to the spans of each polygon, with one block of rows per thread
+template <class Operation>
+void applyPerRowBlock(
+  grid_map::Matrix & layer, const std::vector<std::vector<Span>> & spans_per_polygon,
+  const std::vector<float> & values, const size_t num_threads, const Operation & operation)
+{
+  if (spans_per_polygon.size() != values.size()) {
+    throw std::invalid_argument("the number of values differs from the number of polygons");
+  }
+  const auto nb_rows = static_cast<size_t>(layer.rows());
+  const auto thread_num = std::clamp<size_t>(num_threads, 1, std::max<size_t>(nb_rows, 1));
+  const auto apply = [&](const size_t thread_idx) {
+    const auto from_row = static_cast<int>(nb_rows * thread_idx / thread_num);
+    const auto to_row = static_cast<int>(nb_rows * (thread_idx + 1) / thread_num);
+    for (size_t i = 0; i < spans_per_polygon.size(); ++i) {
+      for (const auto & span : spans_per_polygon[i]) {
+        if (span.row >= from_row && span.row < to_row) operation(layer, span, values[i]);
+      }
+    }
+  };
+  std::vector<std::future<void>> futures;
+  futures.reserve(thread_num - 1);
+  for (size_t thread_idx = 1; thread_idx < thread_num; ++thread_idx) {
+    futures.push_back(std::async(std::launch::async, apply, thread_idx));
+  }
+  apply(0);
+  for (auto & future : futures) future.get();
+}
+
+void setSpanValue(grid_map::Matrix & layer, const Span & span, const float value)
+{
+  layer.row(span.row).segment(span.col_begin, span.col_end - span.col_begin).setConstant(value);
+}
+
+void setSpanMaxValue(grid_map::Matrix & layer, const Span & span, const float value)
+{
+  for (auto col = span.col_begin; col < span.col_end; ++col) {
+    auto & cell = layer(span.row, col);
+    if (value > cell) cell = value;
+  }
+}
+
+void setSpanMinValue(grid_map::Matrix & layer, const Span & span, const float value)
+{
+  for (auto col = span.col_begin; col < span.col_end; ++col) {
+    auto & cell = layer(span.row, col);
+    if (value < cell) cell = value;
+  }
+}
+}  // namespace
+
+void rasterizePolygon(
+  const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon, std::vector<Span> & spans)
+{
+  spans.clear();
+  auto poly = polygon;
+  if (poly.nVertices() < 3) return;
+  // repeat the first vertex to get the last edge [last vertex, first vertex]
+  if (poly.getVertex(0) != poly.getVertex(poly.nVertices() - 1)) poly.addVertex(poly.getVertex(0));
+
+  const auto & map_start_idx = grid_map.getStartIndex();
+  const auto & map_size = grid_map.getSize();
+  const auto map_resolution = grid_map.getResolution();
+  grid_map::Position origin;
+  grid_map.getPosition(map_start_idx, origin);
+
+  const auto edges = PolygonIterator::calculateSortedEdges(poly);
+  if (edges.empty()) return;
+  const auto from_to_row = PolygonIterator::calculateRowRange(edges, origin, grid_map);
+  const auto intersections_per_line =
+    PolygonIterator::calculateIntersectionsPerLine(edges, from_to_row, origin, grid_map);
+
+  for (size_t line = 0; line < intersections_per_line.size(); ++line) {
+    const auto & y_intersections = intersections_per_line[line];
+    int row = map_start_idx(0) + from_to_row.first + static_cast<int>(line);
+    grid_map::wrapIndexToRange(row, map_size(0));
+    // same columns as PolygonIterator::calculateColumnIndexes() for each pair of intersections
+    for (size_t i = 0; i + 1 < y_intersections.size(); i += 2) {
+      const auto dist_from_origin = origin.y() - y_intersections[i] + map_resolution;
+      const auto col =
+        std::clamp(static_cast<int>(dist_from_origin / map_resolution), 0, map_size(1) - 1);
+      const auto dist_to_origin = origin.y() - y_intersections[i + 1];
+      const auto to_col =
+        std::clamp(static_cast<int>(dist_to_origin / map_resolution), 0, map_size(1) - 1);
+      if (to_col < col) continue;
+      addSpan(spans, row, map_start_idx(1) + col, map_start_idx(1) + to_col + 1, map_size(1));
+    }
+  }
+}
+
+std::vector<Span> rasterizePolygon(
+  const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon)
+{
+  std::vector<Span> spans;
+  rasterizePolygon(grid_map, polygon, spans);
+  return spans;
+}
+
+std::vector<std::vector<Span>> rasterizePolygons(
+  const grid_map::GridMap & grid_map, const std::vector<grid_map::Polygon> & polygons,
+  const size_t num_threads)
+{
+  std::vector<std::vector<Span>> spans_per_polygon(polygons.size());
+  const auto thread_num = std::clamp<size_t>(num_threads, 1, std::max<size_t>(polygons.size(), 1));
+  const auto rasterize = [&](const size_t thread_idx) {
+    for (auto i = thread_idx; i < polygons.size(); i += thread_num) {
+      rasterizePolygon(grid_map, polygons[i], spans_per_polygon[i]);
+    }
+  };
+  std::vector<std::future<void>> futures;
+  futures.reserve(thread_num - 1);
+  for (size_t thread_idx = 1; thread_idx < thread_num; ++thread_idx) {
+    futures.push_back(std::async(std::launch::async, rasterize, thread_idx));
+  }
+  rasterize(0);
+  for (auto & future : futures) future.get();
+  return spans_per_polygon;
+}
+
+void setValue(grid_map::Matrix & layer, const std::vector<Span> & spans, const float value)
+{
+  for (const auto & span : spans) setSpanValue(layer, span, value);
+}
+
+void setMaxValue(grid_map::Matrix & layer, const std::vector<Span> & spans, const float value)
+{
+  for (const auto & span : spans) setSpanMaxValue(layer, span, value);
+}
+
+void setMinValue(grid_map::Matrix & layer, const std::vector<Span> & spans, const float value)
+{
+  for (const auto & span : spans) setSpanMinValue(layer, span, value);
+}
+
+float getMaxValue(const grid_map::Matrix & layer, const std::vector<Span> & spans)
+{
+  auto max_value = -std::numeric_limits<float>::infinity();
+  for (const auto & span : spans) {
+    for (auto col = span.col_begin; col < span.col_end; ++col) {
+      const auto cell = layer(span.row, col);
+      if (cell > max_value) max_value = cell;
+    }
+  }
+  return max_value;
+}
+
+float getMinValue(const grid_map::Matrix & layer, const std::vector<Span> & spans)
+{
+  auto min_value = std::numeric_limits<float>::infinity();
+  for (const auto & span : spans) {
+    for (auto col = span.col_begin; col < span.col_end; ++col) {
+      const auto cell = layer(span.row, col);
+      if (cell < min_value) min_value = cell;
+    }
+  }
+  return min_value;
+}
+
+size_t countCells(const std::vector<Span> & spans)
+{
+  size_t count = 0;
+  for (const auto & span : spans) count += static_cast<size_t>(span.col_end - span.col_begin);
+  return count;
+}
+
+size_t countValue(
+  const grid_map::Matrix & layer, const std::vector<Span> & spans, const float value)
+{
+  size_t count = 0;
+  for (const auto & span : spans) {
+    for (auto col = span.col_begin; col < span.col_end; ++col) {
+      if (layer(span.row, col) == value) ++count;
+    }
+  }
+  return count;
+}
+
+void setValues(
+  grid_map::Matrix & layer, const std::vector<std::vector<Span>> & spans_per_polygon,
+  const std::vector<float> & values, const size_t num_threads)
+{
+  applyPerRowBlock(layer, spans_per_polygon, values, num_threads, setSpanValue);
+}
+
+void setMaxValues(
+  grid_map::Matrix & layer, const std::vector<std::vector<Span>> & spans_per_polygon,
+  const std::vector<float> & values, const size_t num_threads)
+{
+  applyPerRowBlock(layer, spans_per_polygon, values, num_threads, setSpanMaxValue);
+}
+
+void setMinValues(
+  grid_map::Matrix & layer, const std::vector<std::vector<Span>> & spans_per_polygon,
+  const std::vector<float> & values, const size_t num_threads)
+{
+  applyPerRowBlock(layer, spans_per_polygon, values, num_threads, setSpanMinValue);
+}
+}  // namespace autoware::grid_map_utils
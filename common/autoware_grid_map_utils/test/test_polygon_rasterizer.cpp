@@ -0,0 +1,317 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware_grid_map_utils/polygon_iterator.hpp"
+#include "autoware_grid_map_utils/polygon_rasterizer.hpp"
+
+#include <autoware/universe_utils/system/stop_watch.hpp>
+
+// gtest
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using autoware::grid_map_utils::Span;
+using grid_map::GridMap;
+using grid_map::Index;
+using grid_map::Length;
+using grid_map::Polygon;
+using grid_map::Position;
+
+namespace
+{
+// random polygons around the center of the map, some of them partially outside of the map
+std::vector<Polygon> generateRandomPolygons(const size_t nb_polygons, const unsigned int seed)
+{
+  std::default_random_engine engine(seed);
+  std::uniform_real_distribution center_dist(-6.0, 6.0);
+  std::uniform_real_distribution radius_dist(0.5, 4.0);
+  std::uniform_int_distribution nb_vertices_dist(3, 12);
+  std::vector<Polygon> polygons;
+  for (size_t i = 0; i < nb_polygons; ++i) {
+    const Position center(center_dist(engine), center_dist(engine));
+    const auto nb_vertices = nb_vertices_dist(engine);
+    Polygon polygon;
+    for (auto v = 0; v < nb_vertices; ++v) {
+      const auto angle = 2.0 * M_PI * v / nb_vertices;
+      const auto radius = radius_dist(engine);
+      polygon.addVertex(center + radius * Position(std::cos(angle), std::sin(angle)));
+    }
+    polygons.push_back(polygon);
+  }
+  return polygons;
+}
+
+std::vector<Index> expandSpans(const std::vector<Span> & spans)
+{
+  std::vector<Index> indexes;
+  for (const auto & span : spans) {
+    for (auto col = span.col_begin; col < span.col_end; ++col) indexes.emplace_back(span.row, col);
+  }
+  return indexes;
+}
+
+std::vector<Index> iterate(const GridMap & map, const Polygon & polygon)
+{
+  std::vector<Index> indexes;
+  for (autoware::grid_map_utils::PolygonIterator iterator(map, polygon); !iterator.isPastEnd();
+       ++iterator)
+    indexes.push_back(*iterator);
+  return indexes;
+}
+}  // namespace
+
+TEST(PolygonRasterizer, SameCellsAsIterator)
+{
+  GridMap map({"layer"});
+  map.setGeometry(Length(10.0, 10.0), 0.1, Position(0.0, 0.0));  // bufferSize(100, 100)
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution move_dist(-3.0, 3.0);
+  const auto polygons = generateRandomPolygons(100, 0);
+  std::vector<Span> spans;
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    // moving the map shifts the start index of the circular buffer
+    if (i % 10 == 0) map.move(Position(move_dist(engine), move_dist(engine)));
+    autoware::grid_map_utils::rasterizePolygon(map, polygons[i], spans);
+    for (const auto & span : spans) {
+      EXPECT_GE(span.row, 0);
+      EXPECT_LT(span.row, map.getSize()(0));
+      EXPECT_GE(span.col_begin, 0);
+      EXPECT_LT(span.col_begin, span.col_end);
+      EXPECT_LE(span.col_end, map.getSize()(1));
+    }
+    const auto indexes = iterate(map, polygons[i]);
+    const auto span_indexes = expandSpans(spans);
+    ASSERT_EQ(span_indexes.size(), indexes.size());
+    for (size_t j = 0; j < indexes.size(); ++j) {
+      EXPECT_EQ(span_indexes[j](0), indexes[j](0));
+      EXPECT_EQ(span_indexes[j](1), indexes[j](1));
+    }
+  }
+}
+
+TEST(PolygonRasterizer, SpanAcrossBufferEnd)
+{
+  GridMap map({"layer"});
+  map.setGeometry(Length(8.0, 5.0), 1.0, Position(0.0, 0.0));  // bufferSize(8, 5)
+  map.move(Position(0.0, 2.0));
+
+  Polygon polygon;
+  polygon.addVertex(Position(-100.0, 100.0));
+  polygon.addVertex(Position(100.0, 100.0));
+  polygon.addVertex(Position(100.0, -100.0));
+  polygon.addVertex(Position(-100.0, -100.0));
+
+  // each row of the map is split where the columns wrap around
+  const auto spans = autoware::grid_map_utils::rasterizePolygon(map, polygon);
+  EXPECT_EQ(spans.size(), 16UL);
+  EXPECT_EQ(autoware::grid_map_utils::countCells(spans), 40UL);
+  const auto indexes = iterate(map, polygon);
+  const auto span_indexes = expandSpans(spans);
+  ASSERT_EQ(span_indexes.size(), indexes.size());
+  for (size_t j = 0; j < indexes.size(); ++j) {
+    EXPECT_EQ(span_indexes[j](0), indexes[j](0));
+    EXPECT_EQ(span_indexes[j](1), indexes[j](1));
+  }
+}
+
+TEST(PolygonRasterizer, EmptyPolygon)
+{
+  GridMap map({"layer"});
+  map.setGeometry(Length(8.0, 5.0), 1.0, Position(0.0, 0.0));  // bufferSize(8, 5)
+
+  Polygon polygon;
+  polygon.addVertex(Position(0.0, 0.0));
+  polygon.addVertex(Position(1.0, 1.0));
+  auto spans = autoware::grid_map_utils::rasterizePolygon(map, polygon);
+  EXPECT_TRUE(spans.empty());
+
+  // outside of the map
+  polygon.addVertex(Position(100.0, 100.0));
+  polygon.addVertex(Position(100.0, 101.0));
+  polygon.addVertex(Position(101.0, 101.0));
+  spans = autoware::grid_map_utils::rasterizePolygon(map, polygon);
+  EXPECT_EQ(autoware::grid_map_utils::countCells(spans), 0UL);
+  EXPECT_EQ(
+    autoware::grid_map_utils::getMaxValue(map["layer"], spans),
+    -std::numeric_limits<float>::infinity());
+  EXPECT_EQ(
+    autoware::grid_map_utils::getMinValue(map["layer"], spans),
+    std::numeric_limits<float>::infinity());
+}
+
+TEST(PolygonRasterizer, FillAndReduce)
+{
+  GridMap map({"layer"});
+  map.setGeometry(Length(10.0, 10.0), 0.1, Position(0.0, 0.0));  // bufferSize(100, 100)
+  map.move(Position(1.23, -2.34));
+  const auto polygons = generateRandomPolygons(20, 1);
+  auto & layer = map["layer"];
+  auto expected = layer;
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    const auto spans = autoware::grid_map_utils::rasterizePolygon(map, polygons[i]);
+    const auto indexes = iterate(map, polygons[i]);
+    const auto value = static_cast<float>(i % 7);
+    const auto set_value = [&](const auto & update) {
+      for (const auto & index : indexes) update(expected(index(0), index(1)));
+    };
+    switch (i % 3) {
+      case 0:
+        autoware::grid_map_utils::setValue(layer, spans, value);
+        set_value([&](float & cell) { cell = value; });
+        break;
+      case 1:
+        autoware::grid_map_utils::setMaxValue(layer, spans, value);
+        set_value([&](float & cell) {
+          if (value > cell) cell = value;
+        });
+        break;
+      default:
+        autoware::grid_map_utils::setMinValue(layer, spans, value);
+        set_value([&](float & cell) {
+          if (value < cell) cell = value;
+        });
+    }
+    ASSERT_EQ(layer, expected);
+
+    auto max_value = -std::numeric_limits<float>::infinity();
+    auto min_value = std::numeric_limits<float>::infinity();
+    size_t count = 0;
+    for (const auto & index : indexes) {
+      max_value = std::max(max_value, expected(index(0), index(1)));
+      min_value = std::min(min_value, expected(index(0), index(1)));
+      if (expected(index(0), index(1)) == 3.0f) ++count;
+    }
+    EXPECT_EQ(autoware::grid_map_utils::countCells(spans), indexes.size());
+    EXPECT_EQ(autoware::grid_map_utils::getMaxValue(layer, spans), max_value);
+    EXPECT_EQ(autoware::grid_map_utils::getMinValue(layer, spans), min_value);
+    EXPECT_EQ(autoware::grid_map_utils::countValue(layer, spans, 3.0f), count);
+  }
+}
+
+TEST(PolygonRasterizer, KeepNaN)
+{
+  GridMap map({"layer"});
+  map.setGeometry(Length(8.0, 5.0), 1.0, Position(0.0, 0.0));  // bufferSize(8, 5)
+  Polygon polygon;
+  polygon.addVertex(Position(-100.0, 100.0));
+  polygon.addVertex(Position(100.0, 100.0));
+  polygon.addVertex(Position(100.0, -100.0));
+  polygon.addVertex(Position(-100.0, -100.0));
+  auto & layer = map["layer"];
+  layer(3, 3) = std::numeric_limits<float>::quiet_NaN();
+  layer(4, 4) = 2.0f;
+  const auto spans = autoware::grid_map_utils::rasterizePolygon(map, polygon);
+  autoware::grid_map_utils::setMaxValue(layer, spans, 1.0f);
+  EXPECT_TRUE(std::isnan(layer(3, 3)));
+  EXPECT_EQ(layer(4, 4), 2.0f);
+  EXPECT_EQ(autoware::grid_map_utils::getMaxValue(layer, spans), 2.0f);
+  EXPECT_EQ(autoware::grid_map_utils::getMinValue(layer, spans), 1.0f);
+}
+
+TEST(PolygonRasterizer, Batch)
+{
+  GridMap map({"layer"});
+  map.setGeometry(Length(10.0, 10.0), 0.05, Position(0.0, 0.0));  // bufferSize(200, 200)
+  map.move(Position(-0.72, 1.57));
+  const auto polygons = generateRandomPolygons(50, 2);
+  std::vector<float> values;
+  for (size_t i = 0; i < polygons.size(); ++i) values.push_back(static_cast<float>(i % 11));
+
+  const auto spans_per_polygon = autoware::grid_map_utils::rasterizePolygons(map, polygons);
+  ASSERT_EQ(spans_per_polygon.size(), polygons.size());
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    const auto spans = autoware::grid_map_utils::rasterizePolygon(map, polygons[i]);
+    ASSERT_EQ(spans_per_polygon[i].size(), spans.size());
+    for (size_t j = 0; j < spans.size(); ++j) {
+      EXPECT_EQ(spans_per_polygon[i][j].row, spans[j].row);
+      EXPECT_EQ(spans_per_polygon[i][j].col_begin, spans[j].col_begin);
+      EXPECT_EQ(spans_per_polygon[i][j].col_end, spans[j].col_end);
+    }
+  }
+
+  grid_map::Matrix expected_set = map["layer"];
+  grid_map::Matrix expected_max = map["layer"];
+  grid_map::Matrix expected_min = grid_map::Matrix::Constant(
+    expected_max.rows(), expected_max.cols(), std::numeric_limits<float>::infinity());
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    autoware::grid_map_utils::setValue(expected_set, spans_per_polygon[i], values[i]);
+    autoware::grid_map_utils::setMaxValue(expected_max, spans_per_polygon[i], values[i]);
+    autoware::grid_map_utils::setMinValue(expected_min, spans_per_polygon[i], values[i]);
+  }
+  for (const auto num_threads : {1UL, 2UL, 3UL, 8UL, 1000UL}) {
+    EXPECT_EQ(
+      autoware::grid_map_utils::rasterizePolygons(map, polygons, num_threads).size(),
+      polygons.size());
+    grid_map::Matrix layer = map["layer"];
+    autoware::grid_map_utils::setValues(layer, spans_per_polygon, values, num_threads);
+    EXPECT_EQ(layer, expected_set);
+    layer = map["layer"];
+    autoware::grid_map_utils::setMaxValues(layer, spans_per_polygon, values, num_threads);
+    EXPECT_EQ(layer, expected_max);
+    layer.setConstant(std::numeric_limits<float>::infinity());
+    autoware::grid_map_utils::setMinValues(layer, spans_per_polygon, values, num_threads);
+    EXPECT_EQ(layer, expected_min);
+  }
+
+  grid_map::Matrix layer = map["layer"];
+  values.pop_back();
+  EXPECT_THROW(
+    autoware::grid_map_utils::setValues(layer, spans_per_polygon, values), std::invalid_argument);
+}
+
+TEST(PolygonRasterizer, DISABLED_Benchmark)
+{
+  autoware::universe_utils::StopWatch<std::chrono::microseconds, std::chrono::microseconds> sw;
+  for (const auto resolution : {0.1, 0.05, 0.02}) {
+    GridMap map({"layer"});
+    map.setGeometry(Length(20.0, 20.0), resolution, Position(0.0, 0.0));
+    map.move(Position(0.51, -0.37));
+    const auto polygons = generateRandomPolygons(500, 3);
+    auto & layer = map["layer"];
+    std::vector<float> values(polygons.size(), 1.0f);
+
+    sw.tic();
+    for (size_t i = 0; i < polygons.size(); ++i) {
+      for (autoware::grid_map_utils::PolygonIterator iterator(map, polygons[i]);
+           !iterator.isPastEnd(); ++iterator) {
+        auto & cell = layer((*iterator)(0), (*iterator)(1));
+        if (values[i] > cell) cell = values[i];
+      }
+    }
+    const auto iterator_us = sw.toc();
+
+    sw.tic();
+    for (size_t i = 0; i < polygons.size(); ++i) {
+      autoware::grid_map_utils::setMaxValue(
+        layer, autoware::grid_map_utils::rasterizePolygon(map, polygons[i]), values[i]);
+    }
+    const auto spans_us = sw.toc();
+
+    sw.tic();
+    autoware::grid_map_utils::setMaxValues(
+      layer, autoware::grid_map_utils::rasterizePolygons(map, polygons, 4), values, 4);
+    const auto batch_us = sw.toc();
+
+    std::printf(
+      "%dx%d cells, %zu polygons: PolygonIterator = %2.0f us, spans = %2.0f us, batch with 4 "
+      "threads = %2.0f us\n",
+      map.getSize()(0), map.getSize()(1), polygons.size(), iterator_us, spans_us, batch_us);
+  }
+}
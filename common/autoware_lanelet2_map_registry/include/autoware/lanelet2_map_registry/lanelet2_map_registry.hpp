@@ -0,0 +1,145 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LANELET2_MAP_REGISTRY__LANELET2_MAP_REGISTRY_HPP_
+#define AUTOWARE__LANELET2_MAP_REGISTRY__LANELET2_MAP_REGISTRY_HPP_
+
+#include <autoware_map_msgs/msg/lanelet_map_bin.hpp>
+
+#include <lanelet2_core/Forward.h>
+#include <lanelet2_routing/Forward.h>
+#include <lanelet2_traffic_rules/TrafficRules.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace autoware::lanelet2_map_registry
+{
+using autoware_map_msgs::msg::LaneletMapBin;
+
+/**
+ * @brief Hash of the content of a map message, used as the key of the registry
+ */
+uint64_t calcMapHash(const LaneletMapBin & msg);
+
+/**
+ * @brief Deserialized Lanelet2 map shared by all the nodes of a process.
+ * @details The map is read-only. The routing graphs are built on the first request and then
+ * shared, so that a node that does not route does not pay for them. Nodes should keep this object
+ * rather than only the map, since the registry entry lives as long as this object.
+ * @details The map can be read from several threads at the same time. The centerline of a lanelet,
+ * which Lanelet2 calculates on the first access and caches without synchronization, is calculated
+ * before the map is registered.
+ */
+class SharedLaneletMap
+{
+public:
+  SharedLaneletMap(lanelet::LaneletMapConstPtr map, const uint64_t hash, const LaneletMapBin & msg);
+
+  const lanelet::LaneletMapConstPtr & map() const { return map_; }
+  uint64_t hash() const { return hash_; }
+
+  /**
+   * @brief Check if the map was deserialized from a message with the same content as msg
+   * @details The hash only selects the candidate map, the content is compared byte by byte.
+   */
+  bool isMapOf(const LaneletMapBin & msg) const;
+
+  /**
+   * @brief Get the routing graph of the given participant built with the German traffic rules,
+   * which is the same as the one built by lanelet::utils::conversion::fromBinMsg
+   * @param participant lanelet::Participants::Vehicle or lanelet::Participants::Pedestrian
+   */
+  lanelet::routing::RoutingGraphConstPtr routingGraph(const std::string & participant) const;
+  lanelet::routing::RoutingGraphConstPtr vehicleRoutingGraph() const;
+  lanelet::routing::RoutingGraphConstPtr pedestrianRoutingGraph() const;
+
+  /**
+   * @brief Get the container of the vehicle graph (ID 0) and the pedestrian graph (ID 1)
+   */
+  std::shared_ptr<const lanelet::routing::RoutingGraphContainer> overallGraphs() const;
+
+  static lanelet::traffic_rules::TrafficRulesPtr createTrafficRules(
+    const std::string & participant);
+
+private:
+  lanelet::LaneletMapConstPtr map_;
+  uint64_t hash_;
+
+  // content of the message the map was deserialized from
+  std::string version_map_format_;
+  std::string version_map_;
+  std::string name_map_;
+  std::vector<uint8_t> data_;
+
+  mutable std::mutex routing_graph_mutex_;
+  mutable std::unordered_map<std::string, lanelet::routing::RoutingGraphConstPtr> routing_graphs_;
+  mutable std::shared_ptr<const lanelet::routing::RoutingGraphContainer> overall_graphs_;
+};
+
+/**
+ * @brief Process-wide registry of the deserialized maps, keyed by the hash of the map message.
+ * @details The registry only holds weak references, so a map is released when the last node
+ * drops it, and deserialized again if it is requested later.
+ */
+class LaneletMapRegistry
+{
+public:
+  static LaneletMapRegistry & getInstance();
+
+  /**
+   * @brief Get the map of the message, deserializing it only if no node of this process holds
+   * the same map
+   * @details Deserialization happens without the registry lock, so that requests of other maps are
+   * not blocked. Nodes which receive the same map at the same time wait for the first one instead
+   * of deserializing it again.
+   */
+  std::shared_ptr<const SharedLaneletMap> get(const LaneletMapBin & msg);
+
+  /**
+   * @brief Number of maps held by at least one node
+   */
+  size_t size() const;
+
+  struct Statistics
+  {
+    size_t hit_count{0};
+    size_t deserialize_count{0};
+  };
+  Statistics getStatistics() const;
+
+private:
+  LaneletMapRegistry() = default;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<uint64_t, std::weak_ptr<const SharedLaneletMap>> maps_;
+  // maps being deserialized
+  std::unordered_map<uint64_t, std::shared_future<std::shared_ptr<const SharedLaneletMap>>>
+    pending_maps_;
+  Statistics statistics_;
+};
+
+/**
+ * @brief Shorthand of LaneletMapRegistry::getInstance().get(msg)
+ */
+std::shared_ptr<const SharedLaneletMap> getSharedLaneletMap(const LaneletMapBin & msg);
+}  // namespace autoware::lanelet2_map_registry
+
+#endif  // AUTOWARE__LANELET2_MAP_REGISTRY__LANELET2_MAP_REGISTRY_HPP_
@@ -0,0 +1,211 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/lanelet2_map_registry/lanelet2_map_registry.hpp"
+
+#include <autoware_lanelet2_extension/utility/message_conversion.hpp>
+
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_routing/RoutingGraph.h>
+#include <lanelet2_routing/RoutingGraphContainer.h>
+#include <lanelet2_traffic_rules/TrafficRulesFactory.h>
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace autoware::lanelet2_map_registry
+{
+namespace
+{
+void hashCombine(uint64_t & seed, const uint64_t value)
+{
+  seed ^= value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+}
+
+std::shared_ptr<const SharedLaneletMap> deserializeMap(
+  const LaneletMapBin & msg, const uint64_t hash)
+{
+  auto lanelet_map = std::make_shared<lanelet::LaneletMap>();
+  lanelet::utils::conversion::fromBinMsg(msg, lanelet_map);
+  // the centerline is calculated and cached on the first access without synchronization, so it is
+  // calculated before the map is shared
+  for (const auto & lanelet : lanelet_map->laneletLayer) {
+    static_cast<void>(lanelet.centerline());
+  }
+  return std::make_shared<const SharedLaneletMap>(std::move(lanelet_map), hash, msg);
+}
+}  // namespace
+
+uint64_t calcMapHash(const LaneletMapBin & msg)
+{
+  const std::hash<std::string_view> hasher;
+  uint64_t seed = msg.data.size();
+  hashCombine(seed, hasher(msg.version_map_format));
+  hashCombine(seed, hasher(msg.version_map));
+  hashCombine(seed, hasher(msg.name_map));
+  const std::string_view data(reinterpret_cast<const char *>(msg.data.data()), msg.data.size());
+  hashCombine(seed, hasher(data));
+  return seed;
+}
+
+SharedLaneletMap::SharedLaneletMap(
+  lanelet::LaneletMapConstPtr map, const uint64_t hash, const LaneletMapBin & msg)
+: map_(std::move(map)),
+  hash_(hash),
+  version_map_format_(msg.version_map_format),
+  version_map_(msg.version_map),
+  name_map_(msg.name_map),
+  data_(msg.data.begin(), msg.data.end())
+{
+}
+
+bool SharedLaneletMap::isMapOf(const LaneletMapBin & msg) const
+{
+  return msg.data.size() == data_.size() && msg.version_map_format == version_map_format_ &&
+         msg.version_map == version_map_ && msg.name_map == name_map_ &&
+         std::equal(msg.data.begin(), msg.data.end(), data_.begin());
+}
+
+lanelet::traffic_rules::TrafficRulesPtr SharedLaneletMap::createTrafficRules(
+  const std::string & participant)
+{
+  return lanelet::traffic_rules::TrafficRulesFactory::create(
+    lanelet::Locations::Germany, participant);
+}
+
+lanelet::routing::RoutingGraphConstPtr SharedLaneletMap::routingGraph(
+  const std::string & participant) const
+{
+  std::lock_guard<std::mutex> lock(routing_graph_mutex_);
+  auto & routing_graph = routing_graphs_[participant];
+  if (!routing_graph) {
+    routing_graph = lanelet::routing::RoutingGraph::build(*map_, *createTrafficRules(participant));
+  }
+  return routing_graph;
+}
+
+lanelet::routing::RoutingGraphConstPtr SharedLaneletMap::vehicleRoutingGraph() const
+{
+  return routingGraph(lanelet::Participants::Vehicle);
+}
+
+lanelet::routing::RoutingGraphConstPtr SharedLaneletMap::pedestrianRoutingGraph() const
+{
+  return routingGraph(lanelet::Participants::Pedestrian);
+}
+
+std::shared_ptr<const lanelet::routing::RoutingGraphContainer> SharedLaneletMap::overallGraphs()
+  const
+{
+  // build the graphs before taking the lock, since routingGraph() takes the same lock
+  const auto vehicle_graph = vehicleRoutingGraph();
+  const auto pedestrian_graph = pedestrianRoutingGraph();
+
+  std::lock_guard<std::mutex> lock(routing_graph_mutex_);
+  if (!overall_graphs_) {
+    overall_graphs_ = std::make_shared<const lanelet::routing::RoutingGraphContainer>(
+      std::vector<lanelet::routing::RoutingGraphConstPtr>{vehicle_graph, pedestrian_graph});
+  }
+  return overall_graphs_;
+}
+
+LaneletMapRegistry & LaneletMapRegistry::getInstance()
+{
+  static LaneletMapRegistry registry;
+  return registry;
+}
+
+std::shared_ptr<const SharedLaneletMap> LaneletMapRegistry::get(const LaneletMapBin & msg)
+{
+  const auto hash = calcMapHash(msg);
+
+  std::promise<std::shared_ptr<const SharedLaneletMap>> promise;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (const auto itr = maps_.find(hash); itr != maps_.end()) {
+      if (auto shared_map = itr->second.lock(); shared_map && shared_map->isMapOf(msg)) {
+        ++statistics_.hit_count;
+        return shared_map;
+      }
+    }
+
+    if (const auto itr = pending_maps_.find(hash); itr != pending_maps_.end()) {
+      // wait for the node deserializing the map, which rethrows its exception if it failed
+      const auto pending_map = itr->second;
+      lock.unlock();
+      auto shared_map = pending_map.get();
+      lock.lock();
+      if (shared_map->isMapOf(msg)) {
+        ++statistics_.hit_count;
+        return shared_map;
+      }
+
+      // different map with the same hash, which is not registered
+      ++statistics_.deserialize_count;
+      lock.unlock();
+      return deserializeMap(msg, hash);
+    }
+    pending_maps_.emplace(hash, promise.get_future().share());
+  }
+
+  std::shared_ptr<const SharedLaneletMap> shared_map;
+  try {
+    shared_map = deserializeMap(msg, hash);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_maps_.erase(hash);
+    promise.set_exception(std::current_exception());
+    throw;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++statistics_.deserialize_count;
+
+  // drop the entries of the released maps
+  for (auto itr = maps_.begin(); itr != maps_.end();) {
+    itr = itr->second.expired() ? maps_.erase(itr) : std::next(itr);
+  }
+  maps_[hash] = shared_map;
+  pending_maps_.erase(hash);
+  promise.set_value(shared_map);
+  return shared_map;
+}
+
+size_t LaneletMapRegistry::size() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t count = 0;
+  for (const auto & [hash, map] : maps_) {
+    if (!map.expired()) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+LaneletMapRegistry::Statistics LaneletMapRegistry::getStatistics() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
+std::shared_ptr<const SharedLaneletMap> getSharedLaneletMap(const LaneletMapBin & msg)
+{
+  return LaneletMapRegistry::getInstance().get(msg);
+}
+}  // namespace autoware::lanelet2_map_registry
@@ -0,0 +1,170 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/lanelet2_map_registry/lanelet2_map_registry.hpp"
+
+#include <autoware_lanelet2_extension/utility/message_conversion.hpp>
+#include <autoware_test_utils/autoware_test_utils.hpp>
+
+#include <gtest/gtest.h>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_routing/RoutingGraph.h>
+#include <lanelet2_routing/RoutingGraphContainer.h>
+
+#include <future>
+#include <vector>
+
+using autoware::lanelet2_map_registry::calcMapHash;
+using autoware::lanelet2_map_registry::LaneletMapRegistry;
+using autoware::lanelet2_map_registry::SharedLaneletMap;
+
+TEST(LaneletMapRegistry, shareSameMap)
+{
+  const auto msg = autoware::test_utils::makeMapBinMsg();
+  auto & registry = LaneletMapRegistry::getInstance();
+  const auto initial_statistics = registry.getStatistics();
+
+  const auto map_1 = registry.get(msg);
+  const auto map_2 = registry.get(msg);
+  ASSERT_NE(map_1, nullptr);
+  EXPECT_EQ(map_1, map_2);
+  EXPECT_EQ(map_1->hash(), calcMapHash(msg));
+  EXPECT_FALSE(map_1->map()->laneletLayer.empty());
+
+  const auto statistics = registry.getStatistics();
+  EXPECT_EQ(statistics.deserialize_count, initial_statistics.deserialize_count + 1);
+  EXPECT_EQ(statistics.hit_count, initial_statistics.hit_count + 1);
+}
+
+TEST(LaneletMapRegistry, releaseUnusedMap)
+{
+  const auto msg = autoware::test_utils::makeMapBinMsg();
+  auto & registry = LaneletMapRegistry::getInstance();
+  {
+    const auto map = registry.get(msg);
+    EXPECT_EQ(registry.size(), 1u);
+  }
+  EXPECT_EQ(registry.size(), 0u);
+
+  // a released map is deserialized again
+  const auto deserialize_count = registry.getStatistics().deserialize_count;
+  const auto map = registry.get(msg);
+  EXPECT_EQ(registry.getStatistics().deserialize_count, deserialize_count + 1);
+}
+
+TEST(LaneletMapRegistry, distinguishDifferentMaps)
+{
+  const auto msg = autoware::test_utils::makeMapBinMsg();
+  auto other_msg = msg;
+  other_msg.name_map = msg.name_map + "_other";
+  EXPECT_NE(calcMapHash(msg), calcMapHash(other_msg));
+
+  auto & registry = LaneletMapRegistry::getInstance();
+  const auto map = registry.get(msg);
+  const auto other_map = registry.get(other_msg);
+  EXPECT_NE(map, other_map);
+  EXPECT_EQ(registry.size(), 2u);
+  EXPECT_TRUE(map->isMapOf(msg));
+  EXPECT_FALSE(map->isMapOf(other_msg));
+  EXPECT_TRUE(other_map->isMapOf(other_msg));
+}
+
+TEST(SharedLaneletMap, compareContent)
+{
+  const auto msg = autoware::test_utils::makeMapBinMsg();
+  const auto map = LaneletMapRegistry::getInstance().get(msg);
+  ASSERT_FALSE(msg.data.empty());
+  EXPECT_TRUE(map->isMapOf(msg));
+
+  auto modified_msg = msg;
+  modified_msg.data.back() ^= 0x01;
+  EXPECT_FALSE(map->isMapOf(modified_msg));
+
+  auto truncated_msg = msg;
+  truncated_msg.data.pop_back();
+  EXPECT_FALSE(map->isMapOf(truncated_msg));
+}
+
+TEST(LaneletMapRegistry, concurrentRequests)
+{
+  const auto msg = autoware::test_utils::makeMapBinMsg();
+  auto & registry = LaneletMapRegistry::getInstance();
+  const auto deserialize_count = registry.getStatistics().deserialize_count;
+
+  std::vector<std::future<std::shared_ptr<const SharedLaneletMap>>> futures;
+  for (size_t i = 0; i < 4; ++i) {
+    futures.push_back(std::async(std::launch::async, [&]() { return registry.get(msg); }));
+  }
+  std::vector<std::shared_ptr<const SharedLaneletMap>> maps;
+  for (auto & future : futures) {
+    maps.push_back(future.get());
+  }
+  for (const auto & map : maps) {
+    EXPECT_EQ(map, maps.front());
+  }
+  EXPECT_EQ(registry.getStatistics().deserialize_count, deserialize_count + 1);
+}
+
+TEST(SharedLaneletMap, buildRoutingGraphsOnce)
+{
+  const auto msg = autoware::test_utils::makeMapBinMsg();
+  const auto map = LaneletMapRegistry::getInstance().get(msg);
+
+  const auto vehicle_graph = map->vehicleRoutingGraph();
+  ASSERT_NE(vehicle_graph, nullptr);
+  EXPECT_EQ(vehicle_graph, map->vehicleRoutingGraph());
+  EXPECT_NE(vehicle_graph, map->pedestrianRoutingGraph());
+
+  const auto overall_graphs = map->overallGraphs();
+  ASSERT_NE(overall_graphs, nullptr);
+  EXPECT_EQ(overall_graphs, map->overallGraphs());
+
+  // the graph is the same as the one built by fromBinMsg()
+  auto reference_map = std::make_shared<lanelet::LaneletMap>();
+  lanelet::traffic_rules::TrafficRulesPtr traffic_rules;
+  lanelet::routing::RoutingGraphPtr reference_graph;
+  lanelet::utils::conversion::fromBinMsg(msg, reference_map, &traffic_rules, &reference_graph);
+  for (const auto & lanelet : map->map()->laneletLayer) {
+    const auto reference_lanelet = reference_map->laneletLayer.get(lanelet.id());
+    EXPECT_EQ(
+      vehicle_graph->following(lanelet).size(),
+      reference_graph->following(reference_lanelet).size());
+    EXPECT_EQ(
+      vehicle_graph->besides(lanelet).size(), reference_graph->besides(reference_lanelet).size());
+  }
+}
+
+TEST(SharedLaneletMap, concurrentReads)
+{
+  const auto msg = autoware::test_utils::makeMapBinMsg();
+  const auto map = LaneletMapRegistry::getInstance().get(msg);
+
+  // the centerlines are calculated at the registration, so they are only read here
+  const auto read_centerlines = [&map]() {
+    size_t num_points = 0;
+    for (const auto & lanelet : map->map()->laneletLayer) {
+      num_points += lanelet.centerline().size();
+    }
+    return num_points;
+  };
+  std::vector<std::future<size_t>> futures;
+  for (size_t i = 0; i < 4; ++i) {
+    futures.push_back(std::async(std::launch::async, read_centerlines));
+  }
+  const auto num_points = read_centerlines();
+  EXPECT_GT(num_points, 0u);
+  for (auto & future : futures) {
+    EXPECT_EQ(future.get(), num_points);
+  }
+}
@@ -0,0 +1,161 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__MOTION_UTILS__RESAMPLE__RESAMPLER_HPP_
+#define AUTOWARE__MOTION_UTILS__RESAMPLE__RESAMPLER_HPP_
+
+#include "interpolation/spline_interpolation.hpp"
+
+#include "autoware_planning_msgs/msg/path.hpp"
+#include "autoware_planning_msgs/msg/trajectory.hpp"
+#include "geometry_msgs/msg/pose.hpp"
+#include "tier4_planning_msgs/msg/path_with_lane_id.hpp"
+
+#include <vector>
+
+namespace autoware::motion_utils
+{
+/**
+ * @brief Resampler of paths and trajectories which gives the same results as resamplePath() and
+ * resampleTrajectory(), but interpolates all the fields of the points in one sweep and writes them
+ * to the given output.
+ * @details The arc lengths of the input points, the indices of the interpolation and the spline
+ * coefficients are kept as members. When the same resampler and the same output are used every
+ * cycle, resampling allocates memory only when the number of points grows.
+ * A resampler is not thread-safe. The output may be the input, at the cost of a copy.
+ *
+ * Usage:
+ * ```
+ * // member of the node
+ * autoware::motion_utils::Resampler resampler_;
+ * tier4_planning_msgs::msg::PathWithLaneId resampled_path_;
+ *
+ * // every cycle
+ * resampler_.resamplePath(path, resample_interval, resampled_path_);
+ * ```
+ */
+class Resampler
+{
+public:
+  /**
+   * @brief resample input_path at resampled_arclength into output_path. The arguments are the
+   * same as resamplePath().
+   * @return false if the arguments are invalid, in which case output_path is input_path
+   */
+  bool resamplePath(
+    const tier4_planning_msgs::msg::PathWithLaneId & input_path,
+    const std::vector<double> & resampled_arclength,
+    tier4_planning_msgs::msg::PathWithLaneId & output_path,
+    const bool use_akima_spline_for_xy = false, const bool use_lerp_for_z = true,
+    const bool use_zero_order_hold_for_v = true);
+
+  /**
+   * @brief resample input_path at resample_interval into output_path. The arguments are the same
+   * as resamplePath().
+   * @return false if the arguments are invalid, in which case output_path is input_path
+   */
+  bool resamplePath(
+    const tier4_planning_msgs::msg::PathWithLaneId & input_path, const double resample_interval,
+    tier4_planning_msgs::msg::PathWithLaneId & output_path,
+    const bool use_akima_spline_for_xy = false, const bool use_lerp_for_z = true,
+    const bool use_zero_order_hold_for_v = true, const bool resample_input_path_stop_point = true);
+
+  bool resamplePath(
+    const autoware_planning_msgs::msg::Path & input_path,
+    const std::vector<double> & resampled_arclength,
+    autoware_planning_msgs::msg::Path & output_path, const bool use_akima_spline_for_xy = false,
+    const bool use_lerp_for_z = true, const bool use_zero_order_hold_for_v = true);
+
+  bool resamplePath(
+    const autoware_planning_msgs::msg::Path & input_path, const double resample_interval,
+    autoware_planning_msgs::msg::Path & output_path, const bool use_akima_spline_for_xy = false,
+    const bool use_lerp_for_z = true, const bool use_zero_order_hold_for_twist = true,
+    const bool resample_input_path_stop_point = true);
+
+  bool resampleTrajectory(
+    const autoware_planning_msgs::msg::Trajectory & input_trajectory,
+    const std::vector<double> & resampled_arclength,
+    autoware_planning_msgs::msg::Trajectory & output_trajectory,
+    const bool use_akima_spline_for_xy = false, const bool use_lerp_for_z = true,
+    const bool use_zero_order_hold_for_twist = true);
+
+  bool resampleTrajectory(
+    const autoware_planning_msgs::msg::Trajectory & input_trajectory,
+    const double resample_interval, autoware_planning_msgs::msg::Trajectory & output_trajectory,
+    const bool use_akima_spline_for_xy = false, const bool use_lerp_for_z = true,
+    const bool use_zero_order_hold_for_twist = true,
+    const bool resample_input_trajectory_stop_point = true);
+
+private:
+  // resample at resampling_arclength_
+  bool resample(
+    const tier4_planning_msgs::msg::PathWithLaneId & input_path,
+    tier4_planning_msgs::msg::PathWithLaneId & output_path, const bool use_akima_spline_for_xy,
+    const bool use_lerp_for_z, const bool use_zero_order_hold_for_v);
+  bool resample(
+    const autoware_planning_msgs::msg::Path & input_path,
+    autoware_planning_msgs::msg::Path & output_path, const bool use_akima_spline_for_xy,
+    const bool use_lerp_for_z, const bool use_zero_order_hold_for_v);
+  bool resample(
+    const autoware_planning_msgs::msg::Trajectory & input_trajectory,
+    autoware_planning_msgs::msg::Trajectory & output_trajectory,
+    const bool use_akima_spline_for_xy, const bool use_lerp_for_z,
+    const bool use_zero_order_hold_for_twist);
+
+  // input_arclength_ of input_points
+  template <class T>
+  void calcInputArclength(const T & input_points);
+
+  // resampling_arclength_ at resample_interval, with the terminal point and the stop point
+  template <class T>
+  bool calcResamplingArclength(
+    const T & input_points, const double resample_interval, const bool insert_stop_point);
+
+  // indices and ratios of resampling_arclength_ on input_arclength_
+  void calcInterpolationIndices();
+
+  // positions and orientations of output_points, which have the size of resampling_arclength_.
+  // As resamplePoseVector(), they are fitted on the input poses without the overlapping ones.
+  // Returns false if these poses are invalid.
+  template <class T>
+  bool interpolatePoses(
+    const T & input_points, T & output_points, const bool use_akima_spline_for_xy,
+    const bool use_lerp_for_z);
+
+  std::vector<double> input_arclength_;
+  std::vector<double> resampling_arclength_;
+
+  // per resampled point: the segment of the linear and spline interpolation, and the ratio on it
+  std::vector<size_t> segment_indices_;
+  std::vector<double> segment_ratios_;
+  // per resampled point: the input point held by the zero order hold
+  std::vector<size_t> closest_indices_;
+
+  // input poses without the overlapping ones, their arc lengths, and per resampled point the
+  // segment of the interpolation on them and the ratio on it
+  std::vector<geometry_msgs::msg::Pose> poses_;
+  std::vector<double> pose_arclength_;
+  std::vector<size_t> pose_segment_indices_;
+  std::vector<double> pose_segment_ratios_;
+
+  std::vector<double> x_;
+  std::vector<double> y_;
+  std::vector<double> z_;
+  interpolation::MultiSplineCoef x_coef_;
+  interpolation::MultiSplineCoef y_coef_;
+  SplineInterpolation z_spline_;
+};
+}  // namespace autoware::motion_utils
+
+#endif  // AUTOWARE__MOTION_UTILS__RESAMPLE__RESAMPLER_HPP_
@@ -0,0 +1,559 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__MOTION_UTILS__TRAJECTORY__TRAJECTORY_VIEW_HPP_
+#define AUTOWARE__MOTION_UTILS__TRAJECTORY__TRAJECTORY_VIEW_HPP_
+
+#include "autoware/motion_utils/trajectory/trajectory.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace autoware::motion_utils
+{
+/**
+ * @brief Read-only view of a points container (trajectory, path, ...) with a cumulative arc length
+ * table and a segment direction table.
+ * @details The tables are built on the first query and reused by the following ones, so that the
+ * queries on the same points within one cycle do not scan and measure the points again: arc
+ * lengths between indices are O(1), offset points along the points are O(log n), and the nearest
+ * search reads the positions from a compact array.
+ * The view does not own the points. The points must outlive the view, and invalidate() must be
+ * called after they are modified. The view is not thread-safe since the tables are built lazily.
+ * The results are the same as the ones of the free functions in trajectory.hpp, except that the
+ * segment of an index always ends at the next non-overlapping point, while some free functions
+ * remove the overlapping points of the whole container first.
+ */
+template <class T>
+class TrajectoryView
+{
+public:
+  explicit TrajectoryView(const T & points) : points_(&points) {}
+  // the view does not own the points
+  explicit TrajectoryView(T && points) = delete;
+
+  const T & points() const { return *points_; }
+  size_t size() const { return points_->size(); }
+  bool empty() const { return points_->empty(); }
+
+  /**
+   * @brief drop the tables so that they are rebuilt from the current points on the next query
+   */
+  void invalidate()
+  {
+    is_cache_valid_ = false;
+    last_nearest_idx_ = 0;
+  }
+
+  /**
+   * @brief arc length from the front point to the given index
+   */
+  double arcLength(const size_t idx) const
+  {
+    buildCache();
+    return arc_lengths_.at(idx);
+  }
+
+  double calcArcLength() const
+  {
+    if (empty()) {
+      return 0.0;
+    }
+    buildCache();
+    return arc_lengths_.back();
+  }
+
+  double calcSignedArcLength(const size_t src_idx, const size_t dst_idx) const
+  {
+    if (empty()) {
+      return 0.0;
+    }
+    buildCache();
+    return arc_lengths_.at(dst_idx) - arc_lengths_.at(src_idx);
+  }
+
+  double calcSignedArcLength(
+    const geometry_msgs::msg::Point & src_point, const size_t dst_idx) const
+  {
+    if (empty()) {
+      return 0.0;
+    }
+    const size_t src_seg_idx = findNearestSegmentIndex(src_point);
+    return calcSignedArcLength(src_seg_idx, dst_idx) -
+           calcLongitudinalOffsetToSegment(src_seg_idx, src_point);
+  }
+
+  double calcSignedArcLength(
+    const size_t src_idx, const geometry_msgs::msg::Point & dst_point) const
+  {
+    return -calcSignedArcLength(dst_point, src_idx);
+  }
+
+  double calcSignedArcLength(
+    const geometry_msgs::msg::Point & src_point, const geometry_msgs::msg::Point & dst_point) const
+  {
+    if (empty()) {
+      return 0.0;
+    }
+    const size_t src_seg_idx = findNearestSegmentIndex(src_point);
+    const size_t dst_seg_idx = findNearestSegmentIndex(dst_point);
+    return calcSignedArcLength(src_seg_idx, dst_seg_idx) -
+           calcLongitudinalOffsetToSegment(src_seg_idx, src_point) +
+           calcLongitudinalOffsetToSegment(dst_seg_idx, dst_point);
+  }
+
+  /**
+   * @brief find the segment which contains the given arc length from the front point by binary
+   * search. The arc length is clamped to the points.
+   */
+  size_t findSegmentIndexAtArcLength(const double arc_length) const
+  {
+    validateNonEmpty(points());
+    if (size() < 2) {
+      return 0;
+    }
+    buildCache();
+    const auto itr = std::upper_bound(arc_lengths_.begin(), arc_lengths_.end(), arc_length);
+    const size_t idx =
+      itr == arc_lengths_.begin() ? 0 : static_cast<size_t>(itr - arc_lengths_.begin()) - 1;
+    return std::min(idx, size() - 2);
+  }
+
+  /**
+   * @brief same as calcLongitudinalOffsetPoint() in trajectory.hpp, found by binary search
+   */
+  std::optional<geometry_msgs::msg::Point> calcLongitudinalOffsetPoint(
+    const size_t src_idx, const double offset, const bool throw_exception = false) const
+  {
+    if (empty()) {
+      return {};
+    }
+    if (size() - 1 < src_idx) {
+      handleError<std::out_of_range>(
+        std::string(__func__) +
+          " error: The given source index is out of the points size. Failed to calculate "
+          "longitudinal offset.",
+        throw_exception);
+      return {};
+    }
+    if (size() == 1) {
+      return {};
+    }
+
+    buildCache();
+    const double target_arc_length = arc_lengths_.at(src_idx) + offset;
+    if (target_arc_length < 0.0 || arc_lengths_.back() < target_arc_length) {
+      return {};
+    }
+    const size_t seg_idx = findSegmentIndexAtArcLength(target_arc_length);
+    const double segment_length = arc_lengths_.at(seg_idx + 1) - arc_lengths_.at(seg_idx);
+    const double ratio =
+      segment_length < std::numeric_limits<double>::epsilon()
+        ? 0.0
+        : std::clamp((target_arc_length - arc_lengths_.at(seg_idx)) / segment_length, 0.0, 1.0);
+    return autoware::universe_utils::calcInterpolatedPoint(
+      points().at(seg_idx), points().at(seg_idx + 1), ratio);
+  }
+
+  /**
+   * @brief same as findNearestIndex() in trajectory.hpp
+   */
+  size_t findNearestIndex(const geometry_msgs::msg::Point & point) const
+  {
+    validateNonEmpty(points());
+    buildCache();
+
+    double min_squared_dist = std::numeric_limits<double>::max();
+    size_t min_idx = 0;
+    for (size_t i = 0; i < xs_.size(); ++i) {
+      const double squared_dist = calcSquaredDistance2d(i, point);
+      if (squared_dist < min_squared_dist) {
+        min_squared_dist = squared_dist;
+        min_idx = i;
+      }
+    }
+    last_nearest_idx_ = min_idx;
+    return min_idx;
+  }
+
+  /**
+   * @brief same as findNearestIndex() in trajectory.hpp
+   */
+  std::optional<size_t> findNearestIndex(
+    const geometry_msgs::msg::Pose & pose,
+    const double max_dist = std::numeric_limits<double>::max(),
+    const double max_yaw = std::numeric_limits<double>::max()) const
+  {
+    if (empty()) {
+      return std::nullopt;
+    }
+    buildCache();
+
+    const double max_squared_dist = max_dist * max_dist;
+    double min_squared_dist = std::numeric_limits<double>::max();
+    std::optional<size_t> min_idx;
+    for (size_t i = 0; i < xs_.size(); ++i) {
+      const double squared_dist = calcSquaredDistance2d(i, pose.position);
+      if (squared_dist > max_squared_dist || squared_dist >= min_squared_dist) {
+        continue;
+      }
+      const auto yaw = autoware::universe_utils::calcYawDeviation(
+        autoware::universe_utils::getPose(points().at(i)), pose);
+      if (std::fabs(yaw) > max_yaw) {
+        continue;
+      }
+      min_squared_dist = squared_dist;
+      min_idx = i;
+    }
+    if (min_idx) {
+      last_nearest_idx_ = *min_idx;
+    }
+    return min_idx;
+  }
+
+  /**
+   * @brief find the nearest point index by descending the distance from the hint index
+   * @details This finds the local minimum of the distance around the hint, which is the nearest
+   * point when the given point moves continuously along the points as the ego does. It also keeps
+   * the index on the current lap of a looping path, where the global search may jump to another
+   * lap.
+   */
+  size_t findNearestIndexFromHint(const geometry_msgs::msg::Point & point, size_t hint_idx) const
+  {
+    validateNonEmpty(points());
+    buildCache();
+
+    size_t idx = std::min(hint_idx, size() - 1);
+    double min_squared_dist = calcSquaredDistance2d(idx, point);
+    while (idx + 1 < size() && calcSquaredDistance2d(idx + 1, point) < min_squared_dist) {
+      min_squared_dist = calcSquaredDistance2d(++idx, point);
+    }
+    while (0 < idx && calcSquaredDistance2d(idx - 1, point) < min_squared_dist) {
+      min_squared_dist = calcSquaredDistance2d(--idx, point);
+    }
+    last_nearest_idx_ = idx;
+    return idx;
+  }
+
+  /**
+   * @brief findNearestIndexFromHint() from the result of the last nearest search of this view
+   */
+  size_t findNearestIndexFromHint(const geometry_msgs::msg::Point & point) const
+  {
+    return findNearestIndexFromHint(point, last_nearest_idx_);
+  }
+
+  /**
+   * @brief same as findNearestSegmentIndex() in trajectory.hpp
+   */
+  size_t findNearestSegmentIndex(const geometry_msgs::msg::Point & point) const
+  {
+    return toNearestSegmentIndex(findNearestIndex(point), point);
+  }
+
+  /**
+   * @brief same as findNearestSegmentIndex() in trajectory.hpp
+   */
+  std::optional<size_t> findNearestSegmentIndex(
+    const geometry_msgs::msg::Pose & pose,
+    const double max_dist = std::numeric_limits<double>::max(),
+    const double max_yaw = std::numeric_limits<double>::max()) const
+  {
+    const auto nearest_idx = findNearestIndex(pose, max_dist, max_yaw);
+    if (!nearest_idx) {
+      return std::nullopt;
+    }
+    return toNearestSegmentIndex(*nearest_idx, pose.position);
+  }
+
+  /**
+   * @brief findNearestSegmentIndex() with the nearest index found by findNearestIndexFromHint()
+   */
+  size_t findNearestSegmentIndexFromHint(const geometry_msgs::msg::Point & point) const
+  {
+    return toNearestSegmentIndex(findNearestIndexFromHint(point), point);
+  }
+
+  /**
+   * @brief same as calcLongitudinalOffsetToSegment() in trajectory.hpp
+   */
+  double calcLongitudinalOffsetToSegment(
+    const size_t seg_idx, const geometry_msgs::msg::Point & p_target,
+    const bool throw_exception = false) const
+  {
+    if (size() == 0 || seg_idx >= size() - 1) {
+      return handleError<std::out_of_range>(
+        std::string(__func__) +
+          ": Failed to calculate longitudinal offset because the given segment index is out of "
+          "the points size.",
+        throw_exception);
+    }
+    buildCache();
+    if (next_indices_.at(seg_idx) == size()) {
+      return handleError<std::runtime_error>(
+        std::string(__func__) +
+          ": Longitudinal offset calculation is not supported for the same points.",
+        throw_exception);
+    }
+    return directions_x_.at(seg_idx) * (p_target.x - xs_.at(seg_idx)) +
+           directions_y_.at(seg_idx) * (p_target.y - ys_.at(seg_idx));
+  }
+
+  /**
+   * @brief same as calcLateralOffset() in trajectory.hpp
+   */
+  double calcLateralOffset(
+    const geometry_msgs::msg::Point & p_target, const size_t seg_idx,
+    const bool throw_exception = false) const
+  {
+    if (empty()) {
+      return handleError<std::invalid_argument>(
+        std::string(__func__) + ": Points is empty.", throw_exception);
+    }
+    buildCache();
+    // use the last segment which ends at another point, as the overlap removed points do
+    size_t front_idx = std::min(seg_idx, size() - std::min<size_t>(size(), 2));
+    while (0 < front_idx && next_indices_.at(front_idx) == size()) {
+      --front_idx;
+    }
+    if (next_indices_.at(front_idx) == size()) {
+      return handleError<std::runtime_error>(
+        std::string(__func__) +
+          ": Lateral offset calculation is not supported for the same points.",
+        throw_exception);
+    }
+    return directions_x_.at(front_idx) * (p_target.y - ys_.at(front_idx)) -
+           directions_y_.at(front_idx) * (p_target.x - xs_.at(front_idx));
+  }
+
+  /**
+   * @brief same as calcLateralOffset() in trajectory.hpp
+   */
+  double calcLateralOffset(
+    const geometry_msgs::msg::Point & p_target, const bool throw_exception = false) const
+  {
+    if (empty()) {
+      return calcLateralOffset(p_target, 0, throw_exception);
+    }
+    return calcLateralOffset(p_target, findNearestSegmentIndex(p_target), throw_exception);
+  }
+
+private:
+  void buildCache() const
+  {
+    if (is_cache_valid_) {
+      return;
+    }
+    const size_t n = size();
+    xs_.resize(n);
+    ys_.resize(n);
+    arc_lengths_.resize(n);
+    next_indices_.resize(n);
+    directions_x_.resize(n);
+    directions_y_.resize(n);
+
+    for (size_t i = 0; i < n; ++i) {
+      const auto & p = autoware::universe_utils::getPoint(points_->at(i));
+      xs_[i] = p.x;
+      ys_[i] = p.y;
+      arc_lengths_[i] =
+        i == 0 ? 0.0 : arc_lengths_[i - 1] + std::hypot(xs_[i] - xs_[i - 1], ys_[i] - ys_[i - 1]);
+    }
+
+    // same threshold as removeOverlapPoints()
+    constexpr double eps = 1.0E-08;
+    for (size_t i = 0; i < n; ++i) {
+      size_t next_idx = i + 1;
+      while (next_idx < n && std::abs(xs_[next_idx] - xs_[i]) < eps &&
+             std::abs(ys_[next_idx] - ys_[i]) < eps) {
+        ++next_idx;
+      }
+      next_indices_[i] = next_idx;
+      directions_x_[i] = 0.0;
+      directions_y_[i] = 0.0;
+      if (next_idx < n) {
+        const double dx = xs_[next_idx] - xs_[i];
+        const double dy = ys_[next_idx] - ys_[i];
+        const double length = std::hypot(dx, dy);
+        directions_x_[i] = dx / length;
+        directions_y_[i] = dy / length;
+      }
+    }
+    is_cache_valid_ = true;
+  }
+
+  double calcSquaredDistance2d(const size_t idx, const geometry_msgs::msg::Point & point) const
+  {
+    const double dx = xs_[idx] - point.x;
+    const double dy = ys_[idx] - point.y;
+    return dx * dx + dy * dy;
+  }
+
+  size_t toNearestSegmentIndex(
+    const size_t nearest_idx, const geometry_msgs::msg::Point & point) const
+  {
+    if (nearest_idx == 0) {
+      return 0;
+    }
+    if (nearest_idx == size() - 1) {
+      return size() - 2;
+    }
+    const double signed_length = calcLongitudinalOffsetToSegment(nearest_idx, point);
+    if (signed_length <= 0) {
+      return nearest_idx - 1;
+    }
+    return nearest_idx;
+  }
+
+  template <class ExceptionT>
+  static double handleError(const std::string & message, const bool throw_exception)
+  {
+    const std::string error_message("[autoware_motion_utils] TrajectoryView::" + message);
+    autoware::universe_utils::print_backtrace();
+    if (throw_exception) {
+      throw ExceptionT(error_message);
+    }
+    RCLCPP_DEBUG(
+      get_logger(),
+      "%s Return NaN since no_throw option is enabled. The maintainer must check the code.",
+      error_message.c_str());
+    return std::nan("");
+  }
+
+  const T * points_;
+
+  mutable bool is_cache_valid_{false};
+  mutable size_t last_nearest_idx_{0};
+  mutable std::vector<double> xs_;
+  mutable std::vector<double> ys_;
+  mutable std::vector<double> arc_lengths_;
+  // index of the next point which does not overlap, or size() if there is none
+  mutable std::vector<size_t> next_indices_;
+  // unit direction to the next point which does not overlap
+  mutable std::vector<double> directions_x_;
+  mutable std::vector<double> directions_y_;
+};
+
+extern template class TrajectoryView<std::vector<autoware_planning_msgs::msg::PathPoint>>;
+extern template class TrajectoryView<std::vector<tier4_planning_msgs::msg::PathPointWithLaneId>>;
+extern template class TrajectoryView<std::vector<autoware_planning_msgs::msg::TrajectoryPoint>>;
+
+// Overloads of the functions in trajectory.hpp which use the tables of the view
+
+template <class T>
+size_t findNearestIndex(const TrajectoryView<T> & view, const geometry_msgs::msg::Point & point)
+{
+  return view.findNearestIndex(point);
+}
+
+template <class T>
+std::optional<size_t> findNearestIndex(
+  const TrajectoryView<T> & view, const geometry_msgs::msg::Pose & pose,
+  const double max_dist = std::numeric_limits<double>::max(),
+  const double max_yaw = std::numeric_limits<double>::max())
+{
+  return view.findNearestIndex(pose, max_dist, max_yaw);
+}
+
+template <class T>
+size_t findNearestSegmentIndex(
+  const TrajectoryView<T> & view, const geometry_msgs::msg::Point & point)
+{
+  return view.findNearestSegmentIndex(point);
+}
+
+template <class T>
+std::optional<size_t> findNearestSegmentIndex(
+  const TrajectoryView<T> & view, const geometry_msgs::msg::Pose & pose,
+  const double max_dist = std::numeric_limits<double>::max(),
+  const double max_yaw = std::numeric_limits<double>::max())
+{
+  return view.findNearestSegmentIndex(pose, max_dist, max_yaw);
+}
+
+template <class T>
+double calcLongitudinalOffsetToSegment(
+  const TrajectoryView<T> & view, const size_t seg_idx, const geometry_msgs::msg::Point & p_target,
+  const bool throw_exception = false)
+{
+  return view.calcLongitudinalOffsetToSegment(seg_idx, p_target, throw_exception);
+}
+
+template <class T>
+double calcLateralOffset(
+  const TrajectoryView<T> & view, const geometry_msgs::msg::Point & p_target, const size_t seg_idx,
+  const bool throw_exception = false)
+{
+  return view.calcLateralOffset(p_target, seg_idx, throw_exception);
+}
+
+template <class T>
+double calcLateralOffset(
+  const TrajectoryView<T> & view, const geometry_msgs::msg::Point & p_target,
+  const bool throw_exception = false)
+{
+  return view.calcLateralOffset(p_target, throw_exception);
+}
+
+template <class T>
+double calcSignedArcLength(
+  const TrajectoryView<T> & view, const size_t src_idx, const size_t dst_idx)
+{
+  return view.calcSignedArcLength(src_idx, dst_idx);
+}
+
+template <class T>
+double calcSignedArcLength(
+  const TrajectoryView<T> & view, const geometry_msgs::msg::Point & src_point,
+  const size_t dst_idx)
+{
+  return view.calcSignedArcLength(src_point, dst_idx);
+}
+
+template <class T>
+double calcSignedArcLength(
+  const TrajectoryView<T> & view, const size_t src_idx, const geometry_msgs::msg::Point & dst_point)
+{
+  return view.calcSignedArcLength(src_idx, dst_point);
+}
+
+template <class T>
+double calcSignedArcLength(
+  const TrajectoryView<T> & view, const geometry_msgs::msg::Point & src_point,
+  const geometry_msgs::msg::Point & dst_point)
+{
+  return view.calcSignedArcLength(src_point, dst_point);
+}
+
+template <class T>
+double calcArcLength(const TrajectoryView<T> & view)
+{
+  return view.calcArcLength();
+}
+
+template <class T>
+std::optional<geometry_msgs::msg::Point> calcLongitudinalOffsetPoint(
+  const TrajectoryView<T> & view, const size_t src_idx, const double offset,
+  const bool throw_exception = false)
+{
+  return view.calcLongitudinalOffsetPoint(src_idx, offset, throw_exception);
+}
+}  // namespace autoware::motion_utils
+
+#endif  // AUTOWARE__MOTION_UTILS__TRAJECTORY__TRAJECTORY_VIEW_HPP_
@@ -0,0 +1,621 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/motion_utils/resample/resampler.hpp"
+
+#include "autoware/motion_utils/resample/resample_utils.hpp"
+#include "autoware/motion_utils/trajectory/trajectory.hpp"
+#include "autoware/universe_utils/geometry/geometry.hpp"
+#include "interpolation/interpolation_utils.hpp"
+#include "interpolation/linear_interpolation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace autoware::motion_utils
+{
+namespace
+{
+const autoware_planning_msgs::msg::PathPoint & getPathPoint(
+  const tier4_planning_msgs::msg::PathPointWithLaneId & point)
+{
+  return point.point;
+}
+
+autoware_planning_msgs::msg::PathPoint & getPathPoint(
+  tier4_planning_msgs::msg::PathPointWithLaneId & point)
+{
+  return point.point;
+}
+
+template <class T>
+T & getPathPoint(T & point)
+{
+  return point;
+}
+
+// the key of interpolation::lerp() and interpolation::spline(), which crop the first and last
+// query keys into the base keys
+double getCroppedKey(
+  const std::vector<double> & base_keys, const std::vector<double> & query_keys, const size_t i)
+{
+  double query_key = query_keys[i];
+  if (i == 0) {
+    query_key = std::max(query_key, base_keys.front());
+  }
+  if (i == query_keys.size() - 1) {
+    query_key = std::min(query_key, base_keys.back());
+  }
+  return query_key;
+}
+
+// segment of each query key on the base keys and the ratio on it, as interpolation::lerp()
+void calcSegmentIndices(
+  const std::vector<double> & base_keys, const std::vector<double> & query_keys,
+  std::vector<size_t> & segment_indices, std::vector<double> & segment_ratios)
+{
+  segment_indices.resize(query_keys.size());
+  segment_ratios.resize(query_keys.size());
+
+  // NOTE: query_keys is sorted, so that the segments are found by one sweep over base_keys.
+  size_t segment_idx = 0;
+  for (size_t i = 0; i < query_keys.size(); ++i) {
+    const double s = getCroppedKey(base_keys, query_keys, i);
+    while (segment_idx + 2 < base_keys.size() && base_keys[segment_idx + 1] < s) {
+      ++segment_idx;
+    }
+    segment_indices[i] = segment_idx;
+    segment_ratios[i] =
+      (s - base_keys[segment_idx]) / (base_keys[segment_idx + 1] - base_keys[segment_idx]);
+  }
+}
+
+double calcCubicValue(
+  const interpolation::MultiSplineCoef & coef, const size_t segment_idx, const double ds)
+{
+  return coef.d[segment_idx] +
+         (coef.c[segment_idx] + (coef.b[segment_idx] + coef.a[segment_idx] * ds) * ds) * ds;
+}
+
+// insert arclength into resampling_arclength, or move the resampling point close to it
+void insertResamplingArclength(std::vector<double> & resampling_arclength, const double arclength)
+{
+  for (size_t i = 1; i < resampling_arclength.size(); ++i) {
+    if (resampling_arclength.at(i - 1) <= arclength && arclength < resampling_arclength.at(i)) {
+      const double dist_to_prev_point = std::fabs(arclength - resampling_arclength.at(i - 1));
+      const double dist_to_following_point = std::fabs(resampling_arclength.at(i) - arclength);
+      if (dist_to_prev_point < autoware::motion_utils::overlap_threshold) {
+        resampling_arclength.at(i - 1) = arclength;
+      } else if (dist_to_following_point < autoware::motion_utils::overlap_threshold) {
+        resampling_arclength.at(i) = arclength;
+      } else {
+        resampling_arclength.insert(resampling_arclength.begin() + i, arclength);
+      }
+      break;
+    }
+  }
+}
+}  // namespace
+
+bool Resampler::resamplePath(
+  const tier4_planning_msgs::msg::PathWithLaneId & input_path,
+  const std::vector<double> & resampled_arclength,
+  tier4_planning_msgs::msg::PathWithLaneId & output_path, const bool use_akima_spline_for_xy,
+  const bool use_lerp_for_z, const bool use_zero_order_hold_for_v)
+{
+  if (&input_path == &output_path) {
+    const auto input_path_copy = input_path;
+    return resamplePath(
+      input_path_copy, resampled_arclength, output_path, use_akima_spline_for_xy, use_lerp_for_z,
+      use_zero_order_hold_for_v);
+  }
+
+  calcInputArclength(input_path.points);
+  resampling_arclength_ = resampled_arclength;
+  return resample(
+    input_path, output_path, use_akima_spline_for_xy, use_lerp_for_z, use_zero_order_hold_for_v);
+}
+
+bool Resampler::resamplePath(
+  const tier4_planning_msgs::msg::PathWithLaneId & input_path, const double resample_interval,
+  tier4_planning_msgs::msg::PathWithLaneId & output_path, const bool use_akima_spline_for_xy,
+  const bool use_lerp_for_z, const bool use_zero_order_hold_for_v,
+  const bool resample_input_path_stop_point)
+{
+  if (&input_path == &output_path) {
+    const auto input_path_copy = input_path;
+    return resamplePath(
+      input_path_copy, resample_interval, output_path, use_akima_spline_for_xy, use_lerp_for_z,
+      use_zero_order_hold_for_v, resample_input_path_stop_point);
+  }
+
+  if (!calcResamplingArclength(
+        input_path.points, resample_interval, resample_input_path_stop_point)) {
+    output_path = input_path;
+    return false;
+  }
+  return resample(
+    input_path, output_path, use_akima_spline_for_xy, use_lerp_for_z, use_zero_order_hold_for_v);
+}
+
+bool Resampler::resamplePath(
+  const autoware_planning_msgs::msg::Path & input_path,
+  const std::vector<double> & resampled_arclength, autoware_planning_msgs::msg::Path & output_path,
+  const bool use_akima_spline_for_xy, const bool use_lerp_for_z,
+  const bool use_zero_order_hold_for_v)
+{
+  if (&input_path == &output_path) {
+    const auto input_path_copy = input_path;
+    return resamplePath(
+      input_path_copy, resampled_arclength, output_path, use_akima_spline_for_xy, use_lerp_for_z,
+      use_zero_order_hold_for_v);
+  }
+
+  calcInputArclength(input_path.points);
+  resampling_arclength_ = resampled_arclength;
+  return resample(
+    input_path, output_path, use_akima_spline_for_xy, use_lerp_for_z, use_zero_order_hold_for_v);
+}
+
+bool Resampler::resamplePath(
+  const autoware_planning_msgs::msg::Path & input_path, const double resample_interval,
+  autoware_planning_msgs::msg::Path & output_path, const bool use_akima_spline_for_xy,
+  const bool use_lerp_for_z, const bool use_zero_order_hold_for_twist,
+  const bool resample_input_path_stop_point)
+{
+  if (&input_path == &output_path) {
+    const auto input_path_copy = input_path;
+    return resamplePath(
+      input_path_copy, resample_interval, output_path, use_akima_spline_for_xy, use_lerp_for_z,
+      use_zero_order_hold_for_twist, resample_input_path_stop_point);
+  }
+
+  if (!calcResamplingArclength(
+        input_path.points, resample_interval, resample_input_path_stop_point)) {
+    output_path = input_path;
+    return false;
+  }
+  return resample(
+    input_path, output_path, use_akima_spline_for_xy, use_lerp_for_z,
+    use_zero_order_hold_for_twist);
+}
+
+bool Resampler::resampleTrajectory(
+  const autoware_planning_msgs::msg::Trajectory & input_trajectory,
+  const std::vector<double> & resampled_arclength,
+  autoware_planning_msgs::msg::Trajectory & output_trajectory, const bool use_akima_spline_for_xy,
+  const bool use_lerp_for_z, const bool use_zero_order_hold_for_twist)
+{
+  if (&input_trajectory == &output_trajectory) {
+    const auto input_trajectory_copy = input_trajectory;
+    return resampleTrajectory(
+      input_trajectory_copy, resampled_arclength, output_trajectory, use_akima_spline_for_xy,
+      use_lerp_for_z, use_zero_order_hold_for_twist);
+  }
+
+  calcInputArclength(input_trajectory.points);
+  resampling_arclength_ = resampled_arclength;
+  return resample(
+    input_trajectory, output_trajectory, use_akima_spline_for_xy, use_lerp_for_z,
+    use_zero_order_hold_for_twist);
+}
+
+bool Resampler::resampleTrajectory(
+  const autoware_planning_msgs::msg::Trajectory & input_trajectory,
+  const double resample_interval, autoware_planning_msgs::msg::Trajectory & output_trajectory,
+  const bool use_akima_spline_for_xy, const bool use_lerp_for_z,
+  const bool use_zero_order_hold_for_twist, const bool resample_input_trajectory_stop_point)
+{
+  if (&input_trajectory == &output_trajectory) {
+    const auto input_trajectory_copy = input_trajectory;
+    return resampleTrajectory(
+      input_trajectory_copy, resample_interval, output_trajectory, use_akima_spline_for_xy,
+      use_lerp_for_z, use_zero_order_hold_for_twist, resample_input_trajectory_stop_point);
+  }
+
+  if (!calcResamplingArclength(
+        input_trajectory.points, resample_interval, resample_input_trajectory_stop_point)) {
+    output_trajectory = input_trajectory;
+    return false;
+  }
+  return resample(
+    input_trajectory, output_trajectory, use_akima_spline_for_xy, use_lerp_for_z,
+    use_zero_order_hold_for_twist);
+}
+
+bool Resampler::resample(
+  const tier4_planning_msgs::msg::PathWithLaneId & input_path,
+  tier4_planning_msgs::msg::PathWithLaneId & output_path, const bool use_akima_spline_for_xy,
+  const bool use_lerp_for_z, const bool use_zero_order_hold_for_v)
+{
+  // Add resampling_arclength to insert input points which have multiple lane_ids
+  for (size_t i = 0; i < input_path.points.size(); ++i) {
+    if (input_path.points.at(i).lane_ids.size() < 2) {
+      continue;
+    }
+    insertResamplingArclength(resampling_arclength_, input_arclength_.at(i));
+  }
+
+  // validate arguments
+  if (!resample_utils::validate_arguments(input_path.points, resampling_arclength_)) {
+    output_path = input_path;
+    return false;
+  }
+
+  if (input_arclength_.back() < resampling_arclength_.back()) {
+    std::cerr << "[autoware_motion_utils]: resampled path length is longer than input path length"
+              << std::endl;
+    output_path = input_path;
+    return false;
+  }
+
+  calcInterpolationIndices();
+
+  output_path.header = input_path.header;
+  output_path.left_bound = input_path.left_bound;
+  output_path.right_bound = input_path.right_bound;
+  output_path.points.resize(resampling_arclength_.size());
+  if (!interpolatePoses(
+        input_path.points, output_path.points, use_akima_spline_for_xy, use_lerp_for_z)) {
+    output_path = input_path;
+    return false;
+  }
+
+  // For LaneIds, is_final
+  //
+  // ------|----|----|----|----|----|----|-------> resampled
+  //      [0]  [1]  [2]  [3]  [4]  [5]  [6]
+  //
+  // ------|----------------|----------|---------> base
+  //      [0]             [1]        [2]
+  //
+  // resampled[0~3] = base[0]
+  // resampled[4~5] = base[1]
+  // resampled[6] = base[2]
+  constexpr double epsilon = 1e-6;
+  for (size_t i = 0; i < resampling_arclength_.size(); ++i) {
+    const size_t segment_idx = segment_indices_.at(i);
+    const double ratio = segment_ratios_.at(i);
+    const size_t closest_idx = closest_indices_.at(i);
+    const auto & prev_point = input_path.points.at(segment_idx).point;
+    const auto & next_point = input_path.points.at(segment_idx + 1).point;
+    const auto & closest_point = input_path.points.at(closest_idx).point;
+
+    const auto lerp = [&](const auto & prev_value, const auto & next_value) {
+      return interpolation::lerp(prev_value, next_value, ratio);
+    };
+
+    auto & path_point = output_path.points.at(i).point;
+    path_point.longitudinal_velocity_mps =
+      use_zero_order_hold_for_v
+        ? closest_point.longitudinal_velocity_mps
+        : lerp(prev_point.longitudinal_velocity_mps, next_point.longitudinal_velocity_mps);
+    path_point.lateral_velocity_mps =
+      use_zero_order_hold_for_v
+        ? closest_point.lateral_velocity_mps
+        : lerp(prev_point.lateral_velocity_mps, next_point.lateral_velocity_mps);
+    path_point.heading_rate_rps = lerp(prev_point.heading_rate_rps, next_point.heading_rate_rps);
+    path_point.is_final = closest_point.is_final;
+
+    // interpolate lane_ids
+    const size_t seg_idx = std::min(closest_idx, input_path.points.size() - 2);
+    const auto & prev_lane_ids = input_path.points.at(seg_idx).lane_ids;
+    const auto & next_lane_ids = input_path.points.at(seg_idx + 1).lane_ids;
+    auto & lane_ids = output_path.points.at(i).lane_ids;
+    lane_ids.clear();
+
+    const double s = resampling_arclength_.at(i);
+    if (std::abs(input_arclength_.at(seg_idx) - s) <= epsilon) {
+      lane_ids.insert(lane_ids.end(), prev_lane_ids.begin(), prev_lane_ids.end());
+    } else if (std::abs(input_arclength_.at(seg_idx + 1) - s) <= epsilon) {
+      lane_ids.insert(lane_ids.end(), next_lane_ids.begin(), next_lane_ids.end());
+    } else {
+      // extract lane_ids those prev_lane_ids and next_lane_ids have in common
+      for (const auto target_lane_id : prev_lane_ids) {
+        if (
+          std::find(next_lane_ids.begin(), next_lane_ids.end(), target_lane_id) !=
+          next_lane_ids.end()) {
+          lane_ids.push_back(target_lane_id);
+        }
+      }
+      // If there are no common lane_ids, the prev_lane_ids is assigned.
+      if (lane_ids.empty()) {
+        lane_ids.insert(lane_ids.end(), prev_lane_ids.begin(), prev_lane_ids.end());
+      }
+    }
+  }
+
+  return true;
+}
+
+bool Resampler::resample(
+  const autoware_planning_msgs::msg::Path & input_path,
+  autoware_planning_msgs::msg::Path & output_path, const bool use_akima_spline_for_xy,
+  const bool use_lerp_for_z, const bool use_zero_order_hold_for_v)
+{
+  // validate arguments
+  if (!resample_utils::validate_arguments(input_path.points, resampling_arclength_)) {
+    output_path = input_path;
+    return false;
+  }
+
+  calcInterpolationIndices();
+
+  output_path.header = input_path.header;
+  output_path.left_bound = input_path.left_bound;
+  output_path.right_bound = input_path.right_bound;
+  output_path.points.resize(resampling_arclength_.size());
+  if (!interpolatePoses(
+        input_path.points, output_path.points, use_akima_spline_for_xy, use_lerp_for_z)) {
+    output_path = input_path;
+    return false;
+  }
+
+  for (size_t i = 0; i < resampling_arclength_.size(); ++i) {
+    const double ratio = segment_ratios_.at(i);
+    const auto & prev_point = input_path.points.at(segment_indices_.at(i));
+    const auto & next_point = input_path.points.at(segment_indices_.at(i) + 1);
+    const auto & closest_point = input_path.points.at(closest_indices_.at(i));
+
+    const auto lerp = [&](const auto & prev_value, const auto & next_value) {
+      return interpolation::lerp(prev_value, next_value, ratio);
+    };
+
+    auto & path_point = output_path.points.at(i);
+    path_point.longitudinal_velocity_mps =
+      use_zero_order_hold_for_v
+        ? closest_point.longitudinal_velocity_mps
+        : lerp(prev_point.longitudinal_velocity_mps, next_point.longitudinal_velocity_mps);
+    path_point.lateral_velocity_mps =
+      use_zero_order_hold_for_v
+        ? closest_point.lateral_velocity_mps
+        : lerp(prev_point.lateral_velocity_mps, next_point.lateral_velocity_mps);
+    path_point.heading_rate_rps = lerp(prev_point.heading_rate_rps, next_point.heading_rate_rps);
+    path_point.is_final = false;
+  }
+
+  return true;
+}
+
+bool Resampler::resample(
+  const autoware_planning_msgs::msg::Trajectory & input_trajectory,
+  autoware_planning_msgs::msg::Trajectory & output_trajectory, const bool use_akima_spline_for_xy,
+  const bool use_lerp_for_z, const bool use_zero_order_hold_for_twist)
+{
+  // validate arguments
+  if (!resample_utils::validate_arguments(input_trajectory.points, resampling_arclength_)) {
+    output_trajectory = input_trajectory;
+    return false;
+  }
+
+  calcInterpolationIndices();
+
+  output_trajectory.header = input_trajectory.header;
+  output_trajectory.points.resize(resampling_arclength_.size());
+  if (!interpolatePoses(
+        input_trajectory.points, output_trajectory.points, use_akima_spline_for_xy,
+        use_lerp_for_z)) {
+    output_trajectory = input_trajectory;
+    return false;
+  }
+
+  for (size_t i = 0; i < resampling_arclength_.size(); ++i) {
+    const double ratio = segment_ratios_.at(i);
+    const auto & prev_point = input_trajectory.points.at(segment_indices_.at(i));
+    const auto & next_point = input_trajectory.points.at(segment_indices_.at(i) + 1);
+    const auto & closest_point = input_trajectory.points.at(closest_indices_.at(i));
+    const auto lerp = [&](const auto & prev_value, const auto & next_value) {
+      return interpolation::lerp(prev_value, next_value, ratio);
+    };
+
+    auto & traj_point = output_trajectory.points.at(i);
+    traj_point.longitudinal_velocity_mps =
+      use_zero_order_hold_for_twist
+        ? closest_point.longitudinal_velocity_mps
+        : lerp(prev_point.longitudinal_velocity_mps, next_point.longitudinal_velocity_mps);
+    traj_point.lateral_velocity_mps =
+      use_zero_order_hold_for_twist
+        ? closest_point.lateral_velocity_mps
+        : lerp(prev_point.lateral_velocity_mps, next_point.lateral_velocity_mps);
+    traj_point.heading_rate_rps = lerp(prev_point.heading_rate_rps, next_point.heading_rate_rps);
+    traj_point.acceleration_mps2 =
+      use_zero_order_hold_for_twist
+        ? closest_point.acceleration_mps2
+        : lerp(prev_point.acceleration_mps2, next_point.acceleration_mps2);
+    traj_point.front_wheel_angle_rad =
+      lerp(prev_point.front_wheel_angle_rad, next_point.front_wheel_angle_rad);
+    traj_point.rear_wheel_angle_rad =
+      lerp(prev_point.rear_wheel_angle_rad, next_point.rear_wheel_angle_rad);
+    traj_point.time_from_start = rclcpp::Duration::from_seconds(
+      lerp(
+        rclcpp::Duration(prev_point.time_from_start).seconds(),
+        rclcpp::Duration(next_point.time_from_start).seconds()));
+  }
+
+  return true;
+}
+
+template <class T>
+void Resampler::calcInputArclength(const T & input_points)
+{
+  input_arclength_.resize(input_points.size());
+  if (input_points.empty()) {
+    return;
+  }
+
+  input_arclength_.front() = 0.0;
+  for (size_t i = 1; i < input_points.size(); ++i) {
+    const double ds = autoware::universe_utils::calcDistance2d(
+      autoware::universe_utils::getPoint(input_points.at(i - 1)),
+      autoware::universe_utils::getPoint(input_points.at(i)));
+    input_arclength_.at(i) = ds + input_arclength_.at(i - 1);
+  }
+}
+
+template <class T>
+bool Resampler::calcResamplingArclength(
+  const T & input_points, const double resample_interval, const bool insert_stop_point)
+{
+  // validate arguments
+  if (!resample_utils::validate_arguments(input_points, resample_interval)) {
+    return false;
+  }
+
+  calcInputArclength(input_points);
+  const double input_length = input_arclength_.back();
+
+  resampling_arclength_.clear();
+  for (double s = 0.0; s < input_length; s += resample_interval) {
+    resampling_arclength_.push_back(s);
+  }
+  if (resampling_arclength_.empty()) {
+    std::cerr << "[autoware_motion_utils]: resampling arclength is empty" << std::endl;
+    return false;
+  }
+
+  // Insert terminal point
+  if (input_length - resampling_arclength_.back() < autoware::motion_utils::overlap_threshold) {
+    resampling_arclength_.back() = input_length;
+  } else {
+    resampling_arclength_.push_back(input_length);
+  }
+
+  // Insert stop point, which is the first point of zero velocity as in
+  // calcDistanceToForwardStopPoint()
+  if (insert_stop_point) {
+    constexpr double epsilon = 1e-3;
+    for (size_t i = 0; i < input_points.size(); ++i) {
+      if (std::fabs(getPathPoint(input_points.at(i)).longitudinal_velocity_mps) < epsilon) {
+        insertResamplingArclength(resampling_arclength_, std::max(0.0, input_arclength_.at(i)));
+        break;
+      }
+    }
+  }
+
+  return true;
+}
+
+void Resampler::calcInterpolationIndices()
+{
+  // throw exceptions for invalid arguments as the interpolation functions do
+  interpolation_utils::validateKeysWithoutCropping(input_arclength_, resampling_arclength_);
+
+  calcSegmentIndices(input_arclength_, resampling_arclength_, segment_indices_, segment_ratios_);
+
+  // NOTE: the threshold of interpolation::calc_closest_segment_indices()
+  constexpr double closest_segment_threshold = 1e-3;
+
+  const size_t num_input = input_arclength_.size();
+  closest_indices_.resize(resampling_arclength_.size());
+  size_t closest_idx = 0;
+  for (size_t i = 0; i < resampling_arclength_.size(); ++i) {
+    const double s = getCroppedKey(input_arclength_, resampling_arclength_, i);
+    while (closest_idx + 1 < num_input &&
+           input_arclength_[closest_idx + 1] - closest_segment_threshold < s) {
+      ++closest_idx;
+    }
+    closest_indices_[i] = closest_idx;
+  }
+}
+
+template <class T>
+bool Resampler::interpolatePoses(
+  const T & input_points, T & output_points, const bool use_akima_spline_for_xy,
+  const bool use_lerp_for_z)
+{
+  // NOTE: As resamplePoseVector(), the overlapping points are removed with the criterion of
+  //       removeOverlapPoints(), and the positions are fitted on the arc lengths of the remaining
+  //       points. The other fields are interpolated on input_arclength_.
+  constexpr double overlap_eps = 1.0E-08;
+  poses_.clear();
+  for (const auto & point : input_points) {
+    const auto & pose = getPathPoint(point).pose;
+    if (
+      !poses_.empty() && std::abs(poses_.back().position.x - pose.position.x) < overlap_eps &&
+      std::abs(poses_.back().position.y - pose.position.y) < overlap_eps) {
+      continue;
+    }
+    poses_.push_back(pose);
+  }
+  if (!resample_utils::validate_arguments(poses_, resampling_arclength_)) {
+    std::cerr
+      << "[autoware_motion_utils]: Resampled pose size is different from resampled arclength"
+      << std::endl;
+    return false;
+  }
+
+  pose_arclength_.resize(poses_.size());
+  x_.resize(poses_.size());
+  y_.resize(poses_.size());
+  z_.resize(poses_.size());
+  for (size_t i = 0; i < poses_.size(); ++i) {
+    const auto & position = poses_.at(i).position;
+    pose_arclength_.at(i) =
+      i == 0 ? 0.0
+             : pose_arclength_.at(i - 1) +
+                 autoware::universe_utils::calcDistance2d(poses_.at(i - 1).position, position);
+    x_.at(i) = position.x;
+    y_.at(i) = position.y;
+    z_.at(i) = position.z;
+  }
+  interpolation_utils::validateKeysWithoutCropping(pose_arclength_, resampling_arclength_);
+  calcSegmentIndices(
+    pose_arclength_, resampling_arclength_, pose_segment_indices_, pose_segment_ratios_);
+
+  // NOTE: As resamplePointVector(), use_akima_spline_for_xy selects the linear interpolation.
+  if (!use_akima_spline_for_xy) {
+    interpolation::calcAkimaSplineCoefficients(pose_arclength_, x_, x_coef_);
+    interpolation::calcAkimaSplineCoefficients(pose_arclength_, y_, y_coef_);
+  }
+  if (!use_lerp_for_z) {
+    z_spline_.calcSplineCoefficients(pose_arclength_, z_);
+  }
+
+  for (size_t i = 0; i < resampling_arclength_.size(); ++i) {
+    const size_t segment_idx = pose_segment_indices_.at(i);
+    const double ratio = pose_segment_ratios_.at(i);
+    auto & position = getPathPoint(output_points.at(i)).pose.position;
+
+    if (use_akima_spline_for_xy) {
+      position.x = interpolation::lerp(x_.at(segment_idx), x_.at(segment_idx + 1), ratio);
+      position.y = interpolation::lerp(y_.at(segment_idx), y_.at(segment_idx + 1), ratio);
+    } else {
+      // NOTE: interpolation::splineByAkima() does not crop the keys
+      const double ds = resampling_arclength_.at(i) - pose_arclength_.at(segment_idx);
+      position.x = calcCubicValue(x_coef_, segment_idx, ds);
+      position.y = calcCubicValue(y_coef_, segment_idx, ds);
+    }
+
+    if (use_lerp_for_z) {
+      position.z = interpolation::lerp(z_.at(segment_idx), z_.at(segment_idx + 1), ratio);
+    } else {
+      position.z = z_spline_.getSplineInterpolatedValue(
+        segment_idx, getCroppedKey(pose_arclength_, resampling_arclength_, i));
+    }
+  }
+
+  const bool is_driving_forward =
+    autoware::universe_utils::isDrivingForward(poses_.at(0), poses_.at(1));
+  autoware::motion_utils::insertOrientation(output_points, is_driving_forward);
+
+  // Initial orientation is depend on the initial value of the resampled_arclength
+  // when backward driving
+  if (!is_driving_forward && resampling_arclength_.front() < 1e-3) {
+    getPathPoint(output_points.at(0)).pose.orientation = poses_.at(0).orientation;
+  }
+  return true;
+}
+}  // namespace autoware::motion_utils
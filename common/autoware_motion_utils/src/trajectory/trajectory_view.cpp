@@ -1,4 +1,4 @@
-// Copyright 2020 Autoware Foundation
+// Copyright 2024 TIER IV, Inc.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -12,12 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-/**
- * @file mpstat1.cpp
- * @brief dummy mpstat mpstat to return error
- */
+#include "autoware/motion_utils/trajectory/trajectory_view.hpp"
 
-int main(int argc, char ** argv)
+namespace autoware::motion_utils
 {
-  return -1;
-}
+template class TrajectoryView<std::vector<autoware_planning_msgs::msg::PathPoint>>;
+template class TrajectoryView<std::vector<tier4_planning_msgs::msg::PathPointWithLaneId>>;
+template class TrajectoryView<std::vector<autoware_planning_msgs::msg::TrajectoryPoint>>;
+}  // namespace autoware::motion_utils
@@ -0,0 +1,104 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/motion_utils/resample/resample.hpp"
+#include "autoware/motion_utils/resample/resampler.hpp"
+#include "autoware/universe_utils/geometry/geometry.hpp"
+#include "autoware/universe_utils/system/stop_watch.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+using autoware::universe_utils::createPoint;
+using autoware_planning_msgs::msg::Trajectory;
+using tier4_planning_msgs::msg::PathWithLaneId;
+
+PathWithLaneId generateTestPathWithLaneId(const size_t num_points)
+{
+  PathWithLaneId path;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = i * 0.001;
+    tier4_planning_msgs::msg::PathPointWithLaneId p;
+    p.point.pose.position = createPoint(i * std::cos(theta), i * std::sin(theta), 0.0);
+    p.point.pose.orientation = autoware::universe_utils::createQuaternionFromYaw(theta);
+    p.point.longitudinal_velocity_mps = 10.0;
+    p.lane_ids = {static_cast<int64_t>(i / 10)};
+    path.points.push_back(p);
+  }
+  return path;
+}
+
+Trajectory generateTestTrajectory(const size_t num_points)
+{
+  Trajectory trajectory;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = i * 0.001;
+    autoware_planning_msgs::msg::TrajectoryPoint p;
+    p.pose.position = createPoint(i * std::cos(theta), i * std::sin(theta), 0.0);
+    p.pose.orientation = autoware::universe_utils::createQuaternionFromYaw(theta);
+    p.longitudinal_velocity_mps = 10.0;
+    trajectory.points.push_back(p);
+  }
+  return trajectory;
+}
+}  // namespace
+
+TEST(resample_benchmark, DISABLED_resampler)
+{
+  using autoware::motion_utils::resamplePath;
+  using autoware::motion_utils::resampleTrajectory;
+
+  constexpr size_t num_cycles = 100;
+  constexpr double resample_interval = 0.5;
+  autoware::universe_utils::StopWatch<std::chrono::nanoseconds, std::chrono::nanoseconds> sw;
+
+  for (const size_t num_points : {100, 1000, 5000}) {
+    const auto path = generateTestPathWithLaneId(num_points);
+    const auto trajectory = generateTestTrajectory(num_points);
+    // the number of the resampled points of one cycle
+    const double num_resampled_points = resamplePath(path, resample_interval).points.size();
+
+    for (const bool use_akima_spline_for_xy : {false, true}) {
+      // the free functions allocate the output and the intermediate vectors every cycle
+      sw.tic();
+      for (size_t i = 0; i < num_cycles; ++i) {
+        const auto resampled_path = resamplePath(path, resample_interval, use_akima_spline_for_xy);
+        const auto resampled_trajectory =
+          resampleTrajectory(trajectory, resample_interval, use_akima_spline_for_xy);
+      }
+      const double free_ns = sw.toc() / (num_cycles * num_resampled_points);
+
+      // the resampler and the outputs are kept over the cycles
+      autoware::motion_utils::Resampler resampler;
+      PathWithLaneId resampled_path;
+      Trajectory resampled_trajectory;
+      sw.tic();
+      for (size_t i = 0; i < num_cycles; ++i) {
+        resampler.resamplePath(path, resample_interval, resampled_path, use_akima_spline_for_xy);
+        resampler.resampleTrajectory(
+          trajectory, resample_interval, resampled_trajectory, use_akima_spline_for_xy);
+      }
+      const double resampler_ns = sw.toc() / (num_cycles * num_resampled_points);
+
+      std::printf(
+        "num_points = %zu, akima = %d: free functions = %2.2f ns/point, Resampler = %2.2f "
+        "ns/point\n",
+        num_points, use_akima_spline_for_xy, free_ns, resampler_ns);
+    }
+  }
+}
@@ -0,0 +1,541 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/motion_utils/resample/resample.hpp"
+#include "autoware/motion_utils/resample/resampler.hpp"
+#include "autoware/motion_utils/trajectory/trajectory.hpp"
+#include "autoware/universe_utils/geometry/geometry.hpp"
+#include "interpolation/linear_interpolation.hpp"
+#include "interpolation/zero_order_hold.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+using autoware::motion_utils::Resampler;
+using autoware::universe_utils::createPoint;
+using autoware::universe_utils::createQuaternionFromYaw;
+using autoware_planning_msgs::msg::Path;
+using autoware_planning_msgs::msg::Trajectory;
+using tier4_planning_msgs::msg::PathWithLaneId;
+
+// a curve with a stop point in the middle, driven backward if is_driving_forward is false
+template <class T>
+T generateTestCurve(const size_t num_points, const bool is_driving_forward = true)
+{
+  T traj;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = i * 0.05;
+    const double yaw = is_driving_forward ? theta : theta + M_PI;
+    typename T::_points_type::value_type p;
+    p.pose.position = createPoint(
+      10.0 * std::sin(theta) + 0.1 * i, 10.0 * (1.0 - std::cos(theta)), 0.01 * i * i);
+    p.pose.orientation = createQuaternionFromYaw(yaw);
+    p.longitudinal_velocity_mps = i == num_points / 2 ? 0.0 : 1.0 + i;
+    p.lateral_velocity_mps = 0.1 * i;
+    p.heading_rate_rps = 0.01 * i;
+    traj.points.push_back(p);
+  }
+  return traj;
+}
+
+template <>
+PathWithLaneId generateTestCurve(const size_t num_points, const bool is_driving_forward)
+{
+  const auto path = generateTestCurve<Path>(num_points, is_driving_forward);
+  PathWithLaneId path_with_lane_id;
+  for (size_t i = 0; i < path.points.size(); ++i) {
+    tier4_planning_msgs::msg::PathPointWithLaneId p;
+    p.point = path.points.at(i);
+    p.lane_ids = {static_cast<int64_t>(i / 5), static_cast<int64_t>(i / 5 + 100)};
+    path_with_lane_id.points.push_back(p);
+  }
+  return path_with_lane_id;
+}
+
+std::vector<double> generateArclength(const size_t num_points, const double interval)
+{
+  std::vector<double> resampled_arclength(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    resampled_arclength.at(i) = i * interval;
+  }
+  return resampled_arclength;
+}
+
+// a straight path along x with points every 0.05 m, and a point 1e-5 m after the one at x = 0.5
+template <class T>
+T generateDenseStraightPath()
+{
+  T traj;
+  for (size_t i = 0; i <= 40; ++i) {
+    typename T::_points_type::value_type p;
+    p.pose.position = createPoint(0.05 * i, 0.0, 0.0);
+    p.pose.orientation = createQuaternionFromYaw(0.0);
+    p.longitudinal_velocity_mps = 2.0;
+    p.lateral_velocity_mps = 0.05 * i;
+    traj.points.push_back(p);
+    if (i == 10) {
+      p.pose.position.x += 1e-5;
+      traj.points.push_back(p);
+    }
+  }
+  return traj;
+}
+
+// The reference functions below are the implementation of resamplePath() and resampleTrajectory()
+// before they were replaced by the Resampler. resamplePoseVector() is unchanged.
+
+template <class T>
+std::vector<double> referenceArclength(
+  const T & points, const double resample_interval, const bool insert_stop_point)
+{
+  const double input_len = autoware::motion_utils::calcArcLength(points);
+  std::vector<double> resampling_arclength;
+  for (double s = 0.0; s < input_len; s += resample_interval) {
+    resampling_arclength.push_back(s);
+  }
+  if (input_len - resampling_arclength.back() < autoware::motion_utils::overlap_threshold) {
+    resampling_arclength.back() = input_len;
+  } else {
+    resampling_arclength.push_back(input_len);
+  }
+  if (!insert_stop_point) {
+    return resampling_arclength;
+  }
+  const auto distance_to_stop_point =
+    autoware::motion_utils::calcDistanceToForwardStopPoint(points, 0);
+  if (!distance_to_stop_point) {
+    return resampling_arclength;
+  }
+  for (size_t i = 1; i < resampling_arclength.size(); ++i) {
+    if (
+      resampling_arclength.at(i - 1) <= *distance_to_stop_point &&
+      *distance_to_stop_point < resampling_arclength.at(i)) {
+      if (
+        std::fabs(*distance_to_stop_point - resampling_arclength.at(i - 1)) <
+        autoware::motion_utils::overlap_threshold) {
+        resampling_arclength.at(i - 1) = *distance_to_stop_point;
+      } else if (
+        std::fabs(resampling_arclength.at(i) - *distance_to_stop_point) <
+        autoware::motion_utils::overlap_threshold) {
+        resampling_arclength.at(i) = *distance_to_stop_point;
+      } else {
+        resampling_arclength.insert(resampling_arclength.begin() + i, *distance_to_stop_point);
+      }
+      break;
+    }
+  }
+  return resampling_arclength;
+}
+
+template <class T>
+std::vector<double> referenceInputArclength(const T & points)
+{
+  std::vector<double> input_arclength{0.0};
+  for (size_t i = 1; i < points.size(); ++i) {
+    input_arclength.push_back(
+      input_arclength.back() + autoware::universe_utils::calcDistance2d(
+                                 autoware::universe_utils::getPoint(points.at(i - 1)),
+                                 autoware::universe_utils::getPoint(points.at(i))));
+  }
+  return input_arclength;
+}
+
+template <class T>
+std::vector<geometry_msgs::msg::Pose> referencePoses(const T & points)
+{
+  std::vector<geometry_msgs::msg::Pose> poses;
+  for (const auto & p : points) {
+    poses.push_back(autoware::universe_utils::getPose(p));
+  }
+  return poses;
+}
+
+Path referenceResamplePath(
+  const Path & input_path, const std::vector<double> & resampled_arclength,
+  const bool use_akima_spline_for_xy, const bool use_lerp_for_z,
+  const bool use_zero_order_hold_for_v)
+{
+  const auto input_arclength = referenceInputArclength(input_path.points);
+  std::vector<double> v_lon;
+  std::vector<double> v_lat;
+  std::vector<double> heading_rate;
+  for (const auto & p : input_path.points) {
+    v_lon.push_back(p.longitudinal_velocity_mps);
+    v_lat.push_back(p.lateral_velocity_mps);
+    heading_rate.push_back(p.heading_rate_rps);
+  }
+  const auto lerp = [&](const auto & input) {
+    return interpolation::lerp(input_arclength, input, resampled_arclength);
+  };
+  const auto closest_segment_indices =
+    interpolation::calc_closest_segment_indices(input_arclength, resampled_arclength);
+  const auto zoh = [&](const auto & input) {
+    return interpolation::zero_order_hold(input_arclength, input, closest_segment_indices);
+  };
+
+  const auto interpolated_pose = autoware::motion_utils::resamplePoseVector(
+    referencePoses(input_path.points), resampled_arclength, use_akima_spline_for_xy,
+    use_lerp_for_z);
+  const auto interpolated_v_lon = use_zero_order_hold_for_v ? zoh(v_lon) : lerp(v_lon);
+  const auto interpolated_v_lat = use_zero_order_hold_for_v ? zoh(v_lat) : lerp(v_lat);
+  const auto interpolated_heading_rate = lerp(heading_rate);
+
+  Path resampled_path;
+  resampled_path.header = input_path.header;
+  resampled_path.left_bound = input_path.left_bound;
+  resampled_path.right_bound = input_path.right_bound;
+  resampled_path.points.resize(interpolated_pose.size());
+  for (size_t i = 0; i < resampled_path.points.size(); ++i) {
+    auto & p = resampled_path.points.at(i);
+    p.pose = interpolated_pose.at(i);
+    p.longitudinal_velocity_mps = interpolated_v_lon.at(i);
+    p.lateral_velocity_mps = interpolated_v_lat.at(i);
+    p.heading_rate_rps = interpolated_heading_rate.at(i);
+  }
+  return resampled_path;
+}
+
+PathWithLaneId referenceResamplePath(
+  const PathWithLaneId & input_path, const std::vector<double> & resampled_arclength,
+  const bool use_akima_spline_for_xy, const bool use_lerp_for_z,
+  const bool use_zero_order_hold_for_v)
+{
+  // insert the input points which have multiple lane_ids
+  auto resampling_arclength = resampled_arclength;
+  for (size_t i = 0; i < input_path.points.size(); ++i) {
+    if (input_path.points.at(i).lane_ids.size() < 2) {
+      continue;
+    }
+    const double distance = autoware::motion_utils::calcSignedArcLength(input_path.points, 0, i);
+    for (size_t j = 1; j < resampling_arclength.size(); ++j) {
+      if (resampling_arclength.at(j - 1) <= distance && distance < resampling_arclength.at(j)) {
+        if (
+          std::fabs(distance - resampling_arclength.at(j - 1)) <
+          autoware::motion_utils::overlap_threshold) {
+          resampling_arclength.at(j - 1) = distance;
+        } else if (
+          std::fabs(resampling_arclength.at(j) - distance) <
+          autoware::motion_utils::overlap_threshold) {
+          resampling_arclength.at(j) = distance;
+        } else {
+          resampling_arclength.insert(resampling_arclength.begin() + j, distance);
+        }
+        break;
+      }
+    }
+  }
+
+  Path path;
+  std::vector<bool> is_final;
+  for (const auto & p : input_path.points) {
+    path.points.push_back(p.point);
+    is_final.push_back(p.point.is_final);
+  }
+  const auto resampled_path = referenceResamplePath(
+    path, resampling_arclength, use_akima_spline_for_xy, use_lerp_for_z,
+    use_zero_order_hold_for_v);
+
+  const auto input_arclength = referenceInputArclength(input_path.points);
+  const auto closest_segment_indices =
+    interpolation::calc_closest_segment_indices(input_arclength, resampling_arclength);
+  const auto interpolated_is_final =
+    interpolation::zero_order_hold(input_arclength, is_final, closest_segment_indices);
+
+  PathWithLaneId resampled_path_with_lane_id;
+  resampled_path_with_lane_id.header = input_path.header;
+  resampled_path_with_lane_id.left_bound = input_path.left_bound;
+  resampled_path_with_lane_id.right_bound = input_path.right_bound;
+  resampled_path_with_lane_id.points.resize(resampled_path.points.size());
+  constexpr double epsilon = 1e-6;
+  for (size_t i = 0; i < resampled_path.points.size(); ++i) {
+    auto & p = resampled_path_with_lane_id.points.at(i);
+    p.point = resampled_path.points.at(i);
+    p.point.is_final = interpolated_is_final.at(i);
+
+    const size_t seg_idx = std::min(closest_segment_indices.at(i), input_path.points.size() - 2);
+    const auto & prev_lane_ids = input_path.points.at(seg_idx).lane_ids;
+    const auto & next_lane_ids = input_path.points.at(seg_idx + 1).lane_ids;
+    if (std::abs(input_arclength.at(seg_idx) - resampling_arclength.at(i)) <= epsilon) {
+      p.lane_ids = prev_lane_ids;
+    } else if (std::abs(input_arclength.at(seg_idx + 1) - resampling_arclength.at(i)) <= epsilon) {
+      p.lane_ids = next_lane_ids;
+    } else {
+      for (const auto lane_id : prev_lane_ids) {
+        if (std::find(next_lane_ids.begin(), next_lane_ids.end(), lane_id) != next_lane_ids.end()) {
+          p.lane_ids.push_back(lane_id);
+        }
+      }
+      if (p.lane_ids.empty()) {
+        p.lane_ids = prev_lane_ids;
+      }
+    }
+  }
+  return resampled_path_with_lane_id;
+}
+
+Trajectory referenceResampleTrajectory(
+  const Trajectory & input_trajectory, const std::vector<double> & resampled_arclength,
+  const bool use_akima_spline_for_xy, const bool use_lerp_for_z,
+  const bool use_zero_order_hold_for_twist)
+{
+  const auto input_arclength = referenceInputArclength(input_trajectory.points);
+  std::vector<double> v_lon;
+  std::vector<double> v_lat;
+  std::vector<double> heading_rate;
+  std::vector<double> acceleration;
+  std::vector<double> front_wheel_angle;
+  std::vector<double> rear_wheel_angle;
+  std::vector<double> time_from_start;
+  for (const auto & p : input_trajectory.points) {
+    v_lon.push_back(p.longitudinal_velocity_mps);
+    v_lat.push_back(p.lateral_velocity_mps);
+    heading_rate.push_back(p.heading_rate_rps);
+    acceleration.push_back(p.acceleration_mps2);
+    front_wheel_angle.push_back(p.front_wheel_angle_rad);
+    rear_wheel_angle.push_back(p.rear_wheel_angle_rad);
+    time_from_start.push_back(rclcpp::Duration(p.time_from_start).seconds());
+  }
+  const auto lerp = [&](const auto & input) {
+    return interpolation::lerp(input_arclength, input, resampled_arclength);
+  };
+  const auto closest_segment_indices =
+    interpolation::calc_closest_segment_indices(input_arclength, resampled_arclength);
+  const auto zoh = [&](const auto & input) {
+    return interpolation::zero_order_hold(input_arclength, input, closest_segment_indices);
+  };
+
+  const auto interpolated_pose = autoware::motion_utils::resamplePoseVector(
+    referencePoses(input_trajectory.points), resampled_arclength, use_akima_spline_for_xy,
+    use_lerp_for_z);
+  const auto interpolated_v_lon = use_zero_order_hold_for_twist ? zoh(v_lon) : lerp(v_lon);
+  const auto interpolated_v_lat = use_zero_order_hold_for_twist ? zoh(v_lat) : lerp(v_lat);
+  const auto interpolated_heading_rate = lerp(heading_rate);
+  const auto interpolated_acceleration =
+    use_zero_order_hold_for_twist ? zoh(acceleration) : lerp(acceleration);
+  const auto interpolated_front_wheel_angle = lerp(front_wheel_angle);
+  const auto interpolated_rear_wheel_angle = lerp(rear_wheel_angle);
+  const auto interpolated_time_from_start = lerp(time_from_start);
+
+  Trajectory resampled_trajectory;
+  resampled_trajectory.header = input_trajectory.header;
+  resampled_trajectory.points.resize(interpolated_pose.size());
+  for (size_t i = 0; i < resampled_trajectory.points.size(); ++i) {
+    auto & p = resampled_trajectory.points.at(i);
+    p.pose = interpolated_pose.at(i);
+    p.longitudinal_velocity_mps = interpolated_v_lon.at(i);
+    p.lateral_velocity_mps = interpolated_v_lat.at(i);
+    p.heading_rate_rps = interpolated_heading_rate.at(i);
+    p.acceleration_mps2 = interpolated_acceleration.at(i);
+    p.front_wheel_angle_rad = interpolated_front_wheel_angle.at(i);
+    p.rear_wheel_angle_rad = interpolated_rear_wheel_angle.at(i);
+    p.time_from_start = rclcpp::Duration::from_seconds(interpolated_time_from_start.at(i));
+  }
+  return resampled_trajectory;
+}
+}  // namespace
+
+TEST(resampler, resamplePathWithLaneId)
+{
+  using autoware::motion_utils::calcArcLength;
+
+  Resampler resampler;
+  PathWithLaneId resampled_path;
+  for (const bool is_driving_forward : {true, false}) {
+    for (const size_t num_points : {2, 10, 40}) {
+      const auto path = generateTestCurve<PathWithLaneId>(num_points, is_driving_forward);
+      for (const bool use_akima_spline_for_xy : {false, true}) {
+        for (const bool use_lerp_for_z : {false, true}) {
+          for (const bool use_zero_order_hold_for_v : {false, true}) {
+            const auto arclength = generateArclength(30, calcArcLength(path.points) / 30.0);
+            ASSERT_TRUE(resampler.resamplePath(
+              path, arclength, resampled_path, use_akima_spline_for_xy, use_lerp_for_z,
+              use_zero_order_hold_for_v));
+            EXPECT_EQ(
+              resampled_path, referenceResamplePath(
+                                path, arclength, use_akima_spline_for_xy, use_lerp_for_z,
+                                use_zero_order_hold_for_v));
+
+            ASSERT_TRUE(resampler.resamplePath(
+              path, 0.3, resampled_path, use_akima_spline_for_xy, use_lerp_for_z,
+              use_zero_order_hold_for_v));
+            EXPECT_EQ(
+              resampled_path, referenceResamplePath(
+                                path, referenceArclength(path.points, 0.3, true),
+                                use_akima_spline_for_xy, use_lerp_for_z,
+                                use_zero_order_hold_for_v));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(resampler, resamplePath)
+{
+  Resampler resampler;
+  Path resampled_path;
+  for (const bool is_driving_forward : {true, false}) {
+    for (const size_t num_points : {2, 10, 40}) {
+      const auto path = generateTestCurve<Path>(num_points, is_driving_forward);
+      for (const bool use_akima_spline_for_xy : {false, true}) {
+        for (const bool use_zero_order_hold_for_v : {false, true}) {
+          for (const bool resample_input_path_stop_point : {false, true}) {
+            ASSERT_TRUE(resampler.resamplePath(
+              path, 0.45, resampled_path, use_akima_spline_for_xy, true, use_zero_order_hold_for_v,
+              resample_input_path_stop_point));
+            EXPECT_EQ(
+              resampled_path,
+              referenceResamplePath(
+                path, referenceArclength(path.points, 0.45, resample_input_path_stop_point),
+                use_akima_spline_for_xy, true, use_zero_order_hold_for_v));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(resampler, resampleTrajectory)
+{
+  using autoware::motion_utils::calcArcLength;
+
+  Resampler resampler;
+  Trajectory resampled_trajectory;
+  for (const bool is_driving_forward : {true, false}) {
+    for (const size_t num_points : {2, 10, 40}) {
+      const auto trajectory = generateTestCurve<Trajectory>(num_points, is_driving_forward);
+      for (const bool use_akima_spline_for_xy : {false, true}) {
+        for (const bool use_lerp_for_z : {false, true}) {
+          for (const bool use_zero_order_hold_for_twist : {false, true}) {
+            const auto arclength =
+              generateArclength(25, calcArcLength(trajectory.points) / 25.0);
+            ASSERT_TRUE(resampler.resampleTrajectory(
+              trajectory, arclength, resampled_trajectory, use_akima_spline_for_xy,
+              use_lerp_for_z, use_zero_order_hold_for_twist));
+            EXPECT_EQ(
+              resampled_trajectory,
+              referenceResampleTrajectory(
+                trajectory, arclength, use_akima_spline_for_xy, use_lerp_for_z,
+                use_zero_order_hold_for_twist));
+
+            ASSERT_TRUE(resampler.resampleTrajectory(
+              trajectory, 0.3, resampled_trajectory, use_akima_spline_for_xy, use_lerp_for_z,
+              use_zero_order_hold_for_twist));
+            EXPECT_EQ(
+              resampled_trajectory,
+              referenceResampleTrajectory(
+                trajectory, referenceArclength(trajectory.points, 0.3, true),
+                use_akima_spline_for_xy, use_lerp_for_z, use_zero_order_hold_for_twist));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(resampler, aliasing)
+{
+  Resampler resampler;
+  const auto trajectory = generateTestCurve<Trajectory>(20);
+  auto resampled_trajectory = trajectory;
+  ASSERT_TRUE(resampler.resampleTrajectory(resampled_trajectory, 0.5, resampled_trajectory));
+  EXPECT_EQ(
+    resampled_trajectory,
+    referenceResampleTrajectory(
+      trajectory, referenceArclength(trajectory.points, 0.5, true), false, true, true));
+}
+
+TEST(resampler, invalidInput)
+{
+  Resampler resampler;
+  const auto path = generateTestCurve<PathWithLaneId>(10);
+  PathWithLaneId resampled_path;
+
+  // too few points
+  {
+    const auto one_point_path = generateTestCurve<PathWithLaneId>(1);
+    EXPECT_FALSE(
+      resampler.resamplePath(one_point_path, generateArclength(5, 0.1), resampled_path));
+    EXPECT_EQ(resampled_path, one_point_path);
+  }
+
+  // resampled arclength longer than the path
+  {
+    EXPECT_FALSE(resampler.resamplePath(path, generateArclength(5, 100.0), resampled_path));
+    EXPECT_EQ(resampled_path, path);
+  }
+
+  // too small interval
+  {
+    EXPECT_FALSE(resampler.resamplePath(path, 1e-4, resampled_path));
+    EXPECT_EQ(resampled_path, path);
+  }
+
+  // valid input after invalid input
+  {
+    EXPECT_TRUE(resampler.resamplePath(path, 0.5, resampled_path));
+    EXPECT_EQ(
+      resampled_path,
+      referenceResamplePath(path, referenceArclength(path.points, 0.5, true), false, true, true));
+  }
+}
+
+// Input points closer than the resampling interval and than overlap_threshold, with two points
+// almost at the same position
+TEST(resampler, denseInput)
+{
+  Resampler resampler;
+  Trajectory resampled_trajectory;
+  Path resampled_path;
+  const auto trajectory = generateDenseStraightPath<Trajectory>();
+  const auto path = generateDenseStraightPath<Path>();
+  for (const bool use_akima_spline_for_xy : {false, true}) {
+    for (const double interval : {0.1, 0.15, 0.3}) {
+      ASSERT_TRUE(resampler.resampleTrajectory(
+        trajectory, interval, resampled_trajectory, use_akima_spline_for_xy));
+      EXPECT_EQ(
+        resampled_trajectory,
+        referenceResampleTrajectory(
+          trajectory, referenceArclength(trajectory.points, interval, true),
+          use_akima_spline_for_xy, true, true));
+
+      ASSERT_TRUE(
+        resampler.resamplePath(path, interval, resampled_path, use_akima_spline_for_xy));
+      EXPECT_EQ(
+        resampled_path,
+        referenceResamplePath(
+          path, referenceArclength(path.points, interval, true), use_akima_spline_for_xy, true,
+          true));
+    }
+  }
+
+  // fixed values: the path is a straight line where x is the arc length
+  ASSERT_TRUE(resampler.resampleTrajectory(trajectory, 0.3, resampled_trajectory));
+  ASSERT_EQ(resampled_trajectory.points.size(), 8UL);
+  for (size_t i = 0; i < resampled_trajectory.points.size(); ++i) {
+    const auto & p = resampled_trajectory.points.at(i);
+    const double s = std::min(0.3 * i, 2.0);
+    EXPECT_NEAR(p.pose.position.x, s, 1e-6);
+    EXPECT_NEAR(p.pose.position.y, 0.0, 1e-6);
+    EXPECT_NEAR(p.pose.orientation.z, 0.0, 1e-6);
+    EXPECT_NEAR(p.pose.orientation.w, 1.0, 1e-6);
+    EXPECT_FLOAT_EQ(p.longitudinal_velocity_mps, 2.0);
+    EXPECT_NEAR(p.lateral_velocity_mps, s, 1e-6);
+  }
+}
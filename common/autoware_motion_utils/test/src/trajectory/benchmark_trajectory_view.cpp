@@ -0,0 +1,88 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/motion_utils/trajectory/trajectory.hpp"
+#include "autoware/motion_utils/trajectory/trajectory_view.hpp"
+#include "autoware/universe_utils/system/stop_watch.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+using autoware::universe_utils::createPoint;
+using autoware_planning_msgs::msg::TrajectoryPoint;
+
+std::vector<TrajectoryPoint> generateTestPoints(const size_t num_points)
+{
+  std::vector<TrajectoryPoint> points;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = i * 0.001;
+    TrajectoryPoint p;
+    p.pose.position = createPoint(i * std::cos(theta), i * std::sin(theta), 0.0);
+    p.pose.orientation = autoware::universe_utils::createQuaternionFromYaw(theta);
+    points.push_back(p);
+  }
+  return points;
+}
+}  // namespace
+
+TEST(trajectory_benchmark, DISABLED_trajectoryView)
+{
+  using autoware::motion_utils::calcLateralOffset;
+  using autoware::motion_utils::calcLongitudinalOffsetPoint;
+  using autoware::motion_utils::calcSignedArcLength;
+  using autoware::motion_utils::findNearestSegmentIndex;
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> dist(0.0, 1000.0);
+  autoware::universe_utils::StopWatch<std::chrono::milliseconds, std::chrono::microseconds> sw;
+
+  for (const size_t num_points : {100, 1000, 5000}) {
+    const auto points = generateTestPoints(num_points);
+    std::vector<geometry_msgs::msg::Point> targets;
+    for (size_t i = 0; i < 1000; ++i) {
+      targets.push_back(createPoint(dist(engine), dist(engine), 0.0));
+    }
+
+    // the queries of one planning cycle: nearest segment, lateral offset, arc length, offset point
+    double sum = 0.0;
+    sw.tic();
+    for (const auto & target : targets) {
+      sum += findNearestSegmentIndex(points, target);
+      sum += calcLateralOffset(points, target);
+      sum += calcSignedArcLength(points, target, points.size() / 2);
+      sum += calcLongitudinalOffsetPoint(points, 0, target.x).value_or(target).x;
+    }
+    const double free_ms = sw.toc();
+
+    sw.tic();
+    const autoware::motion_utils::TrajectoryView view(points);
+    for (const auto & target : targets) {
+      sum -= findNearestSegmentIndex(view, target);
+      sum -= calcLateralOffset(view, target);
+      sum -= calcSignedArcLength(view, target, points.size() / 2);
+      sum -= calcLongitudinalOffsetPoint(view, 0, target.x).value_or(target).x;
+    }
+    const double view_ms = sw.toc();
+
+    std::printf(
+      "num_points = %zu: free functions = %2.2f ms, TrajectoryView = %2.2f ms (diff %g)\n",
+      num_points, free_ms, view_ms, sum);
+  }
+}
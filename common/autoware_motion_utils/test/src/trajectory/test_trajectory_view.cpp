@@ -0,0 +1,175 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/motion_utils/trajectory/trajectory.hpp"
+#include "autoware/motion_utils/trajectory/trajectory_view.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+using autoware::motion_utils::TrajectoryView;
+using autoware::universe_utils::createPoint;
+using autoware::universe_utils::createQuaternionFromRPY;
+using TrajectoryPointArray = std::vector<autoware_planning_msgs::msg::TrajectoryPoint>;
+
+constexpr double epsilon = 1e-6;
+
+geometry_msgs::msg::Pose createPose(
+  double x, double y, double z, double roll, double pitch, double yaw)
+{
+  geometry_msgs::msg::Pose p;
+  p.position = createPoint(x, y, z);
+  p.orientation = createQuaternionFromRPY(roll, pitch, yaw);
+  return p;
+}
+
+TrajectoryPointArray generateTestTrajectoryPointArray(
+  const size_t num_points, const double point_interval, const double init_theta = 0.0,
+  const double delta_theta = 0.0)
+{
+  using autoware_planning_msgs::msg::TrajectoryPoint;
+  TrajectoryPointArray traj;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = init_theta + i * delta_theta;
+    const double x = i * point_interval * std::cos(theta);
+    const double y = i * point_interval * std::sin(theta);
+
+    TrajectoryPoint p;
+    p.pose = createPose(x, y, 0.0, 0.0, 0.0, theta);
+    traj.push_back(p);
+  }
+
+  return traj;
+}
+}  // namespace
+
+TEST(trajectory_view, sameAsFreeFunctions)
+{
+  using autoware::motion_utils::calcLateralOffset;
+  using autoware::motion_utils::calcLongitudinalOffsetPoint;
+  using autoware::motion_utils::calcLongitudinalOffsetToSegment;
+  using autoware::motion_utils::calcSignedArcLength;
+  using autoware::motion_utils::findNearestIndex;
+  using autoware::motion_utils::findNearestSegmentIndex;
+
+  const auto points = generateTestTrajectoryPointArray(200, 0.5, 0.0, 0.02);
+  const TrajectoryView view(points);
+
+  EXPECT_NEAR(
+    autoware::motion_utils::calcArcLength(view), autoware::motion_utils::calcArcLength(points),
+    epsilon);
+  EXPECT_NEAR(calcSignedArcLength(view, 150, 3), calcSignedArcLength(points, 150, 3), epsilon);
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> dist(-20.0, 80.0);
+  for (size_t i = 0; i < 500; ++i) {
+    const auto p = createPoint(dist(engine), dist(engine), 0.0);
+    const auto q = createPoint(dist(engine), dist(engine), 0.0);
+    const size_t idx = i % points.size();
+
+    EXPECT_EQ(findNearestIndex(view, p), findNearestIndex(points, p));
+    EXPECT_EQ(findNearestSegmentIndex(view, p), findNearestSegmentIndex(points, p));
+    const auto pose = createPose(p.x, p.y, 0.0, 0.0, 0.0, 0.0);
+    EXPECT_EQ(
+      findNearestSegmentIndex(view, pose, 30.0, 1.0),
+      findNearestSegmentIndex(points, pose, 30.0, 1.0));
+
+    EXPECT_NEAR(calcSignedArcLength(view, p, q), calcSignedArcLength(points, p, q), epsilon);
+    EXPECT_NEAR(calcSignedArcLength(view, p, idx), calcSignedArcLength(points, p, idx), epsilon);
+    EXPECT_NEAR(calcLateralOffset(view, p), calcLateralOffset(points, p), epsilon);
+    EXPECT_NEAR(calcLateralOffset(view, p, idx), calcLateralOffset(points, p, idx), epsilon);
+    if (idx + 1 < points.size()) {
+      EXPECT_NEAR(
+        calcLongitudinalOffsetToSegment(view, idx, p),
+        calcLongitudinalOffsetToSegment(points, idx, p), epsilon);
+    }
+
+    const double offset = dist(engine);
+    const auto offset_point = calcLongitudinalOffsetPoint(view, idx, offset);
+    const auto expected_offset_point = calcLongitudinalOffsetPoint(points, idx, offset);
+    ASSERT_EQ(offset_point.has_value(), expected_offset_point.has_value());
+    if (offset_point) {
+      EXPECT_NEAR(offset_point->x, expected_offset_point->x, epsilon);
+      EXPECT_NEAR(offset_point->y, expected_offset_point->y, epsilon);
+    }
+  }
+}
+
+TEST(trajectory_view, overlappingPoints)
+{
+  auto points = generateTestTrajectoryPointArray(10, 1.0);
+  points.insert(points.begin() + 3, points.at(3));
+  points.push_back(points.back());
+  const TrajectoryView view(points);
+
+  // the segment of the overlapping point ends at the next point
+  EXPECT_NEAR(view.calcLongitudinalOffsetToSegment(3, createPoint(3.5, 0.0, 0.0)), 0.5, epsilon);
+  EXPECT_NEAR(view.calcLateralOffset(createPoint(9.5, 1.0, 0.0), 10), 1.0, epsilon);
+  EXPECT_NEAR(view.calcSignedArcLength(0, points.size() - 1), 9.0, epsilon);
+  EXPECT_THROW(
+    view.calcLongitudinalOffsetToSegment(10, createPoint(0.0, 0.0, 0.0), true),
+    std::runtime_error);
+  EXPECT_TRUE(std::isnan(view.calcLongitudinalOffsetToSegment(10, createPoint(0.0, 0.0, 0.0))));
+
+  const TrajectoryPointArray same_points(3, points.front());
+  EXPECT_TRUE(std::isnan(TrajectoryView(same_points).calcLateralOffset(createPoint(0, 1, 0))));
+}
+
+TEST(trajectory_view, findSegmentIndexAtArcLength)
+{
+  const auto points = generateTestTrajectoryPointArray(10, 1.0);
+  const TrajectoryView view(points);
+
+  EXPECT_EQ(view.findSegmentIndexAtArcLength(-1.0), 0U);
+  EXPECT_EQ(view.findSegmentIndexAtArcLength(0.0), 0U);
+  EXPECT_EQ(view.findSegmentIndexAtArcLength(3.5), 3U);
+  EXPECT_EQ(view.findSegmentIndexAtArcLength(4.0), 4U);
+  EXPECT_EQ(view.findSegmentIndexAtArcLength(9.0), 8U);
+  EXPECT_EQ(view.findSegmentIndexAtArcLength(100.0), 8U);
+
+  const TrajectoryPointArray empty_points;
+  EXPECT_THROW(
+    TrajectoryView(empty_points).findSegmentIndexAtArcLength(0.0), std::invalid_argument);
+}
+
+TEST(trajectory_view, findNearestIndexFromHint)
+{
+  // the hint follows a point moving along the spiral
+  const auto points = generateTestTrajectoryPointArray(1000, 1.0, 0.0, 0.1);
+  const TrajectoryView view(points);
+
+  for (size_t i = 0; i < points.size(); ++i) {
+    auto p = points.at(i).pose.position;
+    p.x += 0.01;
+    EXPECT_EQ(view.findNearestIndexFromHint(p), i);
+  }
+}
+
+TEST(trajectory_view, invalidate)
+{
+  auto points = generateTestTrajectoryPointArray(10, 1.0);
+  TrajectoryView view(points);
+  EXPECT_NEAR(view.calcArcLength(), 9.0, epsilon);
+
+  points.push_back(points.back());
+  points.back().pose.position.x += 1.0;
+  EXPECT_NEAR(view.calcArcLength(), 9.0, epsilon);
+  view.invalidate();
+  EXPECT_NEAR(view.calcArcLength(), 10.0, epsilon);
+}
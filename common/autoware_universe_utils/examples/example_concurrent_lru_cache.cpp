@@ -0,0 +1,102 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/universe_utils/system/concurrent_lru_cache.hpp"
+#include "autoware/universe_utils/system/lru_cache.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using autoware::universe_utils::ConcurrentLRUCache;
+using autoware::universe_utils::LRUCache;
+
+using Value = std::vector<double>;
+
+// LRUCache shared between threads with a single mutex
+class LockedLRUCache
+{
+public:
+  explicit LockedLRUCache(size_t size) : cache_(size) {}
+  void put(const int64_t key, const Value & value)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.put(key, value);
+  }
+  std::optional<Value> get(const int64_t key)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_.get(key);
+  }
+
+private:
+  std::mutex mutex_;
+  LRUCache<int64_t, Value> cache_;
+};
+
+// Each thread gets random keys and puts the missing ones, returns the number of operations per μs
+template <typename Cache>
+double measure_throughput(Cache & cache, const int nb_threads, const int64_t nb_keys)
+{
+  constexpr int nb_operations = 200000;
+  const Value value(8, 1.0);
+  std::vector<std::thread> threads;
+  const auto start = std::chrono::steady_clock::now();
+  for (int t = 0; t < nb_threads; ++t) {
+    threads.emplace_back([&cache, &value, nb_keys, t]() {
+      std::default_random_engine engine(t);
+      std::uniform_int_distribution<int64_t> key_dist(0, nb_keys - 1);
+      for (int i = 0; i < nb_operations; ++i) {
+        const auto key = key_dist(engine);
+        if (!cache.get(key)) cache.put(key, value);
+      }
+    });
+  }
+  for (auto & thread : threads) thread.join();
+  const auto end = std::chrono::steady_clock::now();
+  const auto duration_us = std::chrono::duration<double, std::micro>(end - start).count();
+  return nb_threads * nb_operations / duration_us;
+}
+
+int main()
+{
+  constexpr size_t capacity = 4096;
+  constexpr int64_t nb_keys = 2 * capacity;  // about half of the gets miss
+
+  std::cout << "Throughput of get/put under contention (operations per μs), capacity = "
+            << capacity << ", keys = " << nb_keys << "\n\n";
+  std::cout << "threads\tLRUCache + mutex\tConcurrentLRUCache\thit rate\n";
+  std::cout << std::string(64, '-') << "\n";
+
+  for (const int nb_threads : {1, 2, 4, 8, 16}) {
+    LockedLRUCache locked_cache(capacity);
+    ConcurrentLRUCache<int64_t, Value> concurrent_cache(capacity);
+    const auto locked_throughput = measure_throughput(locked_cache, nb_threads, nb_keys);
+    const auto concurrent_throughput = measure_throughput(concurrent_cache, nb_threads, nb_keys);
+    const auto statistics = concurrent_cache.statistics();
+    const auto nb_gets = statistics.hits + statistics.misses;
+    const auto hit_rate = static_cast<double>(statistics.hits) / static_cast<double>(nb_gets);
+
+    std::cout << nb_threads << "\t" << locked_throughput << "\t\t\t" << concurrent_throughput
+              << "\t\t\t" << hit_rate << "\n";
+  }
+
+  return 0;
+}
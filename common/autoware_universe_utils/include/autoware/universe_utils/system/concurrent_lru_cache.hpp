@@ -0,0 +1,407 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef AUTOWARE__UNIVERSE_UTILS__SYSTEM__CONCURRENT_LRU_CACHE_HPP_
+#define AUTOWARE__UNIVERSE_UTILS__SYSTEM__CONCURRENT_LRU_CACHE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace autoware::universe_utils
+{
+
+/**
+ * @brief A thread-safe LRU (Least Recently Used) cache split into shards.
+ *
+ * A key is assigned to a shard by its hash, and each shard is an LRU cache protected by its own
+ * mutex, so that threads using different shards do not wait for each other.
+ * The entries of a shard are allocated in a pool when the cache is constructed and are linked by
+ * indexes in the recency list and in the hash buckets, so that put() and get() do not allocate
+ * memory other than the copies of the keys and values.
+ *
+ * The least recently used entry is evicted per shard: each shard holds at most
+ * ceil(capacity / num_shards) entries and, if max_bytes is not 0, at most
+ * ceil(max_bytes / num_shards) bytes as given to put().
+ *
+ * @tparam Key The type of keys.
+ * @tparam Value The type of values.
+ * @tparam Hash The hash function of the keys, defaulted to std::hash.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ConcurrentLRUCache
+{
+public:
+  /// @brief Counters of the cache, summed over the shards.
+  struct Statistics
+  {
+    uint64_t hits{0};       ///< Calls to get() which found the key.
+    uint64_t misses{0};     ///< Calls to get() which did not find the key.
+    uint64_t evictions{0};  ///< Entries removed to respect the capacity or the byte budget.
+  };
+
+  /**
+   * @brief Construct a new ConcurrentLRUCache object.
+   *
+   * @param size The capacity of the cache.
+   * @param num_shards The number of shards, limited to the capacity.
+   * @param max_bytes The maximum sum of the bytes given to put(), or 0 to only limit the number of
+   * entries.
+   */
+  explicit ConcurrentLRUCache(size_t size, size_t num_shards = 16, size_t max_bytes = 0)
+  : capacity_(size),
+    max_bytes_(max_bytes),
+    num_shards_(std::clamp<size_t>(num_shards, 1, std::max<size_t>(size, 1))),
+    shard_capacity_((size + num_shards_ - 1) / num_shards_),
+    shard_max_bytes_((max_bytes + num_shards_ - 1) / num_shards_),
+    shards_(std::make_unique<Shard[]>(num_shards_))
+  {
+    size_t nb_buckets = 1;
+    while (nb_buckets < 2 * shard_capacity_) nb_buckets *= 2;
+    for (size_t i = 0; i < num_shards_; ++i) {
+      shards_[i].entries.resize(shard_capacity_);
+      shards_[i].buckets.resize(nb_buckets);
+      reset(shards_[i]);
+    }
+  }
+
+  /**
+   * @brief Get the capacity of the cache.
+   *
+   * @return The capacity of the cache.
+   */
+  [[nodiscard]] size_t capacity() const { return capacity_; }
+
+  /**
+   * @brief Get the maximum number of bytes of the cache.
+   *
+   * @return The maximum number of bytes, or 0 if the bytes are not limited.
+   */
+  [[nodiscard]] size_t max_bytes() const { return max_bytes_; }
+
+  /**
+   * @brief Insert a key-value pair into the cache.
+   *
+   * If the key already exists, its value is updated and it is moved to the front.
+   * Least recently used elements of the shard are removed while the shard exceeds its capacity or
+   * its byte budget.
+   *
+   * @param key The key to insert.
+   * @param value The value to insert.
+   * @param bytes The size of the element counted in the byte budget, e.g., the memory used by the
+   * value.
+   * @return False if the element is larger than the byte budget of a shard, in which case it is not
+   * inserted and a previous value of the key is removed.
+   */
+  bool put(const Key & key, const Value & value, const size_t bytes = 0)
+  {
+    const auto hash = mix(hash_(key));
+    auto & shard = get_shard(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto index = find(shard, hash, key);
+    if (shard_capacity_ == 0 || (max_bytes_ != 0 && bytes > shard_max_bytes_)) {
+      if (index != npos) remove(shard, index);
+      return false;
+    }
+    if (index != npos) {
+      auto & entry = shard.entries[index];
+      entry.item->second = value;
+      shard.bytes = shard.bytes - entry.bytes + bytes;
+      entry.bytes = bytes;
+      unlink(shard, index);
+      push_front(shard, index);
+    } else {
+      if (shard.size == shard_capacity_) evict(shard);
+      index = shard.free;
+      auto & entry = shard.entries[index];
+      shard.free = entry.next;
+      entry.item.emplace(key, value);
+      entry.hash = hash;
+      entry.bytes = bytes;
+      auto & bucket = shard.buckets[get_bucket(shard, hash)];
+      entry.bucket_next = bucket;
+      bucket = index;
+      push_front(shard, index);
+      ++shard.size;
+      shard.bytes += bytes;
+    }
+    while (max_bytes_ != 0 && shard.bytes > shard_max_bytes_) evict(shard);
+    return true;
+  }
+
+  /**
+   * @brief Retrieve a value from the cache.
+   *
+   * If the key does not exist in the cache, std::nullopt is returned.
+   * If the key exists, a copy of the value is returned and the element is moved to the front.
+   *
+   * @param key The key to retrieve.
+   * @return The value associated with the key, or std::nullopt if the key does not exist.
+   */
+  std::optional<Value> get(const Key & key)
+  {
+    const auto hash = mix(hash_(key));
+    auto & shard = get_shard(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto index = find(shard, hash, key);
+    if (index == npos) {
+      shard.misses.fetch_add(1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+    shard.hits.fetch_add(1, std::memory_order_relaxed);
+    unlink(shard, index);
+    push_front(shard, index);
+    return shard.entries[index].item->second;
+  }
+
+  /**
+   * @brief Remove a key from the cache.
+   *
+   * @param key The key to remove.
+   * @return True if the key existed.
+   */
+  bool erase(const Key & key)
+  {
+    const auto hash = mix(hash_(key));
+    auto & shard = get_shard(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto index = find(shard, hash, key);
+    if (index == npos) return false;
+    remove(shard, index);
+    return true;
+  }
+
+  /**
+   * @brief Clear the cache.
+   *
+   * This removes all elements from the cache. The statistics are kept.
+   */
+  void clear()
+  {
+    for (size_t i = 0; i < num_shards_; ++i) {
+      std::lock_guard<std::mutex> lock(shards_[i].mutex);
+      reset(shards_[i]);
+    }
+  }
+
+  /**
+   * @brief Get the current size of the cache.
+   *
+   * @return The number of elements in the cache. Other threads may change it at any time.
+   */
+  [[nodiscard]] size_t size() const
+  {
+    size_t size = 0;
+    for (size_t i = 0; i < num_shards_; ++i) {
+      std::lock_guard<std::mutex> lock(shards_[i].mutex);
+      size += shards_[i].size;
+    }
+    return size;
+  }
+
+  /**
+   * @brief Get the current number of bytes of the cache.
+   *
+   * @return The sum of the bytes given to put() for the elements in the cache.
+   */
+  [[nodiscard]] size_t bytes() const
+  {
+    size_t bytes = 0;
+    for (size_t i = 0; i < num_shards_; ++i) {
+      std::lock_guard<std::mutex> lock(shards_[i].mutex);
+      bytes += shards_[i].bytes;
+    }
+    return bytes;
+  }
+
+  /**
+   * @brief Check if the cache is empty.
+   *
+   * @return True if the cache is empty, false otherwise.
+   */
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  /**
+   * @brief Check if a key exists in the cache.
+   *
+   * The recency and the statistics are not updated.
+   *
+   * @param key The key to check.
+   * @return True if the key exists, false otherwise.
+   */
+  [[nodiscard]] bool contains(const Key & key) const
+  {
+    const auto hash = mix(hash_(key));
+    auto & shard = get_shard(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return find(shard, hash, key) != npos;
+  }
+
+  /**
+   * @brief Get the hit, miss and eviction counters.
+   *
+   * @return The counters summed over the shards.
+   */
+  [[nodiscard]] Statistics statistics() const
+  {
+    Statistics statistics;
+    for (size_t i = 0; i < num_shards_; ++i) {
+      statistics.hits += shards_[i].hits.load(std::memory_order_relaxed);
+      statistics.misses += shards_[i].misses.load(std::memory_order_relaxed);
+      statistics.evictions += shards_[i].evictions.load(std::memory_order_relaxed);
+    }
+    return statistics;
+  }
+
+  /**
+   * @brief Reset the hit, miss and eviction counters to 0.
+   */
+  void reset_statistics()
+  {
+    for (size_t i = 0; i < num_shards_; ++i) {
+      shards_[i].hits.store(0, std::memory_order_relaxed);
+      shards_[i].misses.store(0, std::memory_order_relaxed);
+      shards_[i].evictions.store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+  /// @brief Element of the pool of a shard, linked in the recency list or in the free list.
+  struct Entry
+  {
+    std::optional<std::pair<Key, Value>> item;
+    size_t hash{0};
+    size_t bytes{0};
+    uint32_t prev{npos};         ///< More recently used entry.
+    uint32_t next{npos};         ///< Less recently used entry, or next free entry.
+    uint32_t bucket_next{npos};  ///< Next entry of the same hash bucket.
+  };
+
+  /// @brief LRU cache of the keys of one shard, aligned to avoid false sharing between shards.
+  struct alignas(64) Shard
+  {
+    mutable std::mutex mutex;
+    std::vector<Entry> entries;
+    std::vector<uint32_t> buckets;  ///< First entry of each bucket.
+    uint32_t head{npos};            ///< Most recently used entry.
+    uint32_t tail{npos};            ///< Least recently used entry.
+    uint32_t free{npos};            ///< First unused entry.
+    size_t size{0};
+    size_t bytes{0};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> evictions{0};
+  };
+
+  Shard & get_shard(const size_t hash) const { return shards_[hash % num_shards_]; }
+
+  /// @brief Spread the bits of the hash, as std::hash is the identity for integers on most
+  /// implementations and pointers are multiples of the alignment.
+  static size_t mix(size_t hash)
+  {
+    hash ^= hash >> 33U;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33U;
+    return hash;
+  }
+
+  size_t get_bucket(const Shard & shard, const size_t hash) const
+  {
+    // the shard is selected by the remainder of the hash so use the quotient for the bucket
+    return (hash / num_shards_) & (shard.buckets.size() - 1);
+  }
+
+  uint32_t find(const Shard & shard, const size_t hash, const Key & key) const
+  {
+    if (shard.size == 0) return npos;
+    auto index = shard.buckets[get_bucket(shard, hash)];
+    while (index != npos) {
+      const auto & entry = shard.entries[index];
+      if (entry.hash == hash && entry.item->first == key) return index;
+      index = entry.bucket_next;
+    }
+    return npos;
+  }
+
+  static void unlink(Shard & shard, const uint32_t index)
+  {
+    auto & entry = shard.entries[index];
+    (entry.prev == npos ? shard.head : shard.entries[entry.prev].next) = entry.next;
+    (entry.next == npos ? shard.tail : shard.entries[entry.next].prev) = entry.prev;
+  }
+
+  static void push_front(Shard & shard, const uint32_t index)
+  {
+    auto & entry = shard.entries[index];
+    entry.prev = npos;
+    entry.next = shard.head;
+    (shard.head == npos ? shard.tail : shard.entries[shard.head].prev) = index;
+    shard.head = index;
+  }
+
+  void remove(Shard & shard, const uint32_t index)
+  {
+    auto & entry = shard.entries[index];
+    auto * bucket_link = &shard.buckets[get_bucket(shard, entry.hash)];
+    while (*bucket_link != index) bucket_link = &shard.entries[*bucket_link].bucket_next;
+    *bucket_link = entry.bucket_next;
+    unlink(shard, index);
+    entry.item.reset();
+    shard.bytes -= entry.bytes;
+    --shard.size;
+    entry.next = shard.free;
+    shard.free = index;
+  }
+
+  void evict(Shard & shard)
+  {
+    remove(shard, shard.tail);
+    shard.evictions.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  static void reset(Shard & shard)
+  {
+    std::fill(shard.buckets.begin(), shard.buckets.end(), npos);
+    for (size_t i = 0; i < shard.entries.size(); ++i) {
+      shard.entries[i].item.reset();
+      shard.entries[i].next = i + 1 < shard.entries.size() ? static_cast<uint32_t>(i + 1) : npos;
+    }
+    shard.head = npos;
+    shard.tail = npos;
+    shard.free = shard.entries.empty() ? npos : 0;
+    shard.size = 0;
+    shard.bytes = 0;
+  }
+
+  size_t capacity_;         ///< The maximum capacity of the cache.
+  size_t max_bytes_;        ///< The maximum number of bytes of the cache, 0 if not limited.
+  size_t num_shards_;       ///< The number of shards.
+  size_t shard_capacity_;   ///< The maximum capacity of each shard.
+  size_t shard_max_bytes_;  ///< The maximum number of bytes of each shard.
+  std::unique_ptr<Shard[]> shards_;
+  Hash hash_;
+};
+
+}  // namespace autoware::universe_utils
+
+#endif  // AUTOWARE__UNIVERSE_UTILS__SYSTEM__CONCURRENT_LRU_CACHE_HPP_
@@ -15,6 +15,7 @@
 #define AUTOWARE__UNIVERSE_UTILS__SYSTEM__TIME_KEEPER_HPP_
 
 #include "autoware/universe_utils/system/stop_watch.hpp"
+#include "autoware/universe_utils/system/trace_recorder.hpp"
 
 #include <rclcpp/publisher.hpp>
 
@@ -139,6 +140,16 @@ public:
    */
   void add_reporter(rclcpp::Publisher<ProcessingTimeDetail>::SharedPtr publisher);
 
+  /**
+   * @brief Add a low-overhead reporter recording the begin and end of each track
+   *
+   * @details If only trace recorders are added, the processing time tree is not built at all, and
+   * comment() is ignored. The same recorder can be shared among TimeKeepers on different threads.
+   *
+   * @param recorder Shared pointer to the trace recorder
+   */
+  void add_reporter(std::shared_ptr<TraceRecorder> recorder);
+
   /**
    * @brief Start tracking the processing time of a function
    *
@@ -166,6 +177,11 @@ private:
    */
   void report();
 
+  /**
+   * @brief Whether the processing time tree has to be built
+   */
+  bool is_tree_enabled() const { return !reporters_.empty() || trace_recorders_.empty(); }
+
   std::shared_ptr<ProcessingTimeNode>
     current_time_node_;                            //!< Shared pointer to the current time node
   std::shared_ptr<ProcessingTimeNode> root_node_;  //!< Shared pointer to the root time node
@@ -175,6 +191,8 @@ private:
 
   std::vector<std::function<void(const std::shared_ptr<ProcessingTimeNode> &)>>
     reporters_;  //!< Vector of functions for reporting the processing times
+
+  std::vector<std::shared_ptr<TraceRecorder>> trace_recorders_;  //!< Low-overhead reporters
 };
 
 /**
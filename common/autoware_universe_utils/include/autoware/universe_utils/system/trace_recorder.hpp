@@ -0,0 +1,154 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef AUTOWARE__UNIVERSE_UTILS__SYSTEM__TRACE_RECORDER_HPP_
+#define AUTOWARE__UNIVERSE_UTILS__SYSTEM__TRACE_RECORDER_HPP_
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace autoware::universe_utils
+{
+/**
+ * @brief Begin or end of a traced scope
+ */
+struct TraceEvent
+{
+  std::uint64_t timestamp_ns{0};  //!< Time of the event in steady clock
+  std::uint32_t name_id{0};       //!< Interned name of the scope
+  char phase{'B'};                //!< 'B' for begin, 'E' for end
+};
+
+/**
+ * @brief Events of an outermost scope whose duration exceeded the threshold
+ */
+struct TraceCycle
+{
+  std::uint32_t thread_index{0};  //!< Index of the thread which recorded the cycle
+  double duration_ms{0.0};        //!< Duration of the outermost scope
+  bool truncated{false};  //!< True if older events of the cycle were overwritten in the ring buffer
+  std::vector<TraceEvent> events;  //!< Events of the cycle in chronological order
+};
+
+/**
+ * @brief Low-overhead recorder of scope begin/end events
+ *
+ * Each thread writes to its own fixed size ring buffer without locking, and the scope names are
+ * interned to integer IDs, so that recording a scope does not allocate after the warm up. When the
+ * outermost scope of a thread ends and its duration is longer than the threshold, the events of the
+ * cycle are copied out of the ring buffer and kept for export. The kept cycles can be written in
+ * the Chrome trace event format, which can be opened with chrome://tracing or Perfetto.
+ *
+ * The buffer of a thread is returned to the recorder when the thread exits and is reused by the
+ * next thread, so that short-lived threads do not grow the memory usage. At most max_threads
+ * buffers are allocated, and the scopes of the threads which do not get a buffer are not recorded.
+ */
+class TraceRecorder
+{
+public:
+  /**
+   * @brief Construct a new TraceRecorder object
+   *
+   * @param threshold_ms Cycles shorter than this are discarded
+   * @param events_per_thread Capacity of the ring buffer of each thread, rounded up to a power of 2
+   * @param max_cycles Maximum number of kept cycles, beyond which the oldest cycle is dropped
+   * @param max_threads Maximum number of buffers, i.e. of threads recording at the same time
+   */
+  explicit TraceRecorder(
+    const double threshold_ms = 0.0, const size_t events_per_thread = 16384,
+    const size_t max_cycles = 64, const size_t max_threads = 64);
+
+  ~TraceRecorder();
+
+  TraceRecorder(const TraceRecorder &) = delete;
+  TraceRecorder & operator=(const TraceRecorder &) = delete;
+  TraceRecorder(TraceRecorder &&) = delete;
+  TraceRecorder & operator=(TraceRecorder &&) = delete;
+
+  /**
+   * @brief Record the begin of a scope on the calling thread
+   * @details Nothing is recorded if max_threads other threads hold a buffer
+   *
+   * @param name Name of the scope
+   */
+  void begin(const std::string & name);
+
+  /**
+   * @brief Record the end of a scope on the calling thread
+   *
+   * @param name Name of the scope, which must be the same as the last begun scope
+   * @throw std::runtime_error if the name does not match the last begun scope
+   */
+  void end(const std::string & name);
+
+  /**
+   * @brief Get the name of an interned name ID
+   */
+  std::string get_name(const std::uint32_t name_id) const;
+
+  /**
+   * @brief Get the kept cycles
+   */
+  std::vector<TraceCycle> get_cycles() const;
+
+  /**
+   * @brief Discard the kept cycles
+   */
+  void clear_cycles();
+
+  /**
+   * @brief Write the kept cycles in the Chrome trace event format
+   *
+   * @param os Output stream
+   */
+  void write_chrome_trace(std::ostream & os) const;
+
+  /**
+   * @brief Write the kept cycles in the Chrome trace event format to a file
+   *
+   * @param file_path Path to the output JSON file
+   * @return true if the file is written successfully
+   */
+  bool write_chrome_trace(const std::string & file_path) const;
+
+private:
+  class ThreadBuffer;
+  class BufferPool;
+
+  ThreadBuffer * get_thread_buffer();
+  std::uint32_t intern(const std::string & name);
+  void keep_cycle(TraceCycle && cycle);
+
+  const double threshold_ms_;
+  const size_t events_per_thread_;
+  const size_t max_cycles_;
+  const std::uint64_t recorder_id_;  //!< Unique ID to find the thread buffer of this recorder
+
+  mutable std::mutex names_mutex_;
+  std::vector<std::string> names_;  //!< Interned names indexed by name ID
+
+  //! Buffers of the threads, shared with the threads to return their buffer when they exit
+  std::shared_ptr<BufferPool> buffer_pool_;
+
+  mutable std::mutex cycles_mutex_;
+  std::deque<TraceCycle> cycles_;  //!< Kept cycles
+};
+
+}  // namespace autoware::universe_utils
+
+#endif  // AUTOWARE__UNIVERSE_UTILS__SYSTEM__TRACE_RECORDER_HPP_
@@ -16,7 +16,9 @@
 
 #include <fmt/format.h>
 
+#include <memory>
 #include <stdexcept>
+#include <utility>
 
 namespace autoware::universe_utils
 {
@@ -124,8 +126,20 @@ void TimeKeeper::add_reporter(rclcpp::Publisher<ProcessingTimeDetail>::SharedPtr
   });
 }
 
+void TimeKeeper::add_reporter(std::shared_ptr<TraceRecorder> recorder)
+{
+  trace_recorders_.push_back(std::move(recorder));
+}
+
 void TimeKeeper::start_track(const std::string & func_name)
 {
+  for (const auto & recorder : trace_recorders_) {
+    recorder->begin(func_name);
+  }
+  if (!is_tree_enabled()) {
+    return;
+  }
+
   if (current_time_node_ == nullptr) {
     current_time_node_ = std::make_shared<ProcessingTimeNode>(func_name);
     root_node_ = current_time_node_;
@@ -137,6 +151,9 @@ void TimeKeeper::start_track(const std::string & func_name)
 
 void TimeKeeper::comment(const std::string & comment)
 {
+  if (!is_tree_enabled()) {
+    return;
+  }
   if (current_time_node_ == nullptr) {
     throw std::runtime_error("You must call start_track() first, but comment() is called");
   }
@@ -145,6 +162,13 @@ void TimeKeeper::comment(const std::string & comment)
 
 void TimeKeeper::end_track(const std::string & func_name)
 {
+  for (const auto & recorder : trace_recorders_) {
+    recorder->end(func_name);
+  }
+  if (!is_tree_enabled()) {
+    return;
+  }
+
   if (current_time_node_->get_name() != func_name) {
     throw std::runtime_error(fmt::format(
       "You must call end_track({}) first, but end_track({}) is called",
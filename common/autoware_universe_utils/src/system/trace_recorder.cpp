@@ -0,0 +1,362 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/universe_utils/system/trace_recorder.hpp"
+
+#include <fmt/format.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace autoware::universe_utils
+{
+namespace
+{
+std::uint64_t now_ns()
+{
+  return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                      std::chrono::steady_clock::now().time_since_epoch())
+                                      .count());
+}
+
+size_t round_up_to_power_of_2(const size_t value)
+{
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+std::string escape_json(const std::string & str)
+{
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (const char c : str) {
+    switch (c) {
+      case '"':
+        escaped += "\\\"";
+        break;
+      case '\\':
+        escaped += "\\\\";
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          escaped += fmt::format("\\u{:04x}", static_cast<int>(c));
+        } else {
+          escaped += c;
+        }
+    }
+  }
+  return escaped;
+}
+
+std::atomic<std::uint64_t> next_recorder_id{0};
+}  // namespace
+
+/**
+ * @brief Ring buffer and name cache owned by a single thread
+ *
+ * Only the owner thread accesses the members, so that no synchronization is needed.
+ */
+class TraceRecorder::ThreadBuffer
+{
+public:
+  ThreadBuffer(const std::uint32_t thread_index, const size_t capacity)
+  : thread_index(thread_index), mask(capacity - 1), events(capacity)
+  {
+    scope_stack.reserve(64);
+  }
+
+  void push(const TraceEvent & event) { events[(write_index++) & mask] = event; }
+
+  const std::uint32_t thread_index;
+  const size_t mask;
+  std::vector<TraceEvent> events;
+  std::uint64_t write_index{0};  //!< Total number of events written to the buffer
+
+  std::vector<std::uint32_t> scope_stack;  //!< Name IDs of the scopes being recorded
+  std::uint64_t cycle_begin_index{0};      //!< Write index at the begin of the outermost scope
+  std::unordered_map<std::string, std::uint32_t> name_cache;  //!< Thread local interning cache
+};
+
+/**
+ * @brief Buffers of a recorder and the free list of the buffers of the exited threads
+ *
+ * The pool is shared with the threads, so that a thread can return its buffer even if the thread
+ * exits while the recorder is destroyed.
+ */
+class TraceRecorder::BufferPool
+{
+public:
+  BufferPool(const size_t events_per_thread, const size_t max_threads)
+  : events_per_thread(events_per_thread), max_threads(max_threads)
+  {
+  }
+
+  /**
+   * @brief Get a free buffer, or allocate a new one if there are less than max_threads buffers
+   * @return nullptr if all the buffers are used by other threads
+   */
+  ThreadBuffer * acquire()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!free_buffers.empty()) {
+      auto * buffer = free_buffers.back();
+      free_buffers.pop_back();
+      return buffer;
+    }
+    if (buffers.size() >= max_threads) {
+      return nullptr;
+    }
+    buffers.push_back(std::make_unique<ThreadBuffer>(
+      static_cast<std::uint32_t>(buffers.size()), events_per_thread));
+    return buffers.back().get();
+  }
+
+  /**
+   * @brief Return the buffer of an exited thread, discarding its unfinished cycle
+   */
+  void release(ThreadBuffer * buffer)
+  {
+    buffer->scope_stack.clear();
+    std::lock_guard<std::mutex> lock(mutex);
+    free_buffers.push_back(buffer);
+  }
+
+private:
+  const size_t events_per_thread;
+  const size_t max_threads;
+
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;  //!< All the allocated buffers
+  std::vector<ThreadBuffer *> free_buffers;             //!< Buffers not used by any thread
+};
+
+TraceRecorder::TraceRecorder(
+  const double threshold_ms, const size_t events_per_thread, const size_t max_cycles,
+  const size_t max_threads)
+: threshold_ms_(threshold_ms),
+  events_per_thread_(round_up_to_power_of_2(std::max<size_t>(events_per_thread, 2))),
+  max_cycles_(max_cycles),
+  recorder_id_(next_recorder_id++),
+  buffer_pool_(std::make_shared<BufferPool>(events_per_thread_, max_threads))
+{
+}
+
+TraceRecorder::~TraceRecorder() = default;
+
+TraceRecorder::ThreadBuffer * TraceRecorder::get_thread_buffer()
+{
+  struct Entry
+  {
+    std::uint64_t recorder_id;
+    std::weak_ptr<BufferPool> buffer_pool;
+    ThreadBuffer * buffer;
+  };
+  // Returns the buffers to the recorders which are still alive when the thread exits
+  struct ThreadBuffers
+  {
+    ~ThreadBuffers()
+    {
+      for (const auto & entry : entries) {
+        if (const auto buffer_pool = entry.buffer_pool.lock()) {
+          buffer_pool->release(entry.buffer);
+        }
+      }
+    }
+    std::vector<Entry> entries;
+  };
+  thread_local ThreadBuffers thread_buffers;
+
+  // The recorder ID is never reused, so that a stale entry of a destroyed recorder is never hit.
+  for (const auto & entry : thread_buffers.entries) {
+    if (entry.recorder_id == recorder_id_) {
+      return entry.buffer;
+    }
+  }
+
+  auto * buffer = buffer_pool_->acquire();
+  if (!buffer) {
+    return nullptr;
+  }
+  // drop the entries of the destroyed recorders
+  auto & entries = thread_buffers.entries;
+  const auto is_expired = [](const Entry & entry) { return entry.buffer_pool.expired(); };
+  entries.erase(std::remove_if(entries.begin(), entries.end(), is_expired), entries.end());
+  entries.push_back(Entry{recorder_id_, buffer_pool_, buffer});
+  return buffer;
+}
+
+std::uint32_t TraceRecorder::intern(const std::string & name)
+{
+  std::lock_guard<std::mutex> lock(names_mutex_);
+  for (size_t i = 0; i < names_.size(); ++i) {
+    if (names_[i] == name) {
+      return static_cast<std::uint32_t>(i);
+    }
+  }
+  names_.push_back(name);
+  return static_cast<std::uint32_t>(names_.size() - 1);
+}
+
+void TraceRecorder::begin(const std::string & name)
+{
+  auto * buffer_ptr = get_thread_buffer();
+  if (!buffer_ptr) {
+    return;
+  }
+  auto & buffer = *buffer_ptr;
+
+  auto itr = buffer.name_cache.find(name);
+  if (itr == buffer.name_cache.end()) {
+    itr = buffer.name_cache.emplace(name, intern(name)).first;
+  }
+
+  if (buffer.scope_stack.empty()) {
+    buffer.cycle_begin_index = buffer.write_index;
+  }
+  buffer.scope_stack.push_back(itr->second);
+  buffer.push(TraceEvent{now_ns(), itr->second, 'B'});
+}
+
+void TraceRecorder::end(const std::string & name)
+{
+  const auto timestamp_ns = now_ns();
+  auto * buffer_ptr = get_thread_buffer();
+  if (!buffer_ptr) {
+    return;
+  }
+  auto & buffer = *buffer_ptr;
+
+  const auto itr = buffer.name_cache.find(name);
+  if (
+    buffer.scope_stack.empty() || itr == buffer.name_cache.end() ||
+    buffer.scope_stack.back() != itr->second) {
+    throw std::runtime_error(fmt::format(
+      "You must call end({}) first, but end({}) is called",
+      buffer.scope_stack.empty() ? "" : get_name(buffer.scope_stack.back()), name));
+  }
+  buffer.scope_stack.pop_back();
+  buffer.push(TraceEvent{timestamp_ns, itr->second, 'E'});
+
+  if (!buffer.scope_stack.empty()) {
+    return;
+  }
+
+  // The outermost scope ended
+  const auto & first_event = buffer.events[buffer.cycle_begin_index & buffer.mask];
+  const std::uint64_t num_events = buffer.write_index - buffer.cycle_begin_index;
+  const bool truncated = num_events > buffer.events.size();
+  const double duration_ms =
+    truncated ? 0.0 : static_cast<double>(timestamp_ns - first_event.timestamp_ns) * 1e-6;
+  if (!truncated && duration_ms < threshold_ms_) {
+    return;
+  }
+
+  TraceCycle cycle;
+  cycle.thread_index = buffer.thread_index;
+  cycle.truncated = truncated;
+  const std::uint64_t begin_index =
+    truncated ? buffer.write_index - buffer.events.size() : buffer.cycle_begin_index;
+  cycle.events.reserve(buffer.write_index - begin_index);
+  for (std::uint64_t i = begin_index; i < buffer.write_index; ++i) {
+    cycle.events.push_back(buffer.events[i & buffer.mask]);
+  }
+  cycle.duration_ms =
+    static_cast<double>(timestamp_ns - cycle.events.front().timestamp_ns) * 1e-6;
+  keep_cycle(std::move(cycle));
+}
+
+void TraceRecorder::keep_cycle(TraceCycle && cycle)
+{
+  std::lock_guard<std::mutex> lock(cycles_mutex_);
+  if (max_cycles_ == 0) {
+    return;
+  }
+  if (cycles_.size() >= max_cycles_) {
+    cycles_.pop_front();
+  }
+  cycles_.push_back(std::move(cycle));
+}
+
+std::string TraceRecorder::get_name(const std::uint32_t name_id) const
+{
+  std::lock_guard<std::mutex> lock(names_mutex_);
+  return name_id < names_.size() ? names_.at(name_id) : "";
+}
+
+std::vector<TraceCycle> TraceRecorder::get_cycles() const
+{
+  std::lock_guard<std::mutex> lock(cycles_mutex_);
+  return {cycles_.begin(), cycles_.end()};
+}
+
+void TraceRecorder::clear_cycles()
+{
+  std::lock_guard<std::mutex> lock(cycles_mutex_);
+  cycles_.clear();
+}
+
+void TraceRecorder::write_chrome_trace(std::ostream & os) const
+{
+  const auto cycles = get_cycles();
+  std::vector<std::string> names;
+  {
+    std::lock_guard<std::mutex> lock(names_mutex_);
+    names.reserve(names_.size());
+    for (const auto & name : names_) {
+      names.push_back(escape_json(name));
+    }
+  }
+
+  const int pid = static_cast<int>(getpid());
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool is_first = true;
+  for (const auto & cycle : cycles) {
+    for (const auto & event : cycle.events) {
+      os << (is_first ? "\n" : ",\n")
+         << fmt::format(
+              R"({{"name":"{}","ph":"{}","ts":{:.3f},"pid":{},"tid":{}}})", names.at(event.name_id),
+              event.phase, static_cast<double>(event.timestamp_ns) * 1e-3, pid,
+              cycle.thread_index);
+      is_first = false;
+    }
+  }
+  os << "\n]}\n";
+}
+
+bool TraceRecorder::write_chrome_trace(const std::string & file_path) const
+{
+  std::ofstream ofs(file_path);
+  if (!ofs) {
+    return false;
+  }
+  write_chrome_trace(ofs);
+  return static_cast<bool>(ofs);
+}
+
+}  // namespace autoware::universe_utils
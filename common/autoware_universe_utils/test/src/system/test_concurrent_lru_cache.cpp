@@ -0,0 +1,189 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "autoware/universe_utils/system/concurrent_lru_cache.hpp"
+#include "autoware/universe_utils/system/lru_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using autoware::universe_utils::ConcurrentLRUCache;
+using autoware::universe_utils::LRUCache;
+
+TEST(ConcurrentLRUCacheTest, PutAndGet)
+{
+  ConcurrentLRUCache<int, std::string> cache(3, 1);
+  EXPECT_TRUE(cache.empty());
+  EXPECT_FALSE(cache.get(1));
+
+  EXPECT_TRUE(cache.put(1, "one"));
+  EXPECT_TRUE(cache.put(2, "two"));
+  EXPECT_TRUE(cache.put(3, "three"));
+  EXPECT_EQ(cache.size(), 3UL);
+  EXPECT_EQ(*cache.get(1), "one");
+
+  // 2 is the least recently used
+  EXPECT_TRUE(cache.put(4, "four"));
+  EXPECT_EQ(cache.size(), 3UL);
+  EXPECT_FALSE(cache.contains(2));
+  EXPECT_TRUE(cache.contains(1));
+  EXPECT_TRUE(cache.contains(3));
+  EXPECT_TRUE(cache.contains(4));
+
+  // update an existing key
+  EXPECT_TRUE(cache.put(3, "THREE"));
+  EXPECT_EQ(cache.size(), 3UL);
+  EXPECT_EQ(*cache.get(3), "THREE");
+
+  EXPECT_TRUE(cache.erase(3));
+  EXPECT_FALSE(cache.erase(3));
+  EXPECT_EQ(cache.size(), 2UL);
+
+  cache.clear();
+  EXPECT_TRUE(cache.empty());
+  EXPECT_FALSE(cache.get(1));
+  EXPECT_TRUE(cache.put(5, "five"));
+  EXPECT_EQ(*cache.get(5), "five");
+}
+
+// With a single shard, the cache behaves like LRUCache
+TEST(ConcurrentLRUCacheTest, SameAsLRUCache)
+{
+  constexpr size_t capacity = 50;
+  ConcurrentLRUCache<int, int> concurrent_cache(capacity, 1);
+  LRUCache<int, int> cache(capacity);
+  std::default_random_engine engine(0);
+  std::uniform_int_distribution key_dist(0, 100);
+  std::uniform_int_distribution operation_dist(0, 2);
+  for (int i = 0; i < 100000; ++i) {
+    const auto key = key_dist(engine);
+    if (operation_dist(engine) == 0) {
+      concurrent_cache.put(key, i);
+      cache.put(key, i);
+    } else {
+      EXPECT_EQ(concurrent_cache.get(key), cache.get(key));
+    }
+    ASSERT_EQ(concurrent_cache.size(), cache.size());
+  }
+}
+
+TEST(ConcurrentLRUCacheTest, Shards)
+{
+  ConcurrentLRUCache<int, int> cache(1000, 8);
+  for (int i = 0; i < 1000; ++i) cache.put(i, i);
+  // the keys are not evenly split between the shards
+  EXPECT_GT(cache.size(), 800UL);
+  EXPECT_LE(cache.size(), 1000UL);
+  for (int i = 0; i < 1000; ++i) {
+    const auto value = cache.get(i);
+    if (value) {
+      EXPECT_EQ(*value, i);
+    }
+  }
+  const auto statistics = cache.statistics();
+  EXPECT_EQ(statistics.hits, cache.size());
+  EXPECT_EQ(statistics.hits + statistics.misses, 1000UL);
+  EXPECT_EQ(statistics.evictions, 1000UL - cache.size());
+}
+
+TEST(ConcurrentLRUCacheTest, Bytes)
+{
+  ConcurrentLRUCache<int, std::string> cache(10, 1, 100);
+  EXPECT_EQ(cache.max_bytes(), 100UL);
+  EXPECT_TRUE(cache.put(1, "a", 40));
+  EXPECT_TRUE(cache.put(2, "b", 40));
+  EXPECT_EQ(cache.bytes(), 80UL);
+
+  // 1 is evicted to fit 3
+  EXPECT_TRUE(cache.put(3, "c", 30));
+  EXPECT_FALSE(cache.contains(1));
+  EXPECT_EQ(cache.bytes(), 70UL);
+  EXPECT_EQ(cache.statistics().evictions, 1UL);
+
+  // a smaller value for an existing key
+  EXPECT_TRUE(cache.put(2, "b", 10));
+  EXPECT_EQ(cache.bytes(), 40UL);
+
+  // larger than the budget: not inserted and the previous value is removed
+  EXPECT_FALSE(cache.put(3, "large", 101));
+  EXPECT_FALSE(cache.contains(3));
+  EXPECT_EQ(cache.bytes(), 10UL);
+
+  // 2 and 4 are evicted to fit 5
+  EXPECT_TRUE(cache.put(4, "d", 50));
+  EXPECT_TRUE(cache.put(5, "e", 100));
+  EXPECT_EQ(cache.size(), 1UL);
+  EXPECT_EQ(cache.bytes(), 100UL);
+  EXPECT_EQ(*cache.get(5), "e");
+}
+
+TEST(ConcurrentLRUCacheTest, Statistics)
+{
+  ConcurrentLRUCache<int, int> cache(2);
+  cache.put(1, 1);
+  cache.get(1);
+  cache.get(1);
+  cache.get(2);
+  EXPECT_TRUE(cache.contains(1));
+  auto statistics = cache.statistics();
+  EXPECT_EQ(statistics.hits, 2UL);
+  EXPECT_EQ(statistics.misses, 1UL);
+  EXPECT_EQ(statistics.evictions, 0UL);
+
+  cache.reset_statistics();
+  statistics = cache.statistics();
+  EXPECT_EQ(statistics.hits, 0UL);
+  EXPECT_EQ(statistics.misses, 0UL);
+}
+
+TEST(ConcurrentLRUCacheTest, ZeroCapacity)
+{
+  ConcurrentLRUCache<int, int> cache(0);
+  EXPECT_FALSE(cache.put(1, 1));
+  EXPECT_TRUE(cache.empty());
+  EXPECT_FALSE(cache.get(1));
+}
+
+TEST(ConcurrentLRUCacheTest, MultiThread)
+{
+  constexpr size_t capacity = 256;
+  constexpr int nb_threads = 8;
+  constexpr int nb_operations = 20000;
+  ConcurrentLRUCache<int64_t, int64_t> cache(capacity, 4, capacity * 8);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nb_threads; ++t) {
+    threads.emplace_back([&cache, t]() {
+      std::default_random_engine engine(t);
+      std::uniform_int_distribution<int64_t> key_dist(0, 1000);
+      for (int i = 0; i < nb_operations; ++i) {
+        const auto key = key_dist(engine);
+        if (const auto value = cache.get(key)) {
+          EXPECT_EQ(*value, key * key);
+        } else {
+          cache.put(key, key * key, sizeof(int64_t));
+        }
+      }
+    });
+  }
+  for (auto & thread : threads) thread.join();
+
+  EXPECT_LE(cache.size(), capacity);
+  EXPECT_EQ(cache.bytes(), cache.size() * sizeof(int64_t));
+  const auto statistics = cache.statistics();
+  EXPECT_EQ(statistics.hits + statistics.misses, static_cast<uint64_t>(nb_threads * nb_operations));
+}
@@ -21,6 +21,8 @@
 
 #include <chrono>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <thread>
 
 TEST(system, TimeKeeper)
@@ -51,3 +53,27 @@ TEST(system, TimeKeeper)
     }
   }
 }
+
+TEST(system, TimeKeeperWithTraceRecorder)
+{
+  using autoware::universe_utils::ScopedTimeTrack;
+  using autoware::universe_utils::TimeKeeper;
+  using autoware::universe_utils::TraceRecorder;
+
+  auto recorder = std::make_shared<TraceRecorder>(1.0);
+  TimeKeeper time_keeper(recorder);
+
+  {
+    ScopedTimeTrack st{"main_func", time_keeper};
+    {  // funcA
+      ScopedTimeTrack st{"funcA", time_keeper};
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    time_keeper.comment("comment is ignored without tree reporters");
+  }
+  EXPECT_THROW(time_keeper.end_track("main_func"), std::runtime_error);
+
+  const auto cycles = recorder->get_cycles();
+  ASSERT_EQ(cycles.size(), 1U);
+  EXPECT_EQ(cycles.front().events.size(), 4U);
+}
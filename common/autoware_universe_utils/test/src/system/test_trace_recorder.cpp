@@ -0,0 +1,181 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/universe_utils/system/trace_recorder.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using autoware::universe_utils::TraceRecorder;
+
+TEST(system, TraceRecorderKeepsSlowCyclesOnly)
+{
+  TraceRecorder recorder(5.0);
+
+  // fast cycle
+  recorder.begin("main_func");
+  recorder.begin("funcA");
+  recorder.end("funcA");
+  recorder.end("main_func");
+  EXPECT_TRUE(recorder.get_cycles().empty());
+
+  // slow cycle
+  recorder.begin("main_func");
+  recorder.begin("funcB");
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  recorder.end("funcB");
+  recorder.end("main_func");
+
+  const auto cycles = recorder.get_cycles();
+  ASSERT_EQ(cycles.size(), 1U);
+  EXPECT_GE(cycles.front().duration_ms, 10.0);
+  EXPECT_FALSE(cycles.front().truncated);
+
+  const std::vector<std::pair<std::string, char>> expected{
+    {"main_func", 'B'}, {"funcB", 'B'}, {"funcB", 'E'}, {"main_func", 'E'}};
+  ASSERT_EQ(cycles.front().events.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(recorder.get_name(cycles.front().events.at(i).name_id), expected.at(i).first);
+    EXPECT_EQ(cycles.front().events.at(i).phase, expected.at(i).second);
+  }
+
+  recorder.clear_cycles();
+  EXPECT_TRUE(recorder.get_cycles().empty());
+}
+
+TEST(system, TraceRecorderThrowsOnMismatchedEnd)
+{
+  TraceRecorder recorder;
+  recorder.begin("main_func");
+  recorder.begin("funcA");
+  EXPECT_THROW(recorder.end("main_func"), std::runtime_error);
+}
+
+TEST(system, TraceRecorderTruncatesLongCycle)
+{
+  TraceRecorder recorder(0.0, 8);
+  recorder.begin("main_func");
+  for (int i = 0; i < 10; ++i) {
+    recorder.begin("func");
+    recorder.end("func");
+  }
+  recorder.end("main_func");
+
+  const auto cycles = recorder.get_cycles();
+  ASSERT_EQ(cycles.size(), 1U);
+  EXPECT_TRUE(cycles.front().truncated);
+  EXPECT_EQ(cycles.front().events.size(), 8U);
+  EXPECT_EQ(cycles.front().events.back().phase, 'E');
+}
+
+TEST(system, TraceRecorderRecordsEachThread)
+{
+  auto recorder = std::make_shared<TraceRecorder>(0.0, 1024, 16);
+
+  // the threads wait for each other before exiting, so that each of them gets its own buffer
+  std::atomic<int> num_recorded{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([recorder, &num_recorded]() {
+      recorder->begin("worker");
+      recorder->begin("task");
+      recorder->end("task");
+      recorder->end("worker");
+      ++num_recorded;
+      while (num_recorded < 4) {
+        std::this_thread::yield();
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  const auto cycles = recorder->get_cycles();
+  ASSERT_EQ(cycles.size(), 4U);
+  std::vector<bool> seen(4, false);
+  for (const auto & cycle : cycles) {
+    ASSERT_LT(cycle.thread_index, 4U);
+    seen.at(cycle.thread_index) = true;
+    EXPECT_EQ(cycle.events.size(), 4U);
+  }
+  EXPECT_EQ(std::count(seen.begin(), seen.end(), true), 4);
+
+  std::ostringstream oss;
+  recorder->write_chrome_trace(oss);
+  const auto json = oss.str();
+  EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0U);
+  EXPECT_NE(json.find(R"("name":"worker","ph":"B")"), std::string::npos);
+  EXPECT_NE(json.find(R"("name":"task","ph":"E")"), std::string::npos);
+}
+
+TEST(system, TraceRecorderReusesBuffersOfExitedThreads)
+{
+  auto recorder = std::make_shared<TraceRecorder>(0.0, 1024, 16, 2);
+
+  // the threads run one after another, so that they all use the first buffer
+  for (int i = 0; i < 8; ++i) {
+    std::thread([recorder]() {
+      recorder->begin("worker");
+      recorder->end("worker");
+    }).join();
+  }
+
+  const auto cycles = recorder->get_cycles();
+  ASSERT_EQ(cycles.size(), 8U);
+  for (const auto & cycle : cycles) {
+    EXPECT_EQ(cycle.thread_index, 0U);
+    EXPECT_EQ(cycle.events.size(), 2U);
+  }
+}
+
+TEST(system, TraceRecorderLimitsNumberOfBuffers)
+{
+  TraceRecorder recorder(0.0, 1024, 16, 1);
+
+  // the main thread holds the only buffer
+  recorder.begin("main_func");
+  std::thread([&recorder]() {
+    recorder.begin("worker");
+    recorder.end("worker");
+  }).join();
+  recorder.end("main_func");
+
+  const auto cycles = recorder.get_cycles();
+  ASSERT_EQ(cycles.size(), 1U);
+  ASSERT_EQ(cycles.front().events.size(), 2U);
+  EXPECT_EQ(recorder.get_name(cycles.front().events.front().name_id), "main_func");
+}
+
+TEST(system, TraceRecorderOutlivedByThread)
+{
+  // a thread exits after the recorder is destroyed, and uses recorders created one after another
+  std::thread([]() {
+    for (int i = 0; i < 4; ++i) {
+      TraceRecorder recorder;
+      recorder.begin("main_func");
+      recorder.end("main_func");
+      EXPECT_EQ(recorder.get_cycles().size(), 1U);
+    }
+  }).join();
+}
@@ -49,9 +49,17 @@ struct MultiSplineCoef
 std::vector<double> spline(
   const std::vector<double> & base_keys, const std::vector<double> & base_values,
   const std::vector<double> & query_keys);
+//!< @brief same as spline(), written to query_values to reuse its memory
+void spline(
+  const std::vector<double> & base_keys, const std::vector<double> & base_values,
+  const std::vector<double> & query_keys, std::vector<double> & query_values);
 std::vector<double> splineByAkima(
   const std::vector<double> & base_keys, const std::vector<double> & base_values,
   const std::vector<double> & query_keys);
+//!< @brief calculate coefficients of splineByAkima(), written to coef to reuse its memory
+void calcAkimaSplineCoefficients(
+  const std::vector<double> & base_keys, const std::vector<double> & base_values,
+  MultiSplineCoef & coef);
 }  // namespace interpolation
 
 // non-static 1-dimensional spline interpolation
@@ -76,6 +84,11 @@ public:
     calcSplineCoefficients(base_keys, base_values);
   }
 
+  //!< @brief calculate spline coefficients of base_values on base_keys.
+  //!< @details Calling this again on the same object reuses the memory of the coefficients.
+  void calcSplineCoefficients(
+    const std::vector<double> & base_keys, const std::vector<double> & base_values);
+
   //!< @brief get values of spline interpolation on designated sampling points.
   //!< @details Assuming that query_keys are t vector for sampling, and interpolation is for x,
   //            meaning that spline interpolation was applied to x(t),
@@ -95,14 +108,42 @@ public:
   std::vector<double> getSplineInterpolatedQuadDiffValues(
     const std::vector<double> & query_keys) const;
 
+  //!< @brief get values and differential values of spline interpolation on designated sampling
+  //          points in one sweep over the sorted query_keys.
+  //!< @details The results are written to the given vectors to reuse their memory. Pass nullptr
+  //            for the values which are not needed.
+  void getSplineInterpolatedValues(
+    const std::vector<double> & query_keys, std::vector<double> * values,
+    std::vector<double> * diff_values = nullptr,
+    std::vector<double> * quad_diff_values = nullptr) const;
+
+  //!< @brief get index of the spline between base_keys[i] and base_keys[i+1] which contains
+  //          query_key, found by binary search.
+  //!< @details The spline which ends at query_key is chosen when query_key is one of base_keys,
+  //            as getSplineInterpolatedValues() does. query_key is clamped to base_keys.
+  size_t getSegmentIndex(const double query_key) const;
+
+  //!< @brief get value, 1st and 2nd differential values of the spline of segment_idx at
+  //          query_key without any allocation. Several splines on the same base_keys can share
+  //          one getSegmentIndex().
+  //!< @details query_key is neither validated nor clamped here.
+  double getSplineInterpolatedValue(const size_t segment_idx, const double query_key) const;
+  double getSplineInterpolatedDiffValue(const size_t segment_idx, const double query_key) const;
+  double getSplineInterpolatedQuadDiffValue(
+    const size_t segment_idx, const double query_key) const;
+
   size_t getSize() const { return base_keys_.size(); }
 
 private:
   std::vector<double> base_keys_;
   interpolation::MultiSplineCoef multi_spline_coef_;
 
-  void calcSplineCoefficients(
-    const std::vector<double> & base_keys, const std::vector<double> & base_values);
+  // workspaces of calcSplineCoefficients(), kept to reuse their memory
+  std::vector<double> diff_keys_;
+  std::vector<double> slopes_;
+  std::vector<double> v_;  // second derivatives at base_keys
+  std::vector<double> p_;
+  std::vector<double> q_;
 };
 
 #endif  // INTERPOLATION__SPLINE_INTERPOLATION_HPP_
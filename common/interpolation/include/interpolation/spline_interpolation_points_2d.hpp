@@ -73,12 +73,20 @@ public:
   double getSplineInterpolatedCurvature(const size_t idx, const double s) const;
   std::vector<double> getSplineInterpolatedCurvatures() const;
 
+  // points, yaws and curvatures at the sorted arc lengths from the front point, evaluated in one
+  // sweep over the base points. The results are written to the given vectors to reuse their
+  // memory, and nullptr skips the values which are not needed.
+  void getSplineInterpolatedValues(
+    const std::vector<double> & whole_s_vec, std::vector<geometry_msgs::msg::Point> * points,
+    std::vector<double> * yaws = nullptr, std::vector<double> * curvatures = nullptr) const;
+
   size_t getSize() const { return base_s_vec_.size(); }
   size_t getOffsetIndex(const size_t idx, const double offset) const;
   double getAccumulatedLength(const size_t idx) const;
 
 private:
   void calcSplineCoefficientsInner(const std::vector<geometry_msgs::msg::Point> & points);
+  double calcCurvature(const size_t segment_idx, const double s) const;
   SplineInterpolation spline_x_;
   SplineInterpolation spline_y_;
   SplineInterpolation spline_z_;
@@ -14,6 +14,9 @@
 
 #include "interpolation/spline_interpolation.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
 #include <vector>
 
 namespace
@@ -25,57 +28,43 @@ namespace
 // A = [            ...                   ]
 //     [   O         ... a_N-3 b_N-2 c_N-2]
 //     [                   ... a_N-2 b_N-1]
-struct TDMACoef
+// of the natural cubic spline, where b_i = 2 (h_i + h_i+1), a_i = c_i = h_i+1 and
+// d_i = 6 (slope_i+1 - slope_i) with the intervals h and the slopes of the base values.
+// NOTE: A is not stored, and the solution is written to x[0] ... x[N-1], so that x can be the
+//       inner part of the second derivatives. p and q are the workspaces of the forward sweep,
+//       which are resized so that the caller can reuse their memory.
+void solveTridiagonalMatrixAlgorithm(
+  const std::vector<double> & diff_keys, const std::vector<double> & slopes,
+  std::vector<double> & p, std::vector<double> & q, double * x)
 {
-  explicit TDMACoef(const size_t num_row)
-  {
-    a.resize(num_row - 1);
-    b.resize(num_row);
-    c.resize(num_row - 1);
-    d.resize(num_row);
-  }
+  const size_t num_row = diff_keys.size() - 1;
 
-  std::vector<double> a;
-  std::vector<double> b;
-  std::vector<double> c;
-  std::vector<double> d;
-};
+  p.resize(num_row);
+  q.resize(num_row);
 
-inline std::vector<double> solveTridiagonalMatrixAlgorithm(const TDMACoef & tdma_coef)
-{
-  const auto & a = tdma_coef.a;
-  const auto & b = tdma_coef.b;
-  const auto & c = tdma_coef.c;
-  const auto & d = tdma_coef.d;
-
-  const size_t num_row = b.size();
-
-  std::vector<double> x(num_row);
-  if (num_row != 1) {
-    // calculate p and q
-    std::vector<double> p;
-    std::vector<double> q;
-    p.push_back(-c[0] / b[0]);
-    q.push_back(d[0] / b[0]);
-
-    for (size_t i = 1; i < num_row; ++i) {
-      const double den = b[i] + a[i - 1] * p[i - 1];
-      p.push_back(-c[i - 1] / den);
-      q.push_back((d[i] - a[i - 1] * q[i - 1]) / den);
-    }
+  // calculate p and q
+  {
+    const double b = 2 * (diff_keys[0] + diff_keys[1]);
+    const double d = 6.0 * (slopes[1] - slopes[0]);
+    p[0] = -diff_keys[1] / b;
+    q[0] = d / b;
+  }
+  for (size_t i = 1; i < num_row; ++i) {
+    const double a = diff_keys[i];  // a_i-1
+    const double b = 2 * (diff_keys[i] + diff_keys[i + 1]);
+    const double d = 6.0 * (slopes[i + 1] - slopes[i]);
+    const double den = b + a * p[i - 1];
+    p[i] = -diff_keys[i] / den;  // c_i-1
+    q[i] = (d - a * q[i - 1]) / den;
+  }
 
-    // calculate solution
-    x[num_row - 1] = q[num_row - 1];
+  // calculate solution
+  x[num_row - 1] = q[num_row - 1];
 
-    for (size_t i = 1; i < num_row; ++i) {
-      const size_t j = num_row - 1 - i;
-      x[j] = p[j] * x[j + 1] + q[j];
-    }
-  } else {
-    x[0] = (d[0] / b[0]);
+  for (size_t i = 1; i < num_row; ++i) {
+    const size_t j = num_row - 1 - i;
+    x[j] = p[j] * x[j + 1] + q[j];
   }
-
-  return x;
 }
 }  // namespace
 
@@ -92,77 +81,91 @@ std::vector<double> spline(
   return interpolator.getSplineInterpolatedValues(query_keys);
 }
 
+void spline(
+  const std::vector<double> & base_keys, const std::vector<double> & base_values,
+  const std::vector<double> & query_keys, std::vector<double> & query_values)
+{
+  const SplineInterpolation interpolator(base_keys, base_values);
+  interpolator.getSplineInterpolatedValues(query_keys, &query_values);
+}
+
 std::vector<double> splineByAkima(
   const std::vector<double> & base_keys, const std::vector<double> & base_values,
   const std::vector<double> & query_keys)
+{
+  MultiSplineCoef coef;
+  calcAkimaSplineCoefficients(base_keys, base_values, coef);
+  const auto & a = coef.a;
+  const auto & b = coef.b;
+  const auto & c = coef.c;
+  const auto & d = coef.d;
+
+  // interpolate
+  std::vector<double> res;
+  size_t j = 0;
+  for (const auto & query_key : query_keys) {
+    while (base_keys.at(j + 1) < query_key) {
+      ++j;
+    }
+
+    const double ds = query_key - base_keys.at(j);
+    res.push_back(d.at(j) + (c.at(j) + (b.at(j) + a.at(j) * ds) * ds) * ds);
+  }
+  return res;
+}
+
+void calcAkimaSplineCoefficients(
+  const std::vector<double> & base_keys, const std::vector<double> & base_values,
+  MultiSplineCoef & coef)
 {
   constexpr double epsilon = 1e-5;
 
   // calculate m
-  std::vector<double> m_values;
+  std::vector<double> m_values(base_keys.size() - 1);
   for (size_t i = 0; i < base_keys.size() - 1; ++i) {
-    const double m_val =
+    m_values[i] =
       (base_values.at(i + 1) - base_values.at(i)) / (base_keys.at(i + 1) - base_keys.at(i));
-    m_values.push_back(m_val);
   }
 
   // calculate s
-  std::vector<double> s_values;
+  std::vector<double> s_values(base_keys.size());
   for (size_t i = 0; i < base_keys.size(); ++i) {
     if (i == 0) {
-      s_values.push_back(m_values.front());
+      s_values[i] = m_values.front();
       continue;
     } else if (i == base_keys.size() - 1) {
-      s_values.push_back(m_values.back());
+      s_values[i] = m_values.back();
       continue;
     } else if (i == 1 || i == base_keys.size() - 2) {
-      const double s_val = (m_values.at(i - 1) + m_values.at(i)) / 2.0;
-      s_values.push_back(s_val);
+      s_values[i] = (m_values.at(i - 1) + m_values.at(i)) / 2.0;
       continue;
     }
 
     const double denom = std::abs(m_values.at(i + 1) - m_values.at(i)) +
                          std::abs(m_values.at(i - 1) - m_values.at(i - 2));
     if (std::abs(denom) < epsilon) {
-      const double s_val = (m_values.at(i - 1) + m_values.at(i)) / 2.0;
-      s_values.push_back(s_val);
+      s_values[i] = (m_values.at(i - 1) + m_values.at(i)) / 2.0;
       continue;
     }
 
-    const double s_val = (std::abs(m_values.at(i + 1) - m_values.at(i)) * m_values.at(i - 1) +
-                          std::abs(m_values.at(i - 1) - m_values.at(i - 2)) * m_values.at(i)) /
-                         denom;
-    s_values.push_back(s_val);
+    s_values[i] = (std::abs(m_values.at(i + 1) - m_values.at(i)) * m_values.at(i - 1) +
+                   std::abs(m_values.at(i - 1) - m_values.at(i - 2)) * m_values.at(i)) /
+                  denom;
   }
 
   // calculate cubic coefficients
-  std::vector<double> a;
-  std::vector<double> b;
-  std::vector<double> c;
-  std::vector<double> d;
+  coef.a.resize(base_keys.size() - 1);
+  coef.b.resize(base_keys.size() - 1);
+  coef.c.resize(base_keys.size() - 1);
+  coef.d.resize(base_keys.size() - 1);
   for (size_t i = 0; i < base_keys.size() - 1; ++i) {
-    a.push_back(
-      (s_values.at(i) + s_values.at(i + 1) - 2.0 * m_values.at(i)) /
-      std::pow(base_keys.at(i + 1) - base_keys.at(i), 2));
-    b.push_back(
-      (3.0 * m_values.at(i) - 2.0 * s_values.at(i) - s_values.at(i + 1)) /
-      (base_keys.at(i + 1) - base_keys.at(i)));
-    c.push_back(s_values.at(i));
-    d.push_back(base_values.at(i));
-  }
-
-  // interpolate
-  std::vector<double> res;
-  size_t j = 0;
-  for (const auto & query_key : query_keys) {
-    while (base_keys.at(j + 1) < query_key) {
-      ++j;
-    }
-
-    const double ds = query_key - base_keys.at(j);
-    res.push_back(d.at(j) + (c.at(j) + (b.at(j) + a.at(j) * ds) * ds) * ds);
+    coef.a[i] = (s_values.at(i) + s_values.at(i + 1) - 2.0 * m_values.at(i)) /
+                std::pow(base_keys.at(i + 1) - base_keys.at(i), 2);
+    coef.b[i] = (3.0 * m_values.at(i) - 2.0 * s_values.at(i) - s_values.at(i + 1)) /
+                (base_keys.at(i + 1) - base_keys.at(i));
+    coef.c[i] = s_values.at(i);
+    coef.d[i] = base_values.at(i);
   }
-  return res;
 }
 }  // namespace interpolation
 
@@ -174,43 +177,37 @@ void SplineInterpolation::calcSplineCoefficients(
 
   const size_t num_base = base_keys.size();  // N+1
 
-  std::vector<double> diff_keys;    // N
-  std::vector<double> diff_values;  // N
+  // the workspaces are members, so that they are only reallocated when the size grows
+  auto & diff_keys = diff_keys_;
+  auto & slopes = slopes_;
+  auto & v = v_;
+  diff_keys.resize(num_base - 1);  // N
+  slopes.resize(num_base - 1);     // N
   for (size_t i = 0; i < num_base - 1; ++i) {
-    diff_keys.push_back(base_keys.at(i + 1) - base_keys.at(i));
-    diff_values.push_back(base_values.at(i + 1) - base_values.at(i));
+    diff_keys[i] = base_keys[i + 1] - base_keys[i];
+    slopes[i] = (base_values[i + 1] - base_values[i]) / diff_keys[i];
   }
 
-  std::vector<double> v = {0.0};
+  // calculate v, whose both ends are 0
+  v.assign(num_base, 0.0);
   if (num_base > 2) {
-    // solve tridiagonal matrix algorithm
-    TDMACoef tdma_coef(num_base - 2);  // N-1
-
-    for (size_t i = 0; i < num_base - 2; ++i) {
-      tdma_coef.b[i] = 2 * (diff_keys[i] + diff_keys[i + 1]);
-      if (i != num_base - 3) {
-        tdma_coef.a[i] = diff_keys[i + 1];
-        tdma_coef.c[i] = diff_keys[i + 1];
-      }
-      tdma_coef.d[i] =
-        6.0 * (diff_values[i + 1] / diff_keys[i + 1] - diff_values[i] / diff_keys[i]);
-    }
-
-    const std::vector<double> tdma_res = solveTridiagonalMatrixAlgorithm(tdma_coef);
-
-    // calculate v
-    v.insert(v.end(), tdma_res.begin(), tdma_res.end());
+    solveTridiagonalMatrixAlgorithm(diff_keys, slopes, p_, q_, v.data() + 1);
   }
-  v.push_back(0.0);
 
   // calculate a, b, c, d of spline coefficients
-  multi_spline_coef_ = interpolation::MultiSplineCoef{num_base - 1};  // N
+  auto & a = multi_spline_coef_.a;
+  auto & b = multi_spline_coef_.b;
+  auto & c = multi_spline_coef_.c;
+  auto & d = multi_spline_coef_.d;
+  a.resize(num_base - 1);  // N
+  b.resize(num_base - 1);
+  c.resize(num_base - 1);
+  d.resize(num_base - 1);
   for (size_t i = 0; i < num_base - 1; ++i) {
-    multi_spline_coef_.a[i] = (v[i + 1] - v[i]) / 6.0 / diff_keys[i];
-    multi_spline_coef_.b[i] = v[i] / 2.0;
-    multi_spline_coef_.c[i] =
-      diff_values[i] / diff_keys[i] - diff_keys[i] * (2 * v[i] + v[i + 1]) / 6.0;
-    multi_spline_coef_.d[i] = base_values[i];
+    a[i] = (v[i + 1] - v[i]) / 6.0 / diff_keys[i];
+    b[i] = v[i] / 2.0;
+    c[i] = slopes[i] - diff_keys[i] * (2 * v[i] + v[i + 1]) / 6.0;
+    d[i] = base_values[i];
   }
 
   base_keys_ = base_keys;
@@ -219,71 +216,114 @@ void SplineInterpolation::calcSplineCoefficients(
 std::vector<double> SplineInterpolation::getSplineInterpolatedValues(
   const std::vector<double> & query_keys) const
 {
-  // throw exceptions for invalid arguments
-  const auto validated_query_keys = interpolation_utils::validateKeys(base_keys_, query_keys);
-
-  const auto & a = multi_spline_coef_.a;
-  const auto & b = multi_spline_coef_.b;
-  const auto & c = multi_spline_coef_.c;
-  const auto & d = multi_spline_coef_.d;
-
   std::vector<double> res;
-  size_t j = 0;
-  for (const auto & query_key : validated_query_keys) {
-    while (base_keys_.at(j + 1) < query_key) {
-      ++j;
-    }
-
-    const double ds = query_key - base_keys_.at(j);
-    res.push_back(d.at(j) + (c.at(j) + (b.at(j) + a.at(j) * ds) * ds) * ds);
-  }
-
+  getSplineInterpolatedValues(query_keys, &res);
   return res;
 }
 
 std::vector<double> SplineInterpolation::getSplineInterpolatedDiffValues(
   const std::vector<double> & query_keys) const
+{
+  std::vector<double> res;
+  getSplineInterpolatedValues(query_keys, nullptr, &res);
+  return res;
+}
+
+std::vector<double> SplineInterpolation::getSplineInterpolatedQuadDiffValues(
+  const std::vector<double> & query_keys) const
+{
+  std::vector<double> res;
+  getSplineInterpolatedValues(query_keys, nullptr, nullptr, &res);
+  return res;
+}
+
+void SplineInterpolation::getSplineInterpolatedValues(
+  const std::vector<double> & query_keys, std::vector<double> * values,
+  std::vector<double> * diff_values, std::vector<double> * quad_diff_values) const
 {
   // throw exceptions for invalid arguments
-  const auto validated_query_keys = interpolation_utils::validateKeys(base_keys_, query_keys);
+  interpolation_utils::validateKeysWithoutCropping(base_keys_, query_keys);
 
-  const auto & a = multi_spline_coef_.a;
-  const auto & b = multi_spline_coef_.b;
-  const auto & c = multi_spline_coef_.c;
+  const size_t num_query = query_keys.size();
+  for (auto * res : {values, diff_values, quad_diff_values}) {
+    if (res) {
+      res->resize(num_query);
+    }
+  }
 
-  std::vector<double> res;
+  // NOTE: query_keys are sorted, so that the spline of each key is found by one sweep over
+  //       base_keys instead of a search per key.
+  const size_t last_segment_idx = base_keys_.size() - 2;
   size_t j = 0;
-  for (const auto & query_key : validated_query_keys) {
-    while (base_keys_.at(j + 1) < query_key) {
+  for (size_t i = 0; i < num_query; ++i) {
+    // NOTE: Due to calculation error of double, the first and last query keys may be slightly out
+    //       of base keys. Therefore, they are cropped here as validateKeys() does.
+    double query_key = query_keys[i];
+    if (i == 0) {
+      query_key = std::max(query_key, base_keys_.front());
+    }
+    if (i == num_query - 1) {
+      query_key = std::min(query_key, base_keys_.back());
+    }
+
+    while (j < last_segment_idx && base_keys_[j + 1] < query_key) {
       ++j;
     }
 
-    const double ds = query_key - base_keys_.at(j);
-    res.push_back(c.at(j) + (2.0 * b.at(j) + 3.0 * a.at(j) * ds) * ds);
+    if (values) {
+      (*values)[i] = getSplineInterpolatedValue(j, query_key);
+    }
+    if (diff_values) {
+      (*diff_values)[i] = getSplineInterpolatedDiffValue(j, query_key);
+    }
+    if (quad_diff_values) {
+      (*quad_diff_values)[i] = getSplineInterpolatedQuadDiffValue(j, query_key);
+    }
   }
+}
 
-  return res;
+size_t SplineInterpolation::getSegmentIndex(const double query_key) const
+{
+  if (base_keys_.size() < 2) {
+    throw std::logic_error("Spline coefficients are not calculated.");
+  }
+
+  // the first base key which is not less than query_key is the end of the spline, as the sweep
+  // of getSplineInterpolatedValues() finds
+  const auto end_itr =
+    std::lower_bound(std::next(base_keys_.begin()), std::prev(base_keys_.end()), query_key);
+  return static_cast<size_t>(std::distance(base_keys_.begin(), end_itr)) - 1;
 }
 
-std::vector<double> SplineInterpolation::getSplineInterpolatedQuadDiffValues(
-  const std::vector<double> & query_keys) const
+double SplineInterpolation::getSplineInterpolatedValue(
+  const size_t segment_idx, const double query_key) const
 {
-  // throw exceptions for invalid arguments
-  const auto validated_query_keys = interpolation_utils::validateKeys(base_keys_, query_keys);
+  const auto & a = multi_spline_coef_.a;
+  const auto & b = multi_spline_coef_.b;
+  const auto & c = multi_spline_coef_.c;
+  const auto & d = multi_spline_coef_.d;
 
+  const double ds = query_key - base_keys_[segment_idx];
+  return d[segment_idx] + (c[segment_idx] + (b[segment_idx] + a[segment_idx] * ds) * ds) * ds;
+}
+
+double SplineInterpolation::getSplineInterpolatedDiffValue(
+  const size_t segment_idx, const double query_key) const
+{
   const auto & a = multi_spline_coef_.a;
   const auto & b = multi_spline_coef_.b;
+  const auto & c = multi_spline_coef_.c;
 
-  std::vector<double> res;
-  size_t j = 0;
-  for (const auto & query_key : validated_query_keys) {
-    while (base_keys_.at(j + 1) < query_key) {
-      ++j;
-    }
+  const double ds = query_key - base_keys_[segment_idx];
+  return c[segment_idx] + (2.0 * b[segment_idx] + 3.0 * a[segment_idx] * ds) * ds;
+}
 
-    const double ds = query_key - base_keys_.at(j);
-    res.push_back(2.0 * b.at(j) + 6.0 * a.at(j) * ds);
-  }
+double SplineInterpolation::getSplineInterpolatedQuadDiffValue(
+  const size_t segment_idx, const double query_key) const
+{
+  const auto & a = multi_spline_coef_.a;
+  const auto & b = multi_spline_coef_.b;
 
-  return res;
+  const double ds = query_key - base_keys_[segment_idx];
+  return 2.0 * b[segment_idx] + 6.0 * a[segment_idx] * ds;
 }
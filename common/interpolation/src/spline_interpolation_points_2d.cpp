@@ -14,6 +14,8 @@
 
 #include "interpolation/spline_interpolation_points_2d.hpp"
 
+#include <algorithm>
+#include <stdexcept>
 #include <vector>
 
 namespace
@@ -115,9 +117,11 @@ geometry_msgs::msg::Point SplineInterpolationPoints2d::getSplineInterpolatedPoin
     whole_s = base_s_vec_.back();
   }
 
-  const double x = spline_x_.getSplineInterpolatedValues({whole_s}).at(0);
-  const double y = spline_y_.getSplineInterpolatedValues({whole_s}).at(0);
-  const double z = spline_z_.getSplineInterpolatedValues({whole_s}).at(0);
+  // NOTE: x, y and z share base_s_vec_, and so the spline index.
+  const size_t segment_idx = spline_x_.getSegmentIndex(whole_s);
+  const double x = spline_x_.getSplineInterpolatedValue(segment_idx, whole_s);
+  const double y = spline_y_.getSplineInterpolatedValue(segment_idx, whole_s);
+  const double z = spline_z_.getSplineInterpolatedValue(segment_idx, whole_s);
 
   geometry_msgs::msg::Point geom_point;
   geom_point.x = x;
@@ -135,8 +139,9 @@ double SplineInterpolationPoints2d::getSplineInterpolatedYaw(const size_t idx, c
   const double whole_s =
     std::clamp(base_s_vec_.at(idx) + s, base_s_vec_.front(), base_s_vec_.back());
 
-  const double diff_x = spline_x_.getSplineInterpolatedDiffValues({whole_s}).at(0);
-  const double diff_y = spline_y_.getSplineInterpolatedDiffValues({whole_s}).at(0);
+  const size_t segment_idx = spline_x_.getSegmentIndex(whole_s);
+  const double diff_x = spline_x_.getSplineInterpolatedDiffValue(segment_idx, whole_s);
+  const double diff_y = spline_y_.getSplineInterpolatedDiffValue(segment_idx, whole_s);
 
   return std::atan2(diff_y, diff_x);
 }
@@ -144,10 +149,7 @@ double SplineInterpolationPoints2d::getSplineInterpolatedYaw(const size_t idx, c
 std::vector<double> SplineInterpolationPoints2d::getSplineInterpolatedYaws() const
 {
   std::vector<double> yaw_vec;
-  for (size_t i = 0; i < spline_x_.getSize(); ++i) {
-    const double yaw = getSplineInterpolatedYaw(i, 0.0);
-    yaw_vec.push_back(yaw);
-  }
+  getSplineInterpolatedValues(base_s_vec_, nullptr, &yaw_vec);
   return yaw_vec;
 }
 
@@ -161,11 +163,17 @@ double SplineInterpolationPoints2d::getSplineInterpolatedCurvature(
   const double whole_s =
     std::clamp(base_s_vec_.at(idx) + s, base_s_vec_.front(), base_s_vec_.back());
 
-  const double diff_x = spline_x_.getSplineInterpolatedDiffValues({whole_s}).at(0);
-  const double diff_y = spline_y_.getSplineInterpolatedDiffValues({whole_s}).at(0);
+  const size_t segment_idx = spline_x_.getSegmentIndex(whole_s);
+  return calcCurvature(segment_idx, whole_s);
+}
+
+double SplineInterpolationPoints2d::calcCurvature(const size_t segment_idx, const double s) const
+{
+  const double diff_x = spline_x_.getSplineInterpolatedDiffValue(segment_idx, s);
+  const double diff_y = spline_y_.getSplineInterpolatedDiffValue(segment_idx, s);
 
-  const double quad_diff_x = spline_x_.getSplineInterpolatedQuadDiffValues({whole_s}).at(0);
-  const double quad_diff_y = spline_y_.getSplineInterpolatedQuadDiffValues({whole_s}).at(0);
+  const double quad_diff_x = spline_x_.getSplineInterpolatedQuadDiffValue(segment_idx, s);
+  const double quad_diff_y = spline_y_.getSplineInterpolatedQuadDiffValue(segment_idx, s);
 
   return (diff_x * quad_diff_y - quad_diff_x * diff_y) /
          std::pow(std::pow(diff_x, 2) + std::pow(diff_y, 2), 1.5);
@@ -174,13 +182,60 @@ double SplineInterpolationPoints2d::getSplineInterpolatedCurvature(
 std::vector<double> SplineInterpolationPoints2d::getSplineInterpolatedCurvatures() const
 {
   std::vector<double> curvature_vec;
-  for (size_t i = 0; i < spline_x_.getSize(); ++i) {
-    const double curvature = getSplineInterpolatedCurvature(i, 0.0);
-    curvature_vec.push_back(curvature);
-  }
+  getSplineInterpolatedValues(base_s_vec_, nullptr, nullptr, &curvature_vec);
   return curvature_vec;
 }
 
+void SplineInterpolationPoints2d::getSplineInterpolatedValues(
+  const std::vector<double> & whole_s_vec, std::vector<geometry_msgs::msg::Point> * points,
+  std::vector<double> * yaws, std::vector<double> * curvatures) const
+{
+  const size_t num_query = whole_s_vec.size();
+  if (points) {
+    points->resize(num_query);
+  }
+  if (yaws) {
+    yaws->resize(num_query);
+  }
+  if (curvatures) {
+    curvatures->resize(num_query);
+  }
+  if (num_query == 0) {
+    return;
+  }
+
+  if (base_s_vec_.empty()) {
+    throw std::logic_error("Spline coefficients are not calculated.");
+  }
+  if (!interpolation_utils::isNotDecreasing(whole_s_vec)) {
+    throw std::invalid_argument("whole_s_vec is not sorted.");
+  }
+
+  const size_t last_segment_idx = base_s_vec_.size() - 2;
+  size_t segment_idx = 0;
+  for (size_t i = 0; i < num_query; ++i) {
+    const double whole_s = std::clamp(whole_s_vec[i], base_s_vec_.front(), base_s_vec_.back());
+    while (segment_idx < last_segment_idx && base_s_vec_[segment_idx + 1] < whole_s) {
+      ++segment_idx;
+    }
+
+    if (points) {
+      auto & point = (*points)[i];
+      point.x = spline_x_.getSplineInterpolatedValue(segment_idx, whole_s);
+      point.y = spline_y_.getSplineInterpolatedValue(segment_idx, whole_s);
+      point.z = spline_z_.getSplineInterpolatedValue(segment_idx, whole_s);
+    }
+    if (yaws) {
+      const double diff_x = spline_x_.getSplineInterpolatedDiffValue(segment_idx, whole_s);
+      const double diff_y = spline_y_.getSplineInterpolatedDiffValue(segment_idx, whole_s);
+      (*yaws)[i] = std::atan2(diff_y, diff_x);
+    }
+    if (curvatures) {
+      (*curvatures)[i] = calcCurvature(segment_idx, whole_s);
+    }
+  }
+}
+
 size_t SplineInterpolationPoints2d::getOffsetIndex(const size_t idx, const double offset) const
 {
   const double whole_s = base_s_vec_.at(idx) + offset;
@@ -267,3 +267,66 @@ TEST(spline_interpolation, SplineInterpolation)
     }
   }
 }
+
+TEST(spline_interpolation, SplineInterpolationBatch)
+{
+  const std::vector<double> base_keys{-1.5, 1.0, 5.0, 10.0, 15.0, 20.0};
+  const std::vector<double> base_values{-1.2, 0.5, 1.0, 1.2, 2.0, 1.0};
+  // including base keys and keys slightly out of base keys
+  const std::vector<double> query_keys{-1.5005, 0.0, 1.0, 5.0, 8.0, 12.0, 18.0, 20.0005};
+
+  SplineInterpolation s(base_keys, base_values);
+  const auto ans_values = s.getSplineInterpolatedValues(query_keys);
+  const auto ans_diff_values = s.getSplineInterpolatedDiffValues(query_keys);
+  const auto ans_quad_diff_values = s.getSplineInterpolatedQuadDiffValues(query_keys);
+
+  {  // values and differential values in one sweep
+    std::vector<double> values;
+    std::vector<double> diff_values;
+    std::vector<double> quad_diff_values;
+    s.getSplineInterpolatedValues(query_keys, &values, &diff_values, &quad_diff_values);
+    EXPECT_EQ(values, ans_values);
+    EXPECT_EQ(diff_values, ans_diff_values);
+    EXPECT_EQ(quad_diff_values, ans_quad_diff_values);
+
+    // reuse the output
+    s.getSplineInterpolatedValues(std::vector<double>{0.0, 8.0}, &values);
+    ASSERT_EQ(values.size(), 2u);
+    EXPECT_EQ(values.at(1), ans_values.at(4));
+
+    std::vector<double> spline_values;
+    interpolation::spline(base_keys, base_values, query_keys, spline_values);
+    EXPECT_EQ(spline_values, ans_values);
+  }
+
+  {  // one key
+    for (size_t i = 1; i + 1 < query_keys.size(); ++i) {
+      const double key = query_keys.at(i);
+      const size_t segment_idx = s.getSegmentIndex(key);
+      EXPECT_EQ(s.getSplineInterpolatedValue(segment_idx, key), ans_values.at(i));
+      EXPECT_EQ(s.getSplineInterpolatedDiffValue(segment_idx, key), ans_diff_values.at(i));
+      EXPECT_EQ(
+        s.getSplineInterpolatedQuadDiffValue(segment_idx, key), ans_quad_diff_values.at(i));
+    }
+    EXPECT_EQ(s.getSegmentIndex(-1.5), 0u);
+    EXPECT_EQ(s.getSegmentIndex(1.0), 0u);
+    EXPECT_EQ(s.getSegmentIndex(1.5), 1u);
+    EXPECT_EQ(s.getSegmentIndex(20.0), 4u);
+    EXPECT_EQ(s.getSegmentIndex(30.0), 4u);
+  }
+
+  {  // recalculate coefficients on the same object
+    const std::vector<double> other_base_values{0.0, 1.0, 2.0, 3.0, 4.0, 5.0};
+    s.calcSplineCoefficients(base_keys, other_base_values);
+    EXPECT_EQ(
+      s.getSplineInterpolatedValues(query_keys),
+      SplineInterpolation(base_keys, other_base_values).getSplineInterpolatedValues(query_keys));
+  }
+
+  {  // unsorted query keys
+    std::vector<double> values;
+    EXPECT_THROW(
+      s.getSplineInterpolatedValues(std::vector<double>{1.0, 0.0}, &values),
+      std::invalid_argument);
+  }
+}
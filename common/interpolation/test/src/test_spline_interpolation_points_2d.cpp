@@ -220,3 +220,47 @@ TEST(spline_interpolation, SplineInterpolationPoints2dPolymorphism)
   SplineInterpolationPoints2d s_traj_point(trajectory_points);
   s_traj_point.getSplineInterpolatedPoint(0, 0.);
 }
+
+TEST(spline_interpolation, SplineInterpolationPoints2dBatch)
+{
+  using autoware::universe_utils::createPoint;
+
+  std::vector<geometry_msgs::msg::Point> points;
+  points.push_back(createPoint(-2.0, -10.0, 0.0));
+  points.push_back(createPoint(2.0, 1.5, 1.0));
+  points.push_back(createPoint(3.0, 3.0, 2.0));
+  points.push_back(createPoint(5.0, 10.0, 0.5));
+  points.push_back(createPoint(10.0, 12.5, 0.0));
+
+  const SplineInterpolationPoints2d s(points);
+
+  // including arc lengths out of the points
+  const std::vector<double> whole_s_vec{-1.0, 0.0, 3.0, 12.0, 12.5, 20.0, 100.0};
+  std::vector<geometry_msgs::msg::Point> interpolated_points;
+  std::vector<double> yaws;
+  std::vector<double> curvatures;
+  s.getSplineInterpolatedValues(whole_s_vec, &interpolated_points, &yaws, &curvatures);
+  ASSERT_EQ(interpolated_points.size(), whole_s_vec.size());
+  ASSERT_EQ(yaws.size(), whole_s_vec.size());
+  ASSERT_EQ(curvatures.size(), whole_s_vec.size());
+
+  for (size_t i = 0; i < whole_s_vec.size(); ++i) {
+    const auto ans_point = s.getSplineInterpolatedPoint(0, whole_s_vec.at(i));
+    EXPECT_NEAR(interpolated_points.at(i).x, ans_point.x, epsilon);
+    EXPECT_NEAR(interpolated_points.at(i).y, ans_point.y, epsilon);
+    EXPECT_NEAR(interpolated_points.at(i).z, ans_point.z, epsilon);
+    EXPECT_NEAR(yaws.at(i), s.getSplineInterpolatedYaw(0, whole_s_vec.at(i)), epsilon);
+    EXPECT_NEAR(
+      curvatures.at(i), s.getSplineInterpolatedCurvature(0, whole_s_vec.at(i)), epsilon);
+  }
+
+  // only yaws
+  std::vector<double> only_yaws;
+  s.getSplineInterpolatedValues(whole_s_vec, nullptr, &only_yaws);
+  EXPECT_EQ(only_yaws, yaws);
+
+  // unsorted arc lengths
+  EXPECT_THROW(
+    s.getSplineInterpolatedValues(std::vector<double>{1.0, 0.0}, &interpolated_points),
+    std::invalid_argument);
+}
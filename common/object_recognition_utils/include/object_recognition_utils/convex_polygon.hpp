@@ -0,0 +1,110 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OBJECT_RECOGNITION_UTILS__CONVEX_POLYGON_HPP_
+#define OBJECT_RECOGNITION_UTILS__CONVEX_POLYGON_HPP_
+
+#include "autoware/universe_utils/geometry/boost_geometry.hpp"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace object_recognition_utils
+{
+/**
+ * @brief Convex polygon stored in fixed-capacity arrays, used by the IoU kernels below instead of
+ * the generic boost::geometry union/intersection.
+ * @details The vertices are counter-clockwise and the polygon is not closed, i.e. the first vertex
+ * is not repeated. The capacity covers the boxes (4 vertices), the cylinders (6 vertices) and
+ * small convex footprints.
+ */
+struct ConvexPolygon2d
+{
+  static constexpr size_t max_size = 16;
+
+  std::array<double, max_size> x{};
+  std::array<double, max_size> y{};
+  size_t size{0};
+};
+
+/**
+ * @brief Convert a boost polygon into a ConvexPolygon2d
+ * @return false if the polygon has too many vertices or is not convex, in which case the caller
+ * should fall back to boost::geometry
+ */
+bool toConvexPolygon2d(
+  const autoware::universe_utils::Polygon2d & polygon, ConvexPolygon2d & convex_polygon);
+
+double getConvexPolygonArea(const ConvexPolygon2d & polygon);
+
+/**
+ * @brief Area of the intersection of two convex polygons by Sutherland-Hodgman clipping
+ */
+double getConvexIntersectionArea(
+  const ConvexPolygon2d & polygon1, const ConvexPolygon2d & polygon2);
+
+/**
+ * @brief Area of the convex hull of two convex polygons, which is the convex hull of the union
+ */
+double getConvexHullArea(const ConvexPolygon2d & polygon1, const ConvexPolygon2d & polygon2);
+
+/**
+ * @brief Convex polygons with their areas and bounding boxes in separate arrays, so that the
+ * bounding box rejection of get2dIoUs runs over contiguous memory and can be vectorized
+ */
+class ConvexPolygonBatch
+{
+public:
+  void reserve(const size_t size);
+  void clear();
+
+  /**
+   * @brief Append a polygon. A polygon that cannot be converted is appended as an empty polygon,
+   * whose IoU is 0, so that the indices stay aligned with the input.
+   * @return false if the polygon cannot be converted
+   */
+  bool push_back(const autoware::universe_utils::Polygon2d & polygon);
+
+  size_t size() const { return polygons_.size(); }
+  bool empty() const { return polygons_.empty(); }
+  const ConvexPolygon2d & polygon(const size_t i) const { return polygons_[i]; }
+  const std::vector<double> & areas() const { return areas_; }
+  const std::vector<double> & min_x() const { return min_x_; }
+  const std::vector<double> & max_x() const { return max_x_; }
+  const std::vector<double> & min_y() const { return min_y_; }
+  const std::vector<double> & max_y() const { return max_y_; }
+
+private:
+  void append(const ConvexPolygon2d & polygon);
+
+  std::vector<ConvexPolygon2d> polygons_;
+  std::vector<double> areas_;
+  std::vector<double> min_x_;
+  std::vector<double> max_x_;
+  std::vector<double> min_y_;
+  std::vector<double> max_y_;
+};
+
+/**
+ * @brief IoU of one polygon against many polygons, with the same thresholds as get2dIoU
+ * @details The targets whose bounding box does not overlap the one of the source are rejected
+ * over the whole batch first, and only the remaining ones are clipped.
+ */
+void get2dIoUs(
+  const ConvexPolygon2d & source_polygon, const ConvexPolygonBatch & target_polygons,
+  std::vector<double> & ious, const double min_union_area = 0.01);
+}  // namespace object_recognition_utils
+
+#endif  // OBJECT_RECOGNITION_UTILS__CONVEX_POLYGON_HPP_
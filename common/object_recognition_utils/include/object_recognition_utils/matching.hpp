@@ -17,6 +17,7 @@
 
 #include "autoware/universe_utils/geometry/boost_geometry.hpp"
 #include "autoware/universe_utils/geometry/boost_polygon_utils.hpp"
+#include "object_recognition_utils/convex_polygon.hpp"
 #include "object_recognition_utils/geometry.hpp"
 
 #include <boost/geometry.hpp>
@@ -57,6 +58,22 @@ inline double getIntersectionArea(
   return getSumArea(intersection_polygons);
 }
 
+/**
+ * @brief Same as getIntersectionArea, using the convex polygon kernel when both are convex
+ */
+inline double getConvexAwareIntersectionArea(
+  const Polygon2d & source_polygon, const Polygon2d & target_polygon)
+{
+  ConvexPolygon2d source_convex;
+  ConvexPolygon2d target_convex;
+  if (
+    toConvexPolygon2d(source_polygon, source_convex) &&
+    toConvexPolygon2d(target_polygon, target_convex)) {
+    return getConvexIntersectionArea(source_convex, target_convex);
+  }
+  return getIntersectionArea(source_polygon, target_polygon);
+}
+
 inline double getUnionArea(const Polygon2d & source_polygon, const Polygon2d & target_polygon)
 {
   std::vector<Polygon2d> union_polygons;
@@ -72,15 +89,64 @@ double get2dIoU(const T1 source_object, const T2 target_object, const double min
   const auto target_polygon = autoware::universe_utils::toPolygon2d(target_object);
   if (boost::geometry::area(target_polygon) < MIN_AREA) return 0.0;
 
-  const double intersection_area = getIntersectionArea(source_polygon, target_polygon);
+  // boxes and cylinders are convex and skip the generic boost::geometry operations
+  ConvexPolygon2d source_convex;
+  ConvexPolygon2d target_convex;
+  const bool is_convex = toConvexPolygon2d(source_polygon, source_convex) &&
+                         toConvexPolygon2d(target_polygon, target_convex);
+
+  const double intersection_area = is_convex
+                                     ? getConvexIntersectionArea(source_convex, target_convex)
+                                     : getIntersectionArea(source_polygon, target_polygon);
   if (intersection_area < MIN_AREA) return 0.0;
-  const double union_area = getUnionArea(source_polygon, target_polygon);
+  const double union_area =
+    is_convex ? getConvexPolygonArea(source_convex) + getConvexPolygonArea(target_convex) -
+                  intersection_area
+              : getUnionArea(source_polygon, target_polygon);
 
   const double iou =
     union_area < min_union_area ? 0.0 : std::min(1.0, intersection_area / union_area);
   return iou;
 }
 
+/**
+ * @brief IoU of one object against many objects, same as calling get2dIoU for each of them
+ * @details The convex targets are evaluated as one batch by the convex polygon kernel, and the
+ * others fall back to get2dIoU.
+ */
+template <class T1, class T2>
+std::vector<double> get2dIoUs(
+  const T1 & source_object, const std::vector<T2> & target_objects,
+  const double min_union_area = 0.01)
+{
+  std::vector<double> ious(target_objects.size(), 0.0);
+  const auto source_polygon = autoware::universe_utils::toPolygon2d(source_object);
+  if (boost::geometry::area(source_polygon) < MIN_AREA) return ious;
+
+  ConvexPolygon2d source_convex;
+  if (!toConvexPolygon2d(source_polygon, source_convex)) {
+    for (size_t i = 0; i < target_objects.size(); ++i) {
+      ious.at(i) = get2dIoU(source_object, target_objects.at(i), min_union_area);
+    }
+    return ious;
+  }
+
+  ConvexPolygonBatch target_polygons;
+  target_polygons.reserve(target_objects.size());
+  std::vector<size_t> non_convex_indices;
+  for (size_t i = 0; i < target_objects.size(); ++i) {
+    if (!target_polygons.push_back(autoware::universe_utils::toPolygon2d(target_objects.at(i)))) {
+      non_convex_indices.push_back(i);
+    }
+  }
+
+  get2dIoUs(source_convex, target_polygons, ious, min_union_area);
+  for (const auto i : non_convex_indices) {
+    ious.at(i) = get2dIoU(source_object, target_objects.at(i), min_union_area);
+  }
+  return ious;
+}
+
 template <class T1, class T2>
 double get2dGeneralizedIoU(const T1 & source_object, const T2 & target_object)
 {
@@ -89,9 +155,21 @@ double get2dGeneralizedIoU(const T1 & source_object, const T2 & target_object)
   const auto target_polygon = autoware::universe_utils::toPolygon2d(target_object);
   if (boost::geometry::area(target_polygon) < MIN_AREA) return 0.0;
 
-  const double intersection_area = getIntersectionArea(source_polygon, target_polygon);
-  const double union_area = getUnionArea(source_polygon, target_polygon);
-  const double convex_shape_area = getConvexShapeArea(source_polygon, target_polygon);
+  ConvexPolygon2d source_convex;
+  ConvexPolygon2d target_convex;
+  const bool is_convex = toConvexPolygon2d(source_polygon, source_convex) &&
+                         toConvexPolygon2d(target_polygon, target_convex);
+
+  const double intersection_area = is_convex
+                                     ? getConvexIntersectionArea(source_convex, target_convex)
+                                     : getIntersectionArea(source_polygon, target_polygon);
+  const double union_area =
+    is_convex ? getConvexPolygonArea(source_convex) + getConvexPolygonArea(target_convex) -
+                  intersection_area
+              : getUnionArea(source_polygon, target_polygon);
+  const double convex_shape_area = is_convex
+                                     ? getConvexHullArea(source_convex, target_convex)
+                                     : getConvexShapeArea(source_polygon, target_polygon);
 
   const double iou = union_area < 0.01 ? 0.0 : std::min(1.0, intersection_area / union_area);
   return iou - (convex_shape_area - union_area) / convex_shape_area;
@@ -106,7 +184,7 @@ double get2dPrecision(const T1 source_object, const T2 target_object)
   const auto target_polygon = autoware::universe_utils::toPolygon2d(target_object);
   if (boost::geometry::area(target_polygon) < MIN_AREA) return 0.0;
 
-  const double intersection_area = getIntersectionArea(source_polygon, target_polygon);
+  const double intersection_area = getConvexAwareIntersectionArea(source_polygon, target_polygon);
   if (intersection_area < MIN_AREA) return 0.0;
 
   return std::min(1.0, intersection_area / source_area);
@@ -121,7 +199,7 @@ double get2dRecall(const T1 source_object, const T2 target_object)
   const double target_area = boost::geometry::area(target_polygon);
   if (target_area < MIN_AREA) return 0.0;
 
-  const double intersection_area = getIntersectionArea(source_polygon, target_polygon);
+  const double intersection_area = getConvexAwareIntersectionArea(source_polygon, target_polygon);
   if (intersection_area < MIN_AREA) return 0.0;
 
   return std::min(1.0, intersection_area / target_area);
@@ -0,0 +1,305 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "object_recognition_utils/convex_polygon.hpp"
+
+#include "object_recognition_utils/matching.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace object_recognition_utils
+{
+namespace
+{
+// the intersection of two convex polygons has at most as many vertices as both of them, but one
+// clipping step can add a vertex more than that when the clipped edges are nearly collinear
+constexpr size_t clip_capacity = 2 * ConvexPolygon2d::max_size + 2;
+
+template <size_t N>
+double calcShoelaceArea(
+  const std::array<double, N> & xs, const std::array<double, N> & ys, const size_t size)
+{
+  double area = 0.0;
+  for (size_t i = 0, j = size - 1; i < size; j = i++) {
+    area += xs[j] * ys[i] - xs[i] * ys[j];
+  }
+  return 0.5 * area;
+}
+}  // namespace
+
+bool toConvexPolygon2d(
+  const autoware::universe_utils::Polygon2d & polygon, ConvexPolygon2d & convex_polygon)
+{
+  const auto & ring = polygon.outer();
+  size_t size = ring.size();
+  // drop the closing point
+  if (size > 1 && ring.front().x() == ring.back().x() && ring.front().y() == ring.back().y()) {
+    --size;
+  }
+  if (size < 3 || size > ConvexPolygon2d::max_size) {
+    return false;
+  }
+
+  for (size_t i = 0; i < size; ++i) {
+    convex_polygon.x[i] = ring[i].x();
+    convex_polygon.y[i] = ring[i].y();
+  }
+  convex_polygon.size = size;
+
+  // boost polygons are clockwise by default
+  if (calcShoelaceArea(convex_polygon.x, convex_polygon.y, size) < 0.0) {
+    std::reverse(convex_polygon.x.begin(), convex_polygon.x.begin() + size);
+    std::reverse(convex_polygon.y.begin(), convex_polygon.y.begin() + size);
+  }
+
+  // every turn has to be to the left, allowing collinear and duplicated vertices
+  for (size_t i = 0; i < size; ++i) {
+    const size_t prev = (i + size - 1) % size;
+    const size_t next = (i + 1) % size;
+    const double dx1 = convex_polygon.x[i] - convex_polygon.x[prev];
+    const double dy1 = convex_polygon.y[i] - convex_polygon.y[prev];
+    const double dx2 = convex_polygon.x[next] - convex_polygon.x[i];
+    const double dy2 = convex_polygon.y[next] - convex_polygon.y[i];
+    const double cross = dx1 * dy2 - dy1 * dx2;
+    const double tolerance = 1e-9 * std::hypot(dx1, dy1) * std::hypot(dx2, dy2);
+    if (cross < -tolerance) {
+      return false;
+    }
+  }
+  return true;
+}
+
+double getConvexPolygonArea(const ConvexPolygon2d & polygon)
+{
+  if (polygon.size < 3) {
+    return 0.0;
+  }
+  return calcShoelaceArea(polygon.x, polygon.y, polygon.size);
+}
+
+double getConvexIntersectionArea(
+  const ConvexPolygon2d & polygon1, const ConvexPolygon2d & polygon2)
+{
+  if (polygon1.size < 3 || polygon2.size < 3) {
+    return 0.0;
+  }
+
+  std::array<double, clip_capacity> in_x{};
+  std::array<double, clip_capacity> in_y{};
+  std::array<double, clip_capacity> out_x{};
+  std::array<double, clip_capacity> out_y{};
+  std::copy(polygon1.x.begin(), polygon1.x.begin() + polygon1.size, in_x.begin());
+  std::copy(polygon1.y.begin(), polygon1.y.begin() + polygon1.size, in_y.begin());
+  size_t in_size = polygon1.size;
+
+  // clip polygon1 by the half plane on the left of each edge of polygon2
+  for (size_t j = 0; j < polygon2.size; ++j) {
+    const size_t j_next = (j + 1) % polygon2.size;
+    const double edge_x = polygon2.x[j];
+    const double edge_y = polygon2.y[j];
+    const double edge_dx = polygon2.x[j_next] - edge_x;
+    const double edge_dy = polygon2.y[j_next] - edge_y;
+
+    size_t out_size = 0;
+    const auto push = [&](const double x, const double y) {
+      if (out_size < clip_capacity) {
+        out_x[out_size] = x;
+        out_y[out_size] = y;
+        ++out_size;
+      }
+    };
+
+    size_t prev = in_size - 1;
+    double prev_side = edge_dx * (in_y[prev] - edge_y) - edge_dy * (in_x[prev] - edge_x);
+    for (size_t i = 0; i < in_size; prev = i++) {
+      const double side = edge_dx * (in_y[i] - edge_y) - edge_dy * (in_x[i] - edge_x);
+      if ((side >= 0.0) != (prev_side >= 0.0)) {
+        const double t = prev_side / (prev_side - side);
+        push(in_x[prev] + t * (in_x[i] - in_x[prev]), in_y[prev] + t * (in_y[i] - in_y[prev]));
+      }
+      if (side >= 0.0) {
+        push(in_x[i], in_y[i]);
+      }
+      prev_side = side;
+    }
+
+    if (out_size < 3) {
+      return 0.0;
+    }
+    std::swap(in_x, out_x);
+    std::swap(in_y, out_y);
+    in_size = out_size;
+  }
+
+  return std::max(0.0, calcShoelaceArea(in_x, in_y, in_size));
+}
+
+double getConvexHullArea(const ConvexPolygon2d & polygon1, const ConvexPolygon2d & polygon2)
+{
+  constexpr size_t max_points = 2 * ConvexPolygon2d::max_size;
+  std::array<std::pair<double, double>, max_points> points{};
+  size_t num_points = 0;
+  for (const auto * polygon : {&polygon1, &polygon2}) {
+    for (size_t i = 0; i < polygon->size; ++i) {
+      points[num_points++] = {polygon->x[i], polygon->y[i]};
+    }
+  }
+  if (num_points < 3) {
+    return 0.0;
+  }
+  std::sort(points.begin(), points.begin() + num_points);
+
+  // Andrew's monotone chain
+  std::array<double, 2 * max_points> hull_x{};
+  std::array<double, 2 * max_points> hull_y{};
+  size_t hull_size = 0;
+  const auto turns_left = [&](const double x, const double y) {
+    const double ax = hull_x[hull_size - 1] - hull_x[hull_size - 2];
+    const double ay = hull_y[hull_size - 1] - hull_y[hull_size - 2];
+    return ax * (y - hull_y[hull_size - 2]) - ay * (x - hull_x[hull_size - 2]) > 0.0;
+  };
+  const auto add_point = [&](const size_t lower_size, const std::pair<double, double> & point) {
+    while (hull_size >= lower_size + 2 && !turns_left(point.first, point.second)) {
+      --hull_size;
+    }
+    hull_x[hull_size] = point.first;
+    hull_y[hull_size] = point.second;
+    ++hull_size;
+  };
+  for (size_t i = 0; i < num_points; ++i) {
+    add_point(0, points[i]);
+  }
+  const size_t lower_size = hull_size - 1;
+  for (size_t i = num_points - 1; i-- > 0;) {
+    add_point(lower_size, points[i]);
+  }
+  // the last point is the first one again
+  --hull_size;
+  if (hull_size < 3) {
+    return 0.0;
+  }
+  return calcShoelaceArea(hull_x, hull_y, hull_size);
+}
+
+void ConvexPolygonBatch::reserve(const size_t size)
+{
+  polygons_.reserve(size);
+  areas_.reserve(size);
+  min_x_.reserve(size);
+  max_x_.reserve(size);
+  min_y_.reserve(size);
+  max_y_.reserve(size);
+}
+
+void ConvexPolygonBatch::clear()
+{
+  polygons_.clear();
+  areas_.clear();
+  min_x_.clear();
+  max_x_.clear();
+  min_y_.clear();
+  max_y_.clear();
+}
+
+bool ConvexPolygonBatch::push_back(const autoware::universe_utils::Polygon2d & polygon)
+{
+  ConvexPolygon2d convex_polygon;
+  const bool is_converted = toConvexPolygon2d(polygon, convex_polygon);
+  if (!is_converted) {
+    convex_polygon.size = 0;
+  }
+  append(convex_polygon);
+  return is_converted;
+}
+
+void ConvexPolygonBatch::append(const ConvexPolygon2d & polygon)
+{
+  polygons_.push_back(polygon);
+  areas_.push_back(getConvexPolygonArea(polygon));
+  if (polygon.size == 0) {
+    // NaN bounds never overlap, so that the empty polygon is rejected with the others
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    min_x_.push_back(nan);
+    max_x_.push_back(nan);
+    min_y_.push_back(nan);
+    max_y_.push_back(nan);
+    return;
+  }
+  const auto x_end = polygon.x.begin() + polygon.size;
+  const auto y_end = polygon.y.begin() + polygon.size;
+  const auto [min_x, max_x] = std::minmax_element(polygon.x.begin(), x_end);
+  const auto [min_y, max_y] = std::minmax_element(polygon.y.begin(), y_end);
+  min_x_.push_back(*min_x);
+  max_x_.push_back(*max_x);
+  min_y_.push_back(*min_y);
+  max_y_.push_back(*max_y);
+}
+
+void get2dIoUs(
+  const ConvexPolygon2d & source_polygon, const ConvexPolygonBatch & target_polygons,
+  std::vector<double> & ious, const double min_union_area)
+{
+  const size_t num_targets = target_polygons.size();
+  ious.assign(num_targets, 0.0);
+
+  const double source_area = getConvexPolygonArea(source_polygon);
+  if (source_area < MIN_AREA) {
+    return;
+  }
+  const auto x_end = source_polygon.x.begin() + source_polygon.size;
+  const auto y_end = source_polygon.y.begin() + source_polygon.size;
+  const double source_min_x = *std::min_element(source_polygon.x.begin(), x_end);
+  const double source_max_x = *std::max_element(source_polygon.x.begin(), x_end);
+  const double source_min_y = *std::min_element(source_polygon.y.begin(), y_end);
+  const double source_max_y = *std::max_element(source_polygon.y.begin(), y_end);
+
+  // bounding box rejection over the whole batch, branchless so that it is vectorized. ious is
+  // used as the mask of the targets to be clipped.
+  const double * min_x = target_polygons.min_x().data();
+  const double * max_x = target_polygons.max_x().data();
+  const double * min_y = target_polygons.min_y().data();
+  const double * max_y = target_polygons.max_y().data();
+  double * mask = ious.data();
+  for (size_t i = 0; i < num_targets; ++i) {
+    const bool overlaps = (min_x[i] <= source_max_x) & (max_x[i] >= source_min_x) &
+                          (min_y[i] <= source_max_y) & (max_y[i] >= source_min_y);
+    mask[i] = static_cast<double>(overlaps);
+  }
+
+  for (size_t i = 0; i < num_targets; ++i) {
+    if (mask[i] == 0.0) {
+      continue;
+    }
+    mask[i] = 0.0;
+
+    const double target_area = target_polygons.areas()[i];
+    if (target_area < MIN_AREA) {
+      continue;
+    }
+    const double intersection_area =
+      getConvexIntersectionArea(source_polygon, target_polygons.polygon(i));
+    if (intersection_area < MIN_AREA) {
+      continue;
+    }
+    const double union_area = source_area + target_area - intersection_area;
+    if (union_area < min_union_area) {
+      continue;
+    }
+    ious[i] = std::min(1.0, intersection_area / union_area);
+  }
+}
+}  // namespace object_recognition_utils
@@ -0,0 +1,219 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/universe_utils/geometry/geometry.hpp"
+#include "autoware/universe_utils/system/stop_watch.hpp"
+#include "object_recognition_utils/convex_polygon.hpp"
+#include "object_recognition_utils/matching.hpp"
+
+#include <autoware_perception_msgs/msg/detected_object.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+using autoware::universe_utils::Polygon2d;
+using autoware_perception_msgs::msg::DetectedObject;
+
+namespace
+{
+constexpr double epsilon = 1e-05;
+
+DetectedObject createObject(
+  const double x, const double y, const double yaw, const double length, const double width,
+  const uint8_t shape_type)
+{
+  DetectedObject object;
+  object.kinematics.pose_with_covariance.pose.position.x = x;
+  object.kinematics.pose_with_covariance.pose.position.y = y;
+  object.kinematics.pose_with_covariance.pose.orientation =
+    autoware::universe_utils::createQuaternionFromYaw(yaw);
+  object.shape.type = shape_type;
+  object.shape.dimensions.x = length;
+  object.shape.dimensions.y = width;
+  return object;
+}
+
+std::vector<DetectedObject> createRandomObjects(const size_t num_objects, const double range)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position(-range, range);
+  std::uniform_real_distribution<double> yaw(-M_PI, M_PI);
+  std::uniform_real_distribution<double> size(0.5, 5.0);
+
+  std::vector<DetectedObject> objects;
+  for (size_t i = 0; i < num_objects; ++i) {
+    const auto shape_type = i % 3 == 0 ? autoware_perception_msgs::msg::Shape::CYLINDER
+                                       : autoware_perception_msgs::msg::Shape::BOUNDING_BOX;
+    objects.push_back(createObject(
+      position(engine), position(engine), yaw(engine), size(engine), size(engine), shape_type));
+  }
+  return objects;
+}
+
+// IoUs of the source object with each target object, computed with boost::geometry
+std::vector<double> get2dIoUsWithBoost(
+  const DetectedObject & source_object, const std::vector<DetectedObject> & target_objects)
+{
+  const auto source_polygon = autoware::universe_utils::toPolygon2d(source_object);
+  std::vector<double> ious;
+  ious.reserve(target_objects.size());
+  for (const auto & target_object : target_objects) {
+    const auto target_polygon = autoware::universe_utils::toPolygon2d(target_object);
+    const double intersection_area =
+      object_recognition_utils::getIntersectionArea(source_polygon, target_polygon);
+    const double union_area =
+      object_recognition_utils::getUnionArea(source_polygon, target_polygon);
+    ious.push_back(
+      intersection_area < object_recognition_utils::MIN_AREA || union_area < 0.01
+        ? 0.0
+        : std::min(1.0, intersection_area / union_area));
+  }
+  return ious;
+}
+}  // namespace
+
+TEST(convex_polygon, toConvexPolygon2d)
+{
+  using object_recognition_utils::ConvexPolygon2d;
+  using object_recognition_utils::getConvexPolygonArea;
+  using object_recognition_utils::toConvexPolygon2d;
+
+  {  // clockwise box
+    Polygon2d polygon;
+    polygon.outer() = {{0.0, 0.0}, {0.0, 1.0}, {2.0, 1.0}, {2.0, 0.0}, {0.0, 0.0}};
+    ConvexPolygon2d convex_polygon;
+    ASSERT_TRUE(toConvexPolygon2d(polygon, convex_polygon));
+    EXPECT_EQ(convex_polygon.size, 4u);
+    EXPECT_DOUBLE_EQ(getConvexPolygonArea(convex_polygon), 2.0);
+  }
+
+  {  // non convex
+    Polygon2d polygon;
+    polygon.outer() = {{0.0, 0.0}, {0.0, 2.0}, {1.0, 1.0}, {2.0, 2.0}, {2.0, 0.0}, {0.0, 0.0}};
+    ConvexPolygon2d convex_polygon;
+    EXPECT_FALSE(toConvexPolygon2d(polygon, convex_polygon));
+  }
+
+  {  // too many vertices
+    Polygon2d polygon;
+    for (size_t i = 0; i <= ConvexPolygon2d::max_size; ++i) {
+      const double angle = -2.0 * M_PI * i / (ConvexPolygon2d::max_size + 1);
+      polygon.outer().emplace_back(std::cos(angle), std::sin(angle));
+    }
+    ConvexPolygon2d convex_polygon;
+    EXPECT_FALSE(toConvexPolygon2d(polygon, convex_polygon));
+  }
+}
+
+TEST(convex_polygon, matchBoostGeometry)
+{
+  using object_recognition_utils::ConvexPolygon2d;
+  using object_recognition_utils::toConvexPolygon2d;
+
+  const auto objects = createRandomObjects(1000, 3.0);
+  for (size_t i = 0; i + 1 < objects.size(); i += 2) {
+    const auto polygon1 = autoware::universe_utils::toPolygon2d(objects.at(i));
+    const auto polygon2 = autoware::universe_utils::toPolygon2d(objects.at(i + 1));
+    ConvexPolygon2d convex_polygon1;
+    ConvexPolygon2d convex_polygon2;
+    ASSERT_TRUE(toConvexPolygon2d(polygon1, convex_polygon1));
+    ASSERT_TRUE(toConvexPolygon2d(polygon2, convex_polygon2));
+
+    EXPECT_NEAR(
+      object_recognition_utils::getConvexPolygonArea(convex_polygon1),
+      boost::geometry::area(polygon1), epsilon);
+    EXPECT_NEAR(
+      object_recognition_utils::getConvexIntersectionArea(convex_polygon1, convex_polygon2),
+      object_recognition_utils::getIntersectionArea(polygon1, polygon2), epsilon);
+    EXPECT_NEAR(
+      object_recognition_utils::getConvexHullArea(convex_polygon1, convex_polygon2),
+      object_recognition_utils::getConvexShapeArea(polygon1, polygon2), epsilon);
+  }
+}
+
+TEST(convex_polygon, get2dIoUs)
+{
+  using object_recognition_utils::get2dIoU;
+  using object_recognition_utils::get2dIoUs;
+
+  auto objects = createRandomObjects(200, 10.0);
+  // a non convex footprint falls back to boost::geometry
+  auto & non_convex_object = objects.at(1);
+  non_convex_object.shape.type = autoware_perception_msgs::msg::Shape::POLYGON;
+  non_convex_object.shape.footprint.points.resize(5);
+  const std::vector<std::pair<double, double>> footprint = {
+    {-1.0, -1.0}, {-1.0, 1.0}, {0.0, 0.0}, {1.0, 1.0}, {1.0, -1.0}};
+  for (size_t i = 0; i < footprint.size(); ++i) {
+    non_convex_object.shape.footprint.points.at(i).x = footprint.at(i).first;
+    non_convex_object.shape.footprint.points.at(i).y = footprint.at(i).second;
+  }
+  non_convex_object.kinematics.pose_with_covariance.pose =
+    objects.at(0).kinematics.pose_with_covariance.pose;
+
+  const auto ious = get2dIoUs(objects.at(0), objects, 0.01);
+  ASSERT_EQ(ious.size(), objects.size());
+  EXPECT_NEAR(ious.at(0), 1.0, epsilon);
+  EXPECT_GT(ious.at(1), 0.0);
+  for (size_t i = 0; i < objects.size(); ++i) {
+    EXPECT_NEAR(ious.at(i), get2dIoU(objects.at(0), objects.at(i), 0.01), epsilon);
+  }
+
+  EXPECT_TRUE(get2dIoUs(objects.at(0), std::vector<DetectedObject>{}).empty());
+}
+
+TEST(convex_polygon, get2dIoUsRand)
+{
+  const auto objects = createRandomObjects(100, 20.0);
+  for (const auto & source_object : objects) {
+    const auto ground_truth = get2dIoUsWithBoost(source_object, objects);
+    const auto ious = object_recognition_utils::get2dIoUs(source_object, objects);
+    ASSERT_EQ(ious.size(), ground_truth.size());
+    for (size_t i = 0; i < objects.size(); ++i) {
+      EXPECT_NEAR(ious.at(i), ground_truth.at(i), epsilon);
+    }
+  }
+}
+
+TEST(convex_polygon, DISABLED_get2dIoUsBenchmark)
+{
+  constexpr size_t objects_nb = 500;
+  const auto objects = createRandomObjects(objects_nb, 50.0);
+
+  autoware::universe_utils::StopWatch<std::chrono::nanoseconds, std::chrono::nanoseconds> sw;
+  double boost_ns = 0.0;
+  double batch_ns = 0.0;
+  for (const auto & source_object : objects) {
+    sw.tic();
+    const auto ground_truth = get2dIoUsWithBoost(source_object, objects);
+    boost_ns += sw.toc();
+
+    sw.tic();
+    const auto ious = object_recognition_utils::get2dIoUs(source_object, objects);
+    batch_ns += sw.toc();
+
+    for (size_t i = 0; i < objects.size(); ++i) {
+      EXPECT_NEAR(ious.at(i), ground_truth.at(i), epsilon);
+    }
+  }
+  std::printf("objects_nb = %zu\n", objects_nb);
+  std::printf(
+    "\tIoU:\n\t\tBoost::geometry = %2.2f ms\n\t\tBatch = %2.2f ms\n", boost_ns / 1e6,
+    batch_ns / 1e6);
+}
@@ -20,8 +20,11 @@
 #include <proxsuite/helpers/optional.hpp>
 #include <proxsuite/proxqp/sparse/sparse.hpp>
 
+#include <Eigen/Sparse>
+
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -34,6 +37,18 @@ public:
     const bool enable_warm_start, const int max_iteration, const double eps_abs,
     const double eps_rel, const bool verbose = false);
 
+  /// \brief Solve the problem defined with sparse matrices.
+  /// \details When the warm start is enabled and the problem size does not change, the problem is
+  /// updated in place instead of being set up again. In that case the sparsity pattern of P and A
+  /// must be the same as the previous one, so explicit zeros should be kept in the matrices.
+  std::vector<double> optimize(
+    const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+    const std::vector<double> & q, const std::vector<double> & l, const std::vector<double> & u);
+
+  /// \brief Set the initial guess of the primal variables used by the next optimization only.
+  /// \details The guess is ignored if its size does not match the number of variables.
+  void setPrimalVariables(const std::vector<double> & primal_variables);
+
   int getIterationNumber() const override;
   bool isSolved() const override;
   std::string getStatus() const override;
@@ -45,11 +60,16 @@ public:
 private:
   proxsuite::proxqp::Settings<double> settings_{};
   std::shared_ptr<proxsuite::proxqp::sparse::QP<double, int>> qp_ptr_{nullptr};
+  std::optional<std::vector<double>> initial_primal_guess_{std::nullopt};
 
   void initializeProblemImpl(
     const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
     const std::vector<double> & l, const std::vector<double> & u) override;
 
+  void initializeSparseProblemImpl(
+    const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+    const std::vector<double> & q, const std::vector<double> & l, const std::vector<double> & u);
+
   std::vector<double> optimizeImpl() override;
 };
 }  // namespace autoware::common
@@ -14,6 +14,11 @@
 
 #include "qp_interface/proxqp_interface.hpp"
 
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 namespace autoware::common
 {
 using proxsuite::proxqp::QPSolverOutput;
@@ -32,6 +37,15 @@ ProxQPInterface::ProxQPInterface(
 void ProxQPInterface::initializeProblemImpl(
   const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<double> & q,
   const std::vector<double> & l, const std::vector<double> & u)
+{
+  const Eigen::SparseMatrix<double> P_sparse = P.sparseView();
+  const Eigen::SparseMatrix<double> A_sparse = A.sparseView();
+  initializeSparseProblemImpl(P_sparse, A_sparse, q, l, u);
+}
+
+void ProxQPInterface::initializeSparseProblemImpl(
+  const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+  const std::vector<double> & q, const std::vector<double> & l, const std::vector<double> & u)
 {
   const size_t variables_num = q.size();
   const size_t constraints_num = l.size();
@@ -58,32 +72,56 @@ void ProxQPInterface::initializeProblemImpl(
   settings_.initial_guess =
     enable_warm_start ? proxsuite::proxqp::InitialGuessStatus::WARM_START_WITH_PREVIOUS_RESULT
                       : proxsuite::proxqp::InitialGuessStatus::NO_INITIAL_GUESS;
+  if (initial_primal_guess_ && initial_primal_guess_->size() == variables_num) {
+    settings_.initial_guess = proxsuite::proxqp::InitialGuessStatus::WARM_START;
+  }
 
   qp_ptr_->settings = settings_;
 
-  Eigen::SparseMatrix<double> P_sparse(variables_num, constraints_num);
-  P_sparse = P.sparseView();
-
-  // NOTE: const std vector cannot be converted to eigen vector
-  std::vector<double> non_const_q = q;
-  Eigen::VectorXd eigen_q =
-    Eigen::Map<Eigen::VectorXd, Eigen::Unaligned>(non_const_q.data(), non_const_q.size());
-  std::vector<double> l_std_vec = l;
-  Eigen::VectorXd eigen_l =
-    Eigen::Map<Eigen::VectorXd, Eigen::Unaligned>(l_std_vec.data(), l_std_vec.size());
-  std::vector<double> u_std_vec = u;
-  Eigen::VectorXd eigen_u =
-    Eigen::Map<Eigen::VectorXd, Eigen::Unaligned>(u_std_vec.data(), u_std_vec.size());
+  const Eigen::Map<const Eigen::VectorXd> eigen_q(q.data(), q.size());
+  const Eigen::Map<const Eigen::VectorXd> eigen_l(l.data(), l.size());
+  const Eigen::Map<const Eigen::VectorXd> eigen_u(u.data(), u.size());
 
   if (enable_warm_start) {
+    constexpr bool update_preconditioner = true;
     qp_ptr_->update(
-      P_sparse, eigen_q, proxsuite::nullopt, proxsuite::nullopt, A.sparseView(), eigen_l, eigen_u);
+      P, eigen_q, proxsuite::nullopt, proxsuite::nullopt, A, eigen_l, eigen_u,
+      update_preconditioner);
   } else {
-    qp_ptr_->init(
-      P_sparse, eigen_q, proxsuite::nullopt, proxsuite::nullopt, A.sparseView(), eigen_l, eigen_u);
+    qp_ptr_->init(P, eigen_q, proxsuite::nullopt, proxsuite::nullopt, A, eigen_l, eigen_u);
   }
 }
 
+std::vector<double> ProxQPInterface::optimize(
+  const Eigen::SparseMatrix<double> & P, const Eigen::SparseMatrix<double> & A,
+  const std::vector<double> & q, const std::vector<double> & l, const std::vector<double> & u)
+{
+  // check if arguments are valid
+  std::stringstream ss;
+  if (P.rows() != P.cols() || P.rows() != static_cast<int>(q.size()) || P.rows() != A.cols()) {
+    ss << "Invalid size of P or A. P.rows() = " << P.rows() << ", P.cols() = " << P.cols()
+       << ", A.cols() = " << A.cols() << ", q.size() = " << q.size();
+    throw std::invalid_argument(ss.str());
+  }
+  if (A.rows() != static_cast<int>(l.size()) || A.rows() != static_cast<int>(u.size())) {
+    ss << "Invalid size of A, l or u. A.rows() = " << A.rows() << ", l.size() = " << l.size()
+       << ", u.size() = " << u.size();
+    throw std::invalid_argument(ss.str());
+  }
+
+  initializeSparseProblemImpl(P, A, q, l, u);
+
+  variables_num_ = q.size();
+  constraints_num_ = l.size();
+
+  return optimizeImpl();
+}
+
+void ProxQPInterface::setPrimalVariables(const std::vector<double> & primal_variables)
+{
+  initial_primal_guess_ = primal_variables;
+}
+
 void ProxQPInterface::updateEpsAbs(const double eps_abs)
 {
   settings_.eps_abs = eps_abs;
@@ -142,7 +180,14 @@ std::string ProxQPInterface::getStatus() const
 
 std::vector<double> ProxQPInterface::optimizeImpl()
 {
-  qp_ptr_->solve();
+  if (settings_.initial_guess == proxsuite::proxqp::InitialGuessStatus::WARM_START) {
+    const Eigen::Map<const Eigen::VectorXd> x_guess(
+      initial_primal_guess_->data(), initial_primal_guess_->size());
+    qp_ptr_->solve(x_guess, proxsuite::nullopt, proxsuite::nullopt);
+  } else {
+    qp_ptr_->solve();
+  }
+  initial_primal_guess_ = std::nullopt;
 
   std::vector<double> result;
   for (Eigen::Index i = 0; i < qp_ptr_->results.x.size(); ++i) {
@@ -16,6 +16,7 @@
 #include "qp_interface/proxqp_interface.hpp"
 
 #include <Eigen/Core>
+#include <Eigen/Sparse>
 
 #include <tuple>
 #include <vector>
@@ -80,4 +81,49 @@ TEST(TestProxqpInterface, BasicQp)
     }
   }
 }
+
+TEST(TestProxqpInterface, SparseQp)
+{
+  auto check_result = [](const auto & solution, const std::string & status) {
+    EXPECT_EQ(status, "PROXQP_SOLVED");
+
+    static const auto ep = 1.0e-8;
+    ASSERT_EQ(solution.size(), size_t(2));
+    EXPECT_NEAR(solution[0], 0.3, ep);
+    EXPECT_NEAR(solution[1], 0.7, ep);
+  };
+
+  const Eigen::MatrixXd P_dense = (Eigen::MatrixXd(2, 2) << 4, 1, 1, 2).finished();
+  const Eigen::MatrixXd A_dense = (Eigen::MatrixXd(4, 2) << 1, 1, 1, 0, 0, 1, 0, 1).finished();
+  const Eigen::SparseMatrix<double> P = P_dense.sparseView();
+  const Eigen::SparseMatrix<double> A = A_dense.sparseView();
+  const std::vector<double> q = {1.0, 1.0};
+  const std::vector<double> l = {1.0, 0.0, 0.0, -std::numeric_limits<double>::max()};
+  const std::vector<double> u = {1.0, 0.7, 0.7, std::numeric_limits<double>::max()};
+
+  {
+    autoware::common::ProxQPInterface proxqp(false, 4000, 1e-9, 1e-9, false);
+    const auto solution = proxqp.optimize(P, A, q, l, u);
+    check_result(solution, proxqp.getStatus());
+  }
+
+  {
+    // update the problem in place and start from the given initial guess
+    autoware::common::ProxQPInterface proxqp(true, 4000, 1e-9, 1e-9, false);
+    const auto first_solution = proxqp.optimize(P, A, q, l, u);
+    check_result(first_solution, proxqp.getStatus());
+
+    proxqp.setPrimalVariables({0.3, 0.7});
+    const auto solution = proxqp.optimize(P, A, q, l, u);
+    check_result(solution, proxqp.getStatus());
+  }
+
+  {
+    // an initial guess of a wrong size is ignored
+    autoware::common::ProxQPInterface proxqp(false, 4000, 1e-9, 1e-9, false);
+    proxqp.setPrimalVariables({0.3, 0.7, 0.0});
+    const auto solution = proxqp.optimize(P, A, q, l, u);
+    check_result(solution, proxqp.getStatus());
+  }
+}
 }  // namespace
@@ -348,6 +348,13 @@ public:
    */
   void onPointCloud(const PointCloud2::ConstSharedPtr input_msg);
 
+  /**
+   * @brief Keep the raw point cloud and its transform to base_link for the fast path, which
+   * filters the points only after cropping them with the ego path
+   * @param input_msg Shared pointer to the point cloud message
+   */
+  void onPointCloudFastPath(const PointCloud2::ConstSharedPtr input_msg);
+
   /**
    * @brief Callback for IMU messages
    * @param input_msg Shared pointer to the IMU message
@@ -430,6 +437,35 @@ public:
     std::vector<ObjectData> & objects,
     const pcl::PointCloud<pcl::PointXYZ>::Ptr obstacle_points_ptr);
 
+  /**
+   * @brief Create object data using the raw point cloud. The points are cropped with the expanded
+   * ego path before any other processing, clustered on a hash grid, and hulls are only built for
+   * the clusters closest along the path
+   * @param ego_path Ego vehicle path
+   * @param ego_polys Polygons representing the ego vehicle footprint
+   * @param expanded_ego_polys Polygons of the ego vehicle footprint with the extra margin
+   * @param stamp Timestamp of the data
+   * @param objects Vector to store the created object data
+   * @param filtered_objects Pointer to store the cropped point cloud of obstacles
+   */
+  void createObjectDataUsingPointCloudFastPath(
+    const Path & ego_path, const std::vector<Polygon2d> & ego_polys,
+    const std::vector<Polygon2d> & expanded_ego_polys, const rclcpp::Time & stamp,
+    std::vector<ObjectData> & objects, const pcl::PointCloud<pcl::PointXYZ>::Ptr filtered_objects);
+
+  /**
+   * @brief Create object data for the points inside the ego vehicle footprint
+   * @param ego_path Ego vehicle path
+   * @param ego_polys Polygons representing the ego vehicle footprint
+   * @param stamp Timestamp of the data
+   * @param points Candidate points, usually the vertices of the cluster hulls
+   * @param objects Vector to store the created object data
+   * @return True if any object data was created, false otherwise
+   */
+  bool createObjectDataUsingPointsInsideEgoPath(
+    const Path & ego_path, const std::vector<Polygon2d> & ego_polys, const rclcpp::Time & stamp,
+    const PointCloud & points, std::vector<ObjectData> & objects);
+
   /**
    * @brief Create object data using predicted objects
    * @param ego_path Ego vehicle path
@@ -493,6 +529,8 @@ public:
 
   // Member variables
   PointCloud2::SharedPtr obstacle_ros_pointcloud_ptr_{nullptr};
+  PointCloud2::ConstSharedPtr raw_pointcloud_ptr_{nullptr};
+  std::optional<Eigen::Matrix4f> raw_pointcloud_transform_{std::nullopt};
   VelocityReport::ConstSharedPtr current_velocity_ptr_{nullptr};
   Vector3::SharedPtr angular_velocity_ptr_{nullptr};
   Trajectory::ConstSharedPtr predicted_traj_ptr_{nullptr};
@@ -514,6 +552,7 @@ public:
   bool use_predicted_trajectory_;
   bool use_imu_path_;
   bool use_pointcloud_data_;
+  bool use_pointcloud_fast_path_;
   bool use_predicted_object_data_;
   bool use_object_velocity_calculation_;
   bool check_autoware_state_;
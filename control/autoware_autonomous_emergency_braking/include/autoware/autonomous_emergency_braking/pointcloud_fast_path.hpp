@@ -0,0 +1,150 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__AUTONOMOUS_EMERGENCY_BRAKING__POINTCLOUD_FAST_PATH_HPP_
+#define AUTOWARE__AUTONOMOUS_EMERGENCY_BRAKING__POINTCLOUD_FAST_PATH_HPP_
+
+#include <autoware/universe_utils/geometry/boost_geometry.hpp>
+
+#include <geometry_msgs/msg/pose.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <Eigen/Core>
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace autoware::motion::control::autonomous_emergency_braking::fast_path
+{
+using autoware::universe_utils::Box2d;
+using autoware::universe_utils::Polygon2d;
+using sensor_msgs::msg::PointCloud2;
+using PointCloud = pcl::PointCloud<pcl::PointXYZ>;
+
+struct CropParam
+{
+  double min_height{};
+  double max_height{};
+  double voxel_grid_x{};
+  double voxel_grid_y{};
+  double voxel_grid_z{};
+};
+
+struct ClusterParam
+{
+  double cluster_tolerance{};
+  int minimum_cluster_size{};
+  int maximum_cluster_size{};
+};
+
+/**
+ * @brief Check if the point cloud has float32 x, y and z fields that can be read in place
+ * @param msg the point cloud message
+ */
+bool hasXYZFloatFields(const PointCloud2 & msg);
+
+/**
+ * @brief Crop the raw point cloud buffer to the height range and the convex corridor of the ego
+ * path, then downsample the remaining points to one centroid per voxel. Points are read directly
+ * from the message data, so the cost of the points outside of the corridor is a single read.
+ * @param msg the point cloud message, which must satisfy hasXYZFloatFields()
+ * @param transform transform to base_link applied to each point, or nullopt if msg is in base_link
+ * @param corridor convex polygon covering the ego path footprint
+ * @param param height range and voxel size
+ * @param output the cropped and downsampled points, overwritten
+ */
+void cropPointCloud(
+  const PointCloud2 & msg, const std::optional<Eigen::Matrix4f> & transform,
+  const Polygon2d & corridor, const CropParam & param, PointCloud & output);
+
+/**
+ * @brief Euclidean clustering as connected components over a hash grid with the cell size of the
+ * cluster tolerance. Two points are connected if their distance is at most the tolerance, so the
+ * partition is the same as the one of pcl::EuclideanClusterExtraction.
+ * @param points the points to cluster
+ * @param param cluster tolerance and size limits
+ * @return point indices of the clusters within the size limits
+ */
+std::vector<std::vector<size_t>> clusterPoints(
+  const PointCloud & points, const ClusterParam & param);
+
+/**
+ * @brief Calculate the axis-aligned bounding box of each polygon. The boxes only depend on the ego
+ * footprint polygons, so they are calculated once per cycle and shared by all the clusters.
+ * @param polygons ego footprint polygons
+ * @return the bounding box of each polygon
+ */
+std::vector<Box2d> calcEnvelopes(const std::vector<Polygon2d> & polygons);
+
+/**
+ * @brief Get the index of the first polygon that contains any point of the cluster. Since the
+ * ego footprint polygons are ordered along the path, clusters can be ranked by this index before
+ * building any hull.
+ * @param points the clustered points
+ * @param cluster point indices of the cluster
+ * @param polygons ego footprint polygons, ordered along the path
+ * @param envelopes bounding boxes of the polygons from calcEnvelopes()
+ * @return the polygon index, or polygons.size() if no point is inside any polygon
+ */
+size_t findFirstContainingPolygon(
+  const PointCloud & points, const std::vector<size_t> & cluster,
+  const std::vector<Polygon2d> & polygons, const std::vector<Box2d> & envelopes);
+
+/**
+ * @brief Calculate the 2d convex hull of a cluster with the monotone chain algorithm
+ * @param points the clustered points
+ * @param cluster point indices of the cluster
+ * @return point indices of the hull vertices in counter-clockwise order
+ */
+std::vector<size_t> calcConvexHull2d(
+  const PointCloud & points, const std::vector<size_t> & cluster);
+
+/**
+ * @brief Calculate a lower bound of the distance to an object inside each ego footprint polygon.
+ * The polygon i spans the path points i and i+1, so the arc length of its points is at least the
+ * one of the path point i minus the vehicle length, which also covers the rear overhang and the
+ * projection of the polygon corners on a curved path.
+ * @param path the ego path
+ * @param vehicle_length length of the vehicle
+ * @param max_longitudinal_offset distance from base_link to the front of the vehicle
+ * @return the lower bound for each path point, so also for each polygon starting at that point
+ */
+std::vector<double> calcDistanceLowerBounds(
+  const std::vector<geometry_msgs::msg::Pose> & path, const double vehicle_length,
+  const double max_longitudinal_offset);
+
+/**
+ * @brief Check the clusters in the order of the first polygon they enter, and stop once the
+ * distance lower bound of the next cluster exceeds the closest distance found so far. On a curved
+ * path, a cluster first entering a later polygon can still be closer than the ones before it, so
+ * the clusters are not pruned by polygon index alone.
+ * @param ranked_clusters pairs of (first containing polygon index, cluster index), sorted
+ * @param distance_lower_bounds lower bound of the distance to an object inside each polygon
+ * @param check_cluster function creating the objects of a cluster, which returns their closest
+ * distance or nullopt if no object was created
+ * @return the number of checked clusters
+ */
+size_t checkClustersByDistance(
+  const std::vector<std::pair<size_t, size_t>> & ranked_clusters,
+  const std::vector<double> & distance_lower_bounds,
+  const std::function<std::optional<double>(const size_t)> & check_cluster);
+
+}  // namespace autoware::motion::control::autonomous_emergency_braking::fast_path
+
+#endif  // AUTOWARE__AUTONOMOUS_EMERGENCY_BRAKING__POINTCLOUD_FAST_PATH_HPP_
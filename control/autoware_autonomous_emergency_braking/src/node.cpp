@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <autoware/autonomous_emergency_braking/node.hpp>
+#include <autoware/autonomous_emergency_braking/pointcloud_fast_path.hpp>
 #include <autoware/autonomous_emergency_braking/utils.hpp>
 #include <autoware/motion_utils/marker/marker_helper.hpp>
 #include <autoware/universe_utils/geometry/boost_geometry.hpp>
@@ -41,10 +42,14 @@
 #include <pcl/surface/convex_hull.h>
 #include <tf2/utils.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <functional>
+#include <iterator>
 #include <limits>
 #include <optional>
+#include <utility>
 #ifdef ROS_DISTRO_GALACTIC
 #include <tf2_eigen/tf2_eigen.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
@@ -139,6 +144,7 @@ AEB::AEB(const rclcpp::NodeOptions & node_options)
   use_predicted_trajectory_ = declare_parameter<bool>("use_predicted_trajectory");
   use_imu_path_ = declare_parameter<bool>("use_imu_path");
   use_pointcloud_data_ = declare_parameter<bool>("use_pointcloud_data");
+  use_pointcloud_fast_path_ = declare_parameter<bool>("use_pointcloud_fast_path", false);
   use_predicted_object_data_ = declare_parameter<bool>("use_predicted_object_data");
   use_object_velocity_calculation_ = declare_parameter<bool>("use_object_velocity_calculation");
   check_autoware_state_ = declare_parameter<bool>("check_autoware_state");
@@ -192,6 +198,7 @@ rcl_interfaces::msg::SetParametersResult AEB::onParameter(
   updateParam<bool>(parameters, "use_predicted_trajectory", use_predicted_trajectory_);
   updateParam<bool>(parameters, "use_imu_path", use_imu_path_);
   updateParam<bool>(parameters, "use_pointcloud_data", use_pointcloud_data_);
+  updateParam<bool>(parameters, "use_pointcloud_fast_path", use_pointcloud_fast_path_);
   updateParam<bool>(parameters, "use_predicted_object_data", use_predicted_object_data_);
   updateParam<bool>(
     parameters, "use_object_velocity_calculation", use_object_velocity_calculation_);
@@ -259,6 +266,12 @@ void AEB::onImu(const Imu::ConstSharedPtr input_msg)
 
 void AEB::onPointCloud(const PointCloud2::ConstSharedPtr input_msg)
 {
+  if (use_pointcloud_fast_path_ && fast_path::hasXYZFloatFields(*input_msg)) {
+    onPointCloudFastPath(input_msg);
+    return;
+  }
+  raw_pointcloud_ptr_.reset();
+
   PointCloud::Ptr pointcloud_ptr(new PointCloud);
   pcl::fromROSMsg(*input_msg, *pointcloud_ptr);
 
@@ -309,6 +322,31 @@ void AEB::onPointCloud(const PointCloud2::ConstSharedPtr input_msg)
   obstacle_ros_pointcloud_ptr_->header = input_msg->header;
 }
 
+void AEB::onPointCloudFastPath(const PointCloud2::ConstSharedPtr input_msg)
+{
+  // The raw message is kept as is, all the filters are applied while cropping it with the ego path
+  obstacle_ros_pointcloud_ptr_.reset();
+  raw_pointcloud_ptr_.reset();
+  raw_pointcloud_transform_ = std::nullopt;
+
+  if (input_msg->header.frame_id != "base_link") {
+    geometry_msgs::msg::TransformStamped transform_stamped{};
+    try {
+      transform_stamped = tf_buffer_.lookupTransform(
+        "base_link", input_msg->header.frame_id, input_msg->header.stamp,
+        rclcpp::Duration::from_seconds(0.5));
+    } catch (tf2::TransformException & ex) {
+      RCLCPP_ERROR_STREAM(
+        get_logger(),
+        "[AEB] Failed to look up transform from base_link to" << input_msg->header.frame_id);
+      return;
+    }
+    raw_pointcloud_transform_ =
+      tf2::transformToEigen(transform_stamped.transform).matrix().cast<float>();
+  }
+  raw_pointcloud_ptr_ = input_msg;
+}
+
 bool AEB::fetchLatestData()
 {
   const auto missing = [this](const auto & name) {
@@ -328,11 +366,12 @@ bool AEB::fetchLatestData()
     }
 
     onPointCloud(pointcloud_ptr);
-    if (!obstacle_ros_pointcloud_ptr_) {
+    if (!obstacle_ros_pointcloud_ptr_ && !raw_pointcloud_ptr_) {
       return missing("object pointcloud");
     }
   } else {
     obstacle_ros_pointcloud_ptr_.reset();
+    raw_pointcloud_ptr_.reset();
   }
 
   if (use_predicted_object_data_) {
@@ -344,7 +383,7 @@ bool AEB::fetchLatestData()
     predicted_objects_ptr_.reset();
   }
 
-  if (!obstacle_ros_pointcloud_ptr_ && !predicted_objects_ptr_) {
+  if (!obstacle_ros_pointcloud_ptr_ && !raw_pointcloud_ptr_ && !predicted_objects_ptr_) {
     return missing("object detection method (pointcloud or predicted objects)");
   }
 
@@ -435,10 +474,16 @@ bool AEB::checkCollision(MarkerArray & debug_markers)
       if (use_pointcloud_data_) {
         const auto expanded_ego_polys =
           generatePathFootprint(path, expand_width_ + path_footprint_extra_margin_);
-        cropPointCloudWithEgoFootprintPath(expanded_ego_polys, filtered_objects);
-        const auto current_time = obstacle_ros_pointcloud_ptr_->header.stamp;
-        createObjectDataUsingPointCloudClusters(
-          path, ego_polys, current_time, objects, filtered_objects);
+        if (raw_pointcloud_ptr_) {
+          const auto current_time = raw_pointcloud_ptr_->header.stamp;
+          createObjectDataUsingPointCloudFastPath(
+            path, ego_polys, expanded_ego_polys, current_time, objects, filtered_objects);
+        } else {
+          cropPointCloudWithEgoFootprintPath(expanded_ego_polys, filtered_objects);
+          const auto current_time = obstacle_ros_pointcloud_ptr_->header.stamp;
+          createObjectDataUsingPointCloudClusters(
+            path, ego_polys, current_time, objects, filtered_objects);
+        }
       }
       if (use_predicted_object_data_) {
         createObjectDataUsingPredictedObjects(path, ego_polys, objects);
@@ -774,6 +819,14 @@ void AEB::createObjectDataUsingPointCloudClusters(
     }
   }
 
+  createObjectDataUsingPointsInsideEgoPath(
+    ego_path, ego_polys, stamp, *points_belonging_to_cluster_hulls, objects);
+}
+
+bool AEB::createObjectDataUsingPointsInsideEgoPath(
+  const Path & ego_path, const std::vector<Polygon2d> & ego_polys, const rclcpp::Time & stamp,
+  const PointCloud & points, std::vector<ObjectData> & objects)
+{
   // select points inside the ego footprint path
   const auto current_p = [&]() {
     const auto & first_point_of_path = ego_path.front();
@@ -781,7 +834,8 @@ void AEB::createObjectDataUsingPointCloudClusters(
     return autoware::universe_utils::createPoint(p.x, p.y, p.z);
   }();
 
-  for (const auto & p : *points_belonging_to_cluster_hulls) {
+  const auto num_objects = objects.size();
+  for (const auto & p : points) {
     const auto obj_position = autoware::universe_utils::createPoint(p.x, p.y, p.z);
     const double obj_arc_length =
       autoware::motion_utils::calcSignedArcLength(ego_path, current_p, obj_position);
@@ -808,6 +862,95 @@ void AEB::createObjectDataUsingPointCloudClusters(
       }
     }
   }
+  return objects.size() > num_objects;
+}
+
+void AEB::createObjectDataUsingPointCloudFastPath(
+  const Path & ego_path, const std::vector<Polygon2d> & ego_polys,
+  const std::vector<Polygon2d> & expanded_ego_polys, const rclcpp::Time & stamp,
+  std::vector<ObjectData> & objects, const pcl::PointCloud<pcl::PointXYZ>::Ptr filtered_objects)
+{
+  filtered_objects->clear();
+  if (ego_path.size() < 2 || ego_polys.empty() || expanded_ego_polys.empty()) {
+    return;
+  }
+
+  // step1. crop the raw points with the convex hull of the expanded ego footprint path
+  Polygon2d corridor;
+  {
+    autoware::universe_utils::MultiPoint2d corridor_points;
+    for (const auto & poly : expanded_ego_polys) {
+      for (const auto & p : poly.outer()) {
+        corridor_points.push_back(p);
+      }
+    }
+    bg::convex_hull(corridor_points, corridor);
+  }
+  fast_path::CropParam crop_param;
+  crop_param.min_height = detection_range_min_height_;
+  crop_param.max_height = vehicle_info_.vehicle_height_m + detection_range_max_height_margin_;
+  crop_param.voxel_grid_x = voxel_grid_x_;
+  crop_param.voxel_grid_y = voxel_grid_y_;
+  crop_param.voxel_grid_z = voxel_grid_z_;
+  fast_path::cropPointCloud(
+    *raw_pointcloud_ptr_, raw_pointcloud_transform_, corridor, crop_param, *filtered_objects);
+  pcl_conversions::toPCL(raw_pointcloud_ptr_->header, filtered_objects->header);
+  filtered_objects->header.frame_id = "base_link";
+  if (filtered_objects->empty()) {
+    return;
+  }
+
+  // step2. cluster the cropped points
+  fast_path::ClusterParam cluster_param;
+  cluster_param.cluster_tolerance = cluster_tolerance_;
+  cluster_param.minimum_cluster_size = minimum_cluster_size_;
+  cluster_param.maximum_cluster_size = maximum_cluster_size_;
+  const auto clusters = fast_path::clusterPoints(*filtered_objects, cluster_param);
+
+  // step3. rank the clusters by the first ego polygon they enter, which is cheaper than building
+  // the hull of every cluster and only the closest ones can hold the closest object
+  std::vector<std::pair<size_t, size_t>> ranked_clusters;  // (first polygon index, cluster index)
+  const auto ego_poly_envelopes = fast_path::calcEnvelopes(ego_polys);
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    const auto & cluster = clusters.at(i);
+    const bool cluster_surpasses_threshold_height =
+      std::any_of(cluster.begin(), cluster.end(), [&](const auto index) {
+        return filtered_objects->at(index).z > cluster_minimum_height_;
+      });
+    if (!cluster_surpasses_threshold_height) continue;
+    const auto first_poly_index = fast_path::findFirstContainingPolygon(
+      *filtered_objects, cluster, ego_polys, ego_poly_envelopes);
+    if (first_poly_index < ego_polys.size()) {
+      ranked_clusters.emplace_back(first_poly_index, i);
+    }
+  }
+  std::sort(ranked_clusters.begin(), ranked_clusters.end());
+
+  // step4. build the hulls from the closest cluster on, until the distance lower bound of the next
+  // cluster exceeds the closest object found. On a curved path, a cluster first entering a later
+  // polygon can still hold a closer point, so the clusters are not pruned by polygon index alone.
+  const auto distance_lower_bounds = fast_path::calcDistanceLowerBounds(
+    ego_path, vehicle_info_.vehicle_length_m, vehicle_info_.max_longitudinal_offset_m);
+  fast_path::checkClustersByDistance(
+    ranked_clusters, distance_lower_bounds,
+    [&](const size_t cluster_index) -> std::optional<double> {
+      const auto & cluster = clusters.at(cluster_index);
+      PointCloud hull_points;
+      for (const auto index : fast_path::calcConvexHull2d(*filtered_objects, cluster)) {
+        hull_points.push_back(filtered_objects->at(index));
+      }
+      const auto num_objects = objects.size();
+      if (!createObjectDataUsingPointsInsideEgoPath(
+            ego_path, ego_polys, stamp, hull_points, objects)) {
+        return std::nullopt;
+      }
+      const auto closest_object = std::min_element(
+        std::next(objects.begin(), static_cast<std::ptrdiff_t>(num_objects)), objects.end(),
+        [](const auto & o1, const auto & o2) {
+          return o1.distance_to_object < o2.distance_to_object;
+        });
+      return closest_object->distance_to_object;
+    });
 }
 
 void AEB::cropPointCloudWithEgoFootprintPath(
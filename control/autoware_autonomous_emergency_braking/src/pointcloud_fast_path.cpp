@@ -0,0 +1,414 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/autonomous_emergency_braking/pointcloud_fast_path.hpp>
+#include <autoware/universe_utils/geometry/geometry.hpp>
+
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace autoware::motion::control::autonomous_emergency_braking::fast_path
+{
+namespace bg = boost::geometry;
+using autoware::universe_utils::Point2d;
+using sensor_msgs::msg::PointField;
+
+namespace
+{
+std::optional<uint32_t> findFloatFieldOffset(const PointCloud2 & msg, const std::string & name)
+{
+  for (const auto & field : msg.fields) {
+    if (field.name == name && field.datatype == PointField::FLOAT32 && field.count == 1) {
+      return field.offset;
+    }
+  }
+  return std::nullopt;
+}
+
+// Pack three signed cell indices into a single hash key, 21 bits each
+uint64_t packCellKey(const int64_t ix, const int64_t iy, const int64_t iz)
+{
+  constexpr int64_t offset = int64_t{1} << 20;
+  constexpr uint64_t mask = (uint64_t{1} << 21) - 1;
+  return ((static_cast<uint64_t>(ix + offset) & mask) << 42) |
+         ((static_cast<uint64_t>(iy + offset) & mask) << 21) |
+         (static_cast<uint64_t>(iz + offset) & mask);
+}
+
+uint64_t calcCellKey(
+  const pcl::PointXYZ & p, const double inv_x, const double inv_y, const double inv_z)
+{
+  return packCellKey(
+    static_cast<int64_t>(std::floor(p.x * inv_x)), static_cast<int64_t>(std::floor(p.y * inv_y)),
+    static_cast<int64_t>(std::floor(p.z * inv_z)));
+}
+
+// Half-plane representation of a convex polygon for the per-point inside test
+class ConvexCorridor
+{
+public:
+  explicit ConvexCorridor(const Polygon2d & polygon)
+  {
+    const auto & ring = polygon.outer();
+    if (ring.size() < 3) {
+      return;
+    }
+    double signed_area = 0.0;
+    for (size_t i = 0; i + 1 < ring.size(); ++i) {
+      signed_area += ring.at(i).x() * ring.at(i + 1).y() - ring.at(i + 1).x() * ring.at(i).y();
+    }
+    const double orientation = signed_area > 0.0 ? 1.0 : -1.0;
+    for (size_t i = 0; i + 1 < ring.size(); ++i) {
+      const auto & a = ring.at(i);
+      const auto & b = ring.at(i + 1);
+      edges_.push_back(
+        {a.x(), a.y(), orientation * (b.x() - a.x()), orientation * (b.y() - a.y())});
+      min_x_ = std::min(min_x_, a.x());
+      max_x_ = std::max(max_x_, a.x());
+      min_y_ = std::min(min_y_, a.y());
+      max_y_ = std::max(max_y_, a.y());
+    }
+  }
+
+  bool contains(const double x, const double y) const
+  {
+    if (edges_.empty() || x < min_x_ || x > max_x_ || y < min_y_ || y > max_y_) {
+      return false;
+    }
+    return std::all_of(edges_.begin(), edges_.end(), [&](const auto & e) {
+      return e.dx * (y - e.y) - e.dy * (x - e.x) >= 0.0;
+    });
+  }
+
+private:
+  struct Edge
+  {
+    double x;
+    double y;
+    double dx;
+    double dy;
+  };
+  std::vector<Edge> edges_;
+  double min_x_{std::numeric_limits<double>::max()};
+  double max_x_{std::numeric_limits<double>::lowest()};
+  double min_y_{std::numeric_limits<double>::max()};
+  double max_y_{std::numeric_limits<double>::lowest()};
+};
+
+size_t findRoot(std::vector<size_t> & parents, size_t i)
+{
+  while (parents.at(i) != i) {
+    parents.at(i) = parents.at(parents.at(i));
+    i = parents.at(i);
+  }
+  return i;
+}
+
+double cross(const pcl::PointXYZ & o, const pcl::PointXYZ & a, const pcl::PointXYZ & b)
+{
+  return (static_cast<double>(a.x) - o.x) * (static_cast<double>(b.y) - o.y) -
+         (static_cast<double>(a.y) - o.y) * (static_cast<double>(b.x) - o.x);
+}
+}  // namespace
+
+bool hasXYZFloatFields(const PointCloud2 & msg)
+{
+  return findFloatFieldOffset(msg, "x") && findFloatFieldOffset(msg, "y") &&
+         findFloatFieldOffset(msg, "z") && !msg.is_bigendian;
+}
+
+void cropPointCloud(
+  const PointCloud2 & msg, const std::optional<Eigen::Matrix4f> & transform,
+  const Polygon2d & corridor, const CropParam & param, PointCloud & output)
+{
+  output.clear();
+  const auto offset_x = findFloatFieldOffset(msg, "x");
+  const auto offset_y = findFloatFieldOffset(msg, "y");
+  const auto offset_z = findFloatFieldOffset(msg, "z");
+  if (!offset_x || !offset_y || !offset_z) {
+    return;
+  }
+
+  const ConvexCorridor convex_corridor(corridor);
+  const double inv_x = 1.0 / param.voxel_grid_x;
+  const double inv_y = 1.0 / param.voxel_grid_y;
+  const double inv_z = 1.0 / param.voxel_grid_z;
+
+  // voxel key -> index of the accumulated centroid
+  std::unordered_map<uint64_t, size_t> voxel_indices;
+  std::vector<Eigen::Vector4d> voxel_sums;
+
+  const auto read_float = [](const uint8_t * ptr) {
+    float value;
+    std::memcpy(&value, ptr, sizeof(float));
+    return value;
+  };
+
+  for (uint32_t row = 0; row < msg.height; ++row) {
+    const uint8_t * row_ptr = msg.data.data() + static_cast<size_t>(row) * msg.row_step;
+    for (uint32_t col = 0; col < msg.width; ++col) {
+      const uint8_t * point_ptr = row_ptr + static_cast<size_t>(col) * msg.point_step;
+      pcl::PointXYZ p(
+        read_float(point_ptr + *offset_x), read_float(point_ptr + *offset_y),
+        read_float(point_ptr + *offset_z));
+      if (!std::isfinite(p.x) || !std::isfinite(p.y) || !std::isfinite(p.z)) {
+        continue;
+      }
+      if (transform) {
+        p.getVector3fMap() =
+          transform->topLeftCorner<3, 3>() * p.getVector3fMap() + transform->topRightCorner<3, 1>();
+      }
+      if (p.z < param.min_height || p.z > param.max_height) {
+        continue;
+      }
+      if (!convex_corridor.contains(p.x, p.y)) {
+        continue;
+      }
+      const auto key = calcCellKey(p, inv_x, inv_y, inv_z);
+      const auto [itr, inserted] = voxel_indices.try_emplace(key, voxel_sums.size());
+      if (inserted) {
+        voxel_sums.emplace_back(Eigen::Vector4d::Zero());
+      }
+      voxel_sums.at(itr->second) += Eigen::Vector4d(p.x, p.y, p.z, 1.0);
+    }
+  }
+
+  output.reserve(voxel_sums.size());
+  for (const auto & sum : voxel_sums) {
+    output.push_back(pcl::PointXYZ(sum.x() / sum.w(), sum.y() / sum.w(), sum.z() / sum.w()));
+  }
+}
+
+std::vector<std::vector<size_t>> clusterPoints(
+  const PointCloud & points, const ClusterParam & param)
+{
+  const size_t num_points = points.size();
+  if (num_points == 0 || param.cluster_tolerance <= 0.0) {
+    return {};
+  }
+  const double inv_tolerance = 1.0 / param.cluster_tolerance;
+  const double squared_tolerance = param.cluster_tolerance * param.cluster_tolerance;
+
+  // Sort the points by cell so that each cell is a contiguous range of the order
+  std::vector<uint64_t> keys(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    keys.at(i) = calcCellKey(points.at(i), inv_tolerance, inv_tolerance, inv_tolerance);
+  }
+  std::vector<size_t> order(num_points);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](const size_t a, const size_t b) {
+    return keys.at(a) < keys.at(b);
+  });
+
+  struct Cell
+  {
+    int64_t x;
+    int64_t y;
+    int64_t z;
+    size_t begin;
+    size_t end;
+  };
+  std::vector<Cell> cells;
+  std::unordered_map<uint64_t, size_t> cell_indices;
+  cell_indices.reserve(num_points);
+  for (size_t begin = 0; begin < num_points;) {
+    const uint64_t key = keys.at(order.at(begin));
+    size_t end = begin + 1;
+    while (end < num_points && keys.at(order.at(end)) == key) {
+      ++end;
+    }
+    const auto & p = points.at(order.at(begin));
+    cell_indices.emplace(key, cells.size());
+    cells.push_back(
+      {static_cast<int64_t>(std::floor(p.x * inv_tolerance)),
+       static_cast<int64_t>(std::floor(p.y * inv_tolerance)),
+       static_cast<int64_t>(std::floor(p.z * inv_tolerance)), begin, end});
+    begin = end;
+  }
+
+  // Union the points within the tolerance. The neighbors of a point are in the 27 cells around it,
+  // so each cell is paired with itself and the 13 neighbor cells that come after it.
+  std::vector<size_t> parents(num_points);
+  std::iota(parents.begin(), parents.end(), 0);
+  const auto unite_if_close = [&](const size_t i, const size_t j) {
+    const double squared_distance =
+      (points.at(i).getVector3fMap() - points.at(j).getVector3fMap()).squaredNorm();
+    if (squared_distance > squared_tolerance) {
+      return;
+    }
+    const size_t root_i = findRoot(parents, i);
+    const size_t root_j = findRoot(parents, j);
+    if (root_i != root_j) {
+      parents.at(std::max(root_i, root_j)) = std::min(root_i, root_j);
+    }
+  };
+  for (const auto & cell : cells) {
+    for (size_t k = cell.begin; k < cell.end; ++k) {
+      for (size_t l = k + 1; l < cell.end; ++l) {
+        unite_if_close(order.at(k), order.at(l));
+      }
+    }
+    for (int64_t dx = 0; dx <= 1; ++dx) {
+      for (int64_t dy = (dx == 0 ? 0 : -1); dy <= 1; ++dy) {
+        for (int64_t dz = (dx == 0 && dy == 0 ? 1 : -1); dz <= 1; ++dz) {
+          const auto itr = cell_indices.find(packCellKey(cell.x + dx, cell.y + dy, cell.z + dz));
+          if (itr == cell_indices.end()) {
+            continue;
+          }
+          const auto & neighbor = cells.at(itr->second);
+          for (size_t k = cell.begin; k < cell.end; ++k) {
+            for (size_t l = neighbor.begin; l < neighbor.end; ++l) {
+              unite_if_close(order.at(k), order.at(l));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // Group the points by root. The root is the smallest index of a cluster, so the clusters are
+  // created in the order of their first point
+  std::vector<size_t> cluster_of_root(num_points);
+  std::vector<std::vector<size_t>> clusters;
+  for (size_t i = 0; i < num_points; ++i) {
+    const size_t root = findRoot(parents, i);
+    if (root == i) {
+      cluster_of_root.at(i) = clusters.size();
+      clusters.emplace_back();
+    }
+    clusters.at(cluster_of_root.at(root)).push_back(i);
+  }
+
+  const auto is_out_of_size_limits = [&](const auto & cluster) {
+    const auto size = static_cast<int>(cluster.size());
+    return size < param.minimum_cluster_size || size > param.maximum_cluster_size;
+  };
+  clusters.erase(
+    std::remove_if(clusters.begin(), clusters.end(), is_out_of_size_limits), clusters.end());
+  return clusters;
+}
+
+std::vector<Box2d> calcEnvelopes(const std::vector<Polygon2d> & polygons)
+{
+  std::vector<Box2d> envelopes(polygons.size());
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    bg::envelope(polygons.at(i), envelopes.at(i));
+  }
+  return envelopes;
+}
+
+size_t findFirstContainingPolygon(
+  const PointCloud & points, const std::vector<size_t> & cluster,
+  const std::vector<Polygon2d> & polygons, const std::vector<Box2d> & envelopes)
+{
+  size_t first_index = polygons.size();
+  for (const auto index : cluster) {
+    const Point2d point(points.at(index).x, points.at(index).y);
+    // only the polygons before the current result can improve it
+    for (size_t i = 0; i < first_index; ++i) {
+      if (bg::covered_by(point, envelopes.at(i)) && bg::within(point, polygons.at(i))) {
+        first_index = i;
+        break;
+      }
+    }
+    if (first_index == 0) {
+      break;
+    }
+  }
+  return first_index;
+}
+
+std::vector<size_t> calcConvexHull2d(const PointCloud & points, const std::vector<size_t> & cluster)
+{
+  std::vector<size_t> sorted = cluster;
+  std::sort(sorted.begin(), sorted.end(), [&](const size_t a, const size_t b) {
+    const auto & pa = points.at(a);
+    const auto & pb = points.at(b);
+    return pa.x < pb.x || (pa.x == pb.x && pa.y < pb.y);
+  });
+  if (sorted.size() < 3) {
+    return sorted;
+  }
+
+  std::vector<size_t> hull(2 * sorted.size());
+  size_t k = 0;
+  // lower hull
+  for (const auto index : sorted) {
+    while (k >= 2 &&
+           cross(points.at(hull.at(k - 2)), points.at(hull.at(k - 1)), points.at(index)) <= 0.0) {
+      --k;
+    }
+    hull.at(k++) = index;
+  }
+  // upper hull
+  const size_t lower_size = k + 1;
+  for (auto itr = std::next(sorted.rbegin()); itr != sorted.rend(); ++itr) {
+    while (k >= lower_size &&
+           cross(points.at(hull.at(k - 2)), points.at(hull.at(k - 1)), points.at(*itr)) <= 0.0) {
+      --k;
+    }
+    hull.at(k++) = *itr;
+  }
+  // the last point is the same as the first one
+  hull.resize(k - 1);
+  return hull;
+}
+
+std::vector<double> calcDistanceLowerBounds(
+  const std::vector<geometry_msgs::msg::Pose> & path, const double vehicle_length,
+  const double max_longitudinal_offset)
+{
+  std::vector<double> lower_bounds(path.size(), 0.0);
+  double arc_length = 0.0;
+  for (size_t i = 0; i < path.size(); ++i) {
+    if (i > 0) {
+      arc_length += autoware::universe_utils::calcDistance2d(path.at(i - 1), path.at(i));
+    }
+    lower_bounds.at(i) = std::max(0.0, arc_length - vehicle_length - max_longitudinal_offset);
+  }
+  return lower_bounds;
+}
+
+size_t checkClustersByDistance(
+  const std::vector<std::pair<size_t, size_t>> & ranked_clusters,
+  const std::vector<double> & distance_lower_bounds,
+  const std::function<std::optional<double>(const size_t)> & check_cluster)
+{
+  auto closest_distance = std::numeric_limits<double>::infinity();
+  size_t num_checked = 0;
+  for (const auto & [poly_index, cluster_index] : ranked_clusters) {
+    // the clusters are sorted by polygon index and the lower bounds grow along the path
+    if (distance_lower_bounds.at(poly_index) > closest_distance) {
+      break;
+    }
+    ++num_checked;
+    if (const auto distance = check_cluster(cluster_index)) {
+      closest_distance = std::min(closest_distance, *distance);
+    }
+  }
+  return num_checked;
+}
+
+}  // namespace autoware::motion::control::autonomous_emergency_braking::fast_path
@@ -0,0 +1,414 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/autonomous_emergency_braking/pointcloud_fast_path.hpp"
+
+#include <autoware/motion_utils/trajectory/trajectory.hpp>
+#include <autoware/universe_utils/geometry/geometry.hpp>
+
+#include <boost/geometry/algorithms/convex_hull.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+#include <boost/geometry/strategies/agnostic/hull_graham_andrew.hpp>
+
+#include <gtest/gtest.h>
+#include <pcl/filters/crop_hull.h>
+#include <pcl/filters/passthrough.h>
+#include <pcl/filters/voxel_grid.h>
+#include <pcl/search/kdtree.h>
+#include <pcl/segmentation/extract_clusters.h>
+#include <pcl/surface/convex_hull.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace autoware::motion::control::autonomous_emergency_braking::test
+{
+using autoware::universe_utils::Polygon2d;
+using fast_path::PointCloud;
+using sensor_msgs::msg::PointCloud2;
+
+namespace
+{
+Polygon2d makeBox(const double min_x, const double min_y, const double max_x, const double max_y)
+{
+  Polygon2d polygon;
+  polygon.outer() = {
+    {min_x, min_y}, {min_x, max_y}, {max_x, max_y}, {max_x, min_y}, {min_x, min_y}};
+  return polygon;
+}
+
+PointCloud2 toMsg(const PointCloud & points)
+{
+  PointCloud2 msg;
+  pcl::toROSMsg(points, msg);
+  msg.header.frame_id = "base_link";
+  return msg;
+}
+
+// Dense random ground points with a few box shaped obstacles on the road
+PointCloud makeDenseCloud(const size_t num_points)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> x_dist(-50.0, 100.0);
+  std::uniform_real_distribution<float> y_dist(-50.0, 50.0);
+  std::uniform_real_distribution<float> z_dist(0.05, 2.0);
+  std::uniform_real_distribution<float> unit_dist(0.0, 1.0);
+  PointCloud points;
+  for (size_t i = 0; i < num_points; ++i) {
+    if (i % 10 == 0) {
+      // obstacle points
+      const float obstacle_x = 5.0f + 10.0f * static_cast<float>(i % 40 / 10);
+      points.push_back(
+        pcl::PointXYZ(obstacle_x + unit_dist(engine), unit_dist(engine) - 0.5f, z_dist(engine)));
+    } else {
+      points.push_back(pcl::PointXYZ(x_dist(engine), y_dist(engine), z_dist(engine)));
+    }
+  }
+  return points;
+}
+
+std::set<std::vector<size_t>> toSet(std::vector<std::vector<size_t>> clusters)
+{
+  for (auto & cluster : clusters) {
+    std::sort(cluster.begin(), cluster.end());
+  }
+  return {clusters.begin(), clusters.end()};
+}
+}  // namespace
+
+TEST(TestPointCloudFastPath, cropPointCloud)
+{
+  PointCloud points;
+  points.push_back(pcl::PointXYZ(1.0, 0.0, 0.5));
+  points.push_back(pcl::PointXYZ(1.01, 0.01, 0.5));  // same voxel as the first point
+  points.push_back(pcl::PointXYZ(5.0, 2.0, 0.5));    // outside of the corridor
+  points.push_back(pcl::PointXYZ(5.0, 0.0, -1.0));   // too low
+  points.push_back(pcl::PointXYZ(5.0, 0.0, 3.0));    // too high
+  points.push_back(pcl::PointXYZ(9.0, 0.5, 0.5));
+
+  fast_path::CropParam param;
+  param.min_height = -0.5;
+  param.max_height = 2.5;
+  param.voxel_grid_x = 0.1;
+  param.voxel_grid_y = 0.1;
+  param.voxel_grid_z = 100000.0;
+
+  const auto msg = toMsg(points);
+  ASSERT_TRUE(fast_path::hasXYZFloatFields(msg));
+  PointCloud output;
+  fast_path::cropPointCloud(msg, std::nullopt, makeBox(0.0, -1.0, 10.0, 1.0), param, output);
+  ASSERT_EQ(output.size(), 2u);
+  EXPECT_NEAR(output.at(0).x, 1.005, 1e-4);
+  EXPECT_NEAR(output.at(0).y, 0.005, 1e-4);
+
+  // the points are transformed to base_link before cropping
+  Eigen::Matrix4f transform = Eigen::Matrix4f::Identity();
+  transform(0, 3) = 6.0;
+  fast_path::cropPointCloud(msg, transform, makeBox(0.0, -1.0, 10.0, 1.0), param, output);
+  ASSERT_EQ(output.size(), 1u);
+  EXPECT_NEAR(output.at(0).x, 7.005, 1e-4);
+}
+
+TEST(TestPointCloudFastPath, clusterPointsMatchesEuclideanClustering)
+{
+  std::mt19937 engine(1);
+  std::uniform_real_distribution<float> dist(0.0, 3.0);
+  PointCloud::Ptr points = pcl::make_shared<PointCloud>();
+  for (size_t i = 0; i < 2000; ++i) {
+    points->push_back(pcl::PointXYZ(dist(engine), dist(engine), 0.1f * dist(engine)));
+  }
+
+  fast_path::ClusterParam param;
+  param.cluster_tolerance = 0.1;
+  param.minimum_cluster_size = 3;
+  param.maximum_cluster_size = 1000;
+  const auto clusters = fast_path::clusterPoints(*points, param);
+
+  std::vector<pcl::PointIndices> cluster_indices;
+  pcl::search::KdTree<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
+  tree->setInputCloud(points);
+  pcl::EuclideanClusterExtraction<pcl::PointXYZ> ec;
+  ec.setClusterTolerance(param.cluster_tolerance);
+  ec.setMinClusterSize(param.minimum_cluster_size);
+  ec.setMaxClusterSize(param.maximum_cluster_size);
+  ec.setSearchMethod(tree);
+  ec.setInputCloud(points);
+  ec.extract(cluster_indices);
+
+  std::vector<std::vector<size_t>> expected_clusters;
+  for (const auto & indices : cluster_indices) {
+    expected_clusters.emplace_back(indices.indices.begin(), indices.indices.end());
+  }
+  EXPECT_EQ(toSet(clusters), toSet(expected_clusters));
+}
+
+TEST(TestPointCloudFastPath, findFirstContainingPolygonAndHull)
+{
+  PointCloud points;
+  points.push_back(pcl::PointXYZ(0.0, 0.0, 0.0));
+  points.push_back(pcl::PointXYZ(1.0, 0.0, 1.0));
+  points.push_back(pcl::PointXYZ(0.5, 0.5, 2.0));
+  points.push_back(pcl::PointXYZ(1.0, 1.0, 0.0));
+  points.push_back(pcl::PointXYZ(0.0, 1.0, 0.0));
+  points.push_back(pcl::PointXYZ(0.5, 0.0, 0.0));
+  const std::vector<size_t> cluster{0, 1, 2, 3, 4, 5};
+
+  // the interior and collinear points are not hull vertices
+  const auto hull = fast_path::calcConvexHull2d(points, cluster);
+  EXPECT_EQ(hull, (std::vector<size_t>{0, 1, 3, 4}));
+
+  const std::vector<Polygon2d> polygons{
+    makeBox(2.0, -1.0, 3.0, 1.0), makeBox(0.75, -1.0, 2.0, 1.0), makeBox(-1.0, -1.0, 2.0, 2.0)};
+  const auto envelopes = fast_path::calcEnvelopes(polygons);
+  EXPECT_EQ(fast_path::findFirstContainingPolygon(points, cluster, polygons, envelopes), 1u);
+  EXPECT_EQ(fast_path::findFirstContainingPolygon(points, {0, 2, 4}, polygons, envelopes), 2u);
+  EXPECT_EQ(
+    fast_path::findFirstContainingPolygon(points, cluster, {polygons.front()}, {envelopes.front()}),
+    1u);
+}
+
+// On a sharp curve, a cluster on the outside of the curve enters the front corner of an early
+// footprint polygon while a closer cluster on the inside first enters a polygon two steps later
+TEST(TestPointCloudFastPath, checkClustersByDistanceOnCurvedPath)
+{
+  using autoware::universe_utils::calcOffsetPose;
+  using autoware::universe_utils::createQuaternionFromYaw;
+  constexpr double radius{5.0};
+  constexpr double front_offset{4.0};
+  constexpr double rear_overhang{1.0};
+  constexpr double half_width{1.0};
+  constexpr double vehicle_length{front_offset + rear_overhang};
+
+  // circular path turning left around (0, radius), with the same footprints as the AEB node
+  std::vector<geometry_msgs::msg::Pose> path;
+  for (int i = 0; i < 40; ++i) {
+    const double yaw = 0.1 * i;
+    geometry_msgs::msg::Pose pose;
+    pose.position.x = radius * std::sin(yaw);
+    pose.position.y = radius * (1.0 - std::cos(yaw));
+    pose.orientation = createQuaternionFromYaw(yaw);
+    path.push_back(pose);
+  }
+  std::vector<Polygon2d> polygons;
+  for (size_t i = 0; i + 1 < path.size(); ++i) {
+    autoware::universe_utils::MultiPoint2d corners;
+    for (const auto & pose : {path.at(i), path.at(i + 1)}) {
+      for (const auto longitudinal : {front_offset, -rear_overhang}) {
+        for (const auto lateral : {half_width, -half_width}) {
+          const auto p = calcOffsetPose(pose, longitudinal, lateral, 0.0).position;
+          corners.emplace_back(p.x, p.y);
+        }
+      }
+    }
+    Polygon2d polygon;
+    boost::geometry::convex_hull(corners, polygon);
+    polygons.push_back(polygon);
+  }
+
+  // clusters given in polar coordinates around the center of the curve
+  PointCloud points;
+  const std::vector<std::pair<double, double>> cluster_offsets{{0.0, 0.0}, {0.1, 0.0}, {0.0, 0.02}};
+  const auto add_cluster = [&](const double r, const double angle) {
+    std::vector<size_t> cluster;
+    for (const auto & [dr, d_angle] : cluster_offsets) {
+      cluster.push_back(points.size());
+      points.push_back(pcl::PointXYZ(
+        (r + dr) * std::sin(angle + d_angle), radius - (r + dr) * std::cos(angle + d_angle), 1.0));
+    }
+    return cluster;
+  };
+  const std::vector<std::vector<size_t>> clusters{
+    add_cluster(5.9, 1.1),   // outside of the curve
+    add_cluster(4.1, 0.9),   // inside of the curve, closer
+    add_cluster(5.0, 3.0)};  // far on the path
+  const auto calc_distance = [&](const size_t cluster_index) -> std::optional<double> {
+    std::optional<double> distance;
+    for (const auto index : clusters.at(cluster_index)) {
+      const auto & p = points.at(index);
+      const autoware::universe_utils::Point2d point(p.x, p.y);
+      const bool is_inside = std::any_of(polygons.begin(), polygons.end(), [&](const auto & poly) {
+        return boost::geometry::within(point, poly);
+      });
+      if (!is_inside) continue;
+      const auto arc_length = autoware::motion_utils::calcSignedArcLength(
+        path, path.front().position, autoware::universe_utils::createPoint(p.x, p.y, p.z));
+      const auto d = std::abs(arc_length - front_offset);
+      distance = distance ? std::min(*distance, d) : d;
+    }
+    return distance;
+  };
+
+  std::vector<std::pair<size_t, size_t>> ranked_clusters;
+  const auto envelopes = fast_path::calcEnvelopes(polygons);
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    ranked_clusters.emplace_back(
+      fast_path::findFirstContainingPolygon(points, clusters.at(i), polygons, envelopes), i);
+  }
+  std::sort(ranked_clusters.begin(), ranked_clusters.end());
+  ASSERT_EQ(ranked_clusters.at(0).second, 0u);
+  ASSERT_EQ(ranked_clusters.at(1).second, 1u);
+  // the closest cluster enters the footprint two polygons after the first cluster
+  EXPECT_GE(ranked_clusters.at(1).first, ranked_clusters.at(0).first + 2);
+  EXPECT_LT(*calc_distance(1), *calc_distance(0));
+
+  const auto lower_bounds =
+    fast_path::calcDistanceLowerBounds(path, vehicle_length, front_offset);
+  ASSERT_EQ(lower_bounds.size(), path.size());
+  for (const auto & [poly_index, cluster_index] : ranked_clusters) {
+    EXPECT_LE(lower_bounds.at(poly_index), *calc_distance(cluster_index));
+  }
+
+  std::vector<size_t> checked_clusters;
+  double closest_distance = std::numeric_limits<double>::infinity();
+  const auto num_checked = fast_path::checkClustersByDistance(
+    ranked_clusters, lower_bounds, [&](const size_t cluster_index) {
+      checked_clusters.push_back(cluster_index);
+      const auto distance = calc_distance(cluster_index);
+      if (distance) closest_distance = std::min(closest_distance, *distance);
+      return distance;
+    });
+  // the far cluster is pruned by its lower bound, the closest one is found
+  EXPECT_EQ(num_checked, 2u);
+  EXPECT_EQ(checked_clusters, (std::vector<size_t>{0, 1}));
+  EXPECT_DOUBLE_EQ(closest_distance, *calc_distance(1));
+}
+
+// Latency of the point cloud pipeline on a dense cloud. Run with --gtest_also_run_disabled_tests
+TEST(TestPointCloudFastPath, DISABLED_benchmarkLatency)
+{
+  using std::chrono::duration;
+  using std::chrono::steady_clock;
+  constexpr size_t num_points{1000000};
+  constexpr int num_iterations{10};
+  const auto msg = toMsg(makeDenseCloud(num_points));
+  const auto corridor = makeBox(0.0, -2.0, 40.0, 2.0);
+
+  fast_path::CropParam crop_param;
+  crop_param.min_height = 0.0;
+  crop_param.max_height = 2.5;
+  crop_param.voxel_grid_x = 0.05;
+  crop_param.voxel_grid_y = 0.05;
+  crop_param.voxel_grid_z = 100000.0;
+  fast_path::ClusterParam cluster_param;
+  cluster_param.cluster_tolerance = 0.1;
+  cluster_param.minimum_cluster_size = 10;
+  cluster_param.maximum_cluster_size = 10000;
+
+  double pcl_time_ms{0.0};
+  double max_pcl_time_ms{0.0};
+  for (int i = 0; i < num_iterations; ++i) {
+    const auto start = steady_clock::now();
+    PointCloud::Ptr input = pcl::make_shared<PointCloud>();
+    pcl::fromROSMsg(msg, *input);
+    PointCloud::Ptr height_filtered = pcl::make_shared<PointCloud>();
+    pcl::PassThrough<pcl::PointXYZ> height_filter;
+    height_filter.setInputCloud(input);
+    height_filter.setFilterFieldName("z");
+    height_filter.setFilterLimits(crop_param.min_height, crop_param.max_height);
+    height_filter.filter(*height_filtered);
+    PointCloud::Ptr downsampled = pcl::make_shared<PointCloud>();
+    pcl::VoxelGrid<pcl::PointXYZ> voxel_filter;
+    voxel_filter.setInputCloud(height_filtered);
+    voxel_filter.setLeafSize(
+      crop_param.voxel_grid_x, crop_param.voxel_grid_y, crop_param.voxel_grid_z);
+    voxel_filter.filter(*downsampled);
+
+    PointCloud::Ptr hull_cloud = pcl::make_shared<PointCloud>();
+    for (const auto & p : corridor.outer()) {
+      hull_cloud->push_back(pcl::PointXYZ(p.x(), p.y(), 0.0));
+    }
+    pcl::ConvexHull<pcl::PointXYZ> corridor_hull;
+    corridor_hull.setDimension(2);
+    corridor_hull.setInputCloud(hull_cloud);
+    std::vector<pcl::Vertices> polygons;
+    PointCloud::Ptr corridor_surface = pcl::make_shared<PointCloud>();
+    corridor_hull.reconstruct(*corridor_surface, polygons);
+    PointCloud::Ptr cropped = pcl::make_shared<PointCloud>();
+    pcl::CropHull<pcl::PointXYZ> crop_filter;
+    crop_filter.setDim(2);
+    crop_filter.setInputCloud(downsampled);
+    crop_filter.setHullIndices(polygons);
+    crop_filter.setHullCloud(corridor_surface);
+    crop_filter.filter(*cropped);
+
+    std::vector<pcl::PointIndices> cluster_indices;
+    pcl::search::KdTree<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
+    tree->setInputCloud(cropped);
+    pcl::EuclideanClusterExtraction<pcl::PointXYZ> ec;
+    ec.setClusterTolerance(cluster_param.cluster_tolerance);
+    ec.setMinClusterSize(cluster_param.minimum_cluster_size);
+    ec.setMaxClusterSize(cluster_param.maximum_cluster_size);
+    ec.setSearchMethod(tree);
+    ec.setInputCloud(cropped);
+    ec.extract(cluster_indices);
+    for (const auto & indices : cluster_indices) {
+      PointCloud::Ptr cluster = pcl::make_shared<PointCloud>();
+      for (const auto index : indices.indices) {
+        cluster->push_back(cropped->at(index));
+      }
+      pcl::ConvexHull<pcl::PointXYZ> hull;
+      hull.setDimension(2);
+      hull.setInputCloud(cluster);
+      std::vector<pcl::Vertices> hull_polygons;
+      PointCloud surface;
+      hull.reconstruct(surface, hull_polygons);
+    }
+    const double time_ms = duration<double, std::milli>(steady_clock::now() - start).count();
+    pcl_time_ms += time_ms / num_iterations;
+    max_pcl_time_ms = std::max(max_pcl_time_ms, time_ms);
+  }
+
+  double fast_path_time_ms{0.0};
+  double max_fast_path_time_ms{0.0};
+  const std::vector<Polygon2d> ego_polys{corridor};
+  const auto ego_poly_envelopes = fast_path::calcEnvelopes(ego_polys);
+  for (int i = 0; i < num_iterations; ++i) {
+    const auto start = steady_clock::now();
+    PointCloud cropped;
+    fast_path::cropPointCloud(msg, std::nullopt, corridor, crop_param, cropped);
+    const auto clusters = fast_path::clusterPoints(cropped, cluster_param);
+    size_t closest_cluster_index = clusters.size();
+    size_t closest_poly_index = ego_polys.size();
+    for (size_t j = 0; j < clusters.size(); ++j) {
+      const auto poly_index = fast_path::findFirstContainingPolygon(
+        cropped, clusters.at(j), ego_polys, ego_poly_envelopes);
+      if (poly_index < closest_poly_index) {
+        closest_poly_index = poly_index;
+        closest_cluster_index = j;
+      }
+    }
+    if (closest_cluster_index < clusters.size()) {
+      fast_path::calcConvexHull2d(cropped, clusters.at(closest_cluster_index));
+    }
+    const double time_ms = duration<double, std::milli>(steady_clock::now() - start).count();
+    fast_path_time_ms += time_ms / num_iterations;
+    max_fast_path_time_ms = std::max(max_fast_path_time_ms, time_ms);
+  }
+
+  std::cout << "points: " << num_points << "\n"
+            << "pcl pipeline:  mean " << pcl_time_ms << " ms, max " << max_pcl_time_ms << " ms\n"
+            << "fast path:     mean " << fast_path_time_ms << " ms, max " << max_fast_path_time_ms
+            << " ms" << std::endl;
+}
+
+}  // namespace autoware::motion::control::autonomous_emergency_braking::test
@@ -15,6 +15,8 @@
 #ifndef AUTOWARE__LANE_DEPARTURE_CHECKER__LANE_DEPARTURE_CHECKER_HPP_
 #define AUTOWARE__LANE_DEPARTURE_CHECKER__LANE_DEPARTURE_CHECKER_HPP_
 
+#include "autoware/lane_departure_checker/util/lanelet_polygon_index.hpp"
+
 #include <autoware/universe_utils/geometry/boost_geometry.hpp>
 #include <autoware/universe_utils/geometry/pose_deviation.hpp>
 #include <autoware/universe_utils/system/time_keeper.hpp>
@@ -42,6 +44,8 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -143,8 +147,53 @@ public:
     const lanelet::ConstLanelets & candidate_lanelets, const LinearRing2d & vehicle_footprint);
 
 private:
+  // Union of the lanelet polygons fused so far. It only grows as the path advances, until it is
+  // reset on a map change or when it gets too large. A copy of the checker starts with an empty
+  // cache of its own.
+  struct FusedLaneletPolygonCache
+  {
+    FusedLaneletPolygonCache() = default;
+    FusedLaneletPolygonCache(const FusedLaneletPolygonCache &) {}
+    FusedLaneletPolygonCache & operator=(const FusedLaneletPolygonCache &)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      clear();
+      return *this;
+    }
+    void clear()
+    {
+      lanelet_ids.clear();
+      fused_polygon.clear();
+      connected_lanelet_pairs.clear();
+    }
+
+    std::mutex mutex;
+    std::weak_ptr<const lanelet::LaneletMap> lanelet_map;
+    std::set<lanelet::Id> lanelet_ids;
+    autoware::universe_utils::MultiPolygon2d fused_polygon;
+    // whether the union of two lanelets is a single polygon, by the pair of their ids
+    std::map<std::pair<lanelet::Id, lanelet::Id>, bool> connected_lanelet_pairs;
+  };
+
   Param param_;
   std::shared_ptr<autoware::vehicle_info_utils::VehicleInfo> vehicle_info_ptr_;
+  LaneletPolygonIndex route_lanelet_index_;
+  LaneletPolygonIndex shoulder_lanelet_index_;
+  mutable FusedLaneletPolygonCache fused_lanelet_polygon_cache_;
+
+  std::vector<std::pair<double, lanelet::Lanelet>> getLaneletsFromFootprints(
+    const lanelet::LaneletMapPtr lanelet_map_ptr,
+    const std::vector<LinearRing2d> & vehicle_footprints) const;
+
+  /**
+   * @brief Get the fused polygon of the lanelets around the footprints
+   * @param allow_superset if true, the polygon may also contain lanelets that do not intersect the
+   * hull of the footprints. This does not change whether a footprint is within the polygon, and
+   * allows reusing the cached polygon as the path advances.
+   */
+  std::optional<autoware::universe_utils::Polygon2d> getFusedLaneletPolygonForFootprints(
+    const lanelet::LaneletMapPtr lanelet_map_ptr,
+    const std::vector<LinearRing2d> & vehicle_footprints, const bool allow_superset) const;
 
   static PoseDeviation calcTrajectoryDeviation(
     const Trajectory & trajectory, const geometry_msgs::msg::Pose & pose,
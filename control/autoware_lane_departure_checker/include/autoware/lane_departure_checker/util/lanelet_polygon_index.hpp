@@ -0,0 +1,65 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__LANE_DEPARTURE_CHECKER__UTIL__LANELET_POLYGON_INDEX_HPP_
+#define AUTOWARE__LANE_DEPARTURE_CHECKER__UTIL__LANELET_POLYGON_INDEX_HPP_
+
+#include <autoware/universe_utils/geometry/boost_geometry.hpp>
+
+#include <boost/geometry/index/rtree.hpp>
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace autoware::lane_departure_checker
+{
+using autoware::universe_utils::Box2d;
+using autoware::universe_utils::LinearRing2d;
+using autoware::universe_utils::Point2d;
+
+/**
+ * @brief R-tree over the 2d polygons of a set of lanelets. The polygons are converted once when
+ * the set of lanelets changes, instead of on every query.
+ */
+class LaneletPolygonIndex
+{
+public:
+  /**
+   * @brief Rebuild the index if the lanelets differ from the indexed ones
+   * @return true if the index was rebuilt
+   */
+  bool update(const lanelet::ConstLanelets & lanelets);
+
+  /**
+   * @brief Get the lanelets whose polygon is not disjoint from the given area, in the order they
+   * were given to update()
+   */
+  lanelet::ConstLanelets findIntersecting(const LinearRing2d & area) const;
+
+  bool empty() const { return lanelets_.empty(); }
+
+private:
+  using Polygon = lanelet::BasicPolygon2d;
+  using Value = std::pair<Box2d, size_t>;
+  boost::geometry::index::rtree<Value, boost::geometry::index::rstar<16>> rtree_;
+  lanelet::ConstLanelets lanelets_;
+  std::vector<const lanelet::LaneletData *> lanelet_data_;
+  std::vector<Polygon> polygons_;
+};
+}  // namespace autoware::lane_departure_checker
+
+#endif  // AUTOWARE__LANE_DEPARTURE_CHECKER__UTIL__LANELET_POLYGON_INDEX_HPP_
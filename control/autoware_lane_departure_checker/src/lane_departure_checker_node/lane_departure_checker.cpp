@@ -28,6 +28,9 @@
 #include <tf2/utils.h>
 
 #include <algorithm>
+#include <map>
+#include <numeric>
+#include <utility>
 #include <vector>
 
 using autoware::motion_utils::calcArcLength;
@@ -61,6 +64,77 @@ bool isInAnyLane(const lanelet::ConstLanelets & candidate_lanelets, const Point2
   return false;
 }
 
+bool isInAnyLane(
+  const std::vector<lanelet::BasicPolygon2d> & candidate_polygons, const Point2d & point)
+{
+  return std::any_of(
+    candidate_polygons.begin(), candidate_polygons.end(),
+    [&](const auto & polygon) { return boost::geometry::within(point, polygon); });
+}
+
+autoware::universe_utils::Polygon2d toPolygon2d(const lanelet::BasicPolygon2d & poly)
+{
+  autoware::universe_utils::Polygon2d polygon;
+  auto & outer = polygon.outer();
+
+  for (const auto & p : poly) {
+    autoware::universe_utils::Point2d p2d(p.x(), p.y());
+    outer.push_back(p2d);
+  }
+  boost::geometry::correct(polygon);
+  return polygon;
+}
+
+void fuseLanelet(const lanelet::ConstLanelet & ll, MultiPolygon2d & lanelet_unions)
+{
+  MultiPolygon2d result;
+  boost::geometry::union_(lanelet_unions, toPolygon2d(ll.polygon2d().basicPolygon()), result);
+  lanelet_unions = std::move(result);
+}
+
+// Whether the union of the lanelets is a single polygon. Two lanelets are connected if their union
+// is a single polygon, i.e. they overlap or share an edge, which is kept by the pair of ids.
+bool isSinglePolygonUnion(
+  const std::vector<std::pair<double, lanelet::Lanelet>> & lanelets,
+  std::map<std::pair<lanelet::Id, lanelet::Id>, bool> & connected_lanelet_pairs)
+{
+  std::vector<size_t> parents(lanelets.size());
+  std::iota(parents.begin(), parents.end(), 0);
+  const auto find_root = [&parents](size_t i) {
+    while (parents.at(i) != i) {
+      i = parents.at(i) = parents.at(parents.at(i));
+    }
+    return i;
+  };
+
+  size_t nb_components = lanelets.size();
+  for (size_t i = 0; i < lanelets.size() && nb_components > 1; ++i) {
+    for (size_t j = i + 1; j < lanelets.size(); ++j) {
+      const auto root_i = find_root(i);
+      const auto root_j = find_root(j);
+      if (root_i == root_j) continue;
+
+      const auto & lanelet_i = lanelets.at(i).second;
+      const auto & lanelet_j = lanelets.at(j).second;
+      const auto key = std::make_pair(
+        std::min(lanelet_i.id(), lanelet_j.id()), std::max(lanelet_i.id(), lanelet_j.id()));
+      auto connected = connected_lanelet_pairs.find(key);
+      if (connected == connected_lanelet_pairs.end()) {
+        MultiPolygon2d pair_union;
+        boost::geometry::union_(
+          toPolygon2d(lanelet_i.polygon2d().basicPolygon()),
+          toPolygon2d(lanelet_j.polygon2d().basicPolygon()), pair_union);
+        connected = connected_lanelet_pairs.emplace(key, pair_union.size() == 1).first;
+      }
+      if (connected->second) {
+        parents.at(root_j) = root_i;
+        --nb_components;
+      }
+    }
+  }
+  return nb_components <= 1;
+}
+
 LinearRing2d createHullFromFootprints(const std::vector<LinearRing2d> & footprints)
 {
   MultiPoint2d combined;
@@ -129,10 +203,12 @@ Output LaneDepartureChecker::update(const Input & input)
   output.vehicle_passing_areas = createVehiclePassingAreas(output.vehicle_footprints);
   output.processing_time_map["createVehiclePassingAreas"] = stop_watch.toc(true);
 
-  const auto candidate_road_lanelets =
-    getCandidateLanelets(input.route_lanelets, output.vehicle_footprints);
-  const auto candidate_shoulder_lanelets =
-    getCandidateLanelets(input.shoulder_lanelets, output.vehicle_footprints);
+  // The lanelet polygons are only indexed again when the route or the map changes
+  route_lanelet_index_.update(input.route_lanelets);
+  shoulder_lanelet_index_.update(input.shoulder_lanelets);
+  const auto footprint_hull = createHullFromFootprints(output.vehicle_footprints);
+  const auto candidate_road_lanelets = route_lanelet_index_.findIntersecting(footprint_hull);
+  const auto candidate_shoulder_lanelets = shoulder_lanelet_index_.findIntersecting(footprint_hull);
   output.candidate_lanelets = candidate_road_lanelets;
   output.candidate_lanelets.insert(
     output.candidate_lanelets.end(), candidate_shoulder_lanelets.begin(),
@@ -296,8 +372,19 @@ bool LaneDepartureChecker::willLeaveLane(
 {
   universe_utils::ScopedTimeTrack st(__func__, *time_keeper_);
 
+  // convert the candidate polygons once instead of for each footprint point
+  std::vector<lanelet::BasicPolygon2d> candidate_polygons;
+  candidate_polygons.reserve(candidate_lanelets.size());
+  for (const auto & ll : candidate_lanelets) {
+    candidate_polygons.push_back(ll.polygon2d().basicPolygon());
+  }
+
   for (const auto & vehicle_footprint : vehicle_footprints) {
-    if (isOutOfLane(candidate_lanelets, vehicle_footprint)) {
+    const bool is_out_of_lane =
+      std::any_of(vehicle_footprint.begin(), vehicle_footprint.end(), [&](const auto & point) {
+        return !isInAnyLane(candidate_polygons, point);
+      });
+    if (is_out_of_lane) {
       return true;
     }
   }
@@ -310,8 +397,14 @@ std::vector<std::pair<double, lanelet::Lanelet>> LaneDepartureChecker::getLanele
 {
   universe_utils::ScopedTimeTrack st(__func__, *time_keeper_);
 
+  return getLaneletsFromFootprints(lanelet_map_ptr, createVehicleFootprints(path));
+}
+
+std::vector<std::pair<double, lanelet::Lanelet>> LaneDepartureChecker::getLaneletsFromFootprints(
+  const lanelet::LaneletMapPtr lanelet_map_ptr,
+  const std::vector<LinearRing2d> & vehicle_footprints) const
+{
   // Get Footprint Hull basic polygon
-  std::vector<LinearRing2d> vehicle_footprints = createVehicleFootprints(path);
   LinearRing2d footprint_hull = createHullFromFootprints(vehicle_footprints);
   auto to_basic_polygon = [](const LinearRing2d & footprint_hull) -> lanelet::BasicPolygon2d {
     lanelet::BasicPolygon2d basic_polygon;
@@ -334,40 +427,71 @@ LaneDepartureChecker::getFusedLaneletPolygonForPath(
 {
   universe_utils::ScopedTimeTrack st(__func__, *time_keeper_);
 
-  const auto lanelets_distance_pair = getLaneletsFromPath(lanelet_map_ptr, path);
-  auto to_polygon2d =
-    [](const lanelet::BasicPolygon2d & poly) -> autoware::universe_utils::Polygon2d {
-    autoware::universe_utils::Polygon2d polygon;
-    auto & outer = polygon.outer();
+  return getFusedLaneletPolygonForFootprints(
+    lanelet_map_ptr, createVehicleFootprints(path), false);
+}
 
-    for (const auto & p : poly) {
-      autoware::universe_utils::Point2d p2d(p.x(), p.y());
-      outer.push_back(p2d);
+std::optional<autoware::universe_utils::Polygon2d>
+LaneDepartureChecker::getFusedLaneletPolygonForFootprints(
+  const lanelet::LaneletMapPtr lanelet_map_ptr,
+  const std::vector<LinearRing2d> & vehicle_footprints, const bool allow_superset) const
+{
+  const auto lanelets_distance_pair =
+    getLaneletsFromFootprints(lanelet_map_ptr, vehicle_footprints);
+  if (lanelets_distance_pair.empty()) return std::nullopt;
+
+  // Fuse lanelets into a single polygon, from scratch
+  const auto fuse_lanelets = [&]() {
+    MultiPolygon2d lanelet_unions;
+    for (const auto & [distance, route_lanelet] : lanelets_distance_pair) {
+      fuseLanelet(route_lanelet, lanelet_unions);
     }
-    boost::geometry::correct(polygon);
-    return polygon;
+    return lanelet_unions;
   };
 
-  // Fuse lanelets into a single BasicPolygon2d
-  auto fused_lanelets = [&]() -> std::optional<autoware::universe_utils::Polygon2d> {
-    if (lanelets_distance_pair.empty()) return std::nullopt;
-    autoware::universe_utils::MultiPolygon2d lanelet_unions;
-    autoware::universe_utils::MultiPolygon2d result;
-
-    for (size_t i = 0; i < lanelets_distance_pair.size(); ++i) {
-      const auto & route_lanelet = lanelets_distance_pair.at(i).second;
-      const auto & p = route_lanelet.polygon2d().basicPolygon();
-      autoware::universe_utils::Polygon2d poly = to_polygon2d(p);
-      boost::geometry::union_(lanelet_unions, poly, result);
-      lanelet_unions = result;
-      result.clear();
-    }
+  auto & cache = fused_lanelet_polygon_cache_;
+  std::lock_guard<std::mutex> lock(cache.mutex);
+
+  // Reset the cache if the map changed, or if most of the cached lanelets are already behind
+  constexpr size_t max_cached_lanelets_ratio = 2;
+  if (
+    cache.lanelet_map.lock() != lanelet_map_ptr ||
+    cache.lanelet_ids.size() > max_cached_lanelets_ratio * lanelets_distance_pair.size()) {
+    cache.lanelet_map = lanelet_map_ptr;
+    cache.clear();
+  }
 
-    if (lanelet_unions.empty()) return std::nullopt;
-    return lanelet_unions.front();
-  }();
+  // Only the lanelets that are not fused yet are added, which are the ones ahead as the path
+  // advances
+  for (const auto & [distance, route_lanelet] : lanelets_distance_pair) {
+    if (cache.lanelet_ids.insert(route_lanelet.id()).second) {
+      fuseLanelet(route_lanelet, cache.fused_polygon);
+    }
+  }
+  // If the exact union is a multipolygon, only its front polygon is used, while the cached polygon
+  // may join its polygons through the extra lanelets and contain more footprints, so the superset
+  // is only used when the exact union is a single polygon too
+  const bool is_exact = cache.lanelet_ids.size() == lanelets_distance_pair.size();
+  if (
+    cache.fused_polygon.size() == 1 &&
+    (is_exact ||
+     (allow_superset &&
+      isSinglePolygonUnion(lanelets_distance_pair, cache.connected_lanelet_pairs)))) {
+    return cache.fused_polygon.front();
+  }
 
-  return fused_lanelets;
+  // The extra lanelets split the fused polygon or are not allowed, or the lanelets are not
+  // connected, so fuse the lanelets exactly
+  auto fused_lanelets = fuse_lanelets();
+  if (cache.fused_polygon.size() != 1) {
+    cache.lanelet_ids.clear();
+    for (const auto & [distance, route_lanelet] : lanelets_distance_pair) {
+      cache.lanelet_ids.insert(route_lanelet.id());
+    }
+    cache.fused_polygon = fused_lanelets;
+  }
+  if (fused_lanelets.empty()) return std::nullopt;
+  return fused_lanelets.front();
 }
 
 bool LaneDepartureChecker::checkPathWillLeaveLane(
@@ -377,7 +501,8 @@ bool LaneDepartureChecker::checkPathWillLeaveLane(
 
   // check if the footprint is not fully contained within the fused lanelets polygon
   const std::vector<LinearRing2d> vehicle_footprints = createVehicleFootprints(path);
-  const auto fused_lanelets_polygon = getFusedLaneletPolygonForPath(lanelet_map_ptr, path);
+  const auto fused_lanelets_polygon =
+    getFusedLaneletPolygonForFootprints(lanelet_map_ptr, vehicle_footprints, true);
   if (!fused_lanelets_polygon) return true;
   return !std::all_of(
     vehicle_footprints.begin(), vehicle_footprints.end(),
@@ -392,9 +517,11 @@ PathWithLaneId LaneDepartureChecker::cropPointsOutsideOfLanes(
   universe_utils::ScopedTimeTrack st(__func__, *time_keeper_);
 
   PathWithLaneId temp_path;
-  const auto fused_lanelets_polygon = getFusedLaneletPolygonForPath(lanelet_map_ptr, path);
-  if (path.points.empty() || !fused_lanelets_polygon) return temp_path;
+  if (path.points.empty()) return temp_path;
   const auto vehicle_footprints = createVehicleFootprints(path);
+  const auto fused_lanelets_polygon =
+    getFusedLaneletPolygonForFootprints(lanelet_map_ptr, vehicle_footprints, true);
+  if (!fused_lanelets_polygon) return temp_path;
 
   {
     universe_utils::ScopedTimeTrack st2(
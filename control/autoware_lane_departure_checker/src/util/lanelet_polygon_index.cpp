@@ -0,0 +1,84 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/lane_departure_checker/util/lanelet_polygon_index.hpp"
+
+#include <boost/geometry.hpp>
+
+#include <lanelet2_core/geometry/Polygon.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace autoware::lane_departure_checker
+{
+bool LaneletPolygonIndex::update(const lanelet::ConstLanelets & lanelets)
+{
+  // compare the lanelet data instead of the ids, so that reloading the map also rebuilds the index
+  const bool is_same_lanelets = std::equal(
+    lanelets.begin(), lanelets.end(), lanelet_data_.begin(), lanelet_data_.end(),
+    [](const auto & lanelet, const auto data) { return lanelet.constData().get() == data; });
+  if (is_same_lanelets) {
+    return false;
+  }
+
+  lanelets_ = lanelets;
+  lanelet_data_.clear();
+  polygons_.clear();
+  std::vector<Value> values;
+  values.reserve(lanelets.size());
+  for (const auto & lanelet : lanelets) {
+    lanelet_data_.push_back(lanelet.constData().get());
+    polygons_.push_back(lanelet.polygon2d().basicPolygon());
+
+    Box2d box{
+      {std::numeric_limits<double>::max(), std::numeric_limits<double>::max()},
+      {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()}};
+    for (const auto & p : polygons_.back()) {
+      box.min_corner().x() = std::min(box.min_corner().x(), p.x());
+      box.min_corner().y() = std::min(box.min_corner().y(), p.y());
+      box.max_corner().x() = std::max(box.max_corner().x(), p.x());
+      box.max_corner().y() = std::max(box.max_corner().y(), p.y());
+    }
+    values.emplace_back(box, values.size());
+  }
+  // packing construction is faster to build and to query than inserting one by one
+  rtree_ = decltype(rtree_)(values.begin(), values.end());
+  return true;
+}
+
+lanelet::ConstLanelets LaneletPolygonIndex::findIntersecting(const LinearRing2d & area) const
+{
+  std::vector<Value> candidates;
+  Box2d area_box;
+  boost::geometry::envelope(area, area_box);
+  rtree_.query(boost::geometry::index::intersects(area_box), std::back_inserter(candidates));
+
+  std::vector<size_t> indices;
+  for (const auto & [box, index] : candidates) {
+    if (!boost::geometry::disjoint(polygons_.at(index), area)) {
+      indices.push_back(index);
+    }
+  }
+  std::sort(indices.begin(), indices.end());
+
+  lanelet::ConstLanelets intersecting_lanelets;
+  intersecting_lanelets.reserve(indices.size());
+  for (const auto index : indices) {
+    intersecting_lanelets.push_back(lanelets_.at(index));
+  }
+  return intersecting_lanelets;
+}
+}  // namespace autoware::lane_departure_checker
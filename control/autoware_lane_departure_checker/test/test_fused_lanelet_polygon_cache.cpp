@@ -0,0 +1,226 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/lane_departure_checker/lane_departure_checker.hpp"
+
+#include <autoware/universe_utils/geometry/geometry.hpp>
+#include <autoware_vehicle_info_utils/vehicle_info.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using autoware::lane_departure_checker::LaneDepartureChecker;
+using autoware::lane_departure_checker::Param;
+using autoware::lane_departure_checker::PathWithLaneId;
+
+namespace
+{
+constexpr double lanelet_length = 10.0;
+constexpr double lane_width = 3.5;
+
+// rectangular lanelet along the x axis, which uses 7 ids from the given one
+lanelet::Lanelet makeLanelet(lanelet::Id & id, const double x, const double right_y)
+{
+  const lanelet::Point3d left_0(id++, x, right_y + lane_width, 0.0);
+  const lanelet::Point3d left_1(id++, x + lanelet_length, right_y + lane_width, 0.0);
+  const lanelet::Point3d right_0(id++, x, right_y, 0.0);
+  const lanelet::Point3d right_1(id++, x + lanelet_length, right_y, 0.0);
+  const lanelet::LineString3d left(id++, {left_0, left_1});
+  const lanelet::LineString3d right(id++, {right_0, right_1});
+  return lanelet::Lanelet(id++, left, right);
+}
+
+// road along the x axis made of nb_lanes lanes of nb_lanelets lanelets each
+lanelet::LaneletMapPtr makeRoad(
+  const size_t nb_lanes, const size_t nb_lanelets, const lanelet::Id first_id)
+{
+  lanelet::Id id = first_id;
+  lanelet::Lanelets lanelets;
+  for (size_t lane = 0; lane < nb_lanes; ++lane) {
+    const double right_y = static_cast<double>(lane) * lane_width;
+    for (size_t i = 0; i < nb_lanelets; ++i) {
+      lanelets.push_back(makeLanelet(id, static_cast<double>(i) * lanelet_length, right_y));
+    }
+  }
+  return lanelet::utils::createMap(lanelets);
+}
+
+// path starting at x, with a lateral offset following the given function of the arc length
+template <class LateralOffset>
+PathWithLaneId makePath(
+  const double x, const double length, const double y, const LateralOffset & lateral_offset)
+{
+  constexpr double interval = 1.0;
+  PathWithLaneId path;
+  for (double s = 0.0; s <= length; s += interval) {
+    tier4_planning_msgs::msg::PathPointWithLaneId p;
+    p.point.pose.position.x = x + s;
+    p.point.pose.position.y = y + lateral_offset(s);
+    const double dy = lateral_offset(s + 0.5 * interval) - lateral_offset(s - 0.5 * interval);
+    p.point.pose.orientation =
+      autoware::universe_utils::createQuaternionFromYaw(std::atan2(dy, interval));
+    path.points.push_back(p);
+  }
+  return path;
+}
+
+LaneDepartureChecker makeChecker()
+{
+  LaneDepartureChecker checker;
+  Param param;
+  param.footprint_extra_margin = 0.0;
+  checker.setParam(
+    param, autoware::vehicle_info_utils::createVehicleInfo(
+             0.39, 0.42, 2.74, 1.63, 1.0, 1.03, 0.1, 0.1, 2.5, 0.7));
+  return checker;
+}
+
+// compare the results of the checker, which keeps its cache between the calls, with the results
+// of a new checker, which fuses exactly the lanelets around the path
+void expectSameAsExactUnion(
+  LaneDepartureChecker & checker, const lanelet::LaneletMapPtr & lanelet_map,
+  const PathWithLaneId & path)
+{
+  auto exact_checker = makeChecker();
+  EXPECT_EQ(
+    checker.checkPathWillLeaveLane(lanelet_map, path),
+    exact_checker.checkPathWillLeaveLane(lanelet_map, path));
+
+  for (const size_t end_index : {size_t{0}, path.points.size() / 2, path.points.size()}) {
+    const auto cropped_path = checker.cropPointsOutsideOfLanes(lanelet_map, path, end_index);
+    const auto exact_cropped_path =
+      exact_checker.cropPointsOutsideOfLanes(lanelet_map, path, end_index);
+    ASSERT_EQ(cropped_path.points.size(), exact_cropped_path.points.size());
+    for (size_t i = 0; i < cropped_path.points.size(); ++i) {
+      EXPECT_EQ(cropped_path.points[i], exact_cropped_path.points[i]);
+    }
+  }
+}
+}  // namespace
+
+TEST(FusedLaneletPolygonCache, RouteAdvance)
+{
+  const auto lanelet_map = makeRoad(2, 20, 1);
+  auto checker = makeChecker();
+  const auto straight = [](const double) { return 0.0; };
+  const auto lane_change = [](const double s) {
+    return lane_width * 0.5 * (1.0 - std::cos(M_PI * std::clamp(s / 30.0, 0.0, 1.0)));
+  };
+  const auto departure = [](const double s) { return s > 20.0 ? 2.0 : 0.0; };
+
+  // the path advances along the road, so that the cache keeps some lanelets that are behind
+  for (double x = 0.0; x < 140.0; x += 3.0) {
+    expectSameAsExactUnion(checker, lanelet_map, makePath(x, 40.0, 0.5 * lane_width, straight));
+    expectSameAsExactUnion(checker, lanelet_map, makePath(x, 40.0, 0.5 * lane_width, lane_change));
+    expectSameAsExactUnion(checker, lanelet_map, makePath(x, 40.0, 1.5 * lane_width, departure));
+  }
+  // the path goes back to the start of the road
+  expectSameAsExactUnion(checker, lanelet_map, makePath(0.0, 40.0, 0.5 * lane_width, departure));
+}
+
+TEST(FusedLaneletPolygonCache, RandomPaths)
+{
+  const auto lanelet_map = makeRoad(2, 20, 1);
+  auto checker = makeChecker();
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> x_dist(0.0, 150.0);
+  std::uniform_real_distribution<double> y_dist(0.0, 2.0 * lane_width);
+  std::uniform_real_distribution<double> length_dist(5.0, 50.0);
+  std::uniform_real_distribution<double> slope_dist(-0.1, 0.1);
+  for (int i = 0; i < 200; ++i) {
+    const double slope = slope_dist(engine);
+    expectSameAsExactUnion(
+      checker, lanelet_map,
+      makePath(x_dist(engine), length_dist(engine), y_dist(engine), [slope](const double s) {
+        return slope * s;
+      }));
+  }
+}
+
+TEST(FusedLaneletPolygonCache, MapChange)
+{
+  auto checker = makeChecker();
+  const auto straight = [](const double) { return 0.0; };
+  const auto path = makePath(10.0, 40.0, 1.5 * lane_width, straight);
+
+  // the path is on the second lane
+  const auto two_lanes_map = makeRoad(2, 20, 1);
+  expectSameAsExactUnion(checker, two_lanes_map, path);
+  EXPECT_FALSE(checker.checkPathWillLeaveLane(two_lanes_map, path));
+
+  // a new map with the same ids but only one lane: the lanelets of the previous map are not used
+  const auto one_lane_map = makeRoad(1, 20, 1);
+  expectSameAsExactUnion(checker, one_lane_map, path);
+  EXPECT_TRUE(checker.checkPathWillLeaveLane(one_lane_map, path));
+
+  // reloading the first map
+  const auto reloaded_map = makeRoad(2, 20, 1);
+  expectSameAsExactUnion(checker, reloaded_map, path);
+  EXPECT_FALSE(checker.checkPathWillLeaveLane(reloaded_map, path));
+}
+
+TEST(FusedLaneletPolygonCache, Copies)
+{
+  const auto lanelet_map = makeRoad(2, 20, 1);
+  auto checker = makeChecker();
+  const auto straight = [](const double) { return 0.0; };
+  expectSameAsExactUnion(checker, lanelet_map, makePath(0.0, 40.0, 0.5 * lane_width, straight));
+
+  // each copy starts with an empty cache of its own
+  auto copied_checker = checker;
+  auto assigned_checker = makeChecker();
+  expectSameAsExactUnion(
+    assigned_checker, lanelet_map, makePath(100.0, 40.0, 0.5 * lane_width, straight));
+  assigned_checker = checker;
+  for (double x = 0.0; x < 140.0; x += 5.0) {
+    expectSameAsExactUnion(checker, lanelet_map, makePath(x, 40.0, 0.5 * lane_width, straight));
+    expectSameAsExactUnion(
+      copied_checker, lanelet_map, makePath(x + 20.0, 20.0, 1.5 * lane_width, straight));
+    expectSameAsExactUnion(
+      assigned_checker, lanelet_map, makePath(140.0 - x, 20.0, 0.5 * lane_width, straight));
+  }
+}
+
+TEST(FusedLaneletPolygonCache, DisconnectedLanelets)
+{
+  // two lanes with a gap between them, connected by a single lanelet at the start of the road
+  lanelet::Id id = 1;
+  lanelet::Lanelets lanelets;
+  for (size_t i = 0; i < 10; ++i) {
+    const double x = static_cast<double>(i) * lanelet_length;
+    lanelets.push_back(makeLanelet(id, x, 0.0));
+    lanelets.push_back(makeLanelet(id, x, 2.0 * lane_width));
+  }
+  lanelets.push_back(makeLanelet(id, 0.0, lane_width));
+  const auto lanelet_map = lanelet::utils::createMap(lanelets);
+
+  auto checker = makeChecker();
+  const auto lane_change = [](const double s) {
+    return lane_width * (1.0 - std::cos(M_PI * std::clamp(s / 15.0, 0.0, 1.0)));
+  };
+  // the cache holds the start of both lanes and the lanelet connecting them
+  expectSameAsExactUnion(checker, lanelet_map, makePath(0.0, 15.0, 0.5 * lane_width, lane_change));
+
+  // the lanelets around the path are the two lanes only, whose union is two polygons, while the
+  // cached polygon is a single one through the connecting lanelet
+  const auto back_lane_change = [&](const double s) { return -lane_change(s); };
+  expectSameAsExactUnion(
+    checker, lanelet_map, makePath(25.0, 30.0, 2.5 * lane_width, back_lane_change));
+  expectSameAsExactUnion(
+    checker, lanelet_map, makePath(25.0, 30.0, 0.5 * lane_width, lane_change));
+}
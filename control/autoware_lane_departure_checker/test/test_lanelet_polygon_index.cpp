@@ -0,0 +1,157 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/lane_departure_checker/util/lanelet_polygon_index.hpp"
+
+#include <boost/geometry.hpp>
+
+#include <gtest/gtest.h>
+#include <lanelet2_core/geometry/Polygon.h>
+
+#include <cmath>
+#include <random>
+
+using autoware::lane_departure_checker::LaneletPolygonIndex;
+using autoware::lane_departure_checker::LinearRing2d;
+
+namespace
+{
+lanelet::Lanelet makeLanelet(
+  const lanelet::Id id, const double x, const double y, const double length, const double width,
+  const double skew)
+{
+  const lanelet::Point3d left_0(lanelet::InvalId, x, y + width, 0.0);
+  const lanelet::Point3d left_1(lanelet::InvalId, x + length + skew, y + width, 0.0);
+  const lanelet::Point3d right_0(lanelet::InvalId, x, y, 0.0);
+  const lanelet::Point3d right_1(lanelet::InvalId, x + length, y, 0.0);
+  return lanelet::Lanelet(
+    id, lanelet::LineString3d(lanelet::InvalId, {left_0, left_1}),
+    lanelet::LineString3d(lanelet::InvalId, {right_0, right_1}));
+}
+
+LinearRing2d makeArea(const double x, const double y, const double size, const double yaw)
+{
+  LinearRing2d area;
+  const double c = std::cos(yaw) * size;
+  const double s = std::sin(yaw) * size;
+  area.emplace_back(x + c, y + s);
+  area.emplace_back(x - s, y + c);
+  area.emplace_back(x - c, y - s);
+  area.emplace_back(x + s, y - c);
+  area.emplace_back(x + c, y + s);
+  boost::geometry::correct(area);
+  return area;
+}
+
+// the linear scan used before the index
+lanelet::ConstLanelets findIntersectingByScan(
+  const lanelet::ConstLanelets & lanelets, const LinearRing2d & area)
+{
+  lanelet::ConstLanelets intersecting_lanelets;
+  for (const auto & lanelet : lanelets) {
+    if (!boost::geometry::disjoint(lanelet.polygon2d().basicPolygon(), area)) {
+      intersecting_lanelets.push_back(lanelet);
+    }
+  }
+  return intersecting_lanelets;
+}
+
+lanelet::ConstLanelets makeRandomLanelets(std::default_random_engine & engine, const size_t size)
+{
+  std::uniform_real_distribution<double> position_dist(-100.0, 100.0);
+  std::uniform_real_distribution<double> length_dist(1.0, 20.0);
+  std::uniform_real_distribution<double> width_dist(1.0, 5.0);
+  std::uniform_real_distribution<double> skew_dist(-2.0, 2.0);
+  lanelet::ConstLanelets lanelets;
+  for (size_t i = 0; i < size; ++i) {
+    lanelets.push_back(makeLanelet(
+      static_cast<lanelet::Id>(i + 1), position_dist(engine), position_dist(engine),
+      length_dist(engine), width_dist(engine), skew_dist(engine)));
+  }
+  return lanelets;
+}
+}  // namespace
+
+TEST(LaneletPolygonIndex, Empty)
+{
+  LaneletPolygonIndex index;
+  EXPECT_TRUE(index.empty());
+  EXPECT_FALSE(index.update({}));
+  EXPECT_TRUE(index.findIntersecting(makeArea(0.0, 0.0, 1.0, 0.0)).empty());
+}
+
+TEST(LaneletPolygonIndex, SameAsScan)
+{
+  std::default_random_engine engine(0);
+  std::uniform_real_distribution<double> position_dist(-110.0, 110.0);
+  std::uniform_real_distribution<double> size_dist(0.1, 15.0);
+  std::uniform_real_distribution<double> yaw_dist(-M_PI, M_PI);
+  const auto lanelets = makeRandomLanelets(engine, 200);
+
+  LaneletPolygonIndex index;
+  EXPECT_TRUE(index.update(lanelets));
+  EXPECT_FALSE(index.empty());
+  size_t nb_non_empty_results = 0;
+  for (int i = 0; i < 1000; ++i) {
+    const auto area =
+      makeArea(position_dist(engine), position_dist(engine), size_dist(engine), yaw_dist(engine));
+    const auto expected = findIntersectingByScan(lanelets, area);
+    const auto result = index.findIntersecting(area);
+    ASSERT_EQ(result.size(), expected.size());
+    for (size_t j = 0; j < result.size(); ++j) {
+      EXPECT_EQ(result[j].id(), expected[j].id());
+    }
+    if (!result.empty()) ++nb_non_empty_results;
+  }
+  // make sure that the comparison is not only on empty results
+  EXPECT_GT(nb_non_empty_results, 100UL);
+}
+
+TEST(LaneletPolygonIndex, Touching)
+{
+  // an area touching the lanelet is not disjoint from it
+  const lanelet::ConstLanelets lanelets{makeLanelet(1, 0.0, 0.0, 10.0, 4.0, 0.0)};
+  LaneletPolygonIndex index;
+  index.update(lanelets);
+  const auto area = makeArea(11.0, 2.0, 1.0, M_PI_4);
+  EXPECT_EQ(index.findIntersecting(area).size(), findIntersectingByScan(lanelets, area).size());
+  EXPECT_EQ(index.findIntersecting(area).size(), 1UL);
+}
+
+TEST(LaneletPolygonIndex, Update)
+{
+  std::default_random_engine engine(0);
+  const auto lanelets = makeRandomLanelets(engine, 10);
+  LaneletPolygonIndex index;
+  EXPECT_TRUE(index.update(lanelets));
+  EXPECT_FALSE(index.update(lanelets));
+
+  // same ids but different lanelet objects, as after reloading the map
+  const auto reloaded_lanelets = makeRandomLanelets(engine, 10);
+  EXPECT_TRUE(index.update(reloaded_lanelets));
+  const auto area = makeArea(0.0, 0.0, 200.0, 0.0);
+  const auto result = index.findIntersecting(area);
+  ASSERT_EQ(result.size(), reloaded_lanelets.size());
+  for (size_t i = 0; i < result.size(); ++i) {
+    EXPECT_EQ(result[i].constData(), reloaded_lanelets[i].constData());
+  }
+
+  // a subset of the lanelets
+  const lanelet::ConstLanelets subset(reloaded_lanelets.begin() + 2, reloaded_lanelets.end());
+  EXPECT_TRUE(index.update(subset));
+  EXPECT_EQ(index.findIntersecting(area).size(), subset.size());
+
+  EXPECT_TRUE(index.update({}));
+  EXPECT_TRUE(index.empty());
+}
@@ -174,6 +174,9 @@ struct MPCData
  * Xex = Aex * X0 + Bex * Uex * Wex
  * Yex = Cex * Xex
  * Cost = Xex' * Qex * Xex + (Uex - Uref_ex)' * R1ex * (Uex - Uref_ex) +  Uex' * R2ex * Uex
+ * The condensed matrices of the QP are also kept:
+ * QCBex = Qex * Cex * Bex
+ * Hex = Bex' * Cex' * Qex * Cex * Bex + R1ex + R2ex
  */
 struct MPCMatrix
 {
@@ -185,6 +188,8 @@ struct MPCMatrix
   MatrixXd R1ex;
   MatrixXd R2ex;
   MatrixXd Uref_ex;
+  MatrixXd QCBex;
+  MatrixXd Hex;
 
   MPCMatrix() = default;
 };
@@ -222,6 +227,10 @@ private:
   double m_min_prediction_length = 5.0;  // Minimum prediction distance.
 
   rclcpp::Publisher<Trajectory>::SharedPtr m_debug_frenet_predicted_trajectory_pub;
+
+  // Workspace of the MPC matrix, which is reused in every cycle to avoid the reallocation.
+  MPCMatrix m_mpc_matrix;
+
   /**
    * @brief Get variables for MPC calculation.
    * @param trajectory The reference trajectory.
@@ -254,11 +263,22 @@ private:
    * @brief Generate the MPC matrix using the reference trajectory and vehicle model.
    * @param reference_trajectory The reference trajectory used for linearization.
    * @param prediction_dt The prediction time step.
-   * @return The generated MPC matrix.
+   * @return The generated MPC matrix, which is overwritten in the next call.
    */
-  MPCMatrix generateMPCMatrix(
+  const MPCMatrix & generateMPCMatrix(
     const MPCTrajectory & reference_trajectory, const double prediction_dt);
 
+  /**
+   * @brief Generate the MPC matrix with the blocks of the given dimensions. Eigen::Dynamic is used
+   * for the vehicle models whose dimensions are not specialized.
+   * @param reference_trajectory The reference trajectory used for linearization.
+   * @param prediction_dt The prediction time step.
+   * @param m The MPC matrix to be overwritten.
+   */
+  template <int DIM_X, int DIM_U, int DIM_Y>
+  void generateMPCMatrixImpl(
+    const MPCTrajectory & reference_trajectory, const double prediction_dt, MPCMatrix & m);
+
   /**
    * @brief Execute the optimization using the provided MPC matrix, initial state, and prediction
    * time step.
@@ -522,6 +542,8 @@ public:
    * @param clock The shared pointer to the RCLCPP clock.
    */
   inline void setClock(rclcpp::Clock::SharedPtr clock) { m_clock = clock; }
+
+  friend class MPCTest;  // for test code
 };  // class MPC
 }  // namespace autoware::motion::control::mpc_lateral_controller
 
@@ -73,7 +73,7 @@ bool MPC::calculateMPC(
   }
 
   // generate mpc matrix : predict equation Xec = Aex * x0 + Bex * Uex + Wex
-  const auto mpc_matrix = generateMPCMatrix(mpc_resampled_ref_trajectory, prediction_dt);
+  const auto & mpc_matrix = generateMPCMatrix(mpc_resampled_ref_trajectory, prediction_dt);
 
   // solve Optimization problem
   const auto [success_opt, Uex] = executeOptimization(
@@ -412,36 +412,67 @@ MPCTrajectory MPC::applyVelocityDynamicsFilter(
  * cost function: J = Xex' * Qex * Xex + (Uex - Uref)' * R1ex * (Uex - Uref_ex) + Uex' * R2ex * Uex
  * Qex = diag([Q,Q,...]), R1ex = diag([R,R,...])
  */
-MPCMatrix MPC::generateMPCMatrix(
+const MPCMatrix & MPC::generateMPCMatrix(
   const MPCTrajectory & reference_trajectory, const double prediction_dt)
 {
-  const int N = m_param.prediction_horizon;
-  const double DT = prediction_dt;
   const int DIM_X = m_vehicle_model_ptr->getDimX();
   const int DIM_U = m_vehicle_model_ptr->getDimU();
   const int DIM_Y = m_vehicle_model_ptr->getDimY();
 
-  MPCMatrix m;
-  m.Aex = MatrixXd::Zero(DIM_X * N, DIM_X);
-  m.Bex = MatrixXd::Zero(DIM_X * N, DIM_U * N);
-  m.Wex = MatrixXd::Zero(DIM_X * N, 1);
-  m.Cex = MatrixXd::Zero(DIM_Y * N, DIM_X * N);
-  m.Qex = MatrixXd::Zero(DIM_Y * N, DIM_Y * N);
-  m.R1ex = MatrixXd::Zero(DIM_U * N, DIM_U * N);
-  m.R2ex = MatrixXd::Zero(DIM_U * N, DIM_U * N);
-  m.Uref_ex = MatrixXd::Zero(DIM_U * N, 1);
-
-  // weight matrix depends on the vehicle model
-  MatrixXd Q = MatrixXd::Zero(DIM_Y, DIM_Y);
-  MatrixXd R = MatrixXd::Zero(DIM_U, DIM_U);
-  MatrixXd Q_adaptive = MatrixXd::Zero(DIM_Y, DIM_Y);
-  MatrixXd R_adaptive = MatrixXd::Zero(DIM_U, DIM_U);
+  // use the fixed-size blocks for the vehicle models in this package
+  if (DIM_U == 1 && DIM_Y == 2) {
+    if (DIM_X == 2) {
+      generateMPCMatrixImpl<2, 1, 2>(reference_trajectory, prediction_dt, m_mpc_matrix);
+      return m_mpc_matrix;
+    }
+    if (DIM_X == 3) {
+      generateMPCMatrixImpl<3, 1, 2>(reference_trajectory, prediction_dt, m_mpc_matrix);
+      return m_mpc_matrix;
+    }
+    if (DIM_X == 4) {
+      generateMPCMatrixImpl<4, 1, 2>(reference_trajectory, prediction_dt, m_mpc_matrix);
+      return m_mpc_matrix;
+    }
+  }
+  generateMPCMatrixImpl<Eigen::Dynamic, Eigen::Dynamic, Eigen::Dynamic>(
+    reference_trajectory, prediction_dt, m_mpc_matrix);
+  return m_mpc_matrix;
+}
 
-  MatrixXd Ad(DIM_X, DIM_X);
-  MatrixXd Bd(DIM_X, DIM_U);
-  MatrixXd Wd(DIM_X, 1);
-  MatrixXd Cd(DIM_Y, DIM_X);
-  MatrixXd Uref(DIM_U, 1);
+template <int DIM_X, int DIM_U, int DIM_Y>
+void MPC::generateMPCMatrixImpl(
+  const MPCTrajectory & reference_trajectory, const double prediction_dt, MPCMatrix & m)
+{
+  using MatrixXX = Eigen::Matrix<double, DIM_X, DIM_X>;
+  using MatrixXU = Eigen::Matrix<double, DIM_X, DIM_U>;
+  using MatrixYX = Eigen::Matrix<double, DIM_Y, DIM_X>;
+  using MatrixYY = Eigen::Matrix<double, DIM_Y, DIM_Y>;
+  using MatrixUU = Eigen::Matrix<double, DIM_U, DIM_U>;
+  using VectorX = Eigen::Matrix<double, DIM_X, 1>;
+
+  const int N = m_param.prediction_horizon;
+  const double DT = prediction_dt;
+  const int dim_x = m_vehicle_model_ptr->getDimX();
+  const int dim_u = m_vehicle_model_ptr->getDimU();
+  const int dim_y = m_vehicle_model_ptr->getDimY();
+
+  // the storage is reused if the size is not changed
+  m.Aex.setZero(dim_x * N, dim_x);
+  m.Bex.setZero(dim_x * N, dim_u * N);
+  m.Wex.setZero(dim_x * N, 1);
+  m.Cex.setZero(dim_y * N, dim_x * N);
+  m.Qex.setZero(dim_y * N, dim_y * N);
+  m.R1ex.setZero(dim_u * N, dim_u * N);
+  m.R2ex.setZero(dim_u * N, dim_u * N);
+  m.Uref_ex.setZero(dim_u * N, 1);
+  m.QCBex.setZero(dim_y * N, dim_u * N);
+
+  // the vehicle model interface uses the dynamic-size matrices
+  MatrixXd Ad(dim_x, dim_x);
+  MatrixXd Bd(dim_x, dim_u);
+  MatrixXd Wd(dim_x, 1);
+  MatrixXd Cd(dim_y, dim_x);
+  MatrixXd Uref(dim_u, 1);
 
   const double sign_vx = m_is_forward_shift ? 1 : -1;
 
@@ -458,16 +489,17 @@ MPCMatrix MPC::generateMPCMatrix(
     m_vehicle_model_ptr->setVelocity(ref_vx);
     m_vehicle_model_ptr->setCurvature(ref_k);
     m_vehicle_model_ptr->calculateDiscreteMatrix(Ad, Bd, Cd, Wd, DT);
+    const MatrixXX Ad_i = Ad;
+    const MatrixXU Bd_i = Bd;
+    const VectorX Wd_i = Wd;
 
-    Q = MatrixXd::Zero(DIM_Y, DIM_Y);
-    R = MatrixXd::Zero(DIM_U, DIM_U);
+    // weight matrix depends on the vehicle model
+    MatrixYY Q_adaptive = MatrixYY::Zero(dim_y, dim_y);
+    MatrixUU R_adaptive = MatrixUU::Zero(dim_u, dim_u);
     const auto mpc_weight = getWeight(ref_k);
-    Q(0, 0) = mpc_weight.lat_error;
-    Q(1, 1) = mpc_weight.heading_error;
-    R(0, 0) = mpc_weight.steering_input;
-
-    Q_adaptive = Q;
-    R_adaptive = R;
+    Q_adaptive(0, 0) = mpc_weight.lat_error;
+    Q_adaptive(1, 1) = mpc_weight.heading_error;
+    R_adaptive(0, 0) = mpc_weight.steering_input;
     if (i == N - 1) {
       Q_adaptive(0, 0) = m_param.nominal_weight.terminal_lat_error;
       Q_adaptive(1, 1) = m_param.nominal_weight.terminal_heading_error;
@@ -476,27 +508,27 @@ MPCMatrix MPC::generateMPCMatrix(
     R_adaptive(0, 0) += ref_vx_squared * mpc_weight.steering_input_squared_vel;
 
     // update mpc matrix
-    int idx_x_i = i * DIM_X;
-    int idx_x_i_prev = (i - 1) * DIM_X;
-    int idx_u_i = i * DIM_U;
-    int idx_y_i = i * DIM_Y;
+    const int idx_x_i = i * dim_x;
+    const int idx_x_i_prev = (i - 1) * dim_x;
+    const int idx_u_i = i * dim_u;
+    const int idx_y_i = i * dim_y;
     if (i == 0) {
-      m.Aex.block(0, 0, DIM_X, DIM_X) = Ad;
-      m.Bex.block(0, 0, DIM_X, DIM_U) = Bd;
-      m.Wex.block(0, 0, DIM_X, 1) = Wd;
+      m.Aex.block<DIM_X, DIM_X>(0, 0, dim_x, dim_x) = Ad_i;
+      m.Wex.block<DIM_X, 1>(0, 0, dim_x, 1) = Wd_i;
     } else {
-      m.Aex.block(idx_x_i, 0, DIM_X, DIM_X) = Ad * m.Aex.block(idx_x_i_prev, 0, DIM_X, DIM_X);
-      for (int j = 0; j < i; ++j) {
-        int idx_u_j = j * DIM_U;
-        m.Bex.block(idx_x_i, idx_u_j, DIM_X, DIM_U) =
-          Ad * m.Bex.block(idx_x_i_prev, idx_u_j, DIM_X, DIM_U);
-      }
-      m.Wex.block(idx_x_i, 0, DIM_X, 1) = Ad * m.Wex.block(idx_x_i_prev, 0, DIM_X, 1) + Wd;
+      const MatrixXX Aex_prev = m.Aex.block<DIM_X, DIM_X>(idx_x_i_prev, 0, dim_x, dim_x);
+      const VectorX Wex_prev = m.Wex.block<DIM_X, 1>(idx_x_i_prev, 0, dim_x, 1);
+      m.Aex.block<DIM_X, DIM_X>(idx_x_i, 0, dim_x, dim_x).noalias() = Ad_i * Aex_prev;
+      m.Wex.block<DIM_X, 1>(idx_x_i, 0, dim_x, 1).noalias() = Ad_i * Wex_prev + Wd_i;
+      // Bex is block lower triangular, and the nonzero part of the previous block row is
+      // propagated by a single product.
+      m.Bex.block(idx_x_i, 0, dim_x, idx_u_i).noalias() =
+        Ad_i * m.Bex.block(idx_x_i_prev, 0, dim_x, idx_u_i);
     }
-    m.Bex.block(idx_x_i, idx_u_i, DIM_X, DIM_U) = Bd;
-    m.Cex.block(idx_y_i, idx_x_i, DIM_Y, DIM_X) = Cd;
-    m.Qex.block(idx_y_i, idx_y_i, DIM_Y, DIM_Y) = Q_adaptive;
-    m.R1ex.block(idx_u_i, idx_u_i, DIM_U, DIM_U) = R_adaptive;
+    m.Bex.block<DIM_X, DIM_U>(idx_x_i, idx_u_i, dim_x, dim_u) = Bd_i;
+    m.Cex.block<DIM_Y, DIM_X>(idx_y_i, idx_x_i, dim_y, dim_x) = Cd;
+    m.Qex.block<DIM_Y, DIM_Y>(idx_y_i, idx_y_i, dim_y, dim_y) = Q_adaptive;
+    m.R1ex.block<DIM_U, DIM_U>(idx_u_i, idx_u_i, dim_u, dim_u) = R_adaptive;
 
     // get reference input (feed-forward)
     m_vehicle_model_ptr->setCurvature(ref_smooth_k);
@@ -504,7 +536,7 @@ MPCMatrix MPC::generateMPCMatrix(
     if (std::fabs(Uref(0, 0)) < autoware::universe_utils::deg2rad(m_param.zero_ff_steer_deg)) {
       Uref(0, 0) = 0.0;  // ignore curvature noise
     }
-    m.Uref_ex.block(i * DIM_U, 0, DIM_U, 1) = Uref;
+    m.Uref_ex.block<DIM_U, 1>(idx_u_i, 0, dim_u, 1) = Uref;
   }
 
   // add lateral jerk : weight for (v * {u(i) - u(i-1)} )^2
@@ -518,7 +550,26 @@ MPCMatrix MPC::generateMPCMatrix(
 
   addSteerWeightR(prediction_dt, m.R1ex);
 
-  return m;
+  // Hessian of the condensed QP : H = (Cex * Bex)' * Qex * (Cex * Bex) + R1ex + R2ex
+  // Since Cex and Qex are block diagonal and Bex is block lower triangular, the block row i of
+  // Cex * Bex has nonzero values only in the first (i + 1) block columns. H is accumulated from
+  // each block row instead of the products of the dense matrices.
+  m.Hex = m.R1ex + m.R2ex;
+  Eigen::Matrix<double, DIM_Y, Eigen::Dynamic> CB_i(dim_y, dim_u * N);
+  for (int i = 0; i < N; ++i) {
+    const int idx_x_i = i * dim_x;
+    const int idx_y_i = i * dim_y;
+    const int cols = (i + 1) * dim_u;
+    const MatrixYX C_i = m.Cex.block<DIM_Y, DIM_X>(idx_y_i, idx_x_i, dim_y, dim_x);
+    const MatrixYY Q_i = m.Qex.block<DIM_Y, DIM_Y>(idx_y_i, idx_y_i, dim_y, dim_y);
+    auto CB_i_nonzero = CB_i.leftCols(cols);
+    auto QCB_i_nonzero = m.QCBex.block(idx_y_i, 0, dim_y, cols);
+    CB_i_nonzero.noalias() = C_i * m.Bex.block(idx_x_i, 0, dim_x, cols);
+    QCB_i_nonzero.noalias() = Q_i * CB_i_nonzero;
+    m.Hex.topLeftCorner(cols, cols).template triangularView<Eigen::Upper>() +=
+      CB_i_nonzero.transpose() * QCB_i_nonzero;
+  }
+  m.Hex.triangularView<Eigen::StrictlyLower>() = m.Hex.transpose();
 }
 
 /*
@@ -557,15 +608,10 @@ std::pair<bool, VectorXd> MPC::executeOptimization(
   const int DIM_U_N = m_param.prediction_horizon * m_vehicle_model_ptr->getDimU();
 
   // cost function: 1/2 * Uex' * H * Uex + f' * Uex,  H = B' * C' * Q * C * B + R
-  const MatrixXd CB = m.Cex * m.Bex;
-  const MatrixXd QCB = m.Qex * CB;
-  // MatrixXd H = CB.transpose() * QCB + m.R1ex + m.R2ex; // This calculation is heavy. looking for
-  // a good way.  //NOLINT
-  MatrixXd H = MatrixXd::Zero(DIM_U_N, DIM_U_N);
-  H.triangularView<Eigen::Upper>() = CB.transpose() * QCB;
-  H.triangularView<Eigen::Upper>() += m.R1ex + m.R2ex;
-  H.triangularView<Eigen::Lower>() = H.transpose();
-  MatrixXd f = (m.Cex * (m.Aex * x0 + m.Wex)).transpose() * QCB - m.Uref_ex.transpose() * m.R1ex;
+  // H and Q * C * B are calculated in generateMPCMatrix with the block structure.
+  const MatrixXd & H = m.Hex;
+  MatrixXd f =
+    (m.Cex * (m.Aex * x0 + m.Wex)).transpose() * m.QCBex - m.Uref_ex.transpose() * m.R1ex;
   addSteerWeightF(prediction_dt, f);
 
   MatrixXd A = MatrixXd::Identity(DIM_U_N, DIM_U_N);
@@ -34,6 +34,7 @@
 #include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
 #endif
 
+#include <cmath>
 #include <memory>
 #include <string>
 #include <vector>
@@ -176,6 +177,12 @@ protected:
     mpc.setReferenceTrajectory(dummy_straight_trajectory, trajectory_param, current_kinematics);
   }
 
+  const MPCMatrix & generateMPCMatrix(
+    MPC & mpc, const MPCTrajectory & reference_trajectory, const double prediction_dt)
+  {
+    return mpc.generateMPCMatrix(reference_trajectory, prediction_dt);
+  }
+
   void SetUp() override
   {
     rclcpp::init(0, nullptr);
@@ -426,6 +433,39 @@ TEST_F(MPCTest, MultiSolveWithBuffer)
   EXPECT_EQ(mpc->m_input_buffer.size(), size_t(3));
 }
 
+TEST_F(MPCTest, CondensedMatricesMatchDenseProducts)
+{
+  auto node = rclcpp::Node("mpc_test_node", rclcpp::NodeOptions{});
+  // make R2ex and the steering rate weight of R1ex nonzero
+  param.nominal_weight.lat_jerk = 0.1;
+  param.nominal_weight.steer_rate = 0.1;
+
+  MPCTrajectory reference_trajectory;
+  for (int i = 0; i < param.prediction_horizon; ++i) {
+    const double vx = 1.0 + 0.1 * i;
+    const double k = 0.05 * std::sin(0.2 * i);
+    reference_trajectory.push_back(i, 0.0, 0.0, 0.0, vx, k, k, i * param.prediction_dt);
+  }
+
+  // the state dimensions 2, 3 and 4 use the fixed-size blocks
+  const std::vector<std::shared_ptr<VehicleModelInterface>> vehicle_models{
+    std::make_shared<KinematicsBicycleModelNoDelay>(wheelbase, steer_limit),
+    std::make_shared<KinematicsBicycleModel>(wheelbase, steer_limit, steer_tau),
+    std::make_shared<DynamicsBicycleModel>(wheelbase, mass_fl, mass_fr, mass_rl, mass_rr, cf, cr)};
+  for (const auto & vehicle_model_ptr : vehicle_models) {
+    auto mpc = std::make_unique<MPC>(node);
+    initializeMPC(*mpc);
+    mpc->setVehicleModel(vehicle_model_ptr);
+    const auto & m = generateMPCMatrix(*mpc, reference_trajectory, param.prediction_dt);
+
+    const Eigen::MatrixXd CB = m.Cex * m.Bex;
+    const Eigen::MatrixXd QCB = m.Qex * CB;
+    const Eigen::MatrixXd H = CB.transpose() * QCB + m.R1ex + m.R2ex;
+    EXPECT_TRUE(m.QCBex.isApprox(QCB, 1e-12)) << "dim_x: " << vehicle_model_ptr->getDimX();
+    EXPECT_TRUE(m.Hex.isApprox(H, 1e-12)) << "dim_x: " << vehicle_model_ptr->getDimX();
+  }
+}
+
 TEST_F(MPCTest, FailureCases)
 {
   auto node = rclcpp::Node("mpc_test_node", rclcpp::NodeOptions{});
@@ -0,0 +1,147 @@
+# Copyright 2024 Proxima Technology Inc, TIER IV
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# cSpell:ignore lstm
+
+"""Compare the per-state and the batched evaluation of the trained model in proxima_calc."""
+
+import argparse
+from math import comb
+import time
+from typing import Callable
+
+from autoware_smart_mpc_trajectory_follower import proxima_calc
+from autoware_smart_mpc_trajectory_follower.scripts import drive_functions
+import numpy as np
+
+
+# same layer sizes as drive_NN.DriveNeuralNetwork, which is not imported to avoid depending on torch
+hidden_layer_sizes = (32, 16)
+dim_steer_layer_1_head = 32
+dim_steer_layer_1_tail = 16
+dim_steer_layer_2 = 8
+dim_acc_layer_1 = 16
+dim_acc_layer_2 = 16
+
+
+def create_random_model(deg: int, seed: int = 0) -> proxima_calc.transform_model_to_eigen:
+    """Create the model with the same shapes as drive_NN.DriveNeuralNetwork and random weights."""
+    rng = np.random.default_rng(seed)
+    acc_queue_size = drive_functions.acc_ctrl_queue_size
+    steer_queue_size = drive_functions.steer_ctrl_queue_size
+    steer_queue_size_core = drive_functions.steer_ctrl_queue_size_core
+    dim_polynomial = sum(comb(9 + d - 1, d) for d in range(1, deg + 1))
+
+    def linear(n_out, n_in):
+        return rng.uniform(-0.3, 0.3, (n_out, n_in)), rng.uniform(-0.3, 0.3, n_out)
+
+    acc_1 = linear(dim_acc_layer_1, acc_queue_size + 1)
+    steer_1_head = linear(dim_steer_layer_1_head, steer_queue_size_core + 1)
+    steer_1_tail = linear(dim_steer_layer_1_tail, steer_queue_size)
+    acc_2 = linear(dim_acc_layer_2, dim_acc_layer_1)
+    steer_2 = linear(dim_steer_layer_2, dim_steer_layer_1_head + dim_steer_layer_1_tail)
+    relu_1 = linear(hidden_layer_sizes[0], 1 + dim_acc_layer_2 + dim_steer_layer_2)
+    relu_2 = linear(hidden_layer_sizes[1], hidden_layer_sizes[0])
+    finalize = linear(6, hidden_layer_sizes[1] + dim_acc_layer_2 + dim_steer_layer_2)
+    linear_reg = linear(6, dim_polynomial)
+
+    transform = proxima_calc.transform_model_to_eigen()
+    transform.set_params(
+        acc_1[0],
+        steer_1_head[0],
+        steer_1_tail[0],
+        acc_2[0],
+        steer_2[0],
+        relu_1[0],
+        relu_2[0],
+        finalize[0],
+        acc_1[1],
+        steer_1_head[1],
+        steer_1_tail[1],
+        acc_2[1],
+        steer_2[1],
+        relu_1[1],
+        relu_2[1],
+        finalize[1],
+        0.01 * linear_reg[0],
+        linear_reg[1],
+        deg,
+        drive_functions.acc_delay_step,
+        drive_functions.steer_delay_step,
+        acc_queue_size,
+        steer_queue_size,
+        steer_queue_size_core,
+        drive_functions.vel_normalize,
+        drive_functions.acc_normalize,
+        drive_functions.steer_normalize,
+    )
+    return transform
+
+
+def measure(func: Callable, repeat: int) -> float:
+    """Return the average wall time of func in milliseconds."""
+    func()
+    start = time.perf_counter()
+    for _ in range(repeat):
+        func()
+    return (time.perf_counter() - start) / repeat * 1e3
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--batch_size", type=int, default=500)
+    parser.add_argument("--deg", type=int, default=2)
+    parser.add_argument("--repeat", type=int, default=20)
+    args = parser.parse_args()
+
+    transform = create_random_model(args.deg)
+    x_dim = 6 + drive_functions.acc_ctrl_queue_size + drive_functions.steer_ctrl_queue_size
+    States = np.random.default_rng(1).uniform(-1.0, 1.0, (x_dim, args.batch_size))
+
+    Pred_loop = np.stack(
+        [transform.rotated_error_prediction(States[:, i]) for i in range(args.batch_size)], axis=1
+    )
+    Pred_batch = transform.Rotated_error_prediction(States)
+    Diff_loop = np.stack(
+        [
+            transform.rot_and_d_rot_error_prediction_with_diff(States[:, i])
+            for i in range(args.batch_size)
+        ]
+    )
+    Diff_batch = transform.Rot_and_d_rot_error_prediction_with_diff(States).reshape(
+        args.batch_size, 6, x_dim + 2
+    )
+    print("max difference of prediction:", np.abs(Pred_loop - Pred_batch).max())
+    print("max difference of prediction with diff:", np.abs(Diff_loop - Diff_batch).max())
+
+    results = {
+        "rotated_error_prediction (loop)": lambda: [
+            transform.rotated_error_prediction(States[:, i]) for i in range(args.batch_size)
+        ],
+        "Rotated_error_prediction (batch)": lambda: transform.Rotated_error_prediction(States),
+        "rot_and_d_rot_error_prediction_with_diff (loop)": lambda: [
+            transform.rot_and_d_rot_error_prediction_with_diff(States[:, i])
+            for i in range(args.batch_size)
+        ],
+        "Rot_and_d_rot_error_prediction_with_diff (batch)": lambda: (
+            transform.Rot_and_d_rot_error_prediction_with_diff(States)
+        ),
+    }
+    print(f"batch size: {args.batch_size}, x_dim: {x_dim}")
+    for name, func in results.items():
+        print(f"{name}: {measure(func, args.repeat):.3f} ms")
+
+
+if __name__ == "__main__":
+    main()
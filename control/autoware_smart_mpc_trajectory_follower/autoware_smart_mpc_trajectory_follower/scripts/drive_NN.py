@@ -407,6 +407,7 @@ class transform_model_to_c:
         self.pred_with_diff = self.transform.rot_and_d_rot_error_prediction_with_diff
         self.pred_with_poly_diff = self.transform.rot_and_d_rot_error_prediction_with_poly_diff
         self.Pred = self.transform.Rotated_error_prediction
+        self.Pred_with_diff = self.transform.Rot_and_d_rot_error_prediction_with_diff
 
 
 class transform_model_with_memory_to_c:
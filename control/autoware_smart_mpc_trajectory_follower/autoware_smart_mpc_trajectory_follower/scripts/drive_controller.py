@@ -310,6 +310,18 @@ class drive_controller:
                 acc_time_constant_ctrl=self.acc_time_constant_ctrl,
                 steer_time_constant_ctrl=self.steer_time_constant_ctrl,
             )
+            # The batched derivatives are only available for the model without memory.
+            if (
+                not drive_functions.use_batched_model_diff
+                or drive_functions.reflect_only_poly_diff
+                or drive_functions.use_memory_for_training
+            ):
+                self.F_N_diff_for_trajectory = None
+            else:
+                self.F_N_diff_for_trajectory = partial(
+                    drive_functions.F_with_model_diff_for_trajectory,
+                    Pred_with_diff=self.transform_model.Pred_with_diff,
+                )
             self.F_N_only_state = partial(
                 drive_functions.F_with_model,
                 pred=self.transform_model.pred_only_state,
@@ -335,6 +347,7 @@ class drive_controller:
                 steer_time_constant_ctrl=self.steer_time_constant_ctrl,
             )
             self.F_N_initial_diff = self.F_N_diff
+            self.F_N_diff_for_trajectory = None
             self.F_N_only_state = partial(
                 drive_functions.F_with_history,
                 i=self.acc_delay_step,
@@ -543,7 +556,10 @@ class drive_controller:
                     self.nominal_inputs
                 )
                 self.ilqr.receive_model(
-                    self.F_N_initial_diff, self.F_N_diff, self.F_N_for_candidates
+                    self.F_N_initial_diff,
+                    self.F_N_diff,
+                    self.F_N_for_candidates,
+                    self.F_N_diff_for_trajectory,
                 )
                 self.nominal_inputs, self.u_opt_dot, nominal_traj, proceed = (
                     self.ilqr
@@ -1130,6 +1146,18 @@ class drive_controller:
                     acc_time_constant_ctrl=self.acc_time_constant_ctrl,
                     steer_time_constant_ctrl=self.steer_time_constant_ctrl,
                 )
+                # The batched derivatives are only available for the model without memory.
+                if (
+                    not drive_functions.use_batched_model_diff
+                    or drive_functions.reflect_only_poly_diff
+                    or drive_functions.use_memory_for_training
+                ):
+                    self.F_N_diff_for_trajectory = None
+                else:
+                    self.F_N_diff_for_trajectory = partial(
+                        drive_functions.F_with_model_diff_for_trajectory,
+                        Pred_with_diff=self.transform_model.Pred_with_diff,
+                    )
                 self.F_N_only_state = partial(
                     drive_functions.F_with_model,
                     pred=self.transform_model.pred_only_state,
@@ -185,6 +185,9 @@ use_memory_diff = bool(
 reflect_only_poly_diff = bool(
     trained_model_param["trained_model_parameter"]["control_application"]["reflect_only_poly_diff"]
 )
+use_batched_model_diff = bool(
+    trained_model_param["trained_model_parameter"]["control_application"]["use_batched_model_diff"]
+)
 use_sg_for_trained_model_diff = bool(
     trained_model_param["trained_model_parameter"]["control_application"][
         "use_sg_for_trained_model_diff"
@@ -1442,6 +1445,25 @@ def F_with_model_diff(
     return states_next, dF_dx, dF_du, C, pred_error_
 
 
+def F_with_model_diff_for_trajectory(
+    traj: np.ndarray, dF_dx: np.ndarray, Pred_with_diff: Callable
+) -> np.ndarray:
+    """Compute the derivatives of the trained model for all the states of a trajectory at once.
+
+    traj contains the states in rows and dF_dx the derivatives of the nominal model at these states.
+    The result for each state is the same as C of F_with_model_diff, but the trained model is
+    evaluated by a single batched call instead of one call per state.
+    """
+    N, nx = traj.shape
+    C = Pred_with_diff(traj.T).reshape(N, 6, nx + 2)[:, :, 2:] * mpc_time_step
+    steer_diff = (
+        dF_dx[:, 5, nx_0 + acc_ctrl_queue_size :].sum(axis=1)
+        + C[:, 5, nx_0 + acc_ctrl_queue_size :].sum(axis=1)
+    )
+    C[:, 5, -1] += np.maximum(minimum_steer_diff - steer_diff, 0.0)
+    return C
+
+
 def F_with_model_for_candidates(
     States: np.ndarray,
     Inputs: np.ndarray,
@@ -506,8 +506,16 @@ class drive_iLQR:
         if self.add_state_hc:
             D = np.zeros((N, 6 + self.h_dim_double, nx + self.h_dim_double))
         previous_error_ = previous_error.copy()
+        # Without memory, the derivatives of the trained model only depend on the states, so they
+        # can be computed for the whole trajectory at once after the rollout. F_diff_for_trajectory
+        # is only given when use_batched_model_diff is enabled.
+        use_batched_model_diff = (
+            self.use_trained_model_diff
+            and not self.add_state_hc
+            and self.F_diff_for_trajectory is not None
+        )
         for k in range(N):
-            if self.use_trained_model_diff:
+            if self.use_trained_model_diff and not use_batched_model_diff:
                 traj[k + 1], A[k], B[k], C[k], previous_error_ = self.F_with_diff(
                     traj[k], inputs[k], previous_error_, k
                 )
@@ -523,6 +531,8 @@ class drive_iLQR:
                 traj[k + 1], A[k], B[k], previous_error_ = self.F_with_initial_diff(
                     traj[k], inputs[k], previous_error_, k
                 )
+        if use_batched_model_diff:
+            C = self.F_diff_for_trajectory(traj[:N], A)
         if self.use_trained_model_diff:
             A[:, :6] += drive_functions.sg_filter_for_trained_model_diff(C)
             if self.add_state_hc:
@@ -677,12 +687,21 @@ class drive_iLQR:
         return best_inputs, best_inputs[0], best_traj, proceed
 
     def receive_model(
-        self, F_with_initial_diff: Callable, F_with_diff: Callable, F_for_candidates: Callable
+        self,
+        F_with_initial_diff: Callable,
+        F_with_diff: Callable,
+        F_for_candidates: Callable,
+        F_diff_for_trajectory: Callable | None = None,
     ):
-        """Receive vehicle model for control."""
+        """Receive vehicle model for control.
+
+        If F_diff_for_trajectory is given, the derivatives of the trained model are computed for the
+        whole trajectory at once instead of calling F_with_diff for each step.
+        """
         self.F_with_initial_diff = F_with_initial_diff
         self.F_with_diff = F_with_diff
         self.F_for_candidates = F_for_candidates
+        self.F_diff_for_trajectory = F_diff_for_trajectory
 
     def receive_memory_diff(
         self, get_dhc_dx: Callable, get_dhc_dhc: Callable, get_dy_dhc: Callable
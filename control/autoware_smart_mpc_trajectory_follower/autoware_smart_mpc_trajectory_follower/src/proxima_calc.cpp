@@ -19,7 +19,9 @@
 #include <pybind11/eigen.h>
 #include <pybind11/pybind11.h>
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
 namespace py = pybind11;
 
 Eigen::VectorXd tanh(const Eigen::VectorXd & v)
@@ -32,55 +34,27 @@ Eigen::VectorXd sigmoid(const Eigen::VectorXd & v)
 }
 Eigen::VectorXd relu(const Eigen::VectorXd & x)
 {
-  Eigen::VectorXd x_ = x;
-  for (int i = 0; i < x.size(); i++) {
-    if (x[i] < 0) {
-      x_[i] = 0;
-    }
-  }
-  return x_;
+  return x.cwiseMax(0.0);
 }
 Eigen::MatrixXd d_relu_product(const Eigen::MatrixXd & m, const Eigen::VectorXd & x)
 {
-  Eigen::MatrixXd result = Eigen::MatrixXd::Zero(m.rows(), m.cols());
-  for (int i = 0; i < m.cols(); i++) {
-    if (x[i] >= 0) {
-      result.col(i) = m.col(i);
-    }
-  }
-  return result;
+  return m * (x.array() >= 0.0).cast<double>().matrix().asDiagonal();
 }
 Eigen::MatrixXd d_tanh_product(const Eigen::MatrixXd & m, const Eigen::VectorXd & x)
 {
-  Eigen::MatrixXd result = Eigen::MatrixXd(m.rows(), m.cols());
-  for (int i = 0; i < m.cols(); i++) {
-    result.col(i) = m.col(i) / (std::cosh(x[i]) * std::cosh(x[i]));
-  }
-  return result;
+  return m * x.array().cosh().square().inverse().matrix().asDiagonal();
 }
 Eigen::VectorXd d_tanh_product_vec(const Eigen::VectorXd & v, const Eigen::VectorXd & x)
 {
-  Eigen::VectorXd result = Eigen::VectorXd(v.size());
-  for (int i = 0; i < v.size(); i++) {
-    result[i] = v[i] / (std::cosh(x[i]) * std::cosh(x[i]));
-  }
-  return result;
+  return v.array() / x.array().cosh().square();
 }
 Eigen::MatrixXd d_sigmoid_product(const Eigen::MatrixXd & m, const Eigen::VectorXd & x)
 {
-  Eigen::MatrixXd result = Eigen::MatrixXd(m.rows(), m.cols());
-  for (int i = 0; i < m.cols(); i++) {
-    result.col(i) = 0.25 * m.col(i) / (std::cosh(0.5 * x[i]) * std::cosh(0.5 * x[i]));
-  }
-  return result;
+  return 0.25 * m * (0.5 * x).array().cosh().square().inverse().matrix().asDiagonal();
 }
 Eigen::VectorXd d_sigmoid_product_vec(const Eigen::VectorXd & v, const Eigen::VectorXd & x)
 {
-  Eigen::VectorXd result = Eigen::VectorXd(v.size());
-  for (int i = 0; i < v.size(); i++) {
-    result[i] = 0.25 * v[i] / (std::cosh(0.5 * x[i]) * std::cosh(0.5 * x[i]));
-  }
-  return result;
+  return 0.25 * v.array() / (0.5 * x).array().cosh().square();
 }
 
 Eigen::VectorXd get_polynomial_features(const Eigen::VectorXd & x, const int deg, const int dim)
@@ -143,6 +117,53 @@ Eigen::MatrixXd get_polynomial_features_with_diff(
   }
   return result;
 }
+// Batched version of get_polynomial_features_with_diff for each column of X.
+// result[0] is the features and result[j + 1] is the derivative with respect to the j-th row of X.
+// The derivatives are not computed if with_diff is false.
+void get_polynomial_features_batch(
+  const Eigen::MatrixXd & X, const int deg, const int dim, const bool with_diff,
+  std::vector<Eigen::MatrixXd> & result)
+{
+  const int n_features = X.rows();
+  const int n_outputs = with_diff ? n_features + 1 : 1;
+  result.resize(n_outputs);
+  for (auto & r : result) {
+    r.resize(dim, X.cols());
+  }
+  result[0].topRows(n_features) = X;
+  for (int j = 1; j < n_outputs; j++) {
+    result[j].topRows(n_features).setZero();
+    result[j].row(j - 1).setOnes();
+  }
+  if (deg >= 2) {
+    std::vector<int> index = {};
+    for (int feature_idx = 0; feature_idx < n_features + 1; feature_idx++) {
+      index.push_back(feature_idx);
+    }
+    int current_idx = n_features;
+    for (int i = 0; i < deg - 1; i++) {
+      std::vector<int> new_index = {};
+      const int end = index[index.size() - 1];
+      for (int feature_idx = 0; feature_idx < n_features; feature_idx++) {
+        const int start = index[feature_idx];
+        new_index.push_back(current_idx);
+        const int next_idx = current_idx + end - start;
+        const auto x_row = X.row(feature_idx).array();
+        for (int j = 0; j < n_outputs; j++) {
+          result[j].middleRows(current_idx, end - start) =
+            result[j].middleRows(start, end - start).array().rowwise() * x_row;
+        }
+        if (with_diff) {
+          result[feature_idx + 1].middleRows(current_idx, end - start) +=
+            result[0].middleRows(start, end - start);
+        }
+        current_idx = next_idx;
+      }
+      new_index.push_back(current_idx);
+      index = new_index;
+    }
+  }
+}
 class transform_model_to_eigen
 {
 private:
@@ -176,6 +197,199 @@ private:
   static constexpr double max_acc_error_ = 20.0;
   static constexpr double max_steer_error_ = 20.0;
 
+  // buffers of the batched evaluation, which are reused while the batch size is not changed
+  Eigen::MatrixXd vars_batch_;
+  Eigen::MatrixXd acc_sub_batch_;
+  Eigen::MatrixXd steer_sub_batch_;
+  Eigen::MatrixXd steer_input_full_batch_;
+  Eigen::MatrixXd u_acc_layer_1_batch_;
+  Eigen::MatrixXd acc_layer_1_batch_;
+  Eigen::MatrixXd u_steer_layer_1_batch_;
+  Eigen::MatrixXd steer_layer_1_batch_;
+  Eigen::MatrixXd u_acc_layer_2_batch_;
+  Eigen::MatrixXd u_steer_layer_2_batch_;
+  Eigen::MatrixXd h1_batch_;
+  Eigen::MatrixXd u2_batch_;
+  Eigen::MatrixXd h2_batch_;
+  Eigen::MatrixXd u3_batch_;
+  Eigen::MatrixXd h4_batch_;
+  Eigen::MatrixXd x_for_polynomial_reg_batch_;
+  std::vector<Eigen::MatrixXd> polynomial_features_batch_;
+  Eigen::MatrixXd y_batch_;
+  std::vector<Eigen::MatrixXd> dy_dvars_batch_;
+  Eigen::ArrayXXd d_relu_u_acc_layer_1_batch_;
+  Eigen::ArrayXXd d_relu_u_steer_layer_1_batch_;
+  Eigen::ArrayXXd d_relu_u_acc_layer_2_batch_;
+  Eigen::ArrayXXd d_relu_u_steer_layer_2_batch_;
+  Eigen::ArrayXXd d_relu_u2_batch_;
+  Eigen::ArrayXXd d_relu_u3_batch_;
+  Eigen::MatrixXd grad_h1_batch_;
+  Eigen::MatrixXd grad_a1_batch_;
+  Eigen::MatrixXd grad_s1_batch_;
+  Eigen::MatrixXd grad_buffer_1_;
+  Eigen::MatrixXd grad_buffer_2_;
+
+  // Set the inputs of error_prediction for each column of X to vars_batch_.
+  void set_vars_batch(const Eigen::MatrixXd & X)
+  {
+    const int x_dim = X.rows();
+    vars_batch_.resize(x_dim - 3, X.cols());
+    vars_batch_.row(0) = X.row(2);
+    vars_batch_.row(1) = X.row(4);
+    vars_batch_.row(2) = X.row(5);
+    vars_batch_.bottomRows(x_dim - 6) = X.bottomRows(x_dim - 6);
+  }
+
+  // Evaluate error_prediction for each column of vars_batch_ by matrix-matrix products.
+  // The pre-activations are kept for the backward pass of error_prediction_with_diff_batch.
+  void error_prediction_batch(const bool with_diff)
+  {
+    const Eigen::MatrixXd & vars = vars_batch_;
+    const int steer_head_size = bias_steer_layer_1_head_.size();
+    const int steer_tail_size = bias_steer_layer_1_tail_.size();
+    const int acc_layer_2_size = bias_acc_layer_2_.size();
+    const int steer_layer_2_size = bias_steer_layer_2_.size();
+    const int h3_size = bias_linear_relu_2_.size();
+
+    acc_sub_batch_.resize(acc_ctrl_queue_size_ + 1, vars.cols());
+    acc_sub_batch_.row(0) = acc_normalize_ * vars.row(1);
+    acc_sub_batch_.bottomRows(acc_ctrl_queue_size_) =
+      acc_normalize_ * vars.middleRows(3, acc_ctrl_queue_size_);
+
+    steer_sub_batch_.resize(steer_ctrl_queue_size_core_ + 1, vars.cols());
+    steer_sub_batch_.row(0) = steer_normalize_ * vars.row(2);
+    steer_sub_batch_.bottomRows(steer_ctrl_queue_size_core_) =
+      steer_normalize_ * vars.middleRows(3 + acc_ctrl_queue_size_, steer_ctrl_queue_size_core_);
+    steer_input_full_batch_ =
+      steer_normalize_ * vars.middleRows(3 + acc_ctrl_queue_size_, steer_ctrl_queue_size_);
+
+    u_acc_layer_1_batch_.noalias() = weight_acc_layer_1_ * acc_sub_batch_;
+    u_acc_layer_1_batch_.colwise() += bias_acc_layer_1_;
+    acc_layer_1_batch_ = u_acc_layer_1_batch_.cwiseMax(0.0);
+
+    u_steer_layer_1_batch_.resize(steer_head_size + steer_tail_size, vars.cols());
+    u_steer_layer_1_batch_.topRows(steer_head_size).noalias() =
+      weight_steer_layer_1_head_ * steer_sub_batch_;
+    u_steer_layer_1_batch_.topRows(steer_head_size).colwise() += bias_steer_layer_1_head_;
+    u_steer_layer_1_batch_.bottomRows(steer_tail_size).noalias() =
+      weight_steer_layer_1_tail_ * steer_input_full_batch_;
+    u_steer_layer_1_batch_.bottomRows(steer_tail_size).colwise() += bias_steer_layer_1_tail_;
+    steer_layer_1_batch_ = u_steer_layer_1_batch_.cwiseMax(0.0);
+
+    u_acc_layer_2_batch_.noalias() = weight_acc_layer_2_ * acc_layer_1_batch_;
+    u_acc_layer_2_batch_.colwise() += bias_acc_layer_2_;
+    u_steer_layer_2_batch_.noalias() = weight_steer_layer_2_ * steer_layer_1_batch_;
+    u_steer_layer_2_batch_.colwise() += bias_steer_layer_2_;
+
+    h1_batch_.resize(1 + acc_layer_2_size + steer_layer_2_size, vars.cols());
+    h1_batch_.row(0) = vel_normalize_ * vars.row(0);
+    h1_batch_.middleRows(1, acc_layer_2_size) = u_acc_layer_2_batch_.cwiseMax(0.0);
+    h1_batch_.bottomRows(steer_layer_2_size) = u_steer_layer_2_batch_.cwiseMax(0.0);
+    u2_batch_.noalias() = weight_linear_relu_1_ * h1_batch_;
+    u2_batch_.colwise() += bias_linear_relu_1_;
+    h2_batch_ = u2_batch_.cwiseMax(0.0);
+    u3_batch_.noalias() = weight_linear_relu_2_ * h2_batch_;
+    u3_batch_.colwise() += bias_linear_relu_2_;
+    h4_batch_.resize(h3_size + acc_layer_2_size + steer_layer_2_size, vars.cols());
+    h4_batch_.topRows(h3_size) = u3_batch_.cwiseMax(0.0);
+    h4_batch_.bottomRows(acc_layer_2_size + steer_layer_2_size) =
+      h1_batch_.bottomRows(acc_layer_2_size + steer_layer_2_size);
+
+    x_for_polynomial_reg_batch_.resize(9, vars.cols());
+    x_for_polynomial_reg_batch_.topRows(3) = vars.topRows(3);
+    const int acc_start = 3 + std::max(acc_delay_step_ - 3, 0);
+    x_for_polynomial_reg_batch_.middleRows(3, 3) = vars.middleRows(acc_start, 3);
+    const int steer_start = 3 + acc_ctrl_queue_size_ + std::max(steer_delay_step_ - 3, 0);
+    x_for_polynomial_reg_batch_.bottomRows(3) = vars.middleRows(steer_start, 3);
+    get_polynomial_features_batch(
+      x_for_polynomial_reg_batch_, deg_, A_linear_reg_.cols(), with_diff,
+      polynomial_features_batch_);
+
+    y_batch_.noalias() = weight_finalize_ * h4_batch_;
+    y_batch_.noalias() += A_linear_reg_ * polynomial_features_batch_[0];
+    y_batch_.colwise() += bias_linear_finalize_ + b_linear_reg_;
+    y_batch_.row(4) = y_batch_.row(4).cwiseMax(-max_acc_error_).cwiseMin(max_acc_error_);
+    y_batch_.row(5) = y_batch_.row(5).cwiseMax(-max_steer_error_).cwiseMin(max_steer_error_);
+  }
+
+  // Evaluate error_prediction_with_diff for each column of vars_batch_.
+  // dy_dvars_batch_[k] is the gradient of the k-th output with respect to the inputs. The gradients
+  // of all the columns are propagated backward together by the transposed weights.
+  void error_prediction_with_diff_batch()
+  {
+    error_prediction_batch(true);
+
+    const Eigen::MatrixXd & vars = vars_batch_;
+    const int steer_head_size = bias_steer_layer_1_head_.size();
+    const int steer_tail_size = bias_steer_layer_1_tail_.size();
+    const int acc_layer_2_size = bias_acc_layer_2_.size();
+    const int steer_layer_2_size = bias_steer_layer_2_.size();
+    const int h3_size = bias_linear_relu_2_.size();
+    const int acc_start = 3 + std::max(acc_delay_step_ - 3, 0);
+    const int steer_start = 3 + acc_ctrl_queue_size_ + std::max(steer_delay_step_ - 3, 0);
+    const auto d_relu = [](const Eigen::MatrixXd & u, Eigen::ArrayXXd & d_relu_u) {
+      d_relu_u = (u.array() >= 0.0).cast<double>();
+    };
+    d_relu(u_acc_layer_1_batch_, d_relu_u_acc_layer_1_batch_);
+    d_relu(u_steer_layer_1_batch_, d_relu_u_steer_layer_1_batch_);
+    d_relu(u_acc_layer_2_batch_, d_relu_u_acc_layer_2_batch_);
+    d_relu(u_steer_layer_2_batch_, d_relu_u_steer_layer_2_batch_);
+    d_relu(u2_batch_, d_relu_u2_batch_);
+    d_relu(u3_batch_, d_relu_u3_batch_);
+
+    dy_dvars_batch_.resize(y_batch_.rows());
+    for (int k = 0; k < y_batch_.rows(); k++) {
+      Eigen::MatrixXd & dy_dvars = dy_dvars_batch_[k];
+      dy_dvars.resize(vars.rows(), vars.cols());
+
+      // linear relu stack
+      grad_buffer_1_ =
+        d_relu_u3_batch_.colwise() * weight_finalize_.row(k).head(h3_size).transpose().array();
+      grad_buffer_2_.noalias() = weight_linear_relu_2_.transpose() * grad_buffer_1_;
+      grad_buffer_1_ = grad_buffer_2_.array() * d_relu_u2_batch_;
+      grad_h1_batch_.noalias() = weight_linear_relu_1_.transpose() * grad_buffer_1_;
+
+      // acc layers
+      grad_buffer_1_ = grad_h1_batch_.middleRows(1, acc_layer_2_size);
+      grad_buffer_1_.colwise() +=
+        weight_finalize_.row(k).segment(h3_size, acc_layer_2_size).transpose();
+      grad_buffer_1_.array() *= d_relu_u_acc_layer_2_batch_;
+      grad_a1_batch_.noalias() = weight_acc_layer_2_.transpose() * grad_buffer_1_;
+      grad_a1_batch_.array() *= d_relu_u_acc_layer_1_batch_;
+      grad_buffer_2_.noalias() = weight_acc_layer_1_.transpose() * grad_a1_batch_;
+      dy_dvars.row(1) = acc_normalize_ * grad_buffer_2_.row(0);
+      dy_dvars.middleRows(3, acc_ctrl_queue_size_) =
+        acc_normalize_ * grad_buffer_2_.bottomRows(acc_ctrl_queue_size_);
+
+      // steer layers
+      grad_buffer_1_ = grad_h1_batch_.bottomRows(steer_layer_2_size);
+      grad_buffer_1_.colwise() +=
+        weight_finalize_.row(k).tail(steer_layer_2_size).transpose();
+      grad_buffer_1_.array() *= d_relu_u_steer_layer_2_batch_;
+      grad_s1_batch_.noalias() = weight_steer_layer_2_.transpose() * grad_buffer_1_;
+      grad_s1_batch_.array() *= d_relu_u_steer_layer_1_batch_;
+      auto dy_d_steer = dy_dvars.middleRows(3 + acc_ctrl_queue_size_, steer_ctrl_queue_size_);
+      dy_d_steer.noalias() =
+        steer_normalize_ * weight_steer_layer_1_tail_.transpose() *
+        grad_s1_batch_.bottomRows(steer_tail_size);
+      grad_buffer_2_.noalias() =
+        steer_normalize_ * weight_steer_layer_1_head_.transpose() *
+        grad_s1_batch_.topRows(steer_head_size);
+      dy_dvars.row(2) = grad_buffer_2_.row(0);
+      dy_d_steer.topRows(steer_ctrl_queue_size_core_) +=
+        grad_buffer_2_.bottomRows(steer_ctrl_queue_size_core_);
+
+      dy_dvars.row(0) = vel_normalize_ * grad_h1_batch_.row(0);
+
+      // polynomial regression
+      for (int j = 0; j < 9; j++) {
+        const int vars_idx = j < 3 ? j : (j < 6 ? acc_start + j - 3 : steer_start + j - 6);
+        dy_dvars.row(vars_idx).noalias() +=
+          A_linear_reg_.row(k) * polynomial_features_batch_[j + 1];
+      }
+    }
+  }
+
 public:
   transform_model_to_eigen() {}
   void set_params(
@@ -540,36 +754,59 @@ public:
     rot_pred.tail(4) = coef * pred.tail(4);
     return rot_pred;
   }
-  Eigen::MatrixXd Rotated_error_prediction(const Eigen::MatrixXd & X) const
+  Eigen::MatrixXd Rotated_error_prediction(const Eigen::MatrixXd & X)
+  {
+    set_vars_batch(X);
+    error_prediction_batch(false);
+    using RowArray = Eigen::Array<double, 1, Eigen::Dynamic>;
+    const RowArray coef = (2.0 * X.row(2).array().abs()).pow(7).min(1.0);
+    const RowArray cos = X.row(3).array().cos();
+    const RowArray sin = X.row(3).array().sin();
+    Eigen::MatrixXd Pred(6, X.cols());
+    Pred.row(0) = coef * (cos * y_batch_.row(0).array() - sin * y_batch_.row(1).array());
+    Pred.row(1) = coef * (sin * y_batch_.row(0).array() + cos * y_batch_.row(1).array());
+    Pred.bottomRows(4) = y_batch_.bottomRows(4).array().rowwise() * coef;
+    return Pred;
+  }
+  // Batched version of rot_and_d_rot_error_prediction_with_diff for each column of X.
+  // The result for the i-th column is the block of the rows [6 * i, 6 * i + 6).
+  Eigen::MatrixXd Rot_and_d_rot_error_prediction_with_diff(const Eigen::MatrixXd & X)
   {
-    const int X_cols = X.cols();
     const int x_dim = X.rows();
-    Eigen::MatrixXd Pred(6, X_cols);
-    for (int i = 0; i < X_cols; i++) {
-      const Eigen::VectorXd x = X.col(i);
-      const double theta = x[3];
-      const double v = x[2];
-      double coef = 2.0 * std::abs(v);
+    set_vars_batch(X);
+    error_prediction_with_diff_batch();
+
+    Eigen::MatrixXd result = Eigen::MatrixXd::Zero(6 * X.cols(), x_dim + 2);
+    Eigen::MatrixXd d_pred(6, x_dim - 3);
+    for (int i = 0; i < X.cols(); i++) {
+      double coef = 2.0 * std::abs(X(2, i));
       coef = coef * coef * coef * coef * coef * coef * coef;
       if (coef > 1.0) {
         coef = 1.0;
       }
-      const double cos = std::cos(theta);
-      const double sin = std::sin(theta);
+      const double cos = std::cos(X(3, i));
+      const double sin = std::sin(X(3, i));
       Eigen::Matrix2d Rot;
       Rot << cos, -sin, sin, cos;
-      Eigen::VectorXd vars(x_dim - 3);
-
-      vars[0] = x[2];
-
-      vars[1] = x[4];
-      vars[2] = x[5];
-      vars.tail(x_dim - 6) = x.tail(x_dim - 6);
-      const Eigen::VectorXd pred = error_prediction(vars);
-      Pred.block(0, i, 2, 1) = coef * Rot * pred.head(2);
-      Pred.block(2, i, 4, 1) = coef * pred.tail(4);
+      Eigen::Matrix2d dRot;
+      dRot << -sin, -cos, cos, -sin;
+      for (int k = 0; k < 6; k++) {
+        d_pred.row(k) = dy_dvars_batch_[k].col(i).transpose();
+      }
+      d_pred.topRows(2) = (Rot * d_pred.topRows(2)).eval();
+
+      auto rot_and_d_rot_pred_with_diff = result.block(6 * i, 0, 6, x_dim + 2);
+      rot_and_d_rot_pred_with_diff.block(0, 0, 2, 1) = Rot * y_batch_.block(0, i, 2, 1);
+      rot_and_d_rot_pred_with_diff.block(2, 0, 4, 1) = y_batch_.block(2, i, 4, 1);
+      rot_and_d_rot_pred_with_diff.block(0, 1, 2, 1) = dRot * y_batch_.block(0, i, 2, 1);
+      rot_and_d_rot_pred_with_diff.col(2 + 2) = d_pred.col(0);
+      rot_and_d_rot_pred_with_diff.col(2 + 4) = d_pred.col(1);
+      rot_and_d_rot_pred_with_diff.col(2 + 5) = d_pred.col(2);
+      rot_and_d_rot_pred_with_diff.block(0, 2 + 6, 6, x_dim - 6) =
+        d_pred.block(0, 3, 6, x_dim - 6);
+      rot_and_d_rot_pred_with_diff *= coef;
     }
-    return Pred;
+    return result;
   }
 };
 class transform_model_with_memory_to_eigen
@@ -1526,7 +1763,10 @@ PYBIND11_MODULE(proxima_calc, m)
       "rot_and_d_rot_error_prediction_with_poly_diff",
       &transform_model_to_eigen::rot_and_d_rot_error_prediction_with_poly_diff)
     .def("rotated_error_prediction", &transform_model_to_eigen::rotated_error_prediction)
-    .def("Rotated_error_prediction", &transform_model_to_eigen::Rotated_error_prediction);
+    .def("Rotated_error_prediction", &transform_model_to_eigen::Rotated_error_prediction)
+    .def(
+      "Rot_and_d_rot_error_prediction_with_diff",
+      &transform_model_to_eigen::Rot_and_d_rot_error_prediction_with_diff);
   py::class_<transform_model_with_memory_to_eigen>(m, "transform_model_with_memory_to_eigen")
     .def(py::init())
     .def("set_params", &transform_model_with_memory_to_eigen::set_params)
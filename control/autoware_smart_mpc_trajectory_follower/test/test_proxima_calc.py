@@ -0,0 +1,149 @@
+# Copyright 2024 Proxima Technology Inc, TIER IV
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Compare the batched evaluation of the trained model with the evaluation state by state."""
+
+from math import comb
+
+from autoware_smart_mpc_trajectory_follower import proxima_calc
+from autoware_smart_mpc_trajectory_follower.scripts import drive_functions
+import numpy as np
+
+BATCH_SIZE = 50
+DEG = 2
+TOLERANCE = 1e-10
+
+
+def create_random_model(seed: int = 0) -> proxima_calc.transform_model_to_eigen:
+    """Create the model with the same shapes as drive_NN.DriveNeuralNetwork and random weights."""
+    rng = np.random.default_rng(seed)
+    acc_queue_size = drive_functions.acc_ctrl_queue_size
+    steer_queue_size = drive_functions.steer_ctrl_queue_size
+    steer_queue_size_core = drive_functions.steer_ctrl_queue_size_core
+    dim_polynomial = sum(comb(9 + d - 1, d) for d in range(1, DEG + 1))
+
+    def linear(n_out, n_in):
+        return rng.uniform(-0.3, 0.3, (n_out, n_in)), rng.uniform(-0.3, 0.3, n_out)
+
+    layers = [
+        linear(16, acc_queue_size + 1),
+        linear(32, steer_queue_size_core + 1),
+        linear(16, steer_queue_size),
+        linear(16, 16),
+        linear(8, 32 + 16),
+        linear(32, 1 + 16 + 8),
+        linear(16, 32),
+        linear(6, 16 + 16 + 8),
+    ]
+    linear_reg = linear(6, dim_polynomial)
+
+    transform = proxima_calc.transform_model_to_eigen()
+    transform.set_params(
+        *[weight for weight, _ in layers],
+        *[bias for _, bias in layers],
+        0.01 * linear_reg[0],
+        linear_reg[1],
+        DEG,
+        drive_functions.acc_delay_step,
+        drive_functions.steer_delay_step,
+        acc_queue_size,
+        steer_queue_size,
+        steer_queue_size_core,
+        drive_functions.vel_normalize,
+        drive_functions.acc_normalize,
+        drive_functions.steer_normalize,
+    )
+    return transform
+
+
+def random_states(seed: int = 1) -> np.ndarray:
+    x_dim = 6 + drive_functions.acc_ctrl_queue_size + drive_functions.steer_ctrl_queue_size
+    return np.random.default_rng(seed).uniform(-1.0, 1.0, (x_dim, BATCH_SIZE))
+
+
+def test_rotated_error_prediction():
+    transform = create_random_model()
+    States = random_states()
+
+    expected = np.stack(
+        [transform.rotated_error_prediction(States[:, i]) for i in range(BATCH_SIZE)], axis=1
+    )
+    np.testing.assert_allclose(
+        transform.Rotated_error_prediction(States), expected, rtol=0.0, atol=TOLERANCE
+    )
+
+
+def test_rot_and_d_rot_error_prediction_with_diff():
+    transform = create_random_model()
+    States = random_states()
+    x_dim = States.shape[0]
+
+    expected = np.stack(
+        [
+            transform.rot_and_d_rot_error_prediction_with_diff(States[:, i])
+            for i in range(BATCH_SIZE)
+        ]
+    )
+    result = transform.Rot_and_d_rot_error_prediction_with_diff(States)
+    assert result.shape == (6 * BATCH_SIZE, x_dim + 2)
+    np.testing.assert_allclose(
+        result.reshape(BATCH_SIZE, 6, x_dim + 2), expected, rtol=0.0, atol=TOLERANCE
+    )
+
+
+def test_model_diff_for_trajectory():
+    """Roll out a trajectory as iLQR does with both paths and compare the derivatives."""
+    transform = create_random_model()
+    x_current = random_states()[:, 0]
+    inputs = np.random.default_rng(2).uniform(-0.5, 0.5, (drive_functions.N, 2))
+    nx = x_current.shape[0]
+    N = inputs.shape[0]
+
+    # per step, as drive_iLQR with use_batched_model_diff: false
+    traj = np.zeros((N + 1, nx))
+    traj[0] = x_current
+    A = np.zeros((N, nx, nx))
+    C = np.zeros((N, 6, nx))
+    previous_error = np.zeros(8)
+    for k in range(N):
+        traj[k + 1], A[k], _, C[k], previous_error = drive_functions.F_with_model_diff(
+            traj[k],
+            inputs[k],
+            previous_error,
+            k,
+            pred=transform.rot_and_d_rot_error_prediction_with_diff,
+        )
+
+    # rollout with the nominal derivatives, then the trained model derivatives at once
+    traj_batched = np.zeros((N + 1, nx))
+    traj_batched[0] = x_current
+    A_batched = np.zeros((N, nx, nx))
+    previous_error = np.zeros(8)
+    for k in range(N):
+        traj_batched[k + 1], A_batched[k], _, previous_error = (
+            drive_functions.F_with_model_initial_diff(
+                traj_batched[k],
+                inputs[k],
+                previous_error,
+                k,
+                pred=transform.rot_and_d_rot_error_prediction,
+            )
+        )
+    C_batched = drive_functions.F_with_model_diff_for_trajectory(
+        traj_batched[:N], A_batched, transform.Rot_and_d_rot_error_prediction_with_diff
+    )
+
+    np.testing.assert_allclose(traj_batched, traj, rtol=0.0, atol=TOLERANCE)
+    np.testing.assert_allclose(A_batched, A, rtol=0.0, atol=TOLERANCE)
+    np.testing.assert_allclose(C_batched, C, rtol=0.0, atol=TOLERANCE)
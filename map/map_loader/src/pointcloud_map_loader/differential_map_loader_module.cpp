@@ -14,11 +14,18 @@
 
 #include "differential_map_loader_module.hpp"
 
+#include <chrono>
+#include <cmath>
+#include <string>
 #include <utility>
+#include <vector>
 
 DifferentialMapLoaderModule::DifferentialMapLoaderModule(
-  rclcpp::Node * node, std::map<std::string, PCDFileMetadata> pcd_file_metadata_dict)
-: logger_(node->get_logger()), all_pcd_file_metadata_dict_(std::move(pcd_file_metadata_dict))
+  rclcpp::Node * node, std::map<std::string, PCDFileMetadata> pcd_file_metadata_dict,
+  const bool use_pointcloud_map_tiles)
+: logger_(node->get_logger()),
+  use_pointcloud_map_tiles_(use_pointcloud_map_tiles),
+  all_pcd_file_metadata_dict_(std::move(pcd_file_metadata_dict))
 {
   get_differential_pcd_maps_service_ = node->create_service<GetDifferentialPointCloudMap>(
     "service/get_differential_pcd_map",
@@ -67,21 +74,64 @@ void DifferentialMapLoaderModule::differential_area_load(
 
 bool DifferentialMapLoaderModule::on_service_get_differential_point_cloud_map(
   GetDifferentialPointCloudMap::Request::SharedPtr req,
-  GetDifferentialPointCloudMap::Response::SharedPtr res) const
+  GetDifferentialPointCloudMap::Response::SharedPtr res)
 {
   auto area = req->area;
   std::vector<std::string> cached_ids = req->cached_ids;
   differential_area_load(area, cached_ids, res);
   res->header.frame_id = "map";
+  if (use_pointcloud_map_tiles_) {
+    prefetch_tiles_ahead(area);
+  }
   return true;
 }
 
+void DifferentialMapLoaderModule::prefetch_tiles_ahead(
+  const autoware_map_msgs::msg::AreaInfo & area_info)
+{
+  const auto last_area_center = last_area_center_;
+  last_area_center_ = std::make_pair(area_info.center_x, area_info.center_y);
+  if (!last_area_center) return;
+
+  // the previous prefetch is still reading, skip this one rather than queueing up
+  if (
+    prefetch_future_.valid() &&
+    prefetch_future_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    return;
+  }
+
+  // the next queried area is expected one radius ahead along the direction of travel
+  const double dx = area_info.center_x - last_area_center->first;
+  const double dy = area_info.center_y - last_area_center->second;
+  const double distance = std::hypot(dx, dy);
+  if (distance < 1e-3) return;
+  autoware_map_msgs::msg::AreaInfo area_ahead = area_info;
+  area_ahead.center_x += dx / distance * area_info.radius;
+  area_ahead.center_y += dy / distance * area_info.radius;
+
+  std::vector<std::string> paths_to_prefetch;
+  for (const auto & [path, metadata] : all_pcd_file_metadata_dict_) {
+    if (
+      is_grid_within_queried_area(area_ahead, metadata) &&
+      !is_grid_within_queried_area(area_info, metadata)) {
+      paths_to_prefetch.push_back(path);
+    }
+  }
+  if (paths_to_prefetch.empty()) return;
+
+  prefetch_future_ = std::async(std::launch::async, [paths = std::move(paths_to_prefetch)]() {
+    for (const auto & path : paths) {
+      prefetch_pointcloud_map_tile(path);
+    }
+  });
+}
+
 autoware_map_msgs::msg::PointCloudMapCellWithID
 DifferentialMapLoaderModule::load_point_cloud_map_cell_with_id(
   const std::string & path, const std::string & map_id) const
 {
   sensor_msgs::msg::PointCloud2 pcd;
-  if (pcl::io::loadPCDFile(path, pcd) == -1) {
+  if (!load_pointcloud_map_cell(path, use_pointcloud_map_tiles_, pcd)) {
     RCLCPP_ERROR_STREAM(logger_, "PCD load failed: " << path);
   }
   autoware_map_msgs::msg::PointCloudMapCellWithID pointcloud_map_cell_with_id;
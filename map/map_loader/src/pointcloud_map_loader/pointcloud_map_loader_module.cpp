@@ -14,10 +14,12 @@
 
 #include "pointcloud_map_loader_module.hpp"
 
+#include "pointcloud_map_tile.hpp"
 #include "utils.hpp"
 
 #include <fmt/format.h>
 
+#include <filesystem>
 #include <string>
 #include <vector>
 
@@ -40,8 +42,9 @@ sensor_msgs::msg::PointCloud2 downsample(
 
 PointcloudMapLoaderModule::PointcloudMapLoaderModule(
   rclcpp::Node * node, const std::vector<std::string> & pcd_paths,
-  const std::string & publisher_name, const bool use_downsample)
-: logger_(node->get_logger())
+  const std::string & publisher_name, const bool use_downsample,
+  const bool use_pointcloud_map_tiles)
+: logger_(node->get_logger()), use_pointcloud_map_tiles_(use_pointcloud_map_tiles)
 {
   rclcpp::QoS durable_qos{1};
   durable_qos.transient_local();
@@ -78,12 +81,17 @@ sensor_msgs::msg::PointCloud2 PointcloudMapLoaderModule::load_pcd_files(
         logger_, fmt::format("Load {} ({} out of {})", path, i + 1, pcd_paths.size()));
     }
 
-    if (pcl::io::loadPCDFile(path, partial_pcd) == -1) {
-      RCLCPP_ERROR_STREAM(logger_, "PCD load failed: " << path);
-    }
-
-    if (leaf_size) {
-      partial_pcd = downsample(partial_pcd, leaf_size.get());
+    // the voxel summary of a tile is already downsampled
+    const bool loaded_from_voxel_summary =
+      leaf_size && load_downsampled_cell_from_tile(path, leaf_size.get(), partial_pcd);
+    if (!loaded_from_voxel_summary) {
+      if (!load_pointcloud_map_cell(path, use_pointcloud_map_tiles_, partial_pcd)) {
+        RCLCPP_ERROR_STREAM(logger_, "PCD load failed: " << path);
+      }
+
+      if (leaf_size) {
+        partial_pcd = downsample(partial_pcd, leaf_size.get());
+      }
     }
 
     if (whole_pcd.width == 0) {
@@ -99,3 +107,25 @@ sensor_msgs::msg::PointCloud2 PointcloudMapLoaderModule::load_pcd_files(
 
   return whole_pcd;
 }
+
+bool PointcloudMapLoaderModule::load_downsampled_cell_from_tile(
+  const std::string & pcd_path, const float leaf_size, sensor_msgs::msg::PointCloud2 & pcd) const
+{
+  if (!use_pointcloud_map_tiles_) return false;
+  const auto tile_path = get_pointcloud_map_tile_path(pcd_path);
+  if (!std::filesystem::exists(tile_path)) return false;
+  try {
+    const MappedPointCloudMapTile tile(tile_path);
+    // the summary holds the centroids of the same voxel grid as pcl::VoxelGrid
+    if (tile.header().num_voxels == 0 || tile.header().voxel_size != leaf_size) return false;
+    if (!tile.is_converted_from(pcd_path)) {
+      RCLCPP_WARN_STREAM(logger_, "Tile does not match its PCD file, reconvert it: " << tile_path);
+      return false;
+    }
+    tile.voxels_to_msg(pcd);
+    return true;
+  } catch (const std::runtime_error & e) {
+    RCLCPP_WARN_STREAM(logger_, e.what());
+    return false;
+  }
+}
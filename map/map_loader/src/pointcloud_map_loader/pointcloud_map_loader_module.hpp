@@ -33,14 +33,18 @@ class PointcloudMapLoaderModule
 public:
   explicit PointcloudMapLoaderModule(
     rclcpp::Node * node, const std::vector<std::string> & pcd_paths,
-    const std::string & publisher_name, const bool use_downsample);
+    const std::string & publisher_name, const bool use_downsample,
+    const bool use_pointcloud_map_tiles = false);
 
 private:
   rclcpp::Logger logger_;
+  const bool use_pointcloud_map_tiles_;
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr pub_pointcloud_map_;
 
   [[nodiscard]] sensor_msgs::msg::PointCloud2 load_pcd_files(
     const std::vector<std::string> & pcd_paths, const boost::optional<float> leaf_size) const;
+  [[nodiscard]] bool load_downsampled_cell_from_tile(
+    const std::string & pcd_path, const float leaf_size, sensor_msgs::msg::PointCloud2 & pcd) const;
 };
 
 #endif  // POINTCLOUD_MAP_LOADER__POINTCLOUD_MAP_LOADER_MODULE_HPP_
@@ -0,0 +1,331 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_map_tile.hpp"
+
+#include <pcl/io/pcd_io.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+uint64_t align_up(const uint64_t value)
+{
+  return (value + kPointCloudMapTileAlignment - 1) / kPointCloudMapTileAlignment *
+         kPointCloudMapTileAlignment;
+}
+
+// Byte offsets of the float32 x, y and z fields, -1 for a missing field
+std::array<int64_t, 3> find_xyz_offsets(const sensor_msgs::msg::PointCloud2 & pcd)
+{
+  std::array<int64_t, 3> offsets{-1, -1, -1};
+  for (const auto & field : pcd.fields) {
+    if (field.datatype != sensor_msgs::msg::PointField::FLOAT32 || field.count != 1) continue;
+    if (field.name == "x") offsets[0] = field.offset;
+    if (field.name == "y") offsets[1] = field.offset;
+    if (field.name == "z") offsets[2] = field.offset;
+  }
+  return offsets;
+}
+
+// Whether the section of count elements at the offset is aligned and within the file. The end of
+// the section is not computed, so that corrupted offsets and counts cannot overflow.
+bool is_valid_section(
+  const uint64_t offset, const uint64_t count, const uint64_t element_size,
+  const uint64_t file_size)
+{
+  return offset % kPointCloudMapTileAlignment == 0 && offset <= file_size &&
+         count <= (file_size - offset) / element_size;
+}
+
+void write_padding(std::ofstream & ofs, const uint64_t size)
+{
+  static const std::array<char, kPointCloudMapTileAlignment> zeros{};
+  ofs.write(zeros.data(), static_cast<std::streamsize>(size));
+}
+}  // namespace
+
+PointCloudMapTileSource get_pointcloud_map_tile_source(const std::string & pcd_path)
+{
+  struct stat st = {};
+  if (::stat(pcd_path.c_str(), &st) != 0) {
+    throw std::runtime_error("Failed to stat PCD file: " + pcd_path);
+  }
+  return {
+    static_cast<uint64_t>(st.st_size),
+    static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec};
+}
+
+std::string get_pointcloud_map_tile_path(const std::string & pcd_path)
+{
+  return std::filesystem::path(pcd_path).replace_extension(kPointCloudMapTileExtension).string();
+}
+
+void write_pointcloud_map_tile(
+  const sensor_msgs::msg::PointCloud2 & pcd, const std::string & tile_path, const float voxel_size,
+  const PointCloudMapTileSource & source)
+{
+  if (pcd.is_bigendian) {
+    throw std::runtime_error("Big endian point clouds are not supported: " + tile_path);
+  }
+  const uint64_t num_points = static_cast<uint64_t>(pcd.width) * pcd.height;
+  if (pcd.data.size() != num_points * pcd.point_step) {
+    throw std::runtime_error("Point cloud data size does not match its layout: " + tile_path);
+  }
+
+  PointCloudMapTileHeader header{};
+  std::memcpy(header.magic, kPointCloudMapTileMagic, sizeof(header.magic));
+  header.version = kPointCloudMapTileVersion;
+  header.byte_order = kPointCloudMapTileByteOrderMark;
+  header.height = pcd.height;
+  header.width = pcd.width;
+  header.point_step = pcd.point_step;
+  header.row_step = pcd.row_step;
+  header.is_bigendian = pcd.is_bigendian;
+  header.is_dense = pcd.is_dense;
+  header.source = source;
+  header.num_fields = static_cast<uint32_t>(pcd.fields.size());
+  std::fill(std::begin(header.min), std::end(header.min), std::numeric_limits<float>::max());
+  std::fill(std::begin(header.max), std::end(header.max), std::numeric_limits<float>::lowest());
+
+  std::vector<PointCloudMapTileField> fields(pcd.fields.size());
+  for (size_t i = 0; i < pcd.fields.size(); ++i) {
+    const auto & field = pcd.fields[i];
+    if (field.name.size() >= sizeof(fields[i].name)) {
+      throw std::runtime_error("Field name is too long: " + field.name);
+    }
+    std::memcpy(fields[i].name, field.name.data(), field.name.size());
+    fields[i].offset = field.offset;
+    fields[i].count = field.count;
+    fields[i].datatype = field.datatype;
+  }
+
+  // bounds and voxel centroids, keyed by the voxel index so that the summary is deterministic
+  std::vector<PointCloudMapTileVoxel> voxels;
+  const auto xyz_offsets = find_xyz_offsets(pcd);
+  if (std::all_of(xyz_offsets.begin(), xyz_offsets.end(), [](auto o) { return o >= 0; })) {
+    const bool summarize = voxel_size > 0.0f;
+    std::map<std::array<int64_t, 3>, std::array<double, 4>> voxel_sums;
+    for (uint64_t i = 0; i < num_points; ++i) {
+      const uint8_t * point = pcd.data.data() + i * pcd.point_step;
+      std::array<float, 3> p{};
+      for (size_t j = 0; j < 3; ++j) {
+        std::memcpy(&p[j], point + xyz_offsets[j], sizeof(float));
+      }
+      if (!std::isfinite(p[0]) || !std::isfinite(p[1]) || !std::isfinite(p[2])) continue;
+      for (size_t j = 0; j < 3; ++j) {
+        header.min[j] = std::min(header.min[j], p[j]);
+        header.max[j] = std::max(header.max[j], p[j]);
+      }
+      if (!summarize) continue;
+      const std::array<int64_t, 3> key{
+        static_cast<int64_t>(std::floor(p[0] / voxel_size)),
+        static_cast<int64_t>(std::floor(p[1] / voxel_size)),
+        static_cast<int64_t>(std::floor(p[2] / voxel_size))};
+      auto & sum = voxel_sums[key];
+      sum[0] += p[0];
+      sum[1] += p[1];
+      sum[2] += p[2];
+      sum[3] += 1.0;
+    }
+    if (summarize) {
+      header.voxel_size = voxel_size;
+      voxels.reserve(voxel_sums.size());
+      for (const auto & [key, sum] : voxel_sums) {
+        voxels.push_back(
+          {static_cast<float>(sum[0] / sum[3]), static_cast<float>(sum[1] / sum[3]),
+           static_cast<float>(sum[2] / sum[3]), static_cast<uint32_t>(sum[3])});
+      }
+    }
+  }
+  if (header.min[0] > header.max[0]) {
+    std::fill(std::begin(header.min), std::end(header.min), 0.0f);
+    std::fill(std::begin(header.max), std::end(header.max), 0.0f);
+  }
+  header.num_voxels = static_cast<uint32_t>(voxels.size());
+
+  header.fields_offset = align_up(sizeof(header));
+  header.voxels_offset =
+    align_up(header.fields_offset + fields.size() * sizeof(PointCloudMapTileField));
+  header.data_offset =
+    align_up(header.voxels_offset + voxels.size() * sizeof(PointCloudMapTileVoxel));
+  header.data_size = pcd.data.size();
+
+  const std::string tmp_path = tile_path + ".tmp";
+  {
+    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!ofs) {
+      throw std::runtime_error("Failed to open tile for writing: " + tmp_path);
+    }
+    const auto write_section = [&ofs](const void * src, const uint64_t size, const uint64_t end) {
+      ofs.write(reinterpret_cast<const char *>(src), static_cast<std::streamsize>(size));
+      write_padding(ofs, end - static_cast<uint64_t>(ofs.tellp()));
+    };
+    write_section(&header, sizeof(header), header.fields_offset);
+    write_section(
+      fields.data(), fields.size() * sizeof(PointCloudMapTileField), header.voxels_offset);
+    write_section(
+      voxels.data(), voxels.size() * sizeof(PointCloudMapTileVoxel), header.data_offset);
+    ofs.write(
+      reinterpret_cast<const char *>(pcd.data.data()),
+      static_cast<std::streamsize>(pcd.data.size()));
+    if (!ofs) {
+      throw std::runtime_error("Failed to write tile: " + tmp_path);
+    }
+  }
+  std::filesystem::rename(tmp_path, tile_path);
+}
+
+MappedPointCloudMapTile::MappedPointCloudMapTile(const std::string & tile_path)
+{
+  const int fd = ::open(tile_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open tile: " + tile_path);
+  }
+  struct stat st = {};
+  if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(PointCloudMapTileHeader)) {
+    ::close(fd);
+    throw std::runtime_error("Tile is too small: " + tile_path);
+  }
+  size_ = static_cast<size_t>(st.st_size);
+  address_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping keeps its own reference to the file
+  ::close(fd);
+  if (address_ == MAP_FAILED) {
+    address_ = nullptr;
+    throw std::runtime_error("Failed to map tile: " + tile_path);
+  }
+
+  const auto * base = static_cast<const uint8_t *>(address_);
+  header_ = reinterpret_cast<const PointCloudMapTileHeader *>(base);
+  const auto & h = *header_;
+  // the number of points fits in 64 bits, but not always multiplied by the point step
+  const uint64_t num_points = uint64_t{h.width} * h.height;
+  const bool valid =
+    std::memcmp(h.magic, kPointCloudMapTileMagic, sizeof(h.magic)) == 0 &&
+    h.version == kPointCloudMapTileVersion && h.byte_order == kPointCloudMapTileByteOrderMark &&
+    h.fields_offset >= sizeof(PointCloudMapTileHeader) &&
+    is_valid_section(h.fields_offset, h.num_fields, sizeof(PointCloudMapTileField), size_) &&
+    is_valid_section(h.voxels_offset, h.num_voxels, sizeof(PointCloudMapTileVoxel), size_) &&
+    is_valid_section(h.data_offset, h.data_size, 1, size_) &&
+    (num_points == 0 ? h.data_size == 0
+                     : h.data_size % num_points == 0 && h.data_size / num_points == h.point_step);
+  if (!valid) {
+    ::munmap(address_, size_);
+    address_ = nullptr;
+    throw std::runtime_error("Invalid tile: " + tile_path);
+  }
+  fields_ = reinterpret_cast<const PointCloudMapTileField *>(base + h.fields_offset);
+  voxels_ = reinterpret_cast<const PointCloudMapTileVoxel *>(base + h.voxels_offset);
+  data_ = base + h.data_offset;
+  // the data is read once from start to end by to_msg()
+  ::madvise(address_, size_, MADV_SEQUENTIAL);
+}
+
+MappedPointCloudMapTile::~MappedPointCloudMapTile()
+{
+  if (address_) {
+    ::munmap(address_, size_);
+  }
+}
+
+bool MappedPointCloudMapTile::is_converted_from(const std::string & pcd_path) const
+{
+  try {
+    return get_pointcloud_map_tile_source(pcd_path) == header_->source;
+  } catch (const std::runtime_error &) {
+    return false;
+  }
+}
+
+void MappedPointCloudMapTile::to_msg(sensor_msgs::msg::PointCloud2 & pcd) const
+{
+  const auto & h = *header_;
+  pcd.height = h.height;
+  pcd.width = h.width;
+  pcd.point_step = h.point_step;
+  pcd.row_step = h.row_step;
+  pcd.is_bigendian = h.is_bigendian;
+  pcd.is_dense = h.is_dense;
+  pcd.fields.resize(h.num_fields);
+  for (size_t i = 0; i < h.num_fields; ++i) {
+    const auto & src = fields_[i];
+    auto & dst = pcd.fields[i];
+    dst.name.assign(src.name, strnlen(src.name, sizeof(src.name)));
+    dst.offset = src.offset;
+    dst.count = src.count;
+    dst.datatype = src.datatype;
+  }
+  pcd.data.assign(data_, data_ + h.data_size);
+}
+
+void MappedPointCloudMapTile::voxels_to_msg(sensor_msgs::msg::PointCloud2 & pcd) const
+{
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  cloud.reserve(header_->num_voxels);
+  for (size_t i = 0; i < header_->num_voxels; ++i) {
+    cloud.push_back(pcl::PointXYZ(voxels_[i].x, voxels_[i].y, voxels_[i].z));
+  }
+  pcl::toROSMsg(cloud, pcd);
+}
+
+bool prefetch_pointcloud_map_tile(const std::string & pcd_path)
+{
+  const int fd = ::open(get_pointcloud_map_tile_path(pcd_path).c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  // starts asynchronous readahead of the whole file, the pages are then found in the page cache
+  // when the tile is mapped
+  const bool result = ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED) == 0;
+  ::close(fd);
+  return result;
+}
+
+bool load_pointcloud_map_cell(
+  const std::string & pcd_path, const bool use_tiles, sensor_msgs::msg::PointCloud2 & pcd)
+{
+  if (use_tiles) {
+    const auto tile_path = get_pointcloud_map_tile_path(pcd_path);
+    if (std::filesystem::exists(tile_path)) {
+      try {
+        const MappedPointCloudMapTile tile(tile_path);
+        // a stale tile falls back to the PCD file
+        if (tile.is_converted_from(pcd_path)) {
+          tile.to_msg(pcd);
+          return true;
+        }
+      } catch (const std::runtime_error &) {
+        // fall back to the PCD file
+      }
+    }
+  }
+  return pcl::io::loadPCDFile(pcd_path, pcd) != -1;
+}
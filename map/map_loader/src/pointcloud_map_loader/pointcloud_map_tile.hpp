@@ -0,0 +1,159 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_MAP_LOADER__POINTCLOUD_MAP_TILE_HPP_
+#define POINTCLOUD_MAP_LOADER__POINTCLOUD_MAP_TILE_HPP_
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// A point cloud map tile is a binary file that holds one PCD cell in the byte layout of
+// sensor_msgs::msg::PointCloud2, so that it can be memory-mapped and served without parsing.
+//
+// The header records the size and the modification time of the PCD file the tile was converted
+// from, so that a tile left over from a previous version of the PCD file is not served.
+//
+// The header and the summary are written in the byte order of the host, and a tile written on a
+// host of another byte order is rejected by the byte order mark of the header. The point data is
+// copied as is, and only little endian point clouds are supported.
+//
+// Layout (every section aligned to kPointCloudMapTileAlignment bytes):
+//   PointCloudMapTileHeader
+//   PointCloudMapTileField  x header.num_fields
+//   PointCloudMapTileVoxel  x header.num_voxels  (centroids of the points in each voxel)
+//   point data              (header.data_size bytes, same as PointCloud2::data)
+constexpr char kPointCloudMapTileMagic[8] = {'P', 'C', 'M', 'T', 'I', 'L', 'E', '\0'};
+constexpr uint32_t kPointCloudMapTileVersion = 3;
+constexpr uint32_t kPointCloudMapTileByteOrderMark = 0x01020304;
+constexpr uint64_t kPointCloudMapTileAlignment = 64;
+constexpr char kPointCloudMapTileExtension[] = ".pctile";
+
+// Size and modification time of the PCD file a tile is converted from
+struct PointCloudMapTileSource
+{
+  uint64_t size;
+  int64_t mtime_ns;  // nanoseconds since the epoch
+
+  bool operator==(const PointCloudMapTileSource & other) const
+  {
+    return size == other.size && mtime_ns == other.mtime_ns;
+  }
+};
+
+struct PointCloudMapTileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t height;
+  uint32_t width;
+  uint32_t point_step;
+  uint32_t row_step;
+  uint8_t is_bigendian;
+  uint8_t is_dense;
+  uint8_t reserved[2];
+  uint32_t num_fields;
+  uint32_t num_voxels;
+  float voxel_size;
+  float min[3];
+  float max[3];
+  uint32_t byte_order;  // kPointCloudMapTileByteOrderMark in the byte order of the writer
+  uint64_t fields_offset;
+  uint64_t voxels_offset;
+  uint64_t data_offset;
+  uint64_t data_size;
+  PointCloudMapTileSource source;
+};
+
+struct PointCloudMapTileField
+{
+  char name[32];
+  uint32_t offset;
+  uint32_t count;
+  uint8_t datatype;
+  uint8_t reserved[7];
+};
+
+struct PointCloudMapTileVoxel
+{
+  float x;
+  float y;
+  float z;
+  uint32_t num_points;
+};
+
+static_assert(sizeof(PointCloudMapTileHeader) == 120, "unexpected padding in tile header");
+static_assert(sizeof(PointCloudMapTileField) == 48, "unexpected padding in tile field");
+static_assert(sizeof(PointCloudMapTileVoxel) == 16, "unexpected padding in tile voxel");
+
+// Size and modification time of the given PCD file. Throws std::runtime_error if it does not exist.
+PointCloudMapTileSource get_pointcloud_map_tile_source(const std::string & pcd_path);
+
+// Path of the tile converted from the given PCD file, i.e. the PCD path with the tile extension
+std::string get_pointcloud_map_tile_path(const std::string & pcd_path);
+
+// Write the point cloud as a tile, with a voxel summary of the given voxel size (no summary if the
+// voxel size is not positive or the cloud has no float32 x, y and z fields), converted from the
+// PCD file described by source.
+// The tile is written to a temporary file first, so that readers never see a partial tile.
+// Throws std::runtime_error on failure.
+void write_pointcloud_map_tile(
+  const sensor_msgs::msg::PointCloud2 & pcd, const std::string & tile_path, const float voxel_size,
+  const PointCloudMapTileSource & source);
+
+// Read-only memory mapping of a tile. The constructor validates the header and throws
+// std::runtime_error if the file is not a valid tile.
+class MappedPointCloudMapTile
+{
+public:
+  explicit MappedPointCloudMapTile(const std::string & tile_path);
+  ~MappedPointCloudMapTile();
+  MappedPointCloudMapTile(const MappedPointCloudMapTile &) = delete;
+  MappedPointCloudMapTile & operator=(const MappedPointCloudMapTile &) = delete;
+
+  [[nodiscard]] const PointCloudMapTileHeader & header() const { return *header_; }
+  [[nodiscard]] const PointCloudMapTileField * fields() const { return fields_; }
+  [[nodiscard]] const PointCloudMapTileVoxel * voxels() const { return voxels_; }
+  [[nodiscard]] const uint8_t * data() const { return data_; }
+
+  // Whether the tile was converted from the PCD file as it is now, i.e. the PCD file has the same
+  // size and modification time as recorded in the header
+  [[nodiscard]] bool is_converted_from(const std::string & pcd_path) const;
+
+  // Copy the mapped tile into a message. The point data is copied as a single block.
+  void to_msg(sensor_msgs::msg::PointCloud2 & pcd) const;
+  // Build a message from the voxel centroids, with x, y and z fields only
+  void voxels_to_msg(sensor_msgs::msg::PointCloud2 & pcd) const;
+
+private:
+  void * address_{nullptr};
+  size_t size_{0};
+  const PointCloudMapTileHeader * header_{nullptr};
+  const PointCloudMapTileField * fields_{nullptr};
+  const PointCloudMapTileVoxel * voxels_{nullptr};
+  const uint8_t * data_{nullptr};
+};
+
+// Ask the kernel to read the tile of the given PCD file into the page cache in the background.
+// Returns false if there is no tile.
+bool prefetch_pointcloud_map_tile(const std::string & pcd_path);
+
+// Load a map cell from its tile if use_tiles is set and a valid tile converted from the current PCD
+// file exists next to it, otherwise from the PCD file itself. Returns false if both failed.
+bool load_pointcloud_map_cell(
+  const std::string & pcd_path, const bool use_tiles, sensor_msgs::msg::PointCloud2 & pcd);
+
+#endif  // POINTCLOUD_MAP_LOADER__POINTCLOUD_MAP_TILE_HPP_
@@ -0,0 +1,101 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Convert the PCD files of a divided pointcloud map into point cloud map tiles.
+// The tiles are written next to the PCD files, and are used by pointcloud_map_loader when
+// use_pointcloud_map_tiles is set.
+//
+// Usage: pointcloud_map_tile_converter <pcd_directory> <pcd_metadata_path> [voxel_size]
+
+#include "pointcloud_map_tile.hpp"
+#include "utils.hpp"
+
+#include <pcl/io/pcd_io.h>
+
+#include <filesystem>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+int main(int argc, char ** argv)
+{
+  const auto print_usage = [&]() {
+    std::cerr << "Usage: " << argv[0] << " <pcd_directory> <pcd_metadata_path> [voxel_size]"
+              << std::endl;
+  };
+  if (argc < 3 || argc > 4) {
+    print_usage();
+    return 1;
+  }
+  const std::string pcd_directory = argv[1];
+  const std::string pcd_metadata_path = argv[2];
+  // same as the default leaf_size of the downsampled whole map, so that it can use the summary
+  float voxel_size = 3.0f;
+  if (argc == 4) {
+    const std::string voxel_size_arg = argv[3];
+    size_t parsed_size = 0;
+    try {
+      voxel_size = std::stof(voxel_size_arg, &parsed_size);
+    } catch (const std::logic_error &) {
+      // std::invalid_argument or std::out_of_range, parsed_size stays 0
+    }
+    if (parsed_size == 0 || parsed_size != voxel_size_arg.size()) {
+      std::cerr << "Invalid voxel_size: " << voxel_size_arg << std::endl;
+      print_usage();
+      return 1;
+    }
+  }
+
+  std::vector<std::string> pcd_paths;
+  for (const auto & file : fs::directory_iterator(pcd_directory)) {
+    const auto ext = file.path().extension();
+    if (ext == ".pcd" || ext == ".PCD") {
+      pcd_paths.push_back(file.path().string());
+    }
+  }
+
+  std::set<std::string> missing_pcd_names;
+  const auto pcd_metadata_dict =
+    replace_with_absolute_path(load_pcd_metadata(pcd_metadata_path), pcd_paths, missing_pcd_names);
+  for (const auto & name : missing_pcd_names) {
+    std::cerr << "Missing PCD segment: " << name << std::endl;
+  }
+  if (!missing_pcd_names.empty()) {
+    return 1;
+  }
+
+  size_t num_converted = 0;
+  for (const auto & [pcd_path, metadata] : pcd_metadata_dict) {
+    sensor_msgs::msg::PointCloud2 pcd;
+    if (pcl::io::loadPCDFile(pcd_path, pcd) == -1) {
+      std::cerr << "PCD load failed: " << pcd_path << std::endl;
+      return 1;
+    }
+    const auto tile_path = get_pointcloud_map_tile_path(pcd_path);
+    try {
+      write_pointcloud_map_tile(
+        pcd, tile_path, voxel_size, get_pointcloud_map_tile_source(pcd_path));
+    } catch (const std::exception & e) {
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
+    std::cout << "[" << ++num_converted << "/" << pcd_metadata_dict.size() << "] " << tile_path
+              << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,215 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/pointcloud_map_loader/pointcloud_map_tile.hpp"
+
+#include <gmock/gmock.h>
+#include <pcl/io/pcd_io.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+pcl::PointCloud<pcl::PointXYZI> create_dummy_cloud()
+{
+  pcl::PointCloud<pcl::PointXYZI> cloud;
+  for (int i = 0; i < 100; ++i) {
+    pcl::PointXYZI point;
+    point.x = static_cast<float>(i % 10) * 0.5f;
+    point.y = static_cast<float>(i / 10) * 0.5f;
+    point.z = 1.0f;
+    point.intensity = static_cast<float>(i);
+    cloud.push_back(point);
+  }
+  return cloud;
+}
+}  // namespace
+
+TEST(PointCloudMapTileTest, WriteAndMap)
+{
+  sensor_msgs::msg::PointCloud2 pcd;
+  pcl::toROSMsg(create_dummy_cloud(), pcd);
+
+  const std::string tile_path =
+    (std::filesystem::temp_directory_path() / "test_pointcloud_map_tile.pctile").string();
+  write_pointcloud_map_tile(pcd, tile_path, 1.0f, PointCloudMapTileSource{});
+
+  const MappedPointCloudMapTile tile(tile_path);
+  sensor_msgs::msg::PointCloud2 loaded;
+  tile.to_msg(loaded);
+
+  EXPECT_EQ(loaded.width, pcd.width);
+  EXPECT_EQ(loaded.height, pcd.height);
+  EXPECT_EQ(loaded.point_step, pcd.point_step);
+  EXPECT_EQ(loaded.row_step, pcd.row_step);
+  EXPECT_EQ(loaded.data, pcd.data);
+  ASSERT_EQ(loaded.fields.size(), pcd.fields.size());
+  for (size_t i = 0; i < pcd.fields.size(); ++i) {
+    EXPECT_EQ(loaded.fields[i].name, pcd.fields[i].name);
+    EXPECT_EQ(loaded.fields[i].offset, pcd.fields[i].offset);
+    EXPECT_EQ(loaded.fields[i].datatype, pcd.fields[i].datatype);
+    EXPECT_EQ(loaded.fields[i].count, pcd.fields[i].count);
+  }
+
+  // the points span [0, 4.5] x [0, 4.5] at z = 1, i.e. 5 x 5 voxels of 4 points each
+  const auto & header = tile.header();
+  EXPECT_FLOAT_EQ(header.min[0], 0.0f);
+  EXPECT_FLOAT_EQ(header.max[1], 4.5f);
+  EXPECT_FLOAT_EQ(header.voxel_size, 1.0f);
+  ASSERT_EQ(header.num_voxels, 25u);
+  EXPECT_EQ(tile.voxels()[0].num_points, 4u);
+  EXPECT_FLOAT_EQ(tile.voxels()[0].x, 0.25f);
+  EXPECT_FLOAT_EQ(tile.voxels()[0].y, 0.25f);
+  EXPECT_FLOAT_EQ(tile.voxels()[0].z, 1.0f);
+}
+
+TEST(PointCloudMapTileTest, LoadCellPrefersTile)
+{
+  const auto pcd_path =
+    (std::filesystem::temp_directory_path() / "test_pointcloud_map_cell.pcd").string();
+  const auto cloud = create_dummy_cloud();
+  pcl::io::savePCDFileBinary(pcd_path, cloud);
+
+  sensor_msgs::msg::PointCloud2 pcd;
+  pcl::toROSMsg(cloud, pcd);
+  // drop half of the points from the tile to tell it apart from the PCD file
+  pcd.width /= 2;
+  pcd.row_step = pcd.width * pcd.point_step;
+  pcd.data.resize(pcd.row_step);
+  write_pointcloud_map_tile(
+    pcd, get_pointcloud_map_tile_path(pcd_path), 1.0f, get_pointcloud_map_tile_source(pcd_path));
+
+  sensor_msgs::msg::PointCloud2 loaded;
+  ASSERT_TRUE(load_pointcloud_map_cell(pcd_path, true, loaded));
+  EXPECT_EQ(loaded.width, cloud.size() / 2);
+  ASSERT_TRUE(load_pointcloud_map_cell(pcd_path, false, loaded));
+  EXPECT_EQ(loaded.width, cloud.size());
+  EXPECT_TRUE(prefetch_pointcloud_map_tile(pcd_path));
+
+  // a corrupted tile falls back to the PCD file
+  std::ofstream(get_pointcloud_map_tile_path(pcd_path), std::ios::trunc) << "not a tile";
+  ASSERT_TRUE(load_pointcloud_map_cell(pcd_path, true, loaded));
+  EXPECT_EQ(loaded.width, cloud.size());
+}
+
+TEST(PointCloudMapTileTest, StaleTileFallsBackToPcd)
+{
+  const auto pcd_path =
+    (std::filesystem::temp_directory_path() / "test_stale_pointcloud_map_cell.pcd").string();
+  auto cloud = create_dummy_cloud();
+  pcl::io::savePCDFileBinary(pcd_path, cloud);
+
+  sensor_msgs::msg::PointCloud2 pcd;
+  pcl::toROSMsg(cloud, pcd);
+  // drop half of the points from the tile to tell it apart from the PCD file
+  pcd.width /= 2;
+  pcd.row_step = pcd.width * pcd.point_step;
+  pcd.data.resize(pcd.row_step);
+  const auto write_tile = [&]() {
+    write_pointcloud_map_tile(
+      pcd, get_pointcloud_map_tile_path(pcd_path), 1.0f, get_pointcloud_map_tile_source(pcd_path));
+  };
+  write_tile();
+
+  sensor_msgs::msg::PointCloud2 loaded;
+  ASSERT_TRUE(load_pointcloud_map_cell(pcd_path, true, loaded));
+  EXPECT_EQ(loaded.width, cloud.size() / 2);
+
+  // the PCD file is modified after the conversion, with the same size
+  const auto mtime = std::filesystem::last_write_time(pcd_path);
+  std::filesystem::last_write_time(pcd_path, mtime + std::chrono::seconds(1));
+  EXPECT_FALSE(MappedPointCloudMapTile(get_pointcloud_map_tile_path(pcd_path))
+                 .is_converted_from(pcd_path));
+  ASSERT_TRUE(load_pointcloud_map_cell(pcd_path, true, loaded));
+  EXPECT_EQ(loaded.width, cloud.size());
+
+  // the PCD file is replaced by another one of a different size
+  write_tile();
+  cloud.push_back(cloud.front());
+  pcl::io::savePCDFileBinary(pcd_path, cloud);
+  std::filesystem::last_write_time(pcd_path, mtime + std::chrono::seconds(1));
+  ASSERT_TRUE(load_pointcloud_map_cell(pcd_path, true, loaded));
+  EXPECT_EQ(loaded.width, cloud.size());
+
+  // the PCD file is removed
+  write_tile();
+  std::filesystem::remove(pcd_path);
+  EXPECT_FALSE(MappedPointCloudMapTile(get_pointcloud_map_tile_path(pcd_path))
+                 .is_converted_from(pcd_path));
+}
+
+TEST(PointCloudMapTileTest, RejectInvalidTile)
+{
+  const auto tile_path =
+    (std::filesystem::temp_directory_path() / "test_invalid_pointcloud_map_tile.pctile").string();
+  std::ofstream(tile_path, std::ios::trunc) << std::string(256, 'x');
+  EXPECT_THROW(MappedPointCloudMapTile{tile_path}, std::runtime_error);
+  EXPECT_THROW(MappedPointCloudMapTile{tile_path + ".missing"}, std::runtime_error);
+}
+
+TEST(PointCloudMapTileTest, RejectCorruptedHeader)
+{
+  sensor_msgs::msg::PointCloud2 pcd;
+  pcl::toROSMsg(create_dummy_cloud(), pcd);
+  const auto tile_path =
+    (std::filesystem::temp_directory_path() / "test_corrupted_pointcloud_map_tile.pctile").string();
+
+  // write a valid tile, then overwrite a member of its header
+  const auto expect_rejected = [&](const auto & corrupt) {
+    write_pointcloud_map_tile(pcd, tile_path, 1.0f, PointCloudMapTileSource{});
+    PointCloudMapTileHeader header{};
+    {
+      std::ifstream ifs(tile_path, std::ios::binary);
+      ifs.read(reinterpret_cast<char *>(&header), sizeof(header));
+    }
+    corrupt(header);
+    {
+      std::fstream fs(tile_path, std::ios::binary | std::ios::in | std::ios::out);
+      fs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    }
+    EXPECT_THROW(MappedPointCloudMapTile{tile_path}, std::runtime_error);
+  };
+
+  write_pointcloud_map_tile(pcd, tile_path, 1.0f, PointCloudMapTileSource{});
+  EXPECT_NO_THROW(MappedPointCloudMapTile{tile_path});
+
+  // written on a host of another byte order
+  expect_rejected([](auto & h) { h.byte_order = 0x04030201; });
+  // offset + size wraps around to a small value
+  expect_rejected([](auto & h) { h.data_size = ~uint64_t{0} - h.data_offset + 2; });
+  expect_rejected([](auto & h) { h.num_voxels = ~uint32_t{0}; });
+  expect_rejected([](auto & h) { h.fields_offset = ~uint64_t{0} - 63; });
+  // misaligned sections
+  expect_rejected([](auto & h) { h.voxels_offset += 4; });
+  expect_rejected([](auto & h) { h.data_offset -= 4; });
+  // fields overlapping the header
+  expect_rejected([](auto & h) { h.fields_offset = 0; });
+  // the point step overflows when multiplied by the number of points
+  expect_rejected([](auto & h) {
+    h.width = ~uint32_t{0};
+    h.height = ~uint32_t{0};
+  });
+}
+
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleMock(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,7 +14,6 @@
 #include "autoware_crosswalk_traffic_light_estimator/node.hpp"
 
 #include <autoware_lanelet2_extension/regulatory_elements/Forward.hpp>
-#include <autoware_lanelet2_extension/utility/message_conversion.hpp>
 
 #include <iostream>
 #include <memory>
@@ -28,7 +27,7 @@ namespace
 
 bool hasMergeLane(
   const lanelet::ConstLanelet & lanelet_1, const lanelet::ConstLanelet & lanelet_2,
-  const lanelet::routing::RoutingGraphPtr & routing_graph_ptr)
+  const lanelet::routing::RoutingGraphConstPtr & routing_graph_ptr)
 {
   const auto next_lanelets_1 = routing_graph_ptr->following(lanelet_1);
   const auto next_lanelets_2 = routing_graph_ptr->following(lanelet_2);
@@ -46,7 +45,7 @@ bool hasMergeLane(
 
 bool hasMergeLane(
   const lanelet::ConstLanelets & lanelets,
-  const lanelet::routing::RoutingGraphPtr & routing_graph_ptr)
+  const lanelet::routing::RoutingGraphConstPtr & routing_graph_ptr)
 {
   for (size_t i = 0; i < lanelets.size(); ++i) {
     for (size_t j = i + 1; j < lanelets.size(); ++j) {
@@ -103,20 +102,11 @@ CrosswalkTrafficLightEstimatorNode::CrosswalkTrafficLightEstimatorNode(
 void CrosswalkTrafficLightEstimatorNode::onMap(const LaneletMapBin::ConstSharedPtr msg)
 {
   RCLCPP_DEBUG(get_logger(), "[CrosswalkTrafficLightEstimatorNode]: Start loading lanelet");
-  lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
-  lanelet::utils::conversion::fromBinMsg(
-    *msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
-  const auto traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
-    lanelet::Locations::Germany, lanelet::Participants::Vehicle);
-  const auto pedestrian_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
-    lanelet::Locations::Germany, lanelet::Participants::Pedestrian);
-  lanelet::routing::RoutingGraphConstPtr vehicle_graph =
-    lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *traffic_rules);
-  lanelet::routing::RoutingGraphConstPtr pedestrian_graph =
-    lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *pedestrian_rules);
-  lanelet::routing::RoutingGraphContainer overall_graphs({vehicle_graph, pedestrian_graph});
-  overall_graphs_ptr_ =
-    std::make_shared<const lanelet::routing::RoutingGraphContainer>(overall_graphs);
+  // the map and the routing graphs are shared with the other nodes in the same container
+  shared_lanelet_map_ = autoware::lanelet2_map_registry::getSharedLaneletMap(*msg);
+  lanelet_map_ptr_ = shared_lanelet_map_->map();
+  routing_graph_ptr_ = shared_lanelet_map_->vehicleRoutingGraph();
+  overall_graphs_ptr_ = shared_lanelet_map_->overallGraphs();
   RCLCPP_DEBUG(get_logger(), "[CrosswalkTrafficLightEstimatorNode]: Map is loaded");
 }
 
@@ -15,6 +15,7 @@
 #ifndef TRAFFIC_LIGHT_MAP_BASED_DETECTOR_NODE_HPP_
 #define TRAFFIC_LIGHT_MAP_BASED_DETECTOR_NODE_HPP_
 
+#include <autoware/lanelet2_map_registry/lanelet2_map_registry.hpp>
 #include <autoware_lanelet2_extension/regulatory_elements/autoware_traffic_light.hpp>
 #include <rclcpp/rclcpp.hpp>
 
@@ -102,7 +103,8 @@ private:
 
   std::set<int64_t> pedestrian_tl_id_;
 
-  lanelet::LaneletMapPtr lanelet_map_ptr_;
+  std::shared_ptr<const autoware::lanelet2_map_registry::SharedLaneletMap> shared_lanelet_map_;
+  lanelet::LaneletMapConstPtr lanelet_map_ptr_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_ptr_;
   lanelet::routing::RoutingGraphPtr routing_graph_ptr_;
 
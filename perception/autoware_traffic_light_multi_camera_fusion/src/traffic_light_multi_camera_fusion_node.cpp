@@ -14,7 +14,7 @@
 
 #include "traffic_light_multi_camera_fusion_node.hpp"
 
-#include <autoware_lanelet2_extension/utility/message_conversion.hpp>
+#include <autoware/lanelet2_map_registry/lanelet2_map_registry.hpp>
 #include <autoware_lanelet2_extension/utility/query.hpp>
 
 #include <algorithm>
@@ -206,9 +206,9 @@ void MultiCameraFusion::trafficSignalRoiCallback(
 void MultiCameraFusion::mapCallback(
   const autoware_map_msgs::msg::LaneletMapBin::ConstSharedPtr input_msg)
 {
-  lanelet::LaneletMapPtr lanelet_map_ptr = std::make_shared<lanelet::LaneletMap>();
-
-  lanelet::utils::conversion::fromBinMsg(*input_msg, lanelet_map_ptr);
+  // deserialized only if no other node in the same container holds this map
+  const auto shared_lanelet_map = autoware::lanelet2_map_registry::getSharedLaneletMap(*input_msg);
+  const auto & lanelet_map_ptr = shared_lanelet_map->map();
   lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr);
   std::vector<lanelet::AutowareTrafficLightConstPtr> all_lanelet_traffic_lights =
     lanelet::utils::query::autowareTrafficLights(all_lanelets);
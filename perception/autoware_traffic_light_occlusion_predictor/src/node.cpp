@@ -18,8 +18,8 @@
 
 #include <Eigen/Core>
 #include <Eigen/Geometry>
+#include <autoware/lanelet2_map_registry/lanelet2_map_registry.hpp>
 #include <autoware/universe_utils/system/stop_watch.hpp>
-#include <autoware_lanelet2_extension/utility/message_conversion.hpp>
 #include <autoware_lanelet2_extension/utility/utilities.hpp>
 #include <autoware_lanelet2_extension/visualization/visualization.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -101,9 +101,9 @@ void TrafficLightOcclusionPredictorNode::mapCallback(
   const autoware_map_msgs::msg::LaneletMapBin::ConstSharedPtr input_msg)
 {
   traffic_light_position_map_.clear();
-  auto lanelet_map_ptr = std::make_shared<lanelet::LaneletMap>();
-
-  lanelet::utils::conversion::fromBinMsg(*input_msg, lanelet_map_ptr);
+  // deserialized only if no other node in the same container holds this map
+  const auto shared_lanelet_map = autoware::lanelet2_map_registry::getSharedLaneletMap(*input_msg);
+  const auto & lanelet_map_ptr = shared_lanelet_map->map();
   lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr);
   std::vector<lanelet::AutowareTrafficLightConstPtr> all_lanelet_traffic_lights =
     lanelet::utils::query::autowareTrafficLights(all_lanelets);
@@ -66,6 +66,7 @@ struct AstarNode
   int steering_index;                    // steering index
   bool is_back;                          // true if the current direction of the vehicle is back
   AstarNode * parent = nullptr;          // parent node
+  uint32_t generation = 0;               // search in which the node was last initialized
 
   inline void set(
     const Pose & pose, const double move_cost, const double total_cost, const double steer_ind,
@@ -86,6 +87,43 @@ struct NodeComparison
   bool operator()(const AstarNode * lhs, const AstarNode * rhs) const { return lhs->fc > rhs->fc; }
 };
 
+/// @brief Open list of the A* search storing the nodes in buckets of constant cost width.
+/// @details Each bucket is a small binary heap, so nodes are popped in the same order as with a
+/// single std::priority_queue while push and pop only operate on a few elements. The buckets keep
+/// their memory between searches.
+class AstarOpenList
+{
+public:
+  explicit AstarOpenList(const double bucket_width = 0.5) : bucket_width_(bucket_width) {}
+
+  void push(AstarNode * node);
+  AstarNode * pop();
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+  void clear();
+
+private:
+  struct Entry
+  {
+    double cost;
+    AstarNode * node;
+  };
+  struct EntryComparison
+  {
+    bool operator()(const Entry & lhs, const Entry & rhs) const { return lhs.cost > rhs.cost; }
+  };
+
+  size_t getBucketIndex(const double cost) const;
+
+  std::vector<std::vector<Entry>> buckets_;
+  double bucket_width_;
+  size_t min_bucket_index_{0};
+  size_t size_{0};
+
+  // costs beyond this bucket are all stored in the last bucket to bound the memory usage
+  static constexpr size_t max_bucket_count_ = 1 << 16;
+};
+
 class AstarSearch : public AbstractPlanningAlgorithm
 {
 public:
@@ -120,6 +158,18 @@ public:
   }
 
 private:
+  // get the node of the current search, nodes of previous searches are lazily re-initialized
+  inline AstarNode * getNodeRef(const IndexXYT & index)
+  {
+    AstarNode * node = &graph_[getKey(index)];
+    if (node->generation != search_generation_) {
+      node->status = NodeStatus::None;
+      node->parent = nullptr;
+      node->generation = search_generation_;
+    }
+    return node;
+  }
+
   void setCollisionFreeDistanceMap();
   bool search();
   void expandNodes(AstarNode & current_node, const bool is_back = false);
@@ -141,9 +191,15 @@ private:
 
   // hybrid astar variables
   std::vector<AstarNode> graph_;
-  std::vector<double> col_free_distance_map_;
+  uint32_t search_generation_;
+  AstarOpenList openlist_;
 
-  std::priority_queue<AstarNode *, std::vector<AstarNode *>, NodeComparison> openlist_;
+  // collision free distance map from the goal, kept to be updated incrementally when only a small
+  // part of the costmap changes between two plans
+  std::vector<double> col_free_distance_map_;
+  std::vector<int> col_free_parent_map_;
+  std::vector<uint8_t> col_free_traversable_map_;
+  int col_free_goal_id_;
 
   // goal node, which may helpful in testing and debugging
   AstarNode * goal_node_;
@@ -168,6 +224,9 @@ private:
 
   // cost free obstacle distance
   static constexpr double cost_free_obs_dist = 5.0;
+
+  // the collision free distance map is recomputed from scratch above this ratio of changed cells
+  static constexpr double max_incremental_update_ratio_ = 0.2;
 };
 }  // namespace autoware::freespace_planning_algorithms
 
@@ -21,7 +21,12 @@
 
 #include <tf2/utils.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <limits>
+#include <queue>
+#include <utility>
 
 #ifdef ROS_DISTRO_GALACTIC
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
@@ -66,11 +71,57 @@ Pose calcRelativePose(const Pose & base_pose, const Pose & pose)
   return transformed.pose;
 }
 
+void AstarOpenList::push(AstarNode * node)
+{
+  const size_t bucket_index = getBucketIndex(node->fc);
+  if (buckets_.size() <= bucket_index) {
+    buckets_.resize(bucket_index + 1);
+  }
+  auto & bucket = buckets_[bucket_index];
+  bucket.push_back(Entry{node->fc, node});
+  std::push_heap(bucket.begin(), bucket.end(), EntryComparison{});
+  min_bucket_index_ = std::min(min_bucket_index_, bucket_index);
+  ++size_;
+}
+
+AstarNode * AstarOpenList::pop()
+{
+  if (empty()) {
+    return nullptr;
+  }
+  while (buckets_[min_bucket_index_].empty()) {
+    ++min_bucket_index_;
+  }
+  auto & bucket = buckets_[min_bucket_index_];
+  std::pop_heap(bucket.begin(), bucket.end(), EntryComparison{});
+  AstarNode * node = bucket.back().node;
+  bucket.pop_back();
+  --size_;
+  return node;
+}
+
+void AstarOpenList::clear()
+{
+  for (auto & bucket : buckets_) {
+    bucket.clear();
+  }
+  min_bucket_index_ = buckets_.size();
+  size_ = 0;
+}
+
+size_t AstarOpenList::getBucketIndex(const double cost) const
+{
+  const double index = std::floor(std::max(cost, 0.0) / bucket_width_);
+  return std::min(static_cast<size_t>(index), max_bucket_count_ - 1);
+}
+
 AstarSearch::AstarSearch(
   const PlannerCommonParam & planner_common_param, const VehicleShape & collision_vehicle_shape,
   const AstarParam & astar_param)
 : AbstractPlanningAlgorithm(planner_common_param, collision_vehicle_shape),
   astar_param_(astar_param),
+  search_generation_(0),
+  col_free_goal_id_(-1),
   goal_node_(nullptr),
   use_reeds_shepp_(true)
 {
@@ -89,6 +140,15 @@ AstarSearch::AstarSearch(
 
 void AstarSearch::setMap(const nav_msgs::msg::OccupancyGrid & costmap)
 {
+  // the collision free distance map can only be updated incrementally on the same grid
+  const auto & prev_info = costmap_.info;
+  const auto & info = costmap.info;
+  if (
+    prev_info.width != info.width || prev_info.height != info.height ||
+    prev_info.resolution != info.resolution || prev_info.origin != info.origin) {
+    col_free_goal_id_ = -1;
+  }
+
   AbstractPlanningAlgorithm::setMap(costmap);
 
   // ensure minimum expansion distance is larger then grid cell diagonal length
@@ -124,54 +184,134 @@ bool AstarSearch::makePlan(const Pose & start_pose, const Pose & goal_pose)
 void AstarSearch::resetData()
 {
   // clearing openlist is necessary because otherwise remaining elements of openlist
-  // point to deleted node.
-  openlist_ = std::priority_queue<AstarNode *, std::vector<AstarNode *>, NodeComparison>();
-  const int nb_of_grid_nodes = costmap_.info.width * costmap_.info.height;
-  const int total_astar_node_count = nb_of_grid_nodes * planner_common_param_.theta_size;
-  graph_ = std::vector<AstarNode>(total_astar_node_count);
-  col_free_distance_map_ =
-    std::vector<double>(nb_of_grid_nodes, std::numeric_limits<double>::max());
+  // point to nodes of the previous search.
+  openlist_.clear();
+  const size_t nb_of_grid_nodes = costmap_.info.width * costmap_.info.height;
+  const size_t total_astar_node_count = nb_of_grid_nodes * planner_common_param_.theta_size;
+  if (graph_.size() != total_astar_node_count) {
+    graph_ = std::vector<AstarNode>(total_astar_node_count);
+    search_generation_ = 0;
+  }
+
+  // nodes are re-initialized on their first access in the new search (see getNodeRef)
+  ++search_generation_;
+  if (search_generation_ == 0) {
+    for (auto & node : graph_) {
+      node.generation = 0;
+    }
+    search_generation_ = 1;
+  }
 }
 
 void AstarSearch::setCollisionFreeDistanceMap()
 {
-  using Entry = std::pair<IndexXY, double>;
+  using Entry = std::pair<int, double>;
   struct CompareEntry
   {
     bool operator()(const Entry & a, const Entry & b) const { return a.second > b.second; }
   };
-  std::priority_queue<Entry, std::vector<Entry>, CompareEntry> heap;
-  std::vector<bool> closed(col_free_distance_map_.size(), false);
-  auto goal_index = pose2index(costmap_, goal_pose_, planner_common_param_.theta_size);
-  col_free_distance_map_[indexToId(goal_index)] = 0.0;
-  heap.push({IndexXY{goal_index.x, goal_index.y}, 0.0});
 
-  Entry current;
-  std::array<int, 3> offsets = {1, 0, -1};
-  while (!heap.empty()) {
-    current = heap.top();
-    heap.pop();
-    const int id = indexToId(current.first);
-    if (closed[id]) continue;
-    closed[id] = true;
+  const int width = static_cast<int>(costmap_.info.width);
+  const int nb_of_grid_nodes = width * static_cast<int>(costmap_.info.height);
+  const auto goal_index = pose2index(costmap_, goal_pose_, planner_common_param_.theta_size);
+  const int goal_id = indexToId(goal_index);
+
+  std::vector<uint8_t> traversable_map(nb_of_grid_nodes);
+  for (int id = 0; id < nb_of_grid_nodes; ++id) {
+    traversable_map[id] = !is_obstacle_table_[id] &&
+                          edt_map_[id] >= 0.5 * collision_vehicle_shape_.width;
+  }
 
-    const auto & index = current.first;
+  // call func(neighbor_id, step_distance) for all neighbors of the given cell
+  const std::array<int, 3> offsets = {1, 0, -1};
+  const auto for_each_neighbor = [&](const int id, const auto & func) {
+    const IndexXY index{id % width, id / width};
     for (const auto & offset_x : offsets) {
-      const int x = index.x + offset_x;
       for (const auto & offset_y : offsets) {
-        const int y = index.y + offset_y;
-        const IndexXY n_index{x, y};
+        const IndexXY n_index{index.x + offset_x, index.y + offset_y};
         const double offset = std::abs(offset_x) + std::abs(offset_y);
-        if (isOutOfRange(n_index) || isObs(n_index) || offset < 1) continue;
-        if (getObstacleEDT(n_index) < 0.5 * collision_vehicle_shape_.width) continue;
-        const int n_id = indexToId(n_index);
-        const double dist = current.second + (sqrt(offset) * costmap_.info.resolution);
-        if (closed[n_id] || col_free_distance_map_[n_id] < dist) continue;
-        col_free_distance_map_[n_id] = dist;
-        heap.push({n_index, dist});
+        if (isOutOfRange(n_index) || offset < 1) continue;
+        func(indexToId(n_index), std::sqrt(offset) * costmap_.info.resolution);
+      }
+    }
+  };
+
+  std::priority_queue<Entry, std::vector<Entry>, CompareEntry> heap;
+
+  std::vector<int> changed_ids;
+  const bool is_updatable = goal_id == col_free_goal_id_ &&
+                            static_cast<int>(col_free_traversable_map_.size()) == nb_of_grid_nodes;
+  if (is_updatable) {
+    for (int id = 0; id < nb_of_grid_nodes; ++id) {
+      if (traversable_map[id] != col_free_traversable_map_[id]) {
+        changed_ids.push_back(id);
       }
     }
   }
+
+  if (
+    !is_updatable ||
+    static_cast<double>(changed_ids.size()) > max_incremental_update_ratio_ * nb_of_grid_nodes) {
+    col_free_distance_map_.assign(nb_of_grid_nodes, std::numeric_limits<double>::max());
+    col_free_parent_map_.assign(nb_of_grid_nodes, -1);
+    col_free_distance_map_[goal_id] = 0.0;
+    heap.push({goal_id, 0.0});
+  } else {
+    // invalidate the cells whose shortest path to the goal goes through a newly blocked cell
+    std::vector<int> invalidated_ids;
+    for (const int id : changed_ids) {
+      if (traversable_map[id] || id == goal_id) continue;
+      col_free_distance_map_[id] = std::numeric_limits<double>::max();
+      col_free_parent_map_[id] = -1;
+      invalidated_ids.push_back(id);
+    }
+    for (size_t i = 0; i < invalidated_ids.size(); ++i) {
+      const int id = invalidated_ids[i];
+      for_each_neighbor(id, [&](const int n_id, const double) {
+        if (col_free_parent_map_[n_id] != id) return;
+        col_free_distance_map_[n_id] = std::numeric_limits<double>::max();
+        col_free_parent_map_[n_id] = -1;
+        invalidated_ids.push_back(n_id);
+      });
+    }
+
+    // restart the search from the boundary of the invalidated cells and from newly freed cells
+    const auto seed = [&](const int id) {
+      if (!traversable_map[id]) return;
+      for_each_neighbor(id, [&](const int n_id, const double step) {
+        const double dist = col_free_distance_map_[n_id] + step;
+        if (col_free_distance_map_[n_id] == std::numeric_limits<double>::max()) return;
+        if (dist >= col_free_distance_map_[id]) return;
+        col_free_distance_map_[id] = dist;
+        col_free_parent_map_[id] = n_id;
+      });
+      if (col_free_distance_map_[id] < std::numeric_limits<double>::max()) {
+        heap.push({id, col_free_distance_map_[id]});
+      }
+    };
+    for (const int id : invalidated_ids) seed(id);
+    for (const int id : changed_ids) {
+      if (traversable_map[id]) seed(id);
+    }
+  }
+
+  col_free_traversable_map_ = std::move(traversable_map);
+  col_free_goal_id_ = goal_id;
+
+  while (!heap.empty()) {
+    const auto [id, dist] = heap.top();
+    heap.pop();
+    if (dist > col_free_distance_map_[id]) continue;
+
+    for_each_neighbor(id, [&](const int n_id, const double step) {
+      if (!col_free_traversable_map_[n_id]) return;
+      const double n_dist = dist + step;
+      if (col_free_distance_map_[n_id] <= n_dist) return;
+      col_free_distance_map_[n_id] = n_dist;
+      col_free_parent_map_[n_id] = id;
+      heap.push({n_id, n_dist});
+    });
+  }
 }
 
 bool AstarSearch::setStartNode()
@@ -181,7 +321,7 @@ bool AstarSearch::setStartNode()
   if (detectCollision(index)) return false;
 
   // Set start node
-  AstarNode * start_node = &graph_[getKey(index)];
+  AstarNode * start_node = getNodeRef(index);
   start_node->set(start_pose_, 0.0, estimateCost(start_pose_, index), 0, false);
   start_node->dir_distance = 0.0;
   start_node->dist_to_goal = calcDistance2d(start_pose_, goal_pose_);
@@ -220,8 +360,7 @@ bool AstarSearch::search()
     }
 
     // Expand minimum cost node
-    AstarNode * current_node = openlist_.top();
-    openlist_.pop();
+    AstarNode * current_node = openlist_.pop();
     if (current_node->status == NodeStatus::Closed) continue;
     current_node->status = NodeStatus::Closed;
 
@@ -259,7 +398,7 @@ void AstarSearch::expandNodes(AstarNode & current_node, const bool is_back)
 
     if (isOutOfRange(next_index) || isObs(next_index)) continue;
 
-    AstarNode * next_node = &graph_[getKey(next_index)];
+    AstarNode * next_node = getNodeRef(next_index);
     if (next_node->status == NodeStatus::Closed || detectCollision(next_index)) continue;
 
     const double distance_to_obs = getObstacleEDT(next_index);
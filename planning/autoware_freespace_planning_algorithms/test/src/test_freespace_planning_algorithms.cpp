@@ -385,6 +385,48 @@ TEST(RRTStarTestSuite, InformedUpdate)
   EXPECT_TRUE(test_algorithm(AlgorithmType::RRTSTAR_INFORMED_UPDATE));
 }
 
+// replanning on a costmap where only a small obstacle moves between two plans, which is the typical
+// use case in parking lots. The first plan of each goal builds the search graph and the collision
+// free distance map from scratch, the following ones reuse them.
+TEST(AstarSearchTestSuite, DISABLED_ReplanningBenchmark)
+{
+  constexpr size_t nb_of_replans = 20;
+  const auto base_costmap_msg = construct_cost_map(150, 150, 0.2, 10);
+
+  rclcpp::Clock clock{RCL_SYSTEM_TIME};
+  for (const bool use_multi : {true, false}) {
+    auto algo = configure_astar(use_multi);
+    for (size_t i = 0; i < goal_poses.size(); ++i) {
+      double first_plan_msec = 0.0;
+      double replan_msec_sum = 0.0;
+      for (size_t j = 0; j <= nb_of_replans; ++j) {
+        // moving obstacle (about a pedestrian size) far from the start and goal poses
+        auto costmap_msg = base_costmap_msg;
+        const size_t obstacle_x = 100 + j;
+        for (size_t y = 20; y < 23; ++y) {
+          for (size_t x = obstacle_x; x < obstacle_x + 3; ++x) {
+            costmap_msg.data[y * costmap_msg.info.width + x] = 100;
+          }
+        }
+
+        const rclcpp::Time begin = clock.now();
+        algo->setMap(costmap_msg);
+        EXPECT_TRUE(
+          algo->makePlan(create_pose_msg(start_pose), create_pose_msg(goal_poses.at(i))));
+        const double msec = (clock.now() - begin).seconds() * 1000.0;
+        if (j == 0) {
+          first_plan_msec = msec;
+        } else {
+          replan_msec_sum += msec;
+        }
+      }
+      std::cout << (use_multi ? "multi" : "single") << " curvature, goal " << i
+                << " : first plan " << first_plan_msec << "[msec], average replan "
+                << replan_msec_sum / nb_of_replans << "[msec]" << std::endl;
+    }
+  }
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
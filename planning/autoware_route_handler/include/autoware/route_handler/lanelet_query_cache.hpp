@@ -0,0 +1,182 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__ROUTE_HANDLER__LANELET_QUERY_CACHE_HPP_
+#define AUTOWARE__ROUTE_HANDLER__LANELET_QUERY_CACHE_HPP_
+
+#include <lanelet2_core/Forward.h>
+#include <lanelet2_core/primitives/Lanelet.h>
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace autoware::route_handler
+{
+struct QueryCacheStatistics
+{
+  size_t hit_count{0};
+  size_t miss_count{0};
+
+  double hitRate() const
+  {
+    const auto query_count = hit_count + miss_count;
+    return query_count == 0 ? 0.0
+                            : static_cast<double>(hit_count) / static_cast<double>(query_count);
+  }
+
+  QueryCacheStatistics & operator+=(const QueryCacheStatistics & other)
+  {
+    hit_count += other.hit_count;
+    miss_count += other.miss_count;
+    return *this;
+  }
+};
+
+namespace detail
+{
+inline void hashCombine(size_t & seed, const size_t value)
+{
+  seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+template <typename T>
+size_t hashValue(const T & value)
+{
+  return std::hash<T>{}(value);
+}
+
+// NOTE: the lanelet is identified by its ID and direction here. The equality of the key compares
+// the underlying primitive data, so that a modified copy of a lanelet which has the same ID does not
+// hit the cached result of the original one.
+inline size_t hashValue(const lanelet::ConstLanelet & lanelet)
+{
+  size_t seed = std::hash<lanelet::Id>{}(lanelet.id());
+  hashCombine(seed, std::hash<bool>{}(lanelet.inverted()));
+  return seed;
+}
+
+inline size_t hashValue(const std::vector<lanelet::Id> & ids)
+{
+  size_t seed = ids.size();
+  for (const auto id : ids) {
+    hashCombine(seed, std::hash<lanelet::Id>{}(id));
+  }
+  return seed;
+}
+
+struct TupleHash
+{
+  template <typename... Args>
+  size_t operator()(const std::tuple<Args...> & key) const
+  {
+    size_t seed = 0;
+    std::apply([&seed](const auto &... args) { (hashCombine(seed, hashValue(args)), ...); }, key);
+    return seed;
+  }
+};
+}  // namespace detail
+
+/**
+ * @brief Thread-safe memoization table of a lanelet query.
+ * @details The query is computed outside of the lock, so that the computation can recursively use
+ * the same table. When the table reaches the maximum size, all the entries are discarded.
+ */
+template <typename Key, typename Value>
+class QueryCache
+{
+public:
+  explicit QueryCache(const size_t max_size) : max_size_(max_size) {}
+
+  template <typename Compute>
+  Value getOrCompute(const Key & key, Compute && compute)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      const auto itr = table_.find(key);
+      if (itr != table_.end()) {
+        ++statistics_.hit_count;
+        return itr->second;
+      }
+      ++statistics_.miss_count;
+    }
+
+    Value value = std::invoke(std::forward<Compute>(compute));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (table_.size() >= max_size_) {
+      table_.clear();
+    }
+    table_.emplace(key, value);
+    return value;
+  }
+
+  QueryCacheStatistics getStatistics() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+  }
+
+private:
+  size_t max_size_;
+  mutable std::mutex mutex_;
+  std::unordered_map<Key, Value, detail::TupleHash> table_;
+  QueryCacheStatistics statistics_;
+};
+
+/**
+ * @brief Memoized results of the lanelet queries of RouteHandler.
+ * @details The results depend on the map and the route, so that a new instance has to be created
+ * whenever either of them is updated.
+ */
+struct LaneletQueryCache
+{
+  static constexpr size_t max_size{4096};
+
+  // lanelet, backward_distance, forward_distance, only_route_lanes
+  QueryCache<std::tuple<lanelet::ConstLanelet, double, double, bool>, lanelet::ConstLanelets>
+    lanelet_sequence{max_size};
+  // lanelet, enable_same_root, get_shoulder_lane
+  QueryCache<std::tuple<lanelet::ConstLanelet, bool, bool>, std::optional<lanelet::ConstLanelet>>
+    right_lanelet{max_size};
+  QueryCache<std::tuple<lanelet::ConstLanelet, bool, bool>, std::optional<lanelet::ConstLanelet>>
+    left_lanelet{max_size};
+  // lanelet, length, IDs of exclude_lanelets
+  QueryCache<
+    std::tuple<lanelet::ConstLanelet, double, std::vector<lanelet::Id>>,
+    std::vector<lanelet::ConstLanelets>>
+    preceding_lanelet_sequence{max_size};
+  // lanelet, is_right, is_left, is_opposite, invert_opposite
+  QueryCache<std::tuple<lanelet::ConstLanelet, bool, bool, bool, bool>, lanelet::ConstLanelets>
+    shared_linestring_lanelets{max_size};
+
+  QueryCacheStatistics getStatistics() const
+  {
+    QueryCacheStatistics statistics;
+    statistics += lanelet_sequence.getStatistics();
+    statistics += right_lanelet.getStatistics();
+    statistics += left_lanelet.getStatistics();
+    statistics += preceding_lanelet_sequence.getStatistics();
+    statistics += shared_linestring_lanelets.getStatistics();
+    return statistics;
+  }
+};
+}  // namespace autoware::route_handler
+
+#endif  // AUTOWARE__ROUTE_HANDLER__LANELET_QUERY_CACHE_HPP_
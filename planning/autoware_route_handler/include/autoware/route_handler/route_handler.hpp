@@ -15,6 +15,8 @@
 #ifndef AUTOWARE__ROUTE_HANDLER__ROUTE_HANDLER_HPP_
 #define AUTOWARE__ROUTE_HANDLER__ROUTE_HANDLER_HPP_
 
+#include "autoware/route_handler/lanelet_query_cache.hpp"
+
 #include <rclcpp/logger.hpp>
 
 #include <autoware_map_msgs/msg/lanelet_map_bin.hpp>
@@ -326,6 +328,14 @@ public:
    */
   lanelet::ConstLanelets getShoulderLaneletsAtPose(const Pose & pose) const;
 
+  /**
+   * @brief Get the hit and miss counts of the memoized lanelet queries.
+   * @details getLaneletSequence (without pose), getRightLanelet, getLeftLanelet,
+   * getPrecedingLaneletSequence and getAllSharedLineStringLanelets are memoized. The counts are
+   * reset when the map or the route is updated.
+   */
+  QueryCacheStatistics getQueryCacheStatistics() const;
+
 private:
   // MUST
   lanelet::routing::RoutingGraphPtr routing_graph_ptr_;
@@ -347,8 +357,13 @@ private:
   Pose original_start_pose_;
   Pose original_goal_pose_;
 
+  // memoized results of the lanelet queries, which is shared with the copies of this handler until
+  // the map or the route is updated.
+  std::shared_ptr<LaneletQueryCache> query_cache_{std::make_shared<LaneletQueryCache>()};
+
   // non-const methods
   void setLaneletsFromRouteMsg();
+  void resetQueryCache();
 
   // const methods
   // for routing
@@ -377,6 +392,15 @@ private:
   lanelet::ConstLanelets getPreviousLaneletSequence(
     const lanelet::ConstLanelets & lanelet_sequence) const;
   lanelet::ConstLanelets getNeighborsWithinRoute(const lanelet::ConstLanelet & lanelet) const;
+  lanelet::ConstLanelets getLaneletSequenceImpl(
+    const lanelet::ConstLanelet & lanelet, const double backward_distance,
+    const double forward_distance, const bool only_route_lanes) const;
+  std::optional<lanelet::ConstLanelet> getRightLaneletImpl(
+    const lanelet::ConstLanelet & lanelet, const bool enable_same_root,
+    const bool get_shoulder_lane) const;
+  std::optional<lanelet::ConstLanelet> getLeftLaneletImpl(
+    const lanelet::ConstLanelet & lanelet, const bool enable_same_root,
+    const bool get_shoulder_lane) const;
 
   // for path
 
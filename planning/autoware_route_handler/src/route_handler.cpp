@@ -184,6 +184,8 @@ RouteHandler::RouteHandler(const LaneletMapBin & map_msg)
 
 void RouteHandler::setMap(const LaneletMapBin & map_msg)
 {
+  resetQueryCache();
+  // the map is exposed as mutable by getLaneletMapPtr(), so each handler keeps its own copy
   lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
   lanelet::utils::conversion::fromBinMsg(
     map_msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
@@ -198,18 +200,16 @@ void RouteHandler::setMap(const LaneletMapBin & map_msg)
       map_msg.version_map_format.c_str(), static_cast<int>(lanelet::autoware::version));
   }
 
-  const auto traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
-    lanelet::Locations::Germany, lanelet::Participants::Vehicle);
+  // the vehicle graph built by fromBinMsg uses the same traffic rules, so only the pedestrian graph
+  // is built here
   const auto pedestrian_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
     lanelet::Locations::Germany, lanelet::Participants::Pedestrian);
-  const lanelet::routing::RoutingGraphConstPtr vehicle_graph =
-    lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *traffic_rules);
   const lanelet::routing::RoutingGraphConstPtr pedestrian_graph =
     lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *pedestrian_rules);
-  const lanelet::routing::RoutingGraphContainer overall_graphs({vehicle_graph, pedestrian_graph});
+  const lanelet::routing::RoutingGraphContainer overall_graphs(
+    {routing_graph_ptr_, pedestrian_graph});
   overall_graphs_ptr_ =
     std::make_shared<const lanelet::routing::RoutingGraphContainer>(overall_graphs);
-  lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
 
   is_map_msg_ready_ = true;
   is_handler_ready_ = false;
@@ -241,6 +241,7 @@ void RouteHandler::setRoute(const LaneletRoute & route_msg)
     }
     route_ptr_ = std::make_shared<LaneletRoute>(route_msg);
     is_handler_ready_ = false;
+    resetQueryCache();
     setLaneletsFromRouteMsg();
   } else {
     RCLCPP_ERROR(
@@ -256,6 +257,7 @@ bool RouteHandler::isHandlerReady() const
 
 void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets)
 {
+  resetQueryCache();
   if (!path_lanelets.empty()) {
     const auto & first_lanelet = path_lanelets.front();
     start_lanelets_ = lanelet::utils::query::getAllNeighbors(routing_graph_ptr_, first_lanelet);
@@ -362,6 +364,7 @@ void RouteHandler::clearRoute()
   goal_lanelets_.clear();
   route_ptr_ = nullptr;
   is_handler_ready_ = false;
+  resetQueryCache();
 }
 
 void RouteHandler::setLaneletsFromRouteMsg()
@@ -654,6 +657,16 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceUpTo(
 lanelet::ConstLanelets RouteHandler::getLaneletSequence(
   const lanelet::ConstLanelet & lanelet, const double backward_distance,
   const double forward_distance, const bool only_route_lanes) const
+{
+  return query_cache_->lanelet_sequence.getOrCompute(
+    std::make_tuple(lanelet, backward_distance, forward_distance, only_route_lanes), [&]() {
+      return getLaneletSequenceImpl(lanelet, backward_distance, forward_distance, only_route_lanes);
+    });
+}
+
+lanelet::ConstLanelets RouteHandler::getLaneletSequenceImpl(
+  const lanelet::ConstLanelet & lanelet, const double backward_distance,
+  const double forward_distance, const bool only_route_lanes) const
 {
   Pose current_pose{};
   current_pose.orientation.w = 1;
@@ -1007,6 +1020,15 @@ lanelet::ConstLanelets RouteHandler::getPreviousLanelets(
 std::optional<lanelet::ConstLanelet> RouteHandler::getRightLanelet(
   const lanelet::ConstLanelet & lanelet, const bool enable_same_root,
   const bool get_shoulder_lane) const
+{
+  return query_cache_->right_lanelet.getOrCompute(
+    std::make_tuple(lanelet, enable_same_root, get_shoulder_lane),
+    [&]() { return getRightLaneletImpl(lanelet, enable_same_root, get_shoulder_lane); });
+}
+
+std::optional<lanelet::ConstLanelet> RouteHandler::getRightLaneletImpl(
+  const lanelet::ConstLanelet & lanelet, const bool enable_same_root,
+  const bool get_shoulder_lane) const
 {
   // right road lanelet of shoulder lanelet
   if (isShoulderLanelet(lanelet)) {
@@ -1073,6 +1095,15 @@ std::optional<lanelet::ConstLanelet> RouteHandler::getRightLanelet(
 std::optional<lanelet::ConstLanelet> RouteHandler::getLeftLanelet(
   const lanelet::ConstLanelet & lanelet, const bool enable_same_root,
   const bool get_shoulder_lane) const
+{
+  return query_cache_->left_lanelet.getOrCompute(
+    std::make_tuple(lanelet, enable_same_root, get_shoulder_lane),
+    [&]() { return getLeftLaneletImpl(lanelet, enable_same_root, get_shoulder_lane); });
+}
+
+std::optional<lanelet::ConstLanelet> RouteHandler::getLeftLaneletImpl(
+  const lanelet::ConstLanelet & lanelet, const bool enable_same_root,
+  const bool get_shoulder_lane) const
 {
   // left road lanelet of shoulder lanelet
   if (isShoulderLanelet(lanelet)) {
@@ -1228,21 +1259,24 @@ lanelet::ConstLanelets RouteHandler::getAllSharedLineStringLanelets(
   const lanelet::ConstLanelet & current_lane, bool is_right, bool is_left, bool is_opposite,
   const bool & invert_opposite) const noexcept
 {
-  lanelet::ConstLanelets shared{current_lane};
+  return query_cache_->shared_linestring_lanelets.getOrCompute(
+    std::make_tuple(current_lane, is_right, is_left, is_opposite, invert_opposite), [&]() {
+      lanelet::ConstLanelets shared{current_lane};
 
-  if (is_right) {
-    const lanelet::ConstLanelets all_right_lanelets =
-      getAllRightSharedLinestringLanelets(current_lane, is_opposite, invert_opposite);
-    shared.insert(shared.end(), all_right_lanelets.begin(), all_right_lanelets.end());
-  }
+      if (is_right) {
+        const lanelet::ConstLanelets all_right_lanelets =
+          getAllRightSharedLinestringLanelets(current_lane, is_opposite, invert_opposite);
+        shared.insert(shared.end(), all_right_lanelets.begin(), all_right_lanelets.end());
+      }
 
-  if (is_left) {
-    const lanelet::ConstLanelets all_left_lanelets =
-      getAllLeftSharedLinestringLanelets(current_lane, is_opposite, invert_opposite);
-    shared.insert(shared.end(), all_left_lanelets.begin(), all_left_lanelets.end());
-  }
+      if (is_left) {
+        const lanelet::ConstLanelets all_left_lanelets =
+          getAllLeftSharedLinestringLanelets(current_lane, is_opposite, invert_opposite);
+        shared.insert(shared.end(), all_left_lanelets.begin(), all_left_lanelets.end());
+      }
 
-  return shared;
+      return shared;
+    });
 }
 
 lanelet::Lanelets RouteHandler::getLeftOppositeLanelets(const lanelet::ConstLanelet & lanelet) const
@@ -1294,8 +1328,29 @@ std::vector<lanelet::ConstLanelets> RouteHandler::getPrecedingLaneletSequence(
   const lanelet::ConstLanelet & lanelet, const double length,
   const lanelet::ConstLanelets & exclude_lanelets) const
 {
-  return lanelet::utils::query::getPrecedingLaneletSequences(
-    routing_graph_ptr_, lanelet, length, exclude_lanelets);
+  std::vector<lanelet::Id> exclude_lanelet_ids;
+  exclude_lanelet_ids.reserve(exclude_lanelets.size());
+  for (const auto & exclude_lanelet : exclude_lanelets) {
+    exclude_lanelet_ids.push_back(exclude_lanelet.id());
+  }
+
+  return query_cache_->preceding_lanelet_sequence.getOrCompute(
+    std::make_tuple(lanelet, length, exclude_lanelet_ids), [&]() {
+      return lanelet::utils::query::getPrecedingLaneletSequences(
+        routing_graph_ptr_, lanelet, length, exclude_lanelets);
+    });
+}
+
+QueryCacheStatistics RouteHandler::getQueryCacheStatistics() const
+{
+  return query_cache_->getStatistics();
+}
+
+void RouteHandler::resetQueryCache()
+{
+  // NOTE: the cache may be shared with copies of this handler, so that it is replaced instead of
+  // being cleared.
+  query_cache_ = std::make_shared<LaneletQueryCache>();
 }
 
 std::optional<lanelet::ConstLanelet> RouteHandler::getLaneChangeTarget(
@@ -145,6 +145,59 @@ TEST_F(TestRouteHandler, checkGetLaneletSequence)
   ASSERT_EQ(current_lanes.at(5).id(), 4785ul);
 }
 
+TEST_F(TestRouteHandler, checkLaneletQueryIsMemoized)
+{
+  const auto lane = route_handler_->getLaneletsFromId(4765);
+  const auto initial_statistics = route_handler_->getQueryCacheStatistics();
+
+  const auto lanelet_sequence = route_handler_->getLaneletSequence(lane);
+  const auto right_lanelet = route_handler_->getRightLanelet(lane);
+  const auto statistics_after_miss = route_handler_->getQueryCacheStatistics();
+  ASSERT_EQ(statistics_after_miss.hit_count, initial_statistics.hit_count);
+  ASSERT_GT(statistics_after_miss.miss_count, initial_statistics.miss_count);
+
+  const auto cached_lanelet_sequence = route_handler_->getLaneletSequence(lane);
+  const auto cached_right_lanelet = route_handler_->getRightLanelet(lane);
+  const auto statistics_after_hit = route_handler_->getQueryCacheStatistics();
+  ASSERT_EQ(statistics_after_hit.hit_count, statistics_after_miss.hit_count + 2);
+  ASSERT_EQ(statistics_after_hit.miss_count, statistics_after_miss.miss_count);
+  ASSERT_GT(statistics_after_hit.hitRate(), 0.0);
+
+  ASSERT_EQ(cached_lanelet_sequence.size(), lanelet_sequence.size());
+  for (size_t i = 0; i < lanelet_sequence.size(); ++i) {
+    ASSERT_EQ(cached_lanelet_sequence.at(i).id(), lanelet_sequence.at(i).id());
+  }
+  ASSERT_EQ(cached_right_lanelet.has_value(), right_lanelet.has_value());
+  if (right_lanelet) {
+    ASSERT_EQ(cached_right_lanelet->id(), right_lanelet->id());
+  }
+
+  // the memoized results are discarded when the route is updated
+  set_test_route(lane_change_right_test_route_filename);
+  const auto statistics_after_reset = route_handler_->getQueryCacheStatistics();
+  ASSERT_EQ(statistics_after_reset.hit_count, 0ul);
+  ASSERT_EQ(statistics_after_reset.miss_count, 0ul);
+}
+
+TEST_F(TestRouteHandler, checkMapIsNotSharedBetweenHandlers)
+{
+  const auto lanelet2_path =
+    get_absolute_path_to_lanelet_map(autoware_test_utils_dir, "2km_test.osm");
+  const auto map_bin_msg =
+    autoware::test_utils::make_map_bin_msg(lanelet2_path, center_line_resolution);
+
+  // the map is exposed as mutable, so a modification by one handler is not seen by the others
+  const RouteHandler route_handler(map_bin_msg);
+  ASSERT_NE(route_handler.getLaneletMapPtr(), route_handler_->getLaneletMapPtr());
+  auto modified_lanelet = *route_handler.getLaneletMapPtr()->laneletLayer.begin();
+  const auto lanelet = route_handler_->getLaneletMapPtr()->laneletLayer.get(modified_lanelet.id());
+  const auto centerline_size = lanelet.centerline().size();
+  modified_lanelet.setCenterline(
+    lanelet::LineString3d(lanelet::InvalId, {modified_lanelet.leftBound().front()}));
+  ASSERT_EQ(modified_lanelet.centerline().size(), 1ul);
+  ASSERT_EQ(lanelet.centerline().size(), centerline_size);
+}
+
 TEST_F(TestRouteHandler, checkLateralIntervalToPreferredLaneWhenLaneChangeToRight)
 {
   const auto current_lanes = get_current_lanes();
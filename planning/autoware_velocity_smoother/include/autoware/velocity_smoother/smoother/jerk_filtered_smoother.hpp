@@ -19,12 +19,14 @@
 #include "autoware/universe_utils/geometry/geometry.hpp"
 #include "autoware/universe_utils/system/time_keeper.hpp"
 #include "autoware/velocity_smoother/smoother/smoother_base.hpp"
-#include "qp_interface/qp_interface.hpp"
+#include "qp_interface/proxqp_interface.hpp"
 
 #include "autoware_planning_msgs/msg/trajectory_point.hpp"
 
 #include "boost/optional.hpp"
 
+#include <Eigen/Sparse>
+
 #include <memory>
 #include <vector>
 
@@ -60,9 +62,26 @@ public:
 
 private:
   Param smoother_param_;
-  std::shared_ptr<autoware::common::QPInterface> qp_interface_;
+  std::shared_ptr<autoware::common::ProxQPInterface> qp_interface_;
   rclcpp::Logger logger_{rclcpp::get_logger("smoother").get_child("jerk_filtered_smoother")};
 
+  // QP workspace kept between the cycles. The sparsity pattern of P and A only depends on the
+  // number of the optimized points, so that the solver can update the problem in place.
+  size_t qp_points_num_{0};
+  Eigen::SparseMatrix<double> P_;
+  Eigen::SparseMatrix<double> A_;
+  std::vector<double> q_;
+  std::vector<double> lower_bound_;
+  std::vector<double> upper_bound_;
+
+  // previous solution used as the initial guess of the next optimization
+  TrajectoryPoints prev_opt_trajectory_;
+  std::vector<double> prev_optval_;
+
+  void initializeQPWorkspace(const size_t N);
+  std::vector<double> calcInitialGuess(
+    const TrajectoryPoints & opt_resampled_trajectory, const size_t N) const;
+
   TrajectoryPoints forwardJerkFilter(
     const double v0, const double a0, const double a_max, const double a_stop, const double j_max,
     const TrajectoryPoints & input) const;
@@ -42,7 +42,7 @@ JerkFilteredSmoother::JerkFilteredSmoother(
   p.jerk_filter_ds = node.declare_parameter<double>("jerk_filter_ds");
 
   qp_interface_ =
-    std::make_shared<autoware::common::ProxQPInterface>(false, 20000, 1.0e-8, 1.0e-6, false);
+    std::make_shared<autoware::common::ProxQPInterface>(true, 20000, 1.0e-8, 1.0e-6, false);
 }
 
 void JerkFilteredSmoother::setParam(const Param & smoother_param)
@@ -182,17 +182,17 @@ bool JerkFilteredSmoother::apply(
   const uint32_t IDX_SIGMA0 = 3 * N;
   const uint32_t IDX_GAMMA0 = 4 * N;
 
-  const uint32_t l_variables = 5 * N;
-  const uint32_t l_constraints = 4 * N + 1;
-
-  // the matrix size depends on constraint numbers.
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(l_constraints, l_variables);
-
-  std::vector<double> lower_bound(l_constraints, 0.0);
-  std::vector<double> upper_bound(l_constraints, 0.0);
+  // the sparsity pattern depends only on N, so that it is kept while N does not change.
+  if (N != qp_points_num_) {
+    initializeQPWorkspace(N);
+  }
 
-  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(l_variables, l_variables);
-  std::vector<double> q(l_variables, 0.0);
+  // reset the values without changing the sparsity pattern
+  std::fill(P_.valuePtr(), P_.valuePtr() + P_.nonZeros(), 0.0);
+  std::fill(A_.valuePtr(), A_.valuePtr() + A_.nonZeros(), 0.0);
+  std::fill(q_.begin(), q_.end(), 0.0);
+  std::fill(lower_bound_.begin(), lower_bound_.end(), 0.0);
+  std::fill(upper_bound_.begin(), upper_bound_.end(), 0.0);
 
   /**************************************************************/
   /**************************************************************/
@@ -206,10 +206,13 @@ bool JerkFilteredSmoother::apply(
     const double ref_vel = 0.5 * (v_max_arr.at(i) + v_max_arr.at(i + 1));
     const double interval_dist = std::max(interval_dist_arr.at(i), 0.0001);
     const double w_x_ds_inv = (1.0 / interval_dist) * ref_vel;
-    P(IDX_A0 + i, IDX_A0 + i) += smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i, IDX_A0 + i + 1) -= smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i + 1, IDX_A0 + i) -= smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i + 1, IDX_A0 + i + 1) += smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
+    P_.coeffRef(IDX_A0 + i, IDX_A0 + i) += smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
+    P_.coeffRef(IDX_A0 + i, IDX_A0 + i + 1) -=
+      smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
+    P_.coeffRef(IDX_A0 + i + 1, IDX_A0 + i) -=
+      smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
+    P_.coeffRef(IDX_A0 + i + 1, IDX_A0 + i + 1) +=
+      smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
   }
 
   // |v_max_i^2 - b_i|/v_max^2 -> minimize (-bi) * ds / v_max^2
@@ -220,11 +223,11 @@ bool JerkFilteredSmoother::apply(
       if (i < N - 1) {
         v_weight_term *= std::max(interval_dist_arr.at(i), 0.0001);
       }
-      q.at(IDX_B0 + i) += v_weight_term;
+      q_.at(IDX_B0 + i) += v_weight_term;
     }
-    P(IDX_DELTA0 + i, IDX_DELTA0 + i) += over_v_weight;  // over velocity cost
-    P(IDX_SIGMA0 + i, IDX_SIGMA0 + i) += over_a_weight;  // over acceleration cost
-    P(IDX_GAMMA0 + i, IDX_GAMMA0 + i) += over_j_weight;  // over jerk cost
+    P_.coeffRef(IDX_DELTA0 + i, IDX_DELTA0 + i) += over_v_weight;  // over velocity cost
+    P_.coeffRef(IDX_SIGMA0 + i, IDX_SIGMA0 + i) += over_a_weight;  // over acceleration cost
+    P_.coeffRef(IDX_GAMMA0 + i, IDX_GAMMA0 + i) += over_j_weight;  // over jerk cost
   }
 
   /**************************************************************/
@@ -245,25 +248,25 @@ bool JerkFilteredSmoother::apply(
 
   // Soft Constraint Velocity Limit: 0 < b - delta < v_max^2
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_B0 + i) = 1.0;       // b_i
-    A(constr_idx, IDX_DELTA0 + i) = -1.0;  // -delta_i
-    upper_bound[constr_idx] = v_max_arr.at(i) * v_max_arr.at(i);
-    lower_bound[constr_idx] = 0.0;
+    A_.coeffRef(constr_idx, IDX_B0 + i) = 1.0;       // b_i
+    A_.coeffRef(constr_idx, IDX_DELTA0 + i) = -1.0;  // -delta_i
+    upper_bound_[constr_idx] = v_max_arr.at(i) * v_max_arr.at(i);
+    lower_bound_[constr_idx] = 0.0;
   }
 
   // Soft Constraint Acceleration Limit: a_min < a - sigma < a_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_A0 + i) = 1.0;       // a_i
-    A(constr_idx, IDX_SIGMA0 + i) = -1.0;  // -sigma_i
+    A_.coeffRef(constr_idx, IDX_A0 + i) = 1.0;       // a_i
+    A_.coeffRef(constr_idx, IDX_SIGMA0 + i) = -1.0;  // -sigma_i
 
     constexpr double stop_vel = 1e-3;
     if (v_max_arr.at(i) < stop_vel) {
       // Stop Point
-      upper_bound[constr_idx] = a_stop_decel;
-      lower_bound[constr_idx] = a_stop_decel;
+      upper_bound_[constr_idx] = a_stop_decel;
+      lower_bound_[constr_idx] = a_stop_decel;
     } else {
-      upper_bound[constr_idx] = a_max;
-      lower_bound[constr_idx] = a_min;
+      upper_bound_[constr_idx] = a_max;
+      lower_bound_[constr_idx] = a_min;
     }
   }
 
@@ -272,40 +275,48 @@ bool JerkFilteredSmoother::apply(
   for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
     const double ref_vel = 0.5 * (v_max_arr.at(i) + v_max_arr.at(i + 1));
     const double ds = interval_dist_arr.at(i);
-    A(constr_idx, IDX_A0 + i) = -ref_vel;     // -a[i] * ref_vel
-    A(constr_idx, IDX_A0 + i + 1) = ref_vel;  //  a[i+1] * ref_vel
-    A(constr_idx, IDX_GAMMA0 + i) = -ds;      // -gamma[i] * ds
-    upper_bound[constr_idx] = j_max * ds;     //  jerk_max * ds
-    lower_bound[constr_idx] = j_min * ds;     //  jerk_min * ds
+    A_.coeffRef(constr_idx, IDX_A0 + i) = -ref_vel;     // -a[i] * ref_vel
+    A_.coeffRef(constr_idx, IDX_A0 + i + 1) = ref_vel;  //  a[i+1] * ref_vel
+    A_.coeffRef(constr_idx, IDX_GAMMA0 + i) = -ds;      // -gamma[i] * ds
+    upper_bound_[constr_idx] = j_max * ds;              //  jerk_max * ds
+    lower_bound_[constr_idx] = j_min * ds;              //  jerk_min * ds
   }
 
   // b' = 2a ... (b(i+1) - b(i)) / ds = 2a(i)
   for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
-    A(constr_idx, IDX_B0 + i) = -1.0;                            // b(i)
-    A(constr_idx, IDX_B0 + i + 1) = 1.0;                         // b(i+1)
-    A(constr_idx, IDX_A0 + i) = -2.0 * interval_dist_arr.at(i);  // a(i) * ds
-    upper_bound[constr_idx] = 0.0;
-    lower_bound[constr_idx] = 0.0;
+    A_.coeffRef(constr_idx, IDX_B0 + i) = -1.0;                            // b(i)
+    A_.coeffRef(constr_idx, IDX_B0 + i + 1) = 1.0;                         // b(i+1)
+    A_.coeffRef(constr_idx, IDX_A0 + i) = -2.0 * interval_dist_arr.at(i);  // a(i) * ds
+    upper_bound_[constr_idx] = 0.0;
+    lower_bound_[constr_idx] = 0.0;
   }
 
   // initial condition
   {
-    A(constr_idx, IDX_B0) = 1.0;  // b0
-    upper_bound[constr_idx] = v0 * v0;
-    lower_bound[constr_idx] = v0 * v0;
+    A_.coeffRef(constr_idx, IDX_B0) = 1.0;  // b0
+    upper_bound_[constr_idx] = v0 * v0;
+    lower_bound_[constr_idx] = v0 * v0;
     ++constr_idx;
 
-    A(constr_idx, IDX_A0) = 1.0;  // a0
-    upper_bound[constr_idx] = a0;
-    lower_bound[constr_idx] = a0;
+    A_.coeffRef(constr_idx, IDX_A0) = 1.0;  // a0
+    upper_bound_[constr_idx] = a0;
+    lower_bound_[constr_idx] = a0;
     ++constr_idx;
   }
+
+  // shift the previous solution by the ego travel distance and use it as the initial guess
+  const auto initial_guess = calcInitialGuess(opt_resampled_trajectory, N);
+  if (!initial_guess.empty()) {
+    qp_interface_->setPrimalVariables(initial_guess);
+  }
   time_keeper_->end_track("initOptimization");
 
   // execute optimization
   time_keeper_->start_track("optimize");
-  const auto optval = qp_interface_->optimize(P, A, q, lower_bound, upper_bound);
+  const auto optval = qp_interface_->optimize(P_, A_, q_, lower_bound_, upper_bound_);
   time_keeper_->end_track("optimize");
+  prev_opt_trajectory_.clear();
+  prev_optval_.clear();
   if (!qp_interface_->isSolved()) {
     RCLCPP_WARN(logger_, "optimization failed : %s", qp_interface_->getStatus().c_str());
     return false;
@@ -317,6 +328,9 @@ bool JerkFilteredSmoother::apply(
     RCLCPP_WARN(logger_, "optimization failed: result contains NaN values");
     return false;
   }
+  prev_opt_trajectory_.assign(
+    opt_resampled_trajectory.begin(), opt_resampled_trajectory.begin() + N);
+  prev_optval_ = optval;
 
   const auto tf1 = std::chrono::system_clock::now();
   const double dt_ms1 =
@@ -354,6 +368,113 @@ bool JerkFilteredSmoother::apply(
   return true;
 }
 
+void JerkFilteredSmoother::initializeQPWorkspace(const size_t N)
+{
+  autoware::universe_utils::ScopedTimeTrack st(__func__, *time_keeper_);
+
+  const size_t IDX_B0 = 0;
+  const size_t IDX_A0 = N;
+  const size_t IDX_DELTA0 = 2 * N;
+  const size_t IDX_SIGMA0 = 3 * N;
+  const size_t IDX_GAMMA0 = 4 * N;
+
+  const size_t l_variables = 5 * N;
+  const size_t l_constraints = 4 * N + 1;
+
+  // NOTE: every element which can be non-zero is registered even if its value is zero, so that the
+  // sparsity pattern does not change between the cycles.
+  using Triplet = Eigen::Triplet<double>;
+  std::vector<Triplet> P_triplets;
+  P_triplets.reserve(4 * (N - 1) + 3 * N);
+  for (size_t i = 0; i < N - 1; ++i) {
+    P_triplets.emplace_back(IDX_A0 + i, IDX_A0 + i, 0.0);
+    P_triplets.emplace_back(IDX_A0 + i, IDX_A0 + i + 1, 0.0);
+    P_triplets.emplace_back(IDX_A0 + i + 1, IDX_A0 + i, 0.0);
+    P_triplets.emplace_back(IDX_A0 + i + 1, IDX_A0 + i + 1, 0.0);
+  }
+  for (size_t i = 0; i < N; ++i) {
+    P_triplets.emplace_back(IDX_DELTA0 + i, IDX_DELTA0 + i, 0.0);
+    P_triplets.emplace_back(IDX_SIGMA0 + i, IDX_SIGMA0 + i, 0.0);
+    P_triplets.emplace_back(IDX_GAMMA0 + i, IDX_GAMMA0 + i, 0.0);
+  }
+  P_.resize(l_variables, l_variables);
+  P_.setFromTriplets(P_triplets.begin(), P_triplets.end());
+  P_.makeCompressed();
+
+  std::vector<Triplet> A_triplets;
+  A_triplets.reserve(4 * N + 6 * (N - 1) + 2);
+  size_t constr_idx = 0;
+  for (size_t i = 0; i < N; ++i, ++constr_idx) {
+    A_triplets.emplace_back(constr_idx, IDX_B0 + i, 0.0);
+    A_triplets.emplace_back(constr_idx, IDX_DELTA0 + i, 0.0);
+  }
+  for (size_t i = 0; i < N; ++i, ++constr_idx) {
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, 0.0);
+    A_triplets.emplace_back(constr_idx, IDX_SIGMA0 + i, 0.0);
+  }
+  for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, 0.0);
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i + 1, 0.0);
+    A_triplets.emplace_back(constr_idx, IDX_GAMMA0 + i, 0.0);
+  }
+  for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
+    A_triplets.emplace_back(constr_idx, IDX_B0 + i, 0.0);
+    A_triplets.emplace_back(constr_idx, IDX_B0 + i + 1, 0.0);
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, 0.0);
+  }
+  A_triplets.emplace_back(constr_idx++, IDX_B0, 0.0);
+  A_triplets.emplace_back(constr_idx++, IDX_A0, 0.0);
+  A_.resize(l_constraints, l_variables);
+  A_.setFromTriplets(A_triplets.begin(), A_triplets.end());
+  A_.makeCompressed();
+
+  q_.assign(l_variables, 0.0);
+  lower_bound_.assign(l_constraints, 0.0);
+  upper_bound_.assign(l_constraints, 0.0);
+
+  qp_points_num_ = N;
+}
+
+std::vector<double> JerkFilteredSmoother::calcInitialGuess(
+  const TrajectoryPoints & opt_resampled_trajectory, const size_t N) const
+{
+  const size_t prev_N = prev_opt_trajectory_.size();
+  if (prev_N < 2 || prev_optval_.size() != 5 * prev_N) {
+    return {};
+  }
+
+  // travel distance of the ego from the previous cycle
+  const double travel_dist = autoware::motion_utils::calcSignedArcLength(
+    prev_opt_trajectory_, 0, opt_resampled_trajectory.front().pose.position);
+  const auto prev_s_arr = trajectory_utils::calcArclengthArray(prev_opt_trajectory_);
+  if (travel_dist < 0.0 || prev_s_arr.back() < travel_dist) {
+    return {};
+  }
+
+  const auto s_arr = trajectory_utils::calcArclengthArray(opt_resampled_trajectory);
+
+  // NOTE: the slack variables (delta, sigma and gamma) are initialized with zero.
+  std::vector<double> initial_guess(5 * N, 0.0);
+  size_t prev_idx = 0;
+  for (size_t i = 0; i < N; ++i) {
+    const double prev_s = s_arr.at(i) + travel_dist;
+    while (prev_idx + 2 < prev_N && prev_s_arr.at(prev_idx + 1) < prev_s) {
+      ++prev_idx;
+    }
+    const double ds = prev_s_arr.at(prev_idx + 1) - prev_s_arr.at(prev_idx);
+    const double ratio =
+      ds < 1e-6 ? 0.0 : std::clamp((prev_s - prev_s_arr.at(prev_idx)) / ds, 0.0, 1.0);
+    const auto lerp = [&](const size_t offset) {
+      const double v0 = prev_optval_.at(offset + prev_idx);
+      const double v1 = prev_optval_.at(offset + prev_idx + 1);
+      return v0 + ratio * (v1 - v0);
+    };
+    initial_guess.at(i) = lerp(0);           // b
+    initial_guess.at(N + i) = lerp(prev_N);  // a
+  }
+  return initial_guess;
+}
+
 TrajectoryPoints JerkFilteredSmoother::forwardJerkFilter(
   const double v0, const double a0, const double a_max, const double a_start, const double j_max,
   const TrajectoryPoints & input) const
@@ -0,0 +1,97 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/velocity_smoother/smoother/jerk_filtered_smoother.hpp"
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+using autoware::velocity_smoother::JerkFilteredSmoother;
+using autoware::velocity_smoother::TrajectoryPoints;
+using autoware_planning_msgs::msg::TrajectoryPoint;
+
+namespace
+{
+TrajectoryPoints generateStraightTrajectory(
+  const double start_x, const size_t size, const double velocity)
+{
+  TrajectoryPoints tps;
+  TrajectoryPoint p;
+  p.pose.orientation.w = 1.0;
+  p.longitudinal_velocity_mps = velocity;
+  for (size_t i = 0; i < size; ++i) {
+    p.pose.position.x = start_x + static_cast<double>(i);
+    tps.push_back(p);
+  }
+  // stop at the end
+  tps.back().longitudinal_velocity_mps = 0.0;
+  return tps;
+}
+
+std::shared_ptr<JerkFilteredSmoother> generateSmoother()
+{
+  auto node_options = rclcpp::NodeOptions{};
+  const auto velocity_smoother_dir =
+    ament_index_cpp::get_package_share_directory("autoware_velocity_smoother");
+  node_options.arguments(
+    {"--ros-args", "--params-file",
+     velocity_smoother_dir + "/config/default_velocity_smoother.param.yaml", "--params-file",
+     velocity_smoother_dir + "/config/default_common.param.yaml", "--params-file",
+     velocity_smoother_dir + "/config/JerkFiltered.param.yaml"});
+
+  // the parameters are read in the constructor, so that the node is not kept
+  rclcpp::Node node("jerk_filtered_smoother_test_node", node_options);
+  return std::make_shared<JerkFilteredSmoother>(
+    node, std::make_shared<autoware::universe_utils::TimeKeeper>());
+}
+}  // namespace
+
+TEST(TestJerkFilteredSmoother, WarmStartMatchesColdSolve)
+{
+  rclcpp::init(0, nullptr);
+
+  constexpr double v0 = 5.0;
+  constexpr double a0 = 0.0;
+  constexpr double epsilon = 1e-3;
+
+  // the workspace and the previous solution of this smoother are reused in every cycle
+  const auto warm_smoother = generateSmoother();
+  for (int cycle = 0; cycle < 5; ++cycle) {
+    // the ego moves forward by 1 m in every cycle
+    const auto input = generateStraightTrajectory(static_cast<double>(cycle), 100, 10.0);
+
+    TrajectoryPoints warm_output;
+    TrajectoryPoints cold_output;
+    std::vector<TrajectoryPoints> debug_trajectories;
+    ASSERT_TRUE(warm_smoother->apply(v0, a0, input, warm_output, debug_trajectories, false));
+    ASSERT_TRUE(generateSmoother()->apply(v0, a0, input, cold_output, debug_trajectories, false));
+
+    ASSERT_EQ(warm_output.size(), cold_output.size()) << "cycle: " << cycle;
+    for (size_t i = 0; i < warm_output.size(); ++i) {
+      EXPECT_NEAR(
+        warm_output.at(i).longitudinal_velocity_mps, cold_output.at(i).longitudinal_velocity_mps,
+        epsilon)
+        << "cycle: " << cycle << ", i: " << i;
+      EXPECT_NEAR(warm_output.at(i).acceleration_mps2, cold_output.at(i).acceleration_mps2, epsilon)
+        << "cycle: " << cycle << ", i: " << i;
+    }
+  }
+
+  rclcpp::shutdown();
+}
@@ -16,6 +16,7 @@
 
 #include "autoware/behavior_path_lane_change_module/utils/base_class.hpp"
 #include "autoware/behavior_path_lane_change_module/utils/data_structs.hpp"
+#include "autoware/behavior_path_lane_change_module/utils/thread_pool.hpp"
 
 #include <memory>
 #include <utility>
@@ -174,6 +175,14 @@ protected:
     const utils::path_safety_checker::RSSparams & rss_params,
     const size_t deceleration_sampling_num, CollisionCheckDebugMap & debug_data) const;
 
+  //! @brief Same as isLaneChangePathSafe() but without time tracking, so that it can be called from
+  //! the candidate evaluation threads.
+  PathSafetyStatus check_lane_change_path_safety(
+    const LaneChangePath & lane_change_path,
+    const lane_change::TargetObjects & collision_check_objects,
+    const utils::path_safety_checker::RSSparams & rss_params,
+    const size_t deceleration_sampling_num, CollisionCheckDebugMap & debug_data) const;
+
   bool has_collision_with_decel_patterns(
     const LaneChangePath & lane_change_path, const ExtendedPredictedObjects & objects,
     const size_t deceleration_sampling_num, const RSSparams & rss_param,
@@ -231,6 +240,7 @@ protected:
   }
 
   double stop_time_{0.0};
+  std::unique_ptr<utils::lane_change::ThreadPool> candidate_evaluation_pool_;
   static constexpr double floating_err_th{1e-3};
 };
 }  // namespace autoware::behavior_path_planner
@@ -105,6 +105,7 @@ struct Parameters
   double prediction_time_resolution{0.5};
   int longitudinal_acc_sampling_num{10};
   int lateral_acc_sampling_num{10};
+  int candidate_path_evaluation_thread_num{0};
 
   // lane change parameters
   double backward_length_buffer_for_end_of_lane{0.0};
@@ -0,0 +1,130 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef AUTOWARE__BEHAVIOR_PATH_LANE_CHANGE_MODULE__UTILS__THREAD_POOL_HPP_
+#define AUTOWARE__BEHAVIOR_PATH_LANE_CHANGE_MODULE__UTILS__THREAD_POOL_HPP_
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace autoware::behavior_path_planner::utils::lane_change
+{
+/**
+ * @brief Fixed size pool of worker threads used to evaluate lane change candidate paths.
+ *
+ * Tasks are executed in submission order. When the pool is created with zero worker threads, the
+ * task is executed immediately on the calling thread, so that the caller does not need a separate
+ * serial code path.
+ */
+class ThreadPool
+{
+public:
+  explicit ThreadPool(const size_t num_threads);
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool(ThreadPool &&) = delete;
+  ThreadPool & operator=(const ThreadPool &) = delete;
+  ThreadPool & operator=(ThreadPool &&) = delete;
+  ~ThreadPool();
+
+  /**
+   * @brief Queues a task for execution.
+   *
+   * @param func Callable without arguments. Exceptions thrown by it are propagated to the caller
+   * through the returned future.
+   * @return Future holding the result of the task.
+   */
+  template <typename F>
+  std::future<std::invoke_result_t<F>> submit(F && func)
+  {
+    using ResultT = std::invoke_result_t<F>;
+    auto task = std::make_shared<std::packaged_task<ResultT()>>(std::forward<F>(func));
+    auto future = task->get_future();
+
+    if (workers_.empty()) {
+      (*task)();
+      return future;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.emplace([task]() { (*task)(); });
+    }
+    condition_.notify_one();
+    return future;
+  }
+
+  size_t size() const { return workers_.size(); }
+
+private:
+  void worker_loop();
+
+  std::vector<std::thread> workers_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stop_{false};
+};
+
+/**
+ * @brief Futures of tasks which refer to the local variables of the caller.
+ *
+ * The destructor waits for every task that is not finished yet, so that the local variables used
+ * by the tasks outlive them even when the caller leaves its scope by an exception. Declare it after
+ * the variables used by the tasks.
+ */
+template <typename T>
+class TaskGroup
+{
+public:
+  TaskGroup() = default;
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup(TaskGroup &&) = delete;
+  TaskGroup & operator=(const TaskGroup &) = delete;
+  TaskGroup & operator=(TaskGroup &&) = delete;
+  ~TaskGroup() { wait(); }
+
+  void push_back(std::future<T> && future) { futures_.push_back(std::move(future)); }
+  size_t size() const { return futures_.size(); }
+
+  /**
+   * @brief Get the result of the i-th task, rethrowing its exception.
+   */
+  T get(const size_t i) { return futures_.at(i).get(); }
+
+  /**
+   * @brief Wait for every task whose result was not taken yet, without throwing.
+   */
+  void wait()
+  {
+    for (auto & future : futures_) {
+      if (future.valid()) {
+        future.wait();
+      }
+    }
+  }
+
+private:
+  std::vector<std::future<T>> futures_;
+};
+}  // namespace autoware::behavior_path_planner::utils::lane_change
+
+#endif  // AUTOWARE__BEHAVIOR_PATH_LANE_CHANGE_MODULE__UTILS__THREAD_POOL_HPP_
@@ -50,6 +50,8 @@ void LaneChangeModuleManager::initParams(rclcpp::Node * node)
     getOrDeclareParameter<int>(*node, parameter("longitudinal_acceleration_sampling_num"));
   p.lateral_acc_sampling_num =
     getOrDeclareParameter<int>(*node, parameter("lateral_acceleration_sampling_num"));
+  p.candidate_path_evaluation_thread_num =
+    getOrDeclareParameter<int>(*node, parameter("candidate_path_evaluation_thread_num"));
 
   // parked vehicle detection
   p.object_check_min_road_shoulder_width =
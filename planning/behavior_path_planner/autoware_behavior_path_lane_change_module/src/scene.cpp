@@ -33,7 +33,11 @@
 #include <lanelet2_core/geometry/Polygon.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <deque>
+#include <future>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -55,6 +59,8 @@ NormalLaneChange::NormalLaneChange(
 {
   stop_watch_.tic(getModuleTypeStr());
   stop_watch_.tic("stop_time");
+  candidate_evaluation_pool_ = std::make_unique<utils::lane_change::ThreadPool>(
+    static_cast<size_t>(std::max(0, parameters->candidate_path_evaluation_thread_num)));
 }
 
 void NormalLaneChange::update_lanes(const bool is_approved)
@@ -1432,15 +1438,63 @@ bool NormalLaneChange::getLaneChangePaths(
 
   const auto prepare_durations = calcPrepareDuration(current_lanes, target_lanes);
 
-  candidate_paths->reserve(
-    longitudinal_acc_sampling_values.size() * lateral_acc_sampling_num * prepare_durations.size());
+  // Candidates are evaluated on the thread pool while the next ones are being generated. The
+  // deque keeps references of already queued candidates valid while new ones are appended.
+  std::deque<LaneChangePath> sampled_paths;
+  std::atomic<size_t> first_safe_path_idx{std::numeric_limits<size_t>::max()};
+  bool is_blocked_by_parked_objects = false;
+
+  const auto stop_sampling = [&]() {
+    return is_blocked_by_parked_objects ||
+           first_safe_path_idx.load() != std::numeric_limits<size_t>::max();
+  };
+
+  const auto evaluate_safety = [&, this](const size_t idx, const LaneChangePath & candidate_path) {
+    CollisionCheckDebugMap debug_data;
+
+    // candidates with lower priority than an already found safe path are cancelled
+    if (idx > first_safe_path_idx.load()) {
+      return std::make_pair(false, debug_data);
+    }
+
+    constexpr size_t decel_sampling_num = 1;
+    const auto safety_check_with_normal_rss = check_lane_change_path_safety(
+      candidate_path, target_objects, common_data_ptr_->lc_param_ptr->rss_params,
+      decel_sampling_num, debug_data);
+
+    auto is_safe = safety_check_with_normal_rss.is_safe;
+    if (!is_safe && is_stuck) {
+      const auto safety_check_with_stuck_rss = check_lane_change_path_safety(
+        candidate_path, target_objects, common_data_ptr_->lc_param_ptr->rss_params_for_stuck,
+        decel_sampling_num, debug_data);
+      is_safe = safety_check_with_stuck_rss.is_safe;
+    }
+
+    if (is_safe) {
+      auto current_idx = first_safe_path_idx.load();
+      while (idx < current_idx && !first_safe_path_idx.compare_exchange_weak(current_idx, idx)) {
+      }
+    }
+
+    return std::make_pair(is_safe, debug_data);
+  };
+
+  // declared after the variables used by the tasks, so that its destructor waits for the tasks
+  // before these variables are destroyed, also when an exception leaves this function
+  utils::lane_change::TaskGroup<std::pair<bool, CollisionCheckDebugMap>> safety_check_results;
 
   RCLCPP_DEBUG(
     logger_, "lane change sampling start. Sampling num for prep_time: %lu, acc: %lu",
     prepare_durations.size(), longitudinal_acc_sampling_values.size());
 
   for (const auto & prepare_duration : prepare_durations) {
+    if (stop_sampling()) {
+      break;
+    }
     for (const auto & sampled_longitudinal_acc : longitudinal_acc_sampling_values) {
+      if (stop_sampling()) {
+        break;
+      }
       // get path on original lanes
       const auto prepare_velocity = std::clamp(
         current_velocity + sampled_longitudinal_acc * prepare_duration,
@@ -1464,8 +1518,8 @@ bool NormalLaneChange::getLaneChangePaths(
         continue;
       }
 
-      if (!candidate_paths->empty()) {
-        const auto prev_prep_diff = candidate_paths->back().info.length.prepare - prepare_length;
+      if (!sampled_paths.empty()) {
+        const auto prev_prep_diff = sampled_paths.back().info.length.prepare - prepare_length;
         if (std::abs(prev_prep_diff) < lane_change_parameters_->skip_process_lon_diff_th_prepare) {
           RCLCPP_DEBUG(logger_, "Skip: Change in prepare length is less than threshold.");
           continue;
@@ -1525,6 +1579,9 @@ bool NormalLaneChange::getLaneChangePaths(
         common_data_ptr_, common_data_ptr_->lanes_ptr->target_neighbor, lane_changing_start_pose);
 
       for (const auto & lateral_acc : sample_lat_acc) {
+        if (stop_sampling()) {
+          break;
+        }
         const auto lane_changing_time = PathShifter::calcShiftTimeFromJerk(
           shift_length, lane_change_parameters_->lane_changing_lateral_jerk, lateral_acc);
         const double longitudinal_acc_on_lane_changing =
@@ -1542,10 +1599,10 @@ bool NormalLaneChange::getLaneChangePaths(
             lane_changing_time, sampled_longitudinal_acc, longitudinal_acc_on_lane_changing,
             lane_changing_length);
         };
-        if (!candidate_paths->empty()) {
-          const auto prev_prep_diff = candidate_paths->back().info.length.prepare - prepare_length;
+        if (!sampled_paths.empty()) {
+          const auto prev_prep_diff = sampled_paths.back().info.length.prepare - prepare_length;
           const auto lc_length_diff =
-            candidate_paths->back().info.length.lane_changing - lane_changing_length;
+            sampled_paths.back().info.length.lane_changing - lane_changing_length;
 
           // We only check lc_length_diff if and only if the current prepare_length is equal to the
           // previous prepare_length.
@@ -1672,7 +1729,7 @@ bool NormalLaneChange::getLaneChangePaths(
           debug_print_lat("Ego is stopping near traffic light. Do not allow lane change");
           continue;
         }
-        candidate_paths->push_back(*candidate_path);
+        sampled_paths.push_back(*candidate_path);
 
         if (
           !is_stuck && !utils::lane_change::passed_parked_objects(
@@ -1681,35 +1738,48 @@ bool NormalLaneChange::getLaneChangePaths(
           debug_print_lat(
             "Reject: parking vehicle exists in the target lane, and the ego is not in stuck. Skip "
             "lane change.");
-          return false;
+          is_blocked_by_parked_objects = true;
+          break;
         }
 
-        const auto is_safe = std::invoke([&]() {
-          constexpr size_t decel_sampling_num = 1;
-          const auto safety_check_with_normal_rss = isLaneChangePathSafe(
-            *candidate_path, target_objects, common_data_ptr_->lc_param_ptr->rss_params,
-            decel_sampling_num, lane_change_debug_.collision_check_objects);
-
-          if (!safety_check_with_normal_rss.is_safe && is_stuck) {
-            const auto safety_check_with_stuck_rss = isLaneChangePathSafe(
-              *candidate_path, target_objects, common_data_ptr_->lc_param_ptr->rss_params_for_stuck,
-              decel_sampling_num, lane_change_debug_.collision_check_objects);
-            return safety_check_with_stuck_rss.is_safe;
-          }
-
-          return safety_check_with_normal_rss.is_safe;
-        });
-
-        if (is_safe) {
-          debug_print_lat("ACCEPT!!!: it is valid and safe!");
-          return true;
-        }
+        const auto candidate_idx = sampled_paths.size() - 1;
+        const auto * queued_path = &sampled_paths.back();
+        safety_check_results.push_back(
+          candidate_evaluation_pool_->submit([&evaluate_safety, candidate_idx, queued_path]() {
+            return evaluate_safety(candidate_idx, *queued_path);
+          }));
+        debug_print_lat("Queued for safety check.");
+      }
+    }
+  }
 
-        debug_print_lat("Reject: sampled path is not safe.");
+  {
+    // the safety checks run on the thread pool, so the time of waiting for them is measured here
+    universe_utils::ScopedTimeTrack st("isLaneChangePathSafe", *time_keeper_);
+    for (size_t i = 0; i < safety_check_results.size(); ++i) {
+      const auto debug_data = safety_check_results.get(i).second;
+      if (i > first_safe_path_idx.load()) {
+        continue;
+      }
+      for (const auto & [key, object_debug] : debug_data) {
+        lane_change_debug_.collision_check_objects[key] = object_debug;
       }
     }
   }
 
+  const auto safe_path_idx = first_safe_path_idx.load();
+  if (safe_path_idx < sampled_paths.size()) {
+    sampled_paths.resize(safe_path_idx + 1);
+  }
+  candidate_paths->insert(
+    candidate_paths->end(), std::make_move_iterator(sampled_paths.begin()),
+    std::make_move_iterator(sampled_paths.end()));
+
+  if (safe_path_idx < candidate_paths->size()) {
+    RCLCPP_DEBUG(logger_, "ACCEPT!!!: candidate path %lu is valid and safe!", safe_path_idx);
+    return true;
+  }
+
   RCLCPP_DEBUG(logger_, "No safety path found.");
   return false;
 }
@@ -2125,6 +2195,16 @@ PathSafetyStatus NormalLaneChange::isLaneChangePathSafe(
   CollisionCheckDebugMap & debug_data) const
 {
   universe_utils::ScopedTimeTrack st(__func__, *time_keeper_);
+  return check_lane_change_path_safety(
+    lane_change_path, collision_check_objects, rss_params, deceleration_sampling_num, debug_data);
+}
+
+PathSafetyStatus NormalLaneChange::check_lane_change_path_safety(
+  const LaneChangePath & lane_change_path,
+  const lane_change::TargetObjects & collision_check_objects,
+  const utils::path_safety_checker::RSSparams & rss_params, const size_t deceleration_sampling_num,
+  CollisionCheckDebugMap & debug_data) const
+{
   constexpr auto is_safe = true;
   constexpr auto is_object_behind_ego = true;
 
@@ -2329,7 +2409,6 @@ bool NormalLaneChange::isVehicleStuck(
 
 double NormalLaneChange::get_max_velocity_for_safety_check() const
 {
-  universe_utils::ScopedTimeTrack st(__func__, *time_keeper_);
   const auto external_velocity_limit_ptr = planner_data_->external_limit_max_velocity;
   if (external_velocity_limit_ptr) {
     return std::min(
@@ -0,0 +1,96 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "autoware/behavior_path_lane_change_module/utils/thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using autoware::behavior_path_planner::utils::lane_change::TaskGroup;
+using autoware::behavior_path_planner::utils::lane_change::ThreadPool;
+
+TEST(BehaviorPathPlanningLaneChangeThreadPoolTest, runInlineWithoutWorkers)
+{
+  ThreadPool pool(0);
+  EXPECT_EQ(pool.size(), 0u);
+
+  const auto caller_id = std::this_thread::get_id();
+  auto future = pool.submit([]() { return std::this_thread::get_id(); });
+  EXPECT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+  EXPECT_EQ(future.get(), caller_id);
+}
+
+TEST(BehaviorPathPlanningLaneChangeThreadPoolTest, runAllTasks)
+{
+  ThreadPool pool(4);
+  EXPECT_EQ(pool.size(), 4u);
+
+  std::atomic<int> counter{0};
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 100; ++i) {
+    results.push_back(pool.submit([&counter, i]() {
+      ++counter;
+      return i * i;
+    }));
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(results.at(i).get(), i * i);
+  }
+  EXPECT_EQ(counter.load(), 100);
+}
+
+TEST(BehaviorPathPlanningLaneChangeThreadPoolTest, propagateException)
+{
+  ThreadPool pool(2);
+  auto future = pool.submit([]() -> bool { throw std::runtime_error("failed"); });
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(BehaviorPathPlanningLaneChangeThreadPoolTest, taskGroupWaitsOnScopeExit)
+{
+  ThreadPool pool(2);
+  std::atomic<int> finished{0};
+  const auto slow_task = [&finished]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    return ++finished;
+  };
+
+  {
+    TaskGroup<int> tasks;
+    tasks.push_back(pool.submit(slow_task));
+    tasks.push_back(pool.submit(slow_task));
+    EXPECT_EQ(tasks.size(), 2u);
+  }
+  EXPECT_EQ(finished.load(), 2);
+
+  // the tasks are also waited for when the scope is left by an exception
+  EXPECT_THROW(
+    {
+      TaskGroup<int> tasks;
+      tasks.push_back(pool.submit(slow_task));
+      tasks.push_back(pool.submit([]() -> int { throw std::runtime_error("failed"); }));
+      tasks.push_back(pool.submit(slow_task));
+      for (size_t i = 0; i < tasks.size(); ++i) {
+        tasks.get(i);
+      }
+    },
+    std::runtime_error);
+  EXPECT_EQ(finished.load(), 4);
+}
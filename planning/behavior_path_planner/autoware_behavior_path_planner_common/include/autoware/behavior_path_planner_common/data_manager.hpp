@@ -17,6 +17,7 @@
 
 #include "autoware/behavior_path_planner_common/parameters.hpp"
 #include "autoware/behavior_path_planner_common/turn_signal_decider.hpp"
+#include "autoware/behavior_path_planner_common/utils/drivable_area_expansion/map_utils.hpp"
 #include "autoware/behavior_path_planner_common/utils/drivable_area_expansion/parameters.hpp"
 #include "autoware/motion_utils/trajectory/trajectory.hpp"
 
@@ -168,6 +169,8 @@ struct PlannerData
 
   mutable std::vector<geometry_msgs::msg::Pose> drivable_area_expansion_prev_path_poses{};
   mutable std::vector<double> drivable_area_expansion_prev_curvatures{};
+  mutable autoware::behavior_path_planner::drivable_area_expansion::UncrossableSegmentsCache
+    drivable_area_expansion_uncrossable_segments_cache{};
   mutable TurnSignalDecider turn_signal_decider;
 
   std::pair<TurnSignalInfo, bool> getBehaviorTurnSignalInfo(
@@ -20,11 +20,22 @@
 
 #include <lanelet2_core/LaneletMap.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace autoware::behavior_path_planner::drivable_area_expansion
 {
+/// @brief uncrossable segments of a whole lanelet map, kept across planning cycles
+struct UncrossableSegmentsCache
+{
+  // map and linestring types of the extracted segments
+  std::weak_ptr<const lanelet::LaneletMap> lanelet_map{};
+  std::vector<std::string> linestring_types{};
+  // not modified once built, so that copies of the cache share it
+  std::shared_ptr<const SegmentRtree> segments{};
+};
+
 /// @brief Extract uncrossable segments from the lanelet map that are in range of ego
 /// @param[in] lanelet_map lanelet map
 /// @param[in] ego_point point of the current ego position
@@ -34,6 +45,18 @@ SegmentRtree extract_uncrossable_segments(
   const lanelet::LaneletMap & lanelet_map, const Point & ego_point,
   const DrivableAreaExpansionParameters & params);
 
+/// @brief Extract uncrossable segments from the lanelet map that are in range of ego
+/// @details the segments of the whole map are extracted once and reused while the map and the
+/// linestring types do not change, so that only the range query is done every cycle
+/// @param[in] lanelet_map_ptr lanelet map
+/// @param[in] ego_point point of the current ego position
+/// @param[in] params parameters with linestring types that cannot be crossed and maximum range
+/// @param[inout] cache segments of the whole map extracted in a previous call
+/// @return the uncrossable segments stored in a rtree
+SegmentRtree extract_uncrossable_segments(
+  const lanelet::LaneletMapConstPtr & lanelet_map_ptr, const Point & ego_point,
+  const DrivableAreaExpansionParameters & params, UncrossableSegmentsCache & cache);
+
 /// @brief Determine if the given linestring has one of the given types
 /// @param[in] ls linestring to check
 /// @param[in] types type strings to check
@@ -36,6 +36,7 @@ using geometry_msgs::msg::Pose;
 using tier4_planning_msgs::msg::PathPointWithLaneId;
 using tier4_planning_msgs::msg::PathWithLaneId;
 
+using autoware::universe_utils::Box2d;
 using autoware::universe_utils::LineString2d;
 using autoware::universe_utils::MultiLineString2d;
 using autoware::universe_utils::MultiPoint2d;
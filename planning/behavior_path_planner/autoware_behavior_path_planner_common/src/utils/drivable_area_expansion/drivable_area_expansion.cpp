@@ -30,7 +30,11 @@
 
 #include <boost/geometry/strategies/strategies.hpp>
 
+#include <algorithm>
+#include <iterator>
 #include <limits>
+#include <utility>
+#include <vector>
 
 namespace autoware::behavior_path_planner::drivable_area_expansion
 {
@@ -136,9 +140,29 @@ void calculate_bound_index_mappings(
     (side == LEFT ? expansion.left_projections : expansion.right_projections);
   bound_indexes.resize(path_poses.size(), 0LU);
   bound_projections.resize(path_poses.size(), {{}, std::numeric_limits<double>::max()});
+  // envelopes of blocks of consecutive bound segments, to skip the blocks far from a path point
+  constexpr auto block_size = 16LU;
+  std::vector<Box2d> block_envelopes;
+  for (auto first_idx = 0LU; first_idx + 1 < bound.size(); first_idx += block_size) {
+    const auto last_idx = std::min(first_idx + block_size, bound.size() - 1);
+    Box2d envelope{convert_point(bound[first_idx]), convert_point(bound[first_idx])};
+    for (auto idx = first_idx + 1; idx <= last_idx; ++idx) {
+      boost::geometry::expand(envelope, convert_point(bound[idx]));
+    }
+    block_envelopes.push_back(envelope);
+  }
   for (auto path_idx = 0UL; path_idx < path_poses.size(); ++path_idx) {
     const auto path_p = convert_point(path_poses[path_idx].position);
     for (auto bound_idx = lb_idx; bound_idx + 1 < bound.size(); ++bound_idx) {
+      // no segment of the block can be closer than the block envelope
+      constexpr auto epsilon = 1e-9;
+      if (
+        bound_idx % block_size == 0 &&
+        boost::geometry::distance(path_p, block_envelopes[bound_idx / block_size]) >
+          bound_projections[path_idx].distance + epsilon) {
+        bound_idx += block_size - 1;
+        continue;
+      }
       const auto prev_p = convert_point(bound[bound_idx]);
       const auto next_p = convert_point(bound[bound_idx + 1]);
       const auto projection = point_to_segment_projection(path_p, prev_p, next_p);
@@ -222,6 +246,14 @@ std::vector<double> calculate_maximum_distance(
   std::vector<double> maximum_distances(bound.size(), std::numeric_limits<double>::max());
   LineString2d bound_ls;
   for (const auto & p : bound) bound_ls.push_back(convert_point(p));
+  std::vector<std::pair<Box2d, size_t>> polygon_envelopes;
+  polygon_envelopes.reserve(uncrossable_polygons.size());
+  for (auto poly_idx = 0UL; poly_idx < uncrossable_polygons.size(); ++poly_idx) {
+    polygon_envelopes.emplace_back(
+      boost::geometry::return_envelope<Box2d>(uncrossable_polygons[poly_idx]), poly_idx);
+  }
+  const boost::geometry::index::rtree<std::pair<Box2d, size_t>, boost::geometry::index::rstar<16>>
+    polygon_rtree(polygon_envelopes.begin(), polygon_envelopes.end());
   for (auto i = 0UL; i + 1 < bound_ls.size(); ++i) {
     const Segment2d segment_ls = {bound_ls[i], bound_ls[i + 1]};
     const auto segment_vector = segment_ls.second - segment_ls.first;
@@ -246,20 +278,28 @@ std::vector<double> calculate_maximum_distance(
       maximum_distances[i] = std::min(maximum_distances[i], dist_limit);
       maximum_distances[i + 1] = std::min(maximum_distances[i + 1], dist_limit);
     }
-    for (const auto & uncrossable_poly : uncrossable_polygons) {
+    if (polygon_rtree.empty()) continue;
+    // visit the polygons from the nearest envelope until no farther polygon can be closer
+    constexpr auto epsilon = 1e-9;
+    auto poly_dist_limit = std::numeric_limits<double>::max();
+    for (auto it = polygon_rtree.qbegin(
+           boost::geometry::index::nearest(segment_ls, polygon_rtree.size()));
+         it != polygon_rtree.qend(); ++it) {
+      if (boost::geometry::distance(segment_ls, it->first) > poly_dist_limit + epsilon) break;
+      const auto & uncrossable_poly = uncrossable_polygons[it->second];
       if (boost::geometry::intersects(uncrossable_poly.outer(), segment_ls)) {
-        maximum_distances[i] = 0.0;
-        maximum_distances[i + 1] = 0.0;
+        poly_dist_limit = 0.0;
         break;
       }
       if (std::all_of(
             uncrossable_poly.outer().begin(), uncrossable_poly.outer().end(),
             is_point_on_correct_side)) {
         const auto bound_to_poly_dist = boost::geometry::distance(segment_ls, uncrossable_poly);
-        maximum_distances[i] = std::min(maximum_distances[i], bound_to_poly_dist);
-        maximum_distances[i + 1] = std::min(maximum_distances[i + 1], bound_to_poly_dist);
+        poly_dist_limit = std::min(poly_dist_limit, bound_to_poly_dist);
       }
     }
+    maximum_distances[i] = std::min(maximum_distances[i], poly_dist_limit);
+    maximum_distances[i + 1] = std::min(maximum_distances[i + 1], poly_dist_limit);
   }
   if (params.max_expansion_distance > 0.0)
     for (auto & d : maximum_distances) d = std::min(params.max_expansion_distance, d);
@@ -416,7 +456,8 @@ void expand_drivable_area(
   const auto & params = planner_data->drivable_area_expansion_parameters;
   const auto & route_handler = *planner_data->route_handler;
   const auto uncrossable_segments = extract_uncrossable_segments(
-    *route_handler.getLaneletMapPtr(), planner_data->self_odometry->pose.pose.position, params);
+    route_handler.getLaneletMapPtr(), planner_data->self_odometry->pose.pose.position, params,
+    planner_data->drivable_area_expansion_uncrossable_segments_cache);
   const auto uncrossable_polygons = create_object_footprints(*planner_data->dynamic_object, params);
   const auto preprocessing_ms = stop_watch.toc("preprocessing");
   stop_watch.tic("crop");
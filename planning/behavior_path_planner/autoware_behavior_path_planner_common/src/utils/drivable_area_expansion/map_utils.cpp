@@ -20,31 +20,81 @@
 #include <lanelet2_core/primitives/LineString.h>
 
 #include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace autoware::behavior_path_planner::drivable_area_expansion
 {
-SegmentRtree extract_uncrossable_segments(
-  const lanelet::LaneletMap & lanelet_map, const Point & ego_point,
-  const DrivableAreaExpansionParameters & params)
+namespace
+{
+template <class Function>
+void for_each_uncrossable_segment(
+  const lanelet::LaneletMap & lanelet_map, const std::vector<std::string> & types,
+  const Function & function)
 {
-  SegmentRtree uncrossable_segments_in_range;
   LineString2d line;
-  const auto ego_p = Point2d{ego_point.x, ego_point.y};
   for (const auto & ls : lanelet_map.lineStringLayer) {
-    if (has_types(ls, params.avoid_linestring_types)) {
+    if (has_types(ls, types)) {
       line.clear();
       for (const auto & p : ls) line.push_back(Point2d{p.x(), p.y()});
       for (auto segment_idx = 0LU; segment_idx + 1 < line.size(); ++segment_idx) {
-        Segment2d segment = {line[segment_idx], line[segment_idx + 1]};
-        if (boost::geometry::distance(segment, ego_p) < params.max_path_arc_length) {
-          uncrossable_segments_in_range.insert(segment);
-        }
+        function(Segment2d{line[segment_idx], line[segment_idx + 1]});
       }
     }
   }
+}
+}  // namespace
+
+SegmentRtree extract_uncrossable_segments(
+  const lanelet::LaneletMap & lanelet_map, const Point & ego_point,
+  const DrivableAreaExpansionParameters & params)
+{
+  SegmentRtree uncrossable_segments_in_range;
+  const auto ego_p = Point2d{ego_point.x, ego_point.y};
+  for_each_uncrossable_segment(
+    lanelet_map, params.avoid_linestring_types, [&](const Segment2d & segment) {
+      if (boost::geometry::distance(segment, ego_p) < params.max_path_arc_length) {
+        uncrossable_segments_in_range.insert(segment);
+      }
+    });
   return uncrossable_segments_in_range;
 }
 
+SegmentRtree extract_uncrossable_segments(
+  const lanelet::LaneletMapConstPtr & lanelet_map_ptr, const Point & ego_point,
+  const DrivableAreaExpansionParameters & params, UncrossableSegmentsCache & cache)
+{
+  if (!lanelet_map_ptr) return {};
+  if (
+    !cache.segments || cache.lanelet_map.lock() != lanelet_map_ptr ||
+    cache.linestring_types != params.avoid_linestring_types) {
+    std::vector<Segment2d> segments;
+    for_each_uncrossable_segment(
+      *lanelet_map_ptr, params.avoid_linestring_types,
+      [&](const Segment2d & segment) { segments.push_back(segment); });
+    cache.lanelet_map = lanelet_map_ptr;
+    cache.linestring_types = params.avoid_linestring_types;
+    // packing constructor
+    cache.segments = std::make_shared<SegmentRtree>(segments.begin(), segments.end());
+  }
+
+  // the segments closer than the range to ego are inside the box of the range around ego
+  const auto ego_p = Point2d{ego_point.x, ego_point.y};
+  const auto range = params.max_path_arc_length;
+  const Box2d range_box{
+    Point2d{ego_p.x() - range, ego_p.y() - range}, Point2d{ego_p.x() + range, ego_p.y() + range}};
+  std::vector<Segment2d> segments_in_range;
+  cache.segments->query(
+    boost::geometry::index::intersects(range_box) &&
+      boost::geometry::index::satisfies([&](const Segment2d & segment) {
+        return boost::geometry::distance(segment, ego_p) < range;
+      }),
+    std::back_inserter(segments_in_range));
+  return SegmentRtree(segments_in_range.begin(), segments_in_range.end());
+}
+
 bool has_types(const lanelet::ConstLineString3d & ls, const std::vector<std::string> & types)
 {
   constexpr auto no_type = "";
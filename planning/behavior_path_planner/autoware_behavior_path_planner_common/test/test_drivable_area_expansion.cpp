@@ -14,13 +14,24 @@
 
 #include "autoware/behavior_path_planner_common/data_manager.hpp"
 #include "autoware/behavior_path_planner_common/utils/drivable_area_expansion/drivable_area_expansion.hpp"
+#include "autoware/behavior_path_planner_common/utils/drivable_area_expansion/map_utils.hpp"
 #include "autoware/behavior_path_planner_common/utils/drivable_area_expansion/path_projection.hpp"
 #include "autoware/behavior_path_planner_common/utils/drivable_area_expansion/types.hpp"
+#include "autoware/universe_utils/system/stop_watch.hpp"
 #include "autoware_lanelet2_extension/utility/message_conversion.hpp"
 
+#include <boost/geometry/algorithms/intersects.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+
 #include <gtest/gtest.h>
 #include <lanelet2_core/LaneletMap.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
 using autoware::behavior_path_planner::drivable_area_expansion::LineString2d;
 using autoware::behavior_path_planner::drivable_area_expansion::Point2d;
 using autoware::behavior_path_planner::drivable_area_expansion::Segment2d;
@@ -272,3 +283,261 @@ TEST(DrivableAreaExpansionProjection, expand_drivable_area)
     EXPECT_LT(p.y, -1.0);
   }
 }
+
+namespace
+{
+using autoware::behavior_path_planner::drivable_area_expansion::Point;
+using autoware::behavior_path_planner::drivable_area_expansion::Polygon2d;
+using autoware::behavior_path_planner::drivable_area_expansion::Pose;
+
+// long curved path with bounds of 2 points per path pose, like bounds with added points
+void generate_long_route(
+  const size_t num_poses, std::vector<Pose> & path_poses, std::vector<Point> & left_bound,
+  std::vector<Point> & right_bound)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> noise(-0.1, 0.1);
+  auto x = 0.0;
+  auto y = 0.0;
+  for (auto i = 0LU; i < num_poses; ++i) {
+    const auto yaw = 0.5 * std::sin(i * 0.01) + noise(engine);
+    x += std::cos(yaw);
+    y += std::sin(yaw);
+    Pose pose;
+    pose.position.x = x;
+    pose.position.y = y;
+    path_poses.push_back(pose);
+    for (const auto offset : {0.0, 0.5}) {
+      Point left;
+      left.x = x - 1.5 * std::sin(yaw) + offset * std::cos(yaw);
+      left.y = y + 1.5 * std::cos(yaw) + offset * std::sin(yaw);
+      left_bound.push_back(left);
+      Point right;
+      right.x = x + 1.5 * std::sin(yaw) + offset * std::cos(yaw);
+      right.y = y - 1.5 * std::cos(yaw) + offset * std::sin(yaw);
+      right_bound.push_back(right);
+    }
+  }
+}
+
+// boxes around the path, some of them crossing the bounds
+std::vector<Polygon2d> generate_footprints(
+  const size_t num_footprints, const std::vector<Pose> & path_poses)
+{
+  std::mt19937 engine(1);
+  std::uniform_int_distribution<size_t> index(0, path_poses.size() - 1);
+  std::uniform_real_distribution<double> offset(-10.0, 10.0);
+  std::vector<Polygon2d> footprints;
+  for (auto i = 0LU; i < num_footprints; ++i) {
+    const auto & p = path_poses[index(engine)].position;
+    const auto x = p.x + offset(engine);
+    const auto y = p.y + offset(engine);
+    Polygon2d footprint;
+    footprint.outer() = {
+      Point2d{x + 2.0, y + 1.0}, Point2d{x + 2.0, y - 1.0}, Point2d{x - 2.0, y - 1.0},
+      Point2d{x - 2.0, y + 1.0}, Point2d{x + 2.0, y + 1.0}};
+    footprints.push_back(footprint);
+  }
+  return footprints;
+}
+}  // namespace
+
+TEST(DrivableAreaExpansion, calculate_bound_index_mappings_long_route)
+{
+  using autoware::behavior_path_planner::drivable_area_expansion::calculate_bound_index_mappings;
+  using autoware::behavior_path_planner::drivable_area_expansion::Expansion;
+  using autoware::behavior_path_planner::drivable_area_expansion::point_to_segment_projection;
+
+  std::vector<Pose> path_poses;
+  std::vector<Point> left_bound;
+  std::vector<Point> right_bound;
+  generate_long_route(2000, path_poses, left_bound, right_bound);
+
+  Expansion expansion;
+  calculate_bound_index_mappings(
+    expansion, path_poses, left_bound,
+    autoware::behavior_path_planner::drivable_area_expansion::LEFT);
+
+  // projection on all the segments after the previous mapping
+  size_t lb_idx = 0;
+  for (auto path_idx = 0UL; path_idx < path_poses.size(); ++path_idx) {
+    const auto path_p = Point2d(path_poses[path_idx].position.x, path_poses[path_idx].position.y);
+    auto min_distance = std::numeric_limits<double>::max();
+    auto min_idx = 0LU;
+    for (auto bound_idx = lb_idx; bound_idx + 1 < left_bound.size(); ++bound_idx) {
+      const auto projection = point_to_segment_projection(
+        path_p, Point2d(left_bound[bound_idx].x, left_bound[bound_idx].y),
+        Point2d(left_bound[bound_idx + 1].x, left_bound[bound_idx + 1].y));
+      if (projection.distance < min_distance) {
+        min_distance = projection.distance;
+        min_idx = bound_idx;
+      }
+    }
+    EXPECT_EQ(expansion.left_bound_indexes[path_idx], min_idx);
+    EXPECT_EQ(expansion.left_projections[path_idx].distance, min_distance);
+    lb_idx = min_idx;
+  }
+}
+
+TEST(DrivableAreaExpansion, calculate_maximum_distance_long_route)
+{
+  using autoware::behavior_path_planner::drivable_area_expansion::calculate_maximum_distance;
+  using autoware::behavior_path_planner::drivable_area_expansion::SegmentRtree;
+
+  std::vector<Pose> path_poses;
+  std::vector<Point> left_bound;
+  std::vector<Point> right_bound;
+  generate_long_route(1000, path_poses, left_bound, right_bound);
+  const auto footprints = generate_footprints(1000, path_poses);
+  autoware::behavior_path_planner::drivable_area_expansion::DrivableAreaExpansionParameters params;
+  params.max_expansion_distance = 0.0;  // means no limit
+
+  const auto maximum_distances = calculate_maximum_distance(
+    left_bound, SegmentRtree{}, footprints, params,
+    autoware::behavior_path_planner::drivable_area_expansion::LEFT);
+
+  // distances to all the footprints
+  std::vector<double> expected_distances(left_bound.size(), std::numeric_limits<double>::max());
+  for (auto i = 0UL; i + 1 < left_bound.size(); ++i) {
+    const Segment2d segment = {
+      Point2d(left_bound[i].x, left_bound[i].y), Point2d(left_bound[i + 1].x, left_bound[i + 1].y)};
+    const auto segment_vector = segment.second - segment.first;
+    auto min_distance = std::numeric_limits<double>::max();
+    for (const auto & footprint : footprints) {
+      if (boost::geometry::intersects(footprint.outer(), segment)) {
+        min_distance = 0.0;
+        break;
+      }
+      const auto is_on_left_side = std::all_of(
+        footprint.outer().begin(), footprint.outer().end(), [&](const Point2d & p) {
+          const auto point_vector = p - segment.first;
+          return segment_vector.x() * point_vector.y() - segment_vector.y() * point_vector.x() >=
+                 0.0;
+        });
+      if (is_on_left_side) {
+        min_distance = std::min(min_distance, boost::geometry::distance(segment, footprint));
+      }
+    }
+    expected_distances[i] = std::min(expected_distances[i], min_distance);
+    expected_distances[i + 1] = std::min(expected_distances[i + 1], min_distance);
+  }
+  ASSERT_EQ(maximum_distances.size(), expected_distances.size());
+  for (auto i = 0UL; i < maximum_distances.size(); ++i) {
+    EXPECT_EQ(maximum_distances[i], expected_distances[i]);
+  }
+}
+
+TEST(DrivableAreaExpansion, DISABLED_benchmark_long_route)
+{
+  using autoware::behavior_path_planner::drivable_area_expansion::calculate_bound_index_mappings;
+  using autoware::behavior_path_planner::drivable_area_expansion::calculate_maximum_distance;
+  using autoware::behavior_path_planner::drivable_area_expansion::Expansion;
+  using autoware::behavior_path_planner::drivable_area_expansion::point_to_segment_projection;
+  using autoware::behavior_path_planner::drivable_area_expansion::SegmentRtree;
+
+  autoware::universe_utils::StopWatch<std::chrono::milliseconds, std::chrono::microseconds> sw;
+  for (const auto num_poses : {1000LU, 2000LU, 4000LU}) {
+    std::vector<Pose> path_poses;
+    std::vector<Point> left_bound;
+    std::vector<Point> right_bound;
+    generate_long_route(num_poses, path_poses, left_bound, right_bound);
+
+    Expansion expansion;
+    sw.tic();
+    calculate_bound_index_mappings(
+      expansion, path_poses, left_bound,
+      autoware::behavior_path_planner::drivable_area_expansion::LEFT);
+    const auto mapping_ms = sw.toc();
+
+    // projection on all the segments after the previous mapping
+    sw.tic();
+    size_t lb_idx = 0;
+    for (const auto & pose : path_poses) {
+      const auto path_p = Point2d(pose.position.x, pose.position.y);
+      auto min_distance = std::numeric_limits<double>::max();
+      for (auto bound_idx = lb_idx; bound_idx + 1 < left_bound.size(); ++bound_idx) {
+        const auto projection = point_to_segment_projection(
+          path_p, Point2d(left_bound[bound_idx].x, left_bound[bound_idx].y),
+          Point2d(left_bound[bound_idx + 1].x, left_bound[bound_idx + 1].y));
+        if (projection.distance < min_distance) {
+          min_distance = projection.distance;
+          lb_idx = bound_idx;
+        }
+      }
+    }
+    const auto all_segments_ms = sw.toc();
+
+    const auto footprints = generate_footprints(num_poses, path_poses);
+    autoware::behavior_path_planner::drivable_area_expansion::DrivableAreaExpansionParameters
+      params;
+    params.max_expansion_distance = 0.0;  // means no limit
+    sw.tic();
+    calculate_maximum_distance(
+      left_bound, SegmentRtree{}, footprints, params,
+      autoware::behavior_path_planner::drivable_area_expansion::LEFT);
+    const auto maximum_distance_ms = sw.toc();
+
+    // distances from each segment to all the footprints
+    sw.tic();
+    std::vector<double> distances(left_bound.size(), std::numeric_limits<double>::max());
+    for (auto i = 0UL; i + 1 < left_bound.size(); ++i) {
+      const Segment2d segment = {
+        Point2d(left_bound[i].x, left_bound[i].y),
+        Point2d(left_bound[i + 1].x, left_bound[i + 1].y)};
+      for (const auto & footprint : footprints) {
+        distances[i] = std::min(distances[i], boost::geometry::distance(segment, footprint));
+      }
+    }
+    const auto all_footprints_ms = sw.toc();
+
+    std::printf(
+      "%zu poses: bound index mappings = %2.2f ms (all segments: %2.2f ms), maximum distances "
+      "with %zu footprints = %2.2f ms (all footprints: %2.2f ms)\n",
+      path_poses.size(), mapping_ms, all_segments_ms, footprints.size(), maximum_distance_ms,
+      all_footprints_ms);
+  }
+}
+
+TEST(DrivableAreaExpansion, extract_uncrossable_segments_cache)
+{
+  using autoware::behavior_path_planner::drivable_area_expansion::extract_uncrossable_segments;
+
+  auto lanelet_map_ptr = std::make_shared<lanelet::LaneletMap>();
+  lanelet::LineString3d road_border(
+    1, {lanelet::Point3d(2, 0.0, 2.0), lanelet::Point3d(3, 10.0, 2.0),
+        lanelet::Point3d(4, 100.0, 2.0)});
+  road_border.attributes()[lanelet::AttributeName::Type] = "road_border";
+  lanelet_map_ptr->add(road_border);
+  lanelet::LineString3d line_thin(
+    5, {lanelet::Point3d(6, 0.0, -2.0), lanelet::Point3d(7, 10.0, -2.0)});
+  line_thin.attributes()[lanelet::AttributeName::Type] = "line_thin";
+  lanelet_map_ptr->add(line_thin);
+
+  autoware::behavior_path_planner::drivable_area_expansion::DrivableAreaExpansionParameters params;
+  params.avoid_linestring_types = {"road_border"};
+  params.max_path_arc_length = 50.0;
+  autoware::behavior_path_planner::drivable_area_expansion::UncrossableSegmentsCache cache;
+  Point ego_point;
+
+  const auto segments = extract_uncrossable_segments(lanelet_map_ptr, ego_point, params, cache);
+  EXPECT_EQ(segments.size(), 2ul);
+  ASSERT_TRUE(cache.segments);
+  EXPECT_EQ(cache.segments->size(), 2ul);
+  const auto cached_segments = cache.segments;
+
+  // the segments of the map are reused, and only the ones in range are returned
+  ego_point.x = 100.0;
+  ego_point.y = 40.0;
+  EXPECT_EQ(extract_uncrossable_segments(lanelet_map_ptr, ego_point, params, cache).size(), 1ul);
+  EXPECT_EQ(cache.segments, cached_segments);
+  EXPECT_EQ(
+    extract_uncrossable_segments(lanelet_map_ptr, ego_point, params, cache).size(),
+    extract_uncrossable_segments(*lanelet_map_ptr, ego_point, params).size());
+
+  // the segments are extracted again when the types change
+  params.avoid_linestring_types = {"road_border", "line_thin"};
+  ego_point.x = 0.0;
+  ego_point.y = 0.0;
+  EXPECT_EQ(extract_uncrossable_segments(lanelet_map_ptr, ego_point, params, cache).size(), 3ul);
+  EXPECT_NE(cache.segments, cached_segments);
+}
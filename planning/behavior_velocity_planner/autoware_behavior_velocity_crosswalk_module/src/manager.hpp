@@ -44,6 +44,8 @@ public:
 
   const char * getModuleName() override { return "crosswalk"; }
 
+  bool isTwoPhasePlanningSupported() const override { return true; }
+
 private:
   CrosswalkModule::PlannerParam crosswalk_planner_param_{};
 
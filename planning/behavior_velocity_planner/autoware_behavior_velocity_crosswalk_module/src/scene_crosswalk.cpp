@@ -205,7 +205,15 @@ CrosswalkModule::CrosswalkModule(
 
 bool CrosswalkModule::modifyPathVelocity(PathWithLaneId * path, StopReason * stop_reason)
 {
-  if (path->points.size() < 2) {
+  const auto velocity_requests = decideVelocity(*path, stop_reason);
+  applyVelocityRequests(velocity_requests, path);
+  return true;
+}
+
+std::vector<VelocityRequest> CrosswalkModule::decideVelocity(
+  const PathWithLaneId & path, StopReason * stop_reason)
+{
+  if (path.points.size() < 2) {
     RCLCPP_DEBUG(logger_, "Do not interpolate because path size is less than 2.");
     return {};
   }
@@ -228,31 +236,34 @@ bool CrosswalkModule::modifyPathVelocity(PathWithLaneId * path, StopReason * sto
 
   // Calculate intersection between path and crosswalks
   const auto path_end_points_on_crosswalk =
-    getPathEndPointsOnCrosswalk(*path, crosswalk_.polygon2d().basicPolygon(), ego_pos);
+    getPathEndPointsOnCrosswalk(path, crosswalk_.polygon2d().basicPolygon(), ego_pos);
   if (!path_end_points_on_crosswalk) {
     return {};
   }
   const auto & first_path_point_on_crosswalk = path_end_points_on_crosswalk->first;
   const auto & last_path_point_on_crosswalk = path_end_points_on_crosswalk->second;
 
+  std::vector<VelocityRequest> velocity_requests;
+
   // Apply safety slow down speed if defined in Lanelet2 map
-  applySlowDownByLanelet2Map(*path, first_path_point_on_crosswalk, last_path_point_on_crosswalk);
+  applySlowDownByLanelet2Map(
+    path, first_path_point_on_crosswalk, last_path_point_on_crosswalk, velocity_requests);
 
   // Apply safety slow down speed if the crosswalk is occluded
-  applySlowDownByOcclusion(*path, first_path_point_on_crosswalk, last_path_point_on_crosswalk);
+  applySlowDownByOcclusion(
+    path, first_path_point_on_crosswalk, last_path_point_on_crosswalk, velocity_requests);
   recordTime(2);
 
   // Calculate stop point with margin
-  const auto default_stop_pose = getDefaultStopPose(*path, first_path_point_on_crosswalk);
+  const auto default_stop_pose = getDefaultStopPose(path, first_path_point_on_crosswalk);
 
   // Resample path sparsely for less computation cost
   constexpr double resample_interval = 4.0;
-  const auto sparse_resample_path =
-    resamplePath(*path, resample_interval, false, true, true, false);
+  const auto sparse_resample_path = resamplePath(path, resample_interval, false, true, true, false);
 
   // Decide to stop for crosswalk users
   const auto stop_factor_for_crosswalk_users = checkStopForCrosswalkUsers(
-    *path, sparse_resample_path, first_path_point_on_crosswalk, last_path_point_on_crosswalk,
+    path, sparse_resample_path, first_path_point_on_crosswalk, last_path_point_on_crosswalk,
     default_stop_pose);
 
   // Decide to stop for stuck vehicle
@@ -262,7 +273,7 @@ bool CrosswalkModule::modifyPathVelocity(PathWithLaneId * path, StopReason * sto
 
   // Get nearest stop factor
   const auto nearest_stop_factor =
-    getNearestStopFactor(*path, stop_factor_for_crosswalk_users, stop_factor_for_stuck_vehicles);
+    getNearestStopFactor(path, stop_factor_for_crosswalk_users, stop_factor_for_stuck_vehicles);
   recordTime(3);
 
   // Set safe or unsafe
@@ -270,21 +281,23 @@ bool CrosswalkModule::modifyPathVelocity(PathWithLaneId * path, StopReason * sto
 
   // Set distance
   // NOTE: If no stop point is inserted, distance to the virtual stop line has to be calculated.
-  setDistanceToStop(*path, default_stop_pose, nearest_stop_factor);
+  setDistanceToStop(path, default_stop_pose, nearest_stop_factor);
 
   // plan Go/Stop
   if (isActivated()) {
-    planGo(*path, nearest_stop_factor);
+    planGo(path, nearest_stop_factor, velocity_requests);
   } else {
-    planStop(*path, nearest_stop_factor, default_stop_pose, stop_reason);
+    planStop(path, nearest_stop_factor, default_stop_pose, stop_reason, velocity_requests);
   }
   recordTime(4);
 
+  // NOTE: rclcpp publishers are thread-safe, so that the debug message is published also when
+  // this function runs in parallel with the modules of the other managers.
   const auto collision_info_msg =
     createStringStampedMessage(clock_->now(), module_id_, debug_data_.collision_points);
   collision_info_pub_->publish(collision_info_msg);
 
-  return true;
+  return velocity_requests;
 }
 
 // NOTE: The stop point will be the returned point with the margin.
@@ -415,7 +428,8 @@ std::optional<StopFactor> CrosswalkModule::checkStopForCrosswalkUsers(
 }
 
 std::pair<double, double> CrosswalkModule::getAttentionRange(
-  const PathWithLaneId & ego_path, const geometry_msgs::msg::Point & first_path_point_on_crosswalk,
+  const PathWithLaneId & ego_path,
+  const geometry_msgs::msg::Point & first_path_point_on_crosswalk,
   const geometry_msgs::msg::Point & last_path_point_on_crosswalk)
 {
   stop_watch_.tic(__func__);
@@ -441,12 +455,14 @@ std::pair<double, double> CrosswalkModule::getAttentionRange(
 
 void CrosswalkModule::insertDecelPointWithDebugInfo(
   const geometry_msgs::msg::Point & stop_point, const float target_velocity,
-  PathWithLaneId & output) const
+  const PathWithLaneId & ego_path, std::vector<VelocityRequest> & velocity_requests) const
 {
-  const auto stop_pose = planning_utils::insertDecelPoint(stop_point, output, target_velocity);
+  // pose of the point which will be inserted to the path in the apply phase
+  const auto stop_pose = calcLongitudinalOffsetPose(ego_path.points, stop_point, 0.0);
   if (!stop_pose) {
     return;
   }
+  velocity_requests.push_back({stop_point, target_velocity});
 
   debug_data_.first_stop_pose = getPose(*stop_pose);
 
@@ -780,12 +796,12 @@ CollisionPoint CrosswalkModule::createCollisionPoint(
 }
 
 void CrosswalkModule::applySlowDown(
-  PathWithLaneId & output, const geometry_msgs::msg::Point & first_path_point_on_crosswalk,
+  const PathWithLaneId & ego_path,
+  const geometry_msgs::msg::Point & first_path_point_on_crosswalk,
   const geometry_msgs::msg::Point & last_path_point_on_crosswalk,
-  const float safety_slow_down_speed)
+  const float safety_slow_down_speed, std::vector<VelocityRequest> & velocity_requests)
 {
   const auto & ego_pos = planner_data_->current_odometry->pose.position;
-  const auto ego_path = output;
   std::optional<Pose> slowdown_pose{std::nullopt};
 
   if (!passed_safety_slow_point_) {
@@ -804,7 +820,8 @@ void CrosswalkModule::applySlowDown(
       calcLongitudinalOffsetPoint(ego_path.points, ego_pos, safety_slow_point_range);
 
     if (p_safety_slow.has_value()) {
-      insertDecelPointWithDebugInfo(p_safety_slow.value(), safety_slow_down_speed, output);
+      insertDecelPointWithDebugInfo(
+        p_safety_slow.value(), safety_slow_down_speed, ego_path, velocity_requests);
       slowdown_pose.emplace();
       slowdown_pose->position = p_safety_slow.value();
     }
@@ -818,35 +835,40 @@ void CrosswalkModule::applySlowDown(
       calcSignedArcLength(ego_path.points, ego_pos, last_path_point_on_crosswalk);
 
     if (0.0 < safety_slow_end_point_range) {
-      // insert constant ego speed until the end of the crosswalk
-      for (auto & p : output.points) {
-        const float original_velocity = p.point.longitudinal_velocity_mps;
-        p.point.longitudinal_velocity_mps = std::min(original_velocity, safety_slow_down_speed);
+      // insert constant ego speed until the end of the crosswalk, i.e. limit the velocity from the
+      // front of the path
+      if (!ego_path.points.empty()) {
+        slowdown_pose = ego_path.points.front().point.pose;
+        velocity_requests.push_back({slowdown_pose->position, safety_slow_down_speed});
       }
-      if (!output.points.empty()) slowdown_pose = output.points.front().point.pose;
     }
   }
   if (slowdown_pose)
     velocity_factor_.set(
-      output.points, planner_data_->current_odometry->pose, *slowdown_pose,
+      ego_path.points, planner_data_->current_odometry->pose, *slowdown_pose,
       VelocityFactor::APPROACHING);
 }
 
 void CrosswalkModule::applySlowDownByLanelet2Map(
-  PathWithLaneId & output, const geometry_msgs::msg::Point & first_path_point_on_crosswalk,
-  const geometry_msgs::msg::Point & last_path_point_on_crosswalk)
+  const PathWithLaneId & ego_path,
+  const geometry_msgs::msg::Point & first_path_point_on_crosswalk,
+  const geometry_msgs::msg::Point & last_path_point_on_crosswalk,
+  std::vector<VelocityRequest> & velocity_requests)
 {
   if (!crosswalk_.hasAttribute("safety_slow_down_speed")) {
     return;
   }
   applySlowDown(
-    output, first_path_point_on_crosswalk, last_path_point_on_crosswalk,
-    static_cast<float>(crosswalk_.attribute("safety_slow_down_speed").asDouble().get()));
+    ego_path, first_path_point_on_crosswalk, last_path_point_on_crosswalk,
+    static_cast<float>(crosswalk_.attribute("safety_slow_down_speed").asDouble().get()),
+    velocity_requests);
 }
 
 void CrosswalkModule::applySlowDownByOcclusion(
-  PathWithLaneId & output, const geometry_msgs::msg::Point & first_path_point_on_crosswalk,
-  const geometry_msgs::msg::Point & last_path_point_on_crosswalk)
+  const PathWithLaneId & ego_path,
+  const geometry_msgs::msg::Point & first_path_point_on_crosswalk,
+  const geometry_msgs::msg::Point & last_path_point_on_crosswalk,
+  std::vector<VelocityRequest> & velocity_requests)
 {
   const auto & ego_pos = planner_data_->current_odometry->pose.position;
   const auto objects_ptr = planner_data_->predicted_objects;
@@ -862,7 +884,7 @@ void CrosswalkModule::applySlowDownByOcclusion(
     crosswalk_.hasAttribute("skip_occluded_slowdown");
   if (planner_param_.occlusion_enable && !is_crosswalk_ignored) {
     const auto dist_ego_to_crosswalk =
-      calcSignedArcLength(output.points, ego_pos, first_path_point_on_crosswalk);
+      calcSignedArcLength(ego_path.points, ego_pos, first_path_point_on_crosswalk);
     const auto detection_range =
       planner_data_->vehicle_info_.max_lateral_offset_m +
       calculate_detection_range(
@@ -882,10 +904,11 @@ void CrosswalkModule::applySlowDownByOcclusion(
       }
 
       if (cmp_with_time_buffer(most_recent_occlusion_time_, std::less_equal<double>{})) {
-        const auto target_velocity = calcTargetVelocity(first_path_point_on_crosswalk, output);
+        const auto target_velocity = calcTargetVelocity(first_path_point_on_crosswalk, ego_path);
         applySlowDown(
-          output, first_path_point_on_crosswalk, last_path_point_on_crosswalk,
-          std::max(target_velocity, planner_param_.occlusion_slow_down_velocity));
+          ego_path, first_path_point_on_crosswalk, last_path_point_on_crosswalk,
+          std::max(target_velocity, planner_param_.occlusion_slow_down_velocity),
+          velocity_requests);
         debug_data_.virtual_wall_suffix = " (occluded)";
       } else {
         most_recent_occlusion_time_.reset();
@@ -1260,7 +1283,8 @@ void CrosswalkModule::setDistanceToStop(
 }
 
 void CrosswalkModule::planGo(
-  PathWithLaneId & ego_path, const std::optional<StopFactor> & stop_factor) const
+  const PathWithLaneId & ego_path, const std::optional<StopFactor> & stop_factor,
+  std::vector<VelocityRequest> & velocity_requests) const
 {
   if (!stop_factor.has_value()) {
     return;
@@ -1269,12 +1293,13 @@ void CrosswalkModule::planGo(
   const auto target_velocity = calcTargetVelocity(stop_factor->stop_pose.position, ego_path);
   insertDecelPointWithDebugInfo(
     stop_factor->stop_pose.position,
-    std::max(planner_param_.min_slow_down_velocity, target_velocity), ego_path);
+    std::max(planner_param_.min_slow_down_velocity, target_velocity), ego_path, velocity_requests);
 }
 
 void CrosswalkModule::planStop(
-  PathWithLaneId & ego_path, const std::optional<StopFactor> & nearest_stop_factor,
-  const std::optional<geometry_msgs::msg::Pose> & default_stop_pose, StopReason * stop_reason)
+  const PathWithLaneId & ego_path, const std::optional<StopFactor> & nearest_stop_factor,
+  const std::optional<geometry_msgs::msg::Pose> & default_stop_pose, StopReason * stop_reason,
+  std::vector<VelocityRequest> & velocity_requests)
 {
   const auto stop_factor = [&]() -> std::optional<StopFactor> {
     if (nearest_stop_factor) return *nearest_stop_factor;
@@ -1288,7 +1313,7 @@ void CrosswalkModule::planStop(
   }
 
   // Plan stop
-  insertDecelPointWithDebugInfo(stop_factor->stop_pose.position, 0.0, ego_path);
+  insertDecelPointWithDebugInfo(stop_factor->stop_pose.position, 0.0, ego_path, velocity_requests);
   planning_utils::appendStopReason(*stop_factor, stop_reason);
   velocity_factor_.set(
     ego_path.points, planner_data_->current_odometry->pose, stop_factor->stop_pose,
@@ -326,23 +326,31 @@ public:
 
   bool modifyPathVelocity(PathWithLaneId * path, StopReason * stop_reason) override;
 
+  std::vector<VelocityRequest> decideVelocity(
+    const PathWithLaneId & path, StopReason * stop_reason) override;
+
   visualization_msgs::msg::MarkerArray createDebugMarkerArray() override;
   autoware::motion_utils::VirtualWalls createVirtualWalls() override;
 
 private:
   // main functions
   void applySlowDown(
-    PathWithLaneId & output, const geometry_msgs::msg::Point & first_path_point_on_crosswalk,
+    const PathWithLaneId & ego_path,
+    const geometry_msgs::msg::Point & first_path_point_on_crosswalk,
     const geometry_msgs::msg::Point & last_path_point_on_crosswalk,
-    const float safety_slow_down_speed);
+    const float safety_slow_down_speed, std::vector<VelocityRequest> & velocity_requests);
 
   void applySlowDownByLanelet2Map(
-    PathWithLaneId & output, const geometry_msgs::msg::Point & first_path_point_on_crosswalk,
-    const geometry_msgs::msg::Point & last_path_point_on_crosswalk);
+    const PathWithLaneId & ego_path,
+    const geometry_msgs::msg::Point & first_path_point_on_crosswalk,
+    const geometry_msgs::msg::Point & last_path_point_on_crosswalk,
+    std::vector<VelocityRequest> & velocity_requests);
 
   void applySlowDownByOcclusion(
-    PathWithLaneId & output, const geometry_msgs::msg::Point & first_path_point_on_crosswalk,
-    const geometry_msgs::msg::Point & last_path_point_on_crosswalk);
+    const PathWithLaneId & ego_path,
+    const geometry_msgs::msg::Point & first_path_point_on_crosswalk,
+    const geometry_msgs::msg::Point & last_path_point_on_crosswalk,
+    std::vector<VelocityRequest> & velocity_requests);
 
   std::optional<geometry_msgs::msg::Pose> getDefaultStopPose(
     const PathWithLaneId & ego_path,
@@ -379,11 +387,14 @@ private:
     const std::optional<geometry_msgs::msg::Pose> & default_stop_pose,
     const std::optional<StopFactor> & stop_factor);
 
-  void planGo(PathWithLaneId & ego_path, const std::optional<StopFactor> & stop_factor) const;
+  void planGo(
+    const PathWithLaneId & ego_path, const std::optional<StopFactor> & stop_factor,
+    std::vector<VelocityRequest> & velocity_requests) const;
 
   void planStop(
-    PathWithLaneId & ego_path, const std::optional<StopFactor> & nearest_stop_factor,
-    const std::optional<geometry_msgs::msg::Pose> & default_stop_pose, StopReason * stop_reason);
+    const PathWithLaneId & ego_path, const std::optional<StopFactor> & nearest_stop_factor,
+    const std::optional<geometry_msgs::msg::Pose> & default_stop_pose, StopReason * stop_reason,
+    std::vector<VelocityRequest> & velocity_requests);
 
   // minor functions
   std::pair<double, double> getAttentionRange(
@@ -393,7 +404,7 @@ private:
 
   void insertDecelPointWithDebugInfo(
     const geometry_msgs::msg::Point & stop_point, const float target_velocity,
-    PathWithLaneId & output) const;
+    const PathWithLaneId & ego_path, std::vector<VelocityRequest> & velocity_requests) const;
 
   std::pair<double, double> clampAttentionRangeByNeighborCrosswalks(
     const PathWithLaneId & ego_path, const double near_attention_range,
@@ -36,6 +36,8 @@ public:
 
   const char * getModuleName() override { return "detection_area"; }
 
+  bool isTwoPhasePlanningSupported() const override { return true; }
+
 private:
   DetectionAreaModule::PlannerParam planner_param_;
 
@@ -60,9 +60,14 @@ LineString2d DetectionAreaModule::getStopLineGeometry2d() const
 
 bool DetectionAreaModule::modifyPathVelocity(PathWithLaneId * path, StopReason * stop_reason)
 {
-  // Store original path
-  const auto original_path = *path;
+  const auto velocity_requests = decideVelocity(*path, stop_reason);
+  applyVelocityRequests(velocity_requests, path);
+  return true;
+}
 
+std::vector<VelocityRequest> DetectionAreaModule::decideVelocity(
+  const PathWithLaneId & path, StopReason * stop_reason)
+{
   // Reset data
   debug_data_ = DebugData();
   debug_data_.base_link2front = planner_data_->vehicle_info_.max_longitudinal_offset_m;
@@ -80,39 +85,36 @@ bool DetectionAreaModule::modifyPathVelocity(PathWithLaneId * path, StopReason *
 
   // Get self pose
   const auto & self_pose = planner_data_->current_odometry->pose;
-  const size_t current_seg_idx = findEgoSegmentIndex(path->points);
+  const size_t current_seg_idx = findEgoSegmentIndex(path.points);
 
   // Get stop point
   const auto stop_point = arc_lane_utils::createTargetPoint(
-    original_path, stop_line, planner_param_.stop_margin,
+    path, stop_line, planner_param_.stop_margin,
     planner_data_->vehicle_info_.max_longitudinal_offset_m);
   if (!stop_point) {
-    return true;
+    return {};
   }
 
   const auto & stop_point_idx = stop_point->first;
   const auto & stop_pose = stop_point->second;
   const size_t stop_line_seg_idx = planning_utils::calcSegmentIndexFromPointIndex(
-    path->points, stop_pose.position, stop_point_idx);
+    path.points, stop_pose.position, stop_point_idx);
 
   auto modified_stop_pose = stop_pose;
-  size_t modified_stop_line_seg_idx = stop_line_seg_idx;
 
   const auto is_stopped = planner_data_->isVehicleStopped(0.0);
   const auto stop_dist = calcSignedArcLength(
-    path->points, self_pose.position, current_seg_idx, stop_pose.position, stop_line_seg_idx);
+    path.points, self_pose.position, current_seg_idx, stop_pose.position, stop_line_seg_idx);
 
   // Don't re-approach when the ego stops closer to the stop point than hold_stop_margin_distance
   if (is_stopped && stop_dist < planner_param_.hold_stop_margin_distance) {
-    const auto ego_pos_on_path =
-      calcLongitudinalOffsetPose(original_path.points, self_pose.position, 0.0);
+    const auto ego_pos_on_path = calcLongitudinalOffsetPose(path.points, self_pose.position, 0.0);
 
     if (!ego_pos_on_path) {
-      return false;
+      return {};
     }
 
     modified_stop_pose = ego_pos_on_path.value();
-    modified_stop_line_seg_idx = current_seg_idx;
   }
 
   setDistance(stop_dist);
@@ -122,14 +124,14 @@ bool DetectionAreaModule::modifyPathVelocity(PathWithLaneId * path, StopReason *
   if (isActivated()) {
     state_ = State::GO;
     last_obstacle_found_time_ = {};
-    return true;
+    return {};
   }
 
   // Force ignore objects after dead_line
   if (planner_param_.use_dead_line) {
     // Use '-' for margin because it's the backward distance from stop line
     const auto dead_line_point = arc_lane_utils::createTargetPoint(
-      original_path, stop_line, -planner_param_.dead_line_margin,
+      path, stop_line, -planner_param_.dead_line_margin,
       planner_data_->vehicle_info_.max_longitudinal_offset_m);
 
     if (dead_line_point) {
@@ -137,30 +139,29 @@ bool DetectionAreaModule::modifyPathVelocity(PathWithLaneId * path, StopReason *
       const auto & dead_line_pose = dead_line_point->second;
 
       const size_t dead_line_seg_idx = planning_utils::calcSegmentIndexFromPointIndex(
-        path->points, dead_line_pose.position, dead_line_point_idx);
+        path.points, dead_line_pose.position, dead_line_point_idx);
 
       debug_data_.dead_line_poses.push_back(dead_line_pose);
 
       const double dist_from_ego_to_dead_line = calcSignedArcLength(
-        original_path.points, self_pose.position, current_seg_idx, dead_line_pose.position,
+        path.points, self_pose.position, current_seg_idx, dead_line_pose.position,
         dead_line_seg_idx);
       if (dist_from_ego_to_dead_line < 0.0) {
         RCLCPP_WARN(logger_, "[detection_area] vehicle is over dead line");
         setSafe(true);
-        return true;
+        return {};
       }
     }
   }
 
   // Ignore objects detected after stop_line if not in STOP state
   const double dist_from_ego_to_stop = calcSignedArcLength(
-    original_path.points, self_pose.position, current_seg_idx, stop_pose.position,
-    stop_line_seg_idx);
+    path.points, self_pose.position, current_seg_idx, stop_pose.position, stop_line_seg_idx);
   if (
     state_ != State::STOP &&
     dist_from_ego_to_stop < -planner_param_.distance_to_judge_over_stop_line) {
     setSafe(true);
-    return true;
+    return {};
   }
 
   // Ignore objects if braking distance is not enough
@@ -170,13 +171,13 @@ bool DetectionAreaModule::modifyPathVelocity(PathWithLaneId * path, StopReason *
         logger_, *clock_, std::chrono::milliseconds(1000).count(),
         "[detection_area] vehicle is over stop border");
       setSafe(true);
-      return true;
+      return {};
     }
   }
 
   // Insert stop point
   state_ = State::STOP;
-  planning_utils::insertStopPoint(modified_stop_pose.position, modified_stop_line_seg_idx, *path);
+  const std::vector<VelocityRequest> velocity_requests{{modified_stop_pose.position, 0.0}};
 
   // For virtual wall
   debug_data_.stop_poses.push_back(stop_point->second);
@@ -188,23 +189,14 @@ bool DetectionAreaModule::modifyPathVelocity(PathWithLaneId * path, StopReason *
     stop_factor.stop_factor_points = obstacle_points;
     planning_utils::appendStopReason(stop_factor, stop_reason);
     velocity_factor_.set(
-      path->points, planner_data_->current_odometry->pose, stop_point->second,
+      path.points, planner_data_->current_odometry->pose, stop_point->second,
       VelocityFactor::UNKNOWN);
   }
 
-  // Create legacy StopReason
-  {
-    const auto insert_idx = stop_point->first + 1;
+  // For legacy StopReason
+  debug_data_.first_stop_pose = stop_point->second;
 
-    if (
-      !first_stop_path_point_index_ ||
-      static_cast<int>(insert_idx) < first_stop_path_point_index_) {
-      debug_data_.first_stop_pose = stop_point->second;
-      first_stop_path_point_index_ = static_cast<int>(insert_idx);
-    }
-  }
-
-  return true;
+  return velocity_requests;
 }
 
 // calc smallest enclosing circle with average O(N) algorithm
@@ -72,6 +72,9 @@ public:
 
   bool modifyPathVelocity(PathWithLaneId * path, StopReason * stop_reason) override;
 
+  std::vector<VelocityRequest> decideVelocity(
+    const PathWithLaneId & path, StopReason * stop_reason) override;
+
   visualization_msgs::msg::MarkerArray createDebugMarkerArray() override;
   autoware::motion_utils::VirtualWalls createVirtualWalls() override;
 
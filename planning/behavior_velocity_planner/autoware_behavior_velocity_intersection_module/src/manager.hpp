@@ -41,6 +41,8 @@ public:
 
   const char * getModuleName() override { return "intersection"; }
 
+  bool isTwoPhasePlanningSupported() const override { return true; }
+
 private:
   IntersectionModule::PlannerParam intersection_param_;
   // additional for INTERSECTION_OCCLUSION
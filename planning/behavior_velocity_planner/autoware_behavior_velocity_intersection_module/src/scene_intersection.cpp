@@ -92,13 +92,24 @@ IntersectionModule::IntersectionModule(
 }
 
 bool IntersectionModule::modifyPathVelocity(PathWithLaneId * path, StopReason * stop_reason)
+{
+  const auto velocity_requests = decideVelocity(*path, stop_reason);
+  applyVelocityRequests(velocity_requests, path);
+  return true;
+}
+
+std::vector<VelocityRequest> IntersectionModule::decideVelocity(
+  const PathWithLaneId & input_path, StopReason * stop_reason)
 {
   debug_data_ = DebugData();
   *stop_reason = planning_utils::initializeStopReason(StopReason::INTERSECTION);
 
   initializeRTCStatus();
 
-  const auto decision_result = modifyPathVelocityDetail(path, stop_reason);
+  // NOTE: the stoplines are inserted to the path while preparing the intersection data, so that
+  // the decision is made on a copy and the stop points are inserted again when they are applied.
+  auto path = input_path;
+  const auto decision_result = modifyPathVelocityDetail(&path, stop_reason);
   prev_decision_result_ = decision_result;
 
   {
@@ -107,11 +118,9 @@ bool IntersectionModule::modifyPathVelocity(PathWithLaneId * path, StopReason *
     internal_debug_data_.decision_type = decision_type;
   }
 
-  prepareRTCStatus(decision_result, *path);
-
-  reactRTCApproval(decision_result, path, stop_reason);
+  prepareRTCStatus(decision_result, path);
 
-  return true;
+  return reactRTCApproval(decision_result, path, stop_reason);
 }
 
 void IntersectionModule::initializeRTCStatus()
@@ -701,11 +710,23 @@ void IntersectionModule::prepareRTCStatus(
     std::holds_alternative<FirstWaitBeforeOcclusion>(decision_result);
 }
 
+/**
+ * @brief request to limit the velocity from the given index of the path, which is the same as
+ * planning_utils::setVelocityFromIndex() once the request is applied
+ */
+static void insertVelocityFromIndex(
+  const size_t begin_idx, const double vel, const tier4_planning_msgs::msg::PathWithLaneId & path,
+  std::vector<VelocityRequest> * velocity_requests)
+{
+  velocity_requests->push_back({path.points.at(begin_idx).point.pose.position, vel});
+}
+
 template <typename T>
 void reactRTCApprovalByDecisionResult(
   const bool rtc_default_approved, const bool rtc_occlusion_approved, const T & decision_result,
   const IntersectionModule::PlannerParam & planner_param, const double baselink2front,
-  tier4_planning_msgs::msg::PathWithLaneId * path, StopReason * stop_reason,
+  const tier4_planning_msgs::msg::PathWithLaneId & path,
+  std::vector<VelocityRequest> * velocity_requests, StopReason * stop_reason,
   VelocityFactorInterface * velocity_factor, IntersectionModule::DebugData * debug_data)
 {
   static_assert("Unsupported type passed to reactRTCByDecisionResult");
@@ -719,7 +740,8 @@ void reactRTCApprovalByDecisionResult(
   [[maybe_unused]] const InternalError & decision_result,
   [[maybe_unused]] const IntersectionModule::PlannerParam & planner_param,
   [[maybe_unused]] const double baselink2front,
-  [[maybe_unused]] tier4_planning_msgs::msg::PathWithLaneId * path,
+  [[maybe_unused]] const tier4_planning_msgs::msg::PathWithLaneId & path,
+  [[maybe_unused]] std::vector<VelocityRequest> * velocity_requests,
   [[maybe_unused]] StopReason * stop_reason,
   [[maybe_unused]] VelocityFactorInterface * velocity_factor,
   [[maybe_unused]] IntersectionModule::DebugData * debug_data)
@@ -734,7 +756,8 @@ void reactRTCApprovalByDecisionResult(
   [[maybe_unused]] const OverPassJudge & decision_result,
   [[maybe_unused]] const IntersectionModule::PlannerParam & planner_param,
   [[maybe_unused]] const double baselink2front,
-  [[maybe_unused]] tier4_planning_msgs::msg::PathWithLaneId * path,
+  [[maybe_unused]] const tier4_planning_msgs::msg::PathWithLaneId & path,
+  [[maybe_unused]] std::vector<VelocityRequest> * velocity_requests,
   [[maybe_unused]] StopReason * stop_reason,
   [[maybe_unused]] VelocityFactorInterface * velocity_factor,
   [[maybe_unused]] IntersectionModule::DebugData * debug_data)
@@ -747,9 +770,9 @@ void reactRTCApprovalByDecisionResult(
   const bool rtc_default_approved, const bool rtc_occlusion_approved,
   const StuckStop & decision_result,
   [[maybe_unused]] const IntersectionModule::PlannerParam & planner_param,
-  const double baselink2front, tier4_planning_msgs::msg::PathWithLaneId * path,
-  StopReason * stop_reason, VelocityFactorInterface * velocity_factor,
-  IntersectionModule::DebugData * debug_data)
+  const double baselink2front, const tier4_planning_msgs::msg::PathWithLaneId & path,
+  std::vector<VelocityRequest> * velocity_requests, StopReason * stop_reason,
+  VelocityFactorInterface * velocity_factor, IntersectionModule::DebugData * debug_data)
 {
   RCLCPP_DEBUG(
     rclcpp::get_logger("reactRTCApprovalByDecisionResult"),
@@ -759,31 +782,31 @@ void reactRTCApprovalByDecisionResult(
   if (!rtc_default_approved) {
     // use default_rtc uuid for stuck vehicle detection
     const auto stopline_idx = decision_result.stuck_stopline_idx;
-    planning_utils::setVelocityFromIndex(stopline_idx, 0.0, path);
+    insertVelocityFromIndex(stopline_idx, 0.0, path, velocity_requests);
     debug_data->collision_stop_wall_pose =
-      planning_utils::getAheadPose(stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(stopline_idx, baselink2front, path);
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(stopline_idx).point.pose;
       stop_factor.stop_factor_points = planning_utils::toRosPoints(debug_data->unsafe_targets);
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(closest_idx).point.pose,
-        path->points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(closest_idx).point.pose,
+        path.points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   if (!rtc_occlusion_approved && decision_result.occlusion_stopline_idx) {
     const auto occlusion_stopline_idx = decision_result.occlusion_stopline_idx.value();
-    planning_utils::setVelocityFromIndex(occlusion_stopline_idx, 0.0, path);
+    insertVelocityFromIndex(occlusion_stopline_idx, 0.0, path, velocity_requests);
     debug_data->occlusion_stop_wall_pose =
-      planning_utils::getAheadPose(occlusion_stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(occlusion_stopline_idx, baselink2front, path);
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(occlusion_stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(occlusion_stopline_idx).point.pose;
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(closest_idx).point.pose,
-        path->points.at(occlusion_stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(closest_idx).point.pose,
+        path.points.at(occlusion_stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   return;
@@ -794,9 +817,9 @@ void reactRTCApprovalByDecisionResult(
   const bool rtc_default_approved, const bool rtc_occlusion_approved,
   const YieldStuckStop & decision_result,
   [[maybe_unused]] const IntersectionModule::PlannerParam & planner_param,
-  const double baselink2front, tier4_planning_msgs::msg::PathWithLaneId * path,
-  StopReason * stop_reason, VelocityFactorInterface * velocity_factor,
-  IntersectionModule::DebugData * debug_data)
+  const double baselink2front, const tier4_planning_msgs::msg::PathWithLaneId & path,
+  std::vector<VelocityRequest> * velocity_requests, StopReason * stop_reason,
+  VelocityFactorInterface * velocity_factor, IntersectionModule::DebugData * debug_data)
 {
   RCLCPP_DEBUG(
     rclcpp::get_logger("reactRTCApprovalByDecisionResult"),
@@ -806,17 +829,17 @@ void reactRTCApprovalByDecisionResult(
   if (!rtc_default_approved) {
     // use default_rtc uuid for stuck vehicle detection
     const auto stopline_idx = decision_result.stuck_stopline_idx;
-    planning_utils::setVelocityFromIndex(stopline_idx, 0.0, path);
+    insertVelocityFromIndex(stopline_idx, 0.0, path, velocity_requests);
     debug_data->collision_stop_wall_pose =
-      planning_utils::getAheadPose(stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(stopline_idx, baselink2front, path);
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(stopline_idx).point.pose;
       stop_factor.stop_factor_points = planning_utils::toRosPoints(debug_data->unsafe_targets);
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(closest_idx).point.pose,
-        path->points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(closest_idx).point.pose,
+        path.points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   return;
@@ -827,9 +850,9 @@ void reactRTCApprovalByDecisionResult(
   const bool rtc_default_approved, const bool rtc_occlusion_approved,
   const NonOccludedCollisionStop & decision_result,
   [[maybe_unused]] const IntersectionModule::PlannerParam & planner_param,
-  const double baselink2front, tier4_planning_msgs::msg::PathWithLaneId * path,
-  StopReason * stop_reason, VelocityFactorInterface * velocity_factor,
-  IntersectionModule::DebugData * debug_data)
+  const double baselink2front, const tier4_planning_msgs::msg::PathWithLaneId & path,
+  std::vector<VelocityRequest> * velocity_requests, StopReason * stop_reason,
+  VelocityFactorInterface * velocity_factor, IntersectionModule::DebugData * debug_data)
 {
   RCLCPP_DEBUG(
     rclcpp::get_logger("reactRTCApprovalByDecisionResult"),
@@ -837,30 +860,30 @@ void reactRTCApprovalByDecisionResult(
     rtc_occlusion_approved);
   if (!rtc_default_approved) {
     const auto stopline_idx = decision_result.collision_stopline_idx;
-    planning_utils::setVelocityFromIndex(stopline_idx, 0.0, path);
+    insertVelocityFromIndex(stopline_idx, 0.0, path, velocity_requests);
     debug_data->collision_stop_wall_pose =
-      planning_utils::getAheadPose(stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(stopline_idx, baselink2front, path);
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(stopline_idx).point.pose;
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(decision_result.closest_idx).point.pose,
-        path->points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(decision_result.closest_idx).point.pose,
+        path.points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   if (!rtc_occlusion_approved) {
     const auto stopline_idx = decision_result.occlusion_stopline_idx;
-    planning_utils::setVelocityFromIndex(stopline_idx, 0.0, path);
+    insertVelocityFromIndex(stopline_idx, 0.0, path, velocity_requests);
     debug_data->occlusion_stop_wall_pose =
-      planning_utils::getAheadPose(stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(stopline_idx, baselink2front, path);
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(stopline_idx).point.pose;
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(decision_result.closest_idx).point.pose,
-        path->points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(decision_result.closest_idx).point.pose,
+        path.points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   return;
@@ -871,7 +894,8 @@ void reactRTCApprovalByDecisionResult(
   const bool rtc_default_approved, const bool rtc_occlusion_approved,
   const FirstWaitBeforeOcclusion & decision_result,
   const IntersectionModule::PlannerParam & planner_param, const double baselink2front,
-  tier4_planning_msgs::msg::PathWithLaneId * path, StopReason * stop_reason,
+  const tier4_planning_msgs::msg::PathWithLaneId & path,
+  std::vector<VelocityRequest> * velocity_requests, StopReason * stop_reason,
   VelocityFactorInterface * velocity_factor, IntersectionModule::DebugData * debug_data)
 {
   RCLCPP_DEBUG(
@@ -880,38 +904,39 @@ void reactRTCApprovalByDecisionResult(
     rtc_occlusion_approved);
   if (!rtc_default_approved) {
     const auto stopline_idx = decision_result.first_stopline_idx;
-    planning_utils::setVelocityFromIndex(stopline_idx, 0.0, path);
+    insertVelocityFromIndex(stopline_idx, 0.0, path, velocity_requests);
     debug_data->occlusion_first_stop_wall_pose =
-      planning_utils::getAheadPose(stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(stopline_idx, baselink2front, path);
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(stopline_idx).point.pose;
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(decision_result.closest_idx).point.pose,
-        path->points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(decision_result.closest_idx).point.pose,
+        path.points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   if (!rtc_occlusion_approved) {
     if (planner_param.occlusion.creep_during_peeking.enable) {
       const size_t occlusion_peeking_stopline = decision_result.occlusion_stopline_idx;
       const size_t closest_idx = decision_result.closest_idx;
-      for (size_t i = closest_idx; i < occlusion_peeking_stopline; i++) {
-        planning_utils::setVelocityFromIndex(
-          i, planner_param.occlusion.creep_during_peeking.creep_velocity, path);
+      if (closest_idx < occlusion_peeking_stopline) {
+        insertVelocityFromIndex(
+          closest_idx, planner_param.occlusion.creep_during_peeking.creep_velocity, path,
+          velocity_requests);
       }
     }
     const auto stopline_idx = decision_result.occlusion_stopline_idx;
-    planning_utils::setVelocityFromIndex(stopline_idx, 0.0, path);
+    insertVelocityFromIndex(stopline_idx, 0.0, path, velocity_requests);
     debug_data->occlusion_stop_wall_pose =
-      planning_utils::getAheadPose(stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(stopline_idx, baselink2front, path);
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(stopline_idx).point.pose;
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(decision_result.closest_idx).point.pose,
-        path->points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(decision_result.closest_idx).point.pose,
+        path.points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   return;
@@ -922,7 +947,8 @@ void reactRTCApprovalByDecisionResult(
   const bool rtc_default_approved, const bool rtc_occlusion_approved,
   const PeekingTowardOcclusion & decision_result,
   const IntersectionModule::PlannerParam & planner_param, const double baselink2front,
-  tier4_planning_msgs::msg::PathWithLaneId * path, StopReason * stop_reason,
+  const tier4_planning_msgs::msg::PathWithLaneId & path,
+  std::vector<VelocityRequest> * velocity_requests, StopReason * stop_reason,
   VelocityFactorInterface * velocity_factor, IntersectionModule::DebugData * debug_data)
 {
   RCLCPP_DEBUG(
@@ -937,37 +963,38 @@ void reactRTCApprovalByDecisionResult(
         : decision_result.occlusion_stopline_idx;
     if (planner_param.occlusion.creep_during_peeking.enable) {
       const size_t closest_idx = decision_result.closest_idx;
-      for (size_t i = closest_idx; i < occlusion_peeking_stopline; i++) {
-        planning_utils::setVelocityFromIndex(
-          i, planner_param.occlusion.creep_during_peeking.creep_velocity, path);
+      if (closest_idx < occlusion_peeking_stopline) {
+        insertVelocityFromIndex(
+          closest_idx, planner_param.occlusion.creep_during_peeking.creep_velocity, path,
+          velocity_requests);
       }
     }
-    planning_utils::setVelocityFromIndex(occlusion_peeking_stopline, 0.0, path);
+    insertVelocityFromIndex(occlusion_peeking_stopline, 0.0, path, velocity_requests);
     debug_data->occlusion_stop_wall_pose =
-      planning_utils::getAheadPose(occlusion_peeking_stopline, baselink2front, *path);
+      planning_utils::getAheadPose(occlusion_peeking_stopline, baselink2front, path);
     debug_data->static_occlusion_with_traffic_light_timeout =
       decision_result.static_occlusion_timeout;
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(occlusion_peeking_stopline).point.pose;
+      stop_factor.stop_pose = path.points.at(occlusion_peeking_stopline).point.pose;
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(decision_result.closest_idx).point.pose,
-        path->points.at(occlusion_peeking_stopline).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(decision_result.closest_idx).point.pose,
+        path.points.at(occlusion_peeking_stopline).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   if (!rtc_default_approved) {
     const auto stopline_idx = decision_result.collision_stopline_idx;
-    planning_utils::setVelocityFromIndex(stopline_idx, 0.0, path);
+    insertVelocityFromIndex(stopline_idx, 0.0, path, velocity_requests);
     debug_data->collision_stop_wall_pose =
-      planning_utils::getAheadPose(stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(stopline_idx, baselink2front, path);
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(stopline_idx).point.pose;
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(decision_result.closest_idx).point.pose,
-        path->points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(decision_result.closest_idx).point.pose,
+        path.points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   return;
@@ -978,9 +1005,9 @@ void reactRTCApprovalByDecisionResult(
   const bool rtc_default_approved, const bool rtc_occlusion_approved,
   const OccludedCollisionStop & decision_result,
   [[maybe_unused]] const IntersectionModule::PlannerParam & planner_param,
-  const double baselink2front, tier4_planning_msgs::msg::PathWithLaneId * path,
-  StopReason * stop_reason, VelocityFactorInterface * velocity_factor,
-  IntersectionModule::DebugData * debug_data)
+  const double baselink2front, const tier4_planning_msgs::msg::PathWithLaneId & path,
+  std::vector<VelocityRequest> * velocity_requests, StopReason * stop_reason,
+  VelocityFactorInterface * velocity_factor, IntersectionModule::DebugData * debug_data)
 {
   RCLCPP_DEBUG(
     rclcpp::get_logger("reactRTCApprovalByDecisionResult"),
@@ -988,34 +1015,34 @@ void reactRTCApprovalByDecisionResult(
     rtc_occlusion_approved);
   if (!rtc_default_approved) {
     const auto stopline_idx = decision_result.collision_stopline_idx;
-    planning_utils::setVelocityFromIndex(stopline_idx, 0.0, path);
+    insertVelocityFromIndex(stopline_idx, 0.0, path, velocity_requests);
     debug_data->collision_stop_wall_pose =
-      planning_utils::getAheadPose(stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(stopline_idx, baselink2front, path);
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(stopline_idx).point.pose;
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(decision_result.closest_idx).point.pose,
-        path->points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(decision_result.closest_idx).point.pose,
+        path.points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   if (!rtc_occlusion_approved) {
     const auto stopline_idx = decision_result.temporal_stop_before_attention_required
                                 ? decision_result.first_attention_stopline_idx
                                 : decision_result.occlusion_stopline_idx;
-    planning_utils::setVelocityFromIndex(stopline_idx, 0.0, path);
+    insertVelocityFromIndex(stopline_idx, 0.0, path, velocity_requests);
     debug_data->occlusion_stop_wall_pose =
-      planning_utils::getAheadPose(stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(stopline_idx, baselink2front, path);
     debug_data->static_occlusion_with_traffic_light_timeout =
       decision_result.static_occlusion_timeout;
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(stopline_idx).point.pose;
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(decision_result.closest_idx).point.pose,
-        path->points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(decision_result.closest_idx).point.pose,
+        path.points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   return;
@@ -1026,9 +1053,9 @@ void reactRTCApprovalByDecisionResult(
   const bool rtc_default_approved, const bool rtc_occlusion_approved,
   const OccludedAbsenceTrafficLight & decision_result,
   [[maybe_unused]] const IntersectionModule::PlannerParam & planner_param,
-  const double baselink2front, tier4_planning_msgs::msg::PathWithLaneId * path,
-  StopReason * stop_reason, VelocityFactorInterface * velocity_factor,
-  IntersectionModule::DebugData * debug_data)
+  const double baselink2front, const tier4_planning_msgs::msg::PathWithLaneId & path,
+  std::vector<VelocityRequest> * velocity_requests, StopReason * stop_reason,
+  VelocityFactorInterface * velocity_factor, IntersectionModule::DebugData * debug_data)
 {
   RCLCPP_DEBUG(
     rclcpp::get_logger("reactRTCApprovalByDecisionResult"),
@@ -1036,41 +1063,42 @@ void reactRTCApprovalByDecisionResult(
     rtc_occlusion_approved);
   if (!rtc_default_approved) {
     const auto stopline_idx = decision_result.closest_idx;
-    planning_utils::setVelocityFromIndex(stopline_idx, 0.0, path);
+    insertVelocityFromIndex(stopline_idx, 0.0, path, velocity_requests);
     debug_data->collision_stop_wall_pose =
-      planning_utils::getAheadPose(stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(stopline_idx, baselink2front, path);
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(stopline_idx).point.pose;
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(decision_result.closest_idx).point.pose,
-        path->points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(decision_result.closest_idx).point.pose,
+        path.points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   if (!rtc_occlusion_approved && decision_result.temporal_stop_before_attention_required) {
     const auto stopline_idx = decision_result.first_attention_area_stopline_idx;
-    planning_utils::setVelocityFromIndex(stopline_idx, 0.0, path);
+    insertVelocityFromIndex(stopline_idx, 0.0, path, velocity_requests);
     debug_data->occlusion_stop_wall_pose =
-      planning_utils::getAheadPose(stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(stopline_idx, baselink2front, path);
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(stopline_idx).point.pose;
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(decision_result.closest_idx).point.pose,
-        path->points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(decision_result.closest_idx).point.pose,
+        path.points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   if (!rtc_occlusion_approved && !decision_result.temporal_stop_before_attention_required) {
     const auto closest_idx = decision_result.closest_idx;
     const auto peeking_limit_line = decision_result.peeking_limit_line_idx;
-    for (auto i = closest_idx; i <= peeking_limit_line; ++i) {
-      planning_utils::setVelocityFromIndex(
-        i, planner_param.occlusion.creep_velocity_without_traffic_light, path);
+    if (closest_idx <= peeking_limit_line) {
+      insertVelocityFromIndex(
+        closest_idx, planner_param.occlusion.creep_velocity_without_traffic_light, path,
+        velocity_requests);
     }
     debug_data->absence_traffic_light_creep_wall =
-      planning_utils::getAheadPose(closest_idx, baselink2front, *path);
+      planning_utils::getAheadPose(closest_idx, baselink2front, path);
   }
   return;
 }
@@ -1079,39 +1107,39 @@ template <>
 void reactRTCApprovalByDecisionResult(
   const bool rtc_default_approved, const bool rtc_occlusion_approved, const Safe & decision_result,
   [[maybe_unused]] const IntersectionModule::PlannerParam & planner_param,
-  const double baselink2front, tier4_planning_msgs::msg::PathWithLaneId * path,
-  StopReason * stop_reason, VelocityFactorInterface * velocity_factor,
-  IntersectionModule::DebugData * debug_data)
+  const double baselink2front, const tier4_planning_msgs::msg::PathWithLaneId & path,
+  std::vector<VelocityRequest> * velocity_requests, StopReason * stop_reason,
+  VelocityFactorInterface * velocity_factor, IntersectionModule::DebugData * debug_data)
 {
   RCLCPP_DEBUG(
     rclcpp::get_logger("reactRTCApprovalByDecisionResult"),
     "Safe, approval = (default: %d, occlusion: %d)", rtc_default_approved, rtc_occlusion_approved);
   if (!rtc_default_approved) {
     const auto stopline_idx = decision_result.collision_stopline_idx;
-    planning_utils::setVelocityFromIndex(stopline_idx, 0.0, path);
+    insertVelocityFromIndex(stopline_idx, 0.0, path, velocity_requests);
     debug_data->collision_stop_wall_pose =
-      planning_utils::getAheadPose(stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(stopline_idx, baselink2front, path);
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(stopline_idx).point.pose;
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(decision_result.closest_idx).point.pose,
-        path->points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(decision_result.closest_idx).point.pose,
+        path.points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   if (!rtc_occlusion_approved) {
     const auto stopline_idx = decision_result.occlusion_stopline_idx;
-    planning_utils::setVelocityFromIndex(stopline_idx, 0.0, path);
+    insertVelocityFromIndex(stopline_idx, 0.0, path, velocity_requests);
     debug_data->occlusion_stop_wall_pose =
-      planning_utils::getAheadPose(stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(stopline_idx, baselink2front, path);
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(stopline_idx).point.pose;
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(decision_result.closest_idx).point.pose,
-        path->points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(decision_result.closest_idx).point.pose,
+        path.points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   return;
@@ -1122,9 +1150,9 @@ void reactRTCApprovalByDecisionResult(
   const bool rtc_default_approved, const bool rtc_occlusion_approved,
   const FullyPrioritized & decision_result,
   [[maybe_unused]] const IntersectionModule::PlannerParam & planner_param,
-  const double baselink2front, tier4_planning_msgs::msg::PathWithLaneId * path,
-  StopReason * stop_reason, VelocityFactorInterface * velocity_factor,
-  IntersectionModule::DebugData * debug_data)
+  const double baselink2front, const tier4_planning_msgs::msg::PathWithLaneId & path,
+  std::vector<VelocityRequest> * velocity_requests, StopReason * stop_reason,
+  VelocityFactorInterface * velocity_factor, IntersectionModule::DebugData * debug_data)
 {
   RCLCPP_DEBUG(
     rclcpp::get_logger("reactRTCApprovalByDecisionResult"),
@@ -1132,48 +1160,49 @@ void reactRTCApprovalByDecisionResult(
     rtc_occlusion_approved);
   if (!rtc_default_approved) {
     const auto stopline_idx = decision_result.collision_stopline_idx;
-    planning_utils::setVelocityFromIndex(stopline_idx, 0.0, path);
+    insertVelocityFromIndex(stopline_idx, 0.0, path, velocity_requests);
     debug_data->collision_stop_wall_pose =
-      planning_utils::getAheadPose(stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(stopline_idx, baselink2front, path);
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(stopline_idx).point.pose;
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(decision_result.closest_idx).point.pose,
-        path->points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(decision_result.closest_idx).point.pose,
+        path.points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   if (!rtc_occlusion_approved) {
     const auto stopline_idx = decision_result.occlusion_stopline_idx;
-    planning_utils::setVelocityFromIndex(stopline_idx, 0.0, path);
+    insertVelocityFromIndex(stopline_idx, 0.0, path, velocity_requests);
     debug_data->occlusion_stop_wall_pose =
-      planning_utils::getAheadPose(stopline_idx, baselink2front, *path);
+      planning_utils::getAheadPose(stopline_idx, baselink2front, path);
     {
       tier4_planning_msgs::msg::StopFactor stop_factor;
-      stop_factor.stop_pose = path->points.at(stopline_idx).point.pose;
+      stop_factor.stop_pose = path.points.at(stopline_idx).point.pose;
       planning_utils::appendStopReason(stop_factor, stop_reason);
       velocity_factor->set(
-        path->points, path->points.at(decision_result.closest_idx).point.pose,
-        path->points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
+        path.points, path.points.at(decision_result.closest_idx).point.pose,
+        path.points.at(stopline_idx).point.pose, VelocityFactor::UNKNOWN);
     }
   }
   return;
 }
 
-void IntersectionModule::reactRTCApproval(
-  const DecisionResult & decision_result, tier4_planning_msgs::msg::PathWithLaneId * path,
+std::vector<VelocityRequest> IntersectionModule::reactRTCApproval(
+  const DecisionResult & decision_result, const tier4_planning_msgs::msg::PathWithLaneId & path,
   StopReason * stop_reason)
 {
   const double baselink2front = planner_data_->vehicle_info_.max_longitudinal_offset_m;
+  std::vector<VelocityRequest> velocity_requests;
   std::visit(
     VisitorSwitch{[&](const auto & decision) {
       reactRTCApprovalByDecisionResult(
         activated_, occlusion_activated_, decision, planner_param_, baselink2front, path,
-        stop_reason, &velocity_factor_, &debug_data_);
+        &velocity_requests, stop_reason, &velocity_factor_, &debug_data_);
     }},
     decision_result);
-  return;
+  return velocity_requests;
 }
 
 bool IntersectionModule::isGreenSolidOn() const
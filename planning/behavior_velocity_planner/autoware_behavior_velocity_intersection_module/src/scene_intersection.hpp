@@ -319,9 +319,14 @@ public:
    * INTERSECTION and INTERSECTION_OCCLUSION. Then modifyPathVelocityDetail() is called to analyze
    * the context. Then prepareRTCStatus() is called to set the safety value of INTERSECTION and
    * INTERSECTION_OCCLUSION.
+   * decideVelocity() does all of the above on a copy of the input path and returns the reaction as
+   * velocity requests, so that modifyPathVelocity() only applies them to the path.
    * @{
    */
   bool modifyPathVelocity(PathWithLaneId * path, StopReason * stop_reason) override;
+
+  std::vector<VelocityRequest> decideVelocity(
+    const PathWithLaneId & input_path, StopReason * stop_reason) override;
   /** @}*/
 
   visualization_msgs::msg::MarkerArray createDebugMarkerArray() override;
@@ -514,9 +519,10 @@ private:
 
   /**
    * @brief act based on current RTC approval
+   * @return velocity requests on the given path
    */
-  void reactRTCApproval(
-    const DecisionResult & decision_result, tier4_planning_msgs::msg::PathWithLaneId * path,
+  std::vector<VelocityRequest> reactRTCApproval(
+    const DecisionResult & decision_result, const tier4_planning_msgs::msg::PathWithLaneId & path,
     StopReason * stop_reason);
   /** @}*/
 
@@ -806,6 +812,8 @@ private:
    * @attention this function has access to value() of
    * intersection_stoplines.occlusion_peeking_stopline,
    * intersection_stoplines.first_attention_stopline
+   * @note the velocity of the path is the one of the input path of the planner, i.e. the velocity
+   * limits and the stop points of the other modules are not reflected
    */
   TimeDistanceArray calcIntersectionPassingTime(
     const tier4_planning_msgs::msg::PathWithLaneId & path, const bool is_prioritized,
@@ -853,37 +853,16 @@ IntersectionModule::TimeDistanceArray IntersectionModule::calcIntersectionPassin
     second_attention_stopline_idx ? second_attention_stopline_idx.value()
                                   : std::max(occlusion_stopline_idx, first_attention_stopline_idx);
 
-  bool assigned_lane_found = false;
   // crop intersection part of the path, and set the reference velocity to intersection_velocity
   // for ego's ttc
-  PathWithLaneId reference_path;
-  std::optional<size_t> upstream_stopline{std::nullopt};
-  for (size_t i = 0; i + 1 < path.points.size(); ++i) {
-    auto reference_point = path.points.at(i);
-    // assume backward velocity is current ego velocity
-    if (i < closest_idx) {
-      reference_point.point.longitudinal_velocity_mps = current_velocity;
-    }
-    if (
-      i > last_intersection_stopline_candidate_idx &&
-      std::fabs(reference_point.point.longitudinal_velocity_mps) <
-        std::numeric_limits<double>::epsilon() &&
-      !upstream_stopline) {
-      upstream_stopline = i;
-    }
-    if (!use_upstream_velocity) {
-      reference_point.point.longitudinal_velocity_mps = intersection_velocity;
-    }
-    reference_path.points.push_back(reference_point);
-    bool has_objective_lane_id = util::hasLaneIds(path.points.at(i), associative_ids_);
-    if (assigned_lane_found && !has_objective_lane_id) {
-      break;
-    }
-    assigned_lane_found = has_objective_lane_id;
-  }
-  if (!assigned_lane_found) {
+  const auto reference_path_opt = util::generatePassingTimeReferencePath(
+    path, associative_ids_, closest_idx, last_intersection_stopline_candidate_idx, current_velocity,
+    use_upstream_velocity, intersection_velocity);
+  if (!reference_path_opt) {
     return {{0.0, 0.0}};  // has already passed the intersection.
   }
+  const auto & reference_path = reference_path_opt.value().first;
+  const auto & upstream_stopline = reference_path_opt.value().second;
 
   // apply smoother to reference velocity
   PathWithLaneId smoothed_reference_path = reference_path;
@@ -891,12 +870,6 @@ IntersectionModule::TimeDistanceArray IntersectionModule::calcIntersectionPassin
     smoothed_reference_path = reference_path;
   }
 
-  // calculate when ego is going to reach each (interpolated) points on the path
-  TimeDistanceArray time_distance_array{};
-  double dist_sum = 0.0;
-  double passing_time = time_delay;
-  time_distance_array.emplace_back(passing_time, dist_sum);
-
   // NOTE: `reference_path` is resampled in `reference_smoothed_path`, so
   // `last_intersection_stopline_candidate_idx` makes no sense
   const auto smoothed_path_closest_idx =
@@ -916,30 +889,11 @@ IntersectionModule::TimeDistanceArray IntersectionModule::calcIntersectionPassin
     }
   }();
 
-  for (size_t i = smoothed_path_closest_idx; i + 1 < smoothed_reference_path.points.size(); ++i) {
-    const auto & p1 = smoothed_reference_path.points.at(i);
-    const auto & p2 = smoothed_reference_path.points.at(i + 1);
-
-    const double dist = autoware::universe_utils::calcDistance2d(p1, p2);
-    dist_sum += dist;
-
-    // use average velocity between p1 and p2
-    const double average_velocity =
-      (p1.point.longitudinal_velocity_mps + p2.point.longitudinal_velocity_mps) / 2.0;
-    const double passing_velocity = [=]() {
-      if (use_upstream_velocity) {
-        if (upstream_stopline_idx_opt && i > upstream_stopline_idx_opt.value()) {
-          return minimum_upstream_velocity;
-        }
-        return std::max<double>(average_velocity, minimum_ego_velocity);
-      } else {
-        return std::max<double>(average_velocity, minimum_ego_velocity);
-      }
-    }();
-    passing_time += (dist / passing_velocity);
+  // calculate when ego is going to reach each (interpolated) points on the path
+  const auto time_distance_array = util::calcPassingTimeDistanceArray(
+    smoothed_reference_path, smoothed_path_closest_idx, upstream_stopline_idx_opt, time_delay,
+    use_upstream_velocity, minimum_ego_velocity, minimum_upstream_velocity);
 
-    time_distance_array.emplace_back(passing_time, dist_sum);
-  }
   ego_ttc_array->stamp = clock_->now();
   ego_ttc_array->layout.dim.resize(3);
   ego_ttc_array->layout.dim.at(0).label = "lane_id_@[0][0], ttc_time, ttc_dist, path_x, path_y";
@@ -20,6 +20,7 @@
 #include <autoware/behavior_velocity_planner_common/utilization/path_utilization.hpp>
 #include <autoware/behavior_velocity_planner_common/utilization/util.hpp>
 #include <autoware/motion_utils/trajectory/trajectory.hpp>
+#include <autoware/universe_utils/geometry/geometry.hpp>
 #include <autoware_lanelet2_extension/utility/utilities.hpp>
 
 #include <boost/geometry/algorithms/correct.hpp>
@@ -414,4 +415,81 @@ std::vector<lanelet::CompoundPolygon3d> getPolygon3dFromLanelets(
   return polys;
 }
 
+std::optional<std::pair<tier4_planning_msgs::msg::PathWithLaneId, std::optional<size_t>>>
+generatePassingTimeReferencePath(
+  const tier4_planning_msgs::msg::PathWithLaneId & path,
+  const std::set<lanelet::Id> & associative_ids, const size_t closest_idx,
+  const size_t last_stopline_idx, const double current_velocity, const bool use_upstream_velocity,
+  const double intersection_velocity)
+{
+  bool assigned_lane_found = false;
+  tier4_planning_msgs::msg::PathWithLaneId reference_path;
+  std::optional<size_t> upstream_stopline{std::nullopt};
+  for (size_t i = 0; i + 1 < path.points.size(); ++i) {
+    auto reference_point = path.points.at(i);
+    // assume backward velocity is current ego velocity
+    if (i < closest_idx) {
+      reference_point.point.longitudinal_velocity_mps = current_velocity;
+    }
+    if (
+      i > last_stopline_idx &&
+      std::fabs(reference_point.point.longitudinal_velocity_mps) <
+        std::numeric_limits<double>::epsilon() &&
+      !upstream_stopline) {
+      upstream_stopline = i;
+    }
+    if (!use_upstream_velocity) {
+      reference_point.point.longitudinal_velocity_mps = intersection_velocity;
+    }
+    reference_path.points.push_back(reference_point);
+    bool has_objective_lane_id = hasLaneIds(path.points.at(i), associative_ids);
+    if (assigned_lane_found && !has_objective_lane_id) {
+      break;
+    }
+    assigned_lane_found = has_objective_lane_id;
+  }
+  if (!assigned_lane_found) {
+    return std::nullopt;
+  }
+  return std::make_pair(reference_path, upstream_stopline);
+}
+
+std::vector<std::pair<double, double>> calcPassingTimeDistanceArray(
+  const tier4_planning_msgs::msg::PathWithLaneId & smoothed_reference_path, const size_t start_idx,
+  const std::optional<size_t> upstream_stopline_idx, const double time_delay,
+  const bool use_upstream_velocity, const double minimum_ego_velocity,
+  const double minimum_upstream_velocity)
+{
+  std::vector<std::pair<double, double>> time_distance_array{};
+  double dist_sum = 0.0;
+  double passing_time = time_delay;
+  time_distance_array.emplace_back(passing_time, dist_sum);
+
+  for (size_t i = start_idx; i + 1 < smoothed_reference_path.points.size(); ++i) {
+    const auto & p1 = smoothed_reference_path.points.at(i);
+    const auto & p2 = smoothed_reference_path.points.at(i + 1);
+
+    const double dist = autoware::universe_utils::calcDistance2d(p1, p2);
+    dist_sum += dist;
+
+    // use average velocity between p1 and p2
+    const double average_velocity =
+      (p1.point.longitudinal_velocity_mps + p2.point.longitudinal_velocity_mps) / 2.0;
+    const double passing_velocity = [=]() {
+      if (use_upstream_velocity) {
+        if (upstream_stopline_idx && i > upstream_stopline_idx.value()) {
+          return minimum_upstream_velocity;
+        }
+        return std::max<double>(average_velocity, minimum_ego_velocity);
+      } else {
+        return std::max<double>(average_velocity, minimum_ego_velocity);
+      }
+    }();
+    passing_time += (dist / passing_velocity);
+
+    time_distance_array.emplace_back(passing_time, dist_sum);
+  }
+  return time_distance_array;
+}
+
 }  // namespace autoware::behavior_velocity_planner::util
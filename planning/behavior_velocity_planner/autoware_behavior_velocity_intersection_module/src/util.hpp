@@ -149,6 +149,35 @@ getFirstPointInsidePolygonsByFootprint(
 std::vector<lanelet::CompoundPolygon3d> getPolygon3dFromLanelets(
   const lanelet::ConstLanelets & ll_vec);
 
+/**
+ * @brief crop the path until the end of the intersection lanes as the reference path for the
+ * passing time of ego
+ * @param[in] path the input path of the planner, i.e. without the stop points of the other modules
+ * @param[in] closest_idx the velocity of the points behind it is set to current_velocity
+ * @param[in] last_stopline_idx the first zero velocity point after it is the upstream stopline
+ * @param[in] use_upstream_velocity if false, the velocity is set to intersection_velocity
+ * @return null if ego has already passed the intersection. otherwise, the reference path and the
+ * index of the upstream stopline on it
+ */
+std::optional<std::pair<tier4_planning_msgs::msg::PathWithLaneId, std::optional<size_t>>>
+generatePassingTimeReferencePath(
+  const tier4_planning_msgs::msg::PathWithLaneId & path,
+  const std::set<lanelet::Id> & associative_ids, const size_t closest_idx,
+  const size_t last_stopline_idx, const double current_velocity, const bool use_upstream_velocity,
+  const double intersection_velocity);
+
+/**
+ * @brief calculate the sequence of (time of arrival, traveled distance) along the smoothed
+ * reference path from start_idx, using the average velocity of each segment
+ * @param[in] upstream_stopline_idx after it, minimum_upstream_velocity is used if
+ * use_upstream_velocity is true
+ */
+std::vector<std::pair<double, double>> calcPassingTimeDistanceArray(
+  const tier4_planning_msgs::msg::PathWithLaneId & smoothed_reference_path, const size_t start_idx,
+  const std::optional<size_t> upstream_stopline_idx, const double time_delay,
+  const bool use_upstream_velocity, const double minimum_ego_velocity,
+  const double minimum_upstream_velocity);
+
 }  // namespace autoware::behavior_velocity_planner::util
 
 #endif  // UTIL_HPP_
@@ -20,6 +20,8 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+
 TEST(TestUtil, retrievePathsBackward)
 {
   /*
@@ -88,6 +90,74 @@ TEST(TestUtil, retrievePathsBackward)
   }
 }
 
+TEST(TestUtil, passingTimeFromInputPath)
+{
+  // straight path along x axis with 1m interval, the intersection lane is [5, 15)
+  const lanelet::Id intersection_lane_id = 100;
+  tier4_planning_msgs::msg::PathWithLaneId input_path;
+  for (size_t i = 0; i < 20; ++i) {
+    tier4_planning_msgs::msg::PathPointWithLaneId p;
+    p.point.pose.position.x = static_cast<double>(i);
+    p.point.longitudinal_velocity_mps = 10.0;
+    p.lane_ids.push_back(5 <= i && i < 15 ? intersection_lane_id : 1);
+    input_path.points.push_back(p);
+  }
+  const std::set<lanelet::Id> associative_ids{intersection_lane_id};
+  const size_t closest_idx = 2;
+  const size_t last_stopline_idx = 6;
+  const double current_velocity = 5.0;
+  const double minimum_ego_velocity = 1.0;
+  const double minimum_upstream_velocity = 0.01;
+
+  // the path of the serial planning, where a preceding module inserted a stop point at 10
+  auto path_with_upstream_stop = input_path;
+  for (size_t i = 10; i < path_with_upstream_stop.points.size(); ++i) {
+    path_with_upstream_stop.points.at(i).point.longitudinal_velocity_mps = 0.0;
+  }
+
+  const auto reference_path_opt =
+    autoware::behavior_velocity_planner::util::generatePassingTimeReferencePath(
+      input_path, associative_ids, closest_idx, last_stopline_idx, current_velocity, true, 10.0);
+  ASSERT_TRUE(reference_path_opt);
+  const auto & [reference_path, upstream_stopline] = reference_path_opt.value();
+  // cropped at the first point after the intersection lane
+  EXPECT_EQ(reference_path.points.size(), 16);
+  EXPECT_DOUBLE_EQ(reference_path.points.at(0).point.longitudinal_velocity_mps, current_velocity);
+  EXPECT_DOUBLE_EQ(reference_path.points.at(closest_idx).point.longitudinal_velocity_mps, 10.0);
+  // the stop point of the preceding module is not in the input path
+  EXPECT_FALSE(upstream_stopline);
+
+  const auto time_distance_array =
+    autoware::behavior_velocity_planner::util::calcPassingTimeDistanceArray(
+      reference_path, closest_idx, upstream_stopline, 0.0, true, minimum_ego_velocity,
+      minimum_upstream_velocity);
+  EXPECT_EQ(time_distance_array.size(), 14);
+  EXPECT_NEAR(time_distance_array.back().first, 1.3, 1e-6);
+  EXPECT_NEAR(time_distance_array.back().second, 13.0, 1e-6);
+
+  const auto reference_path_with_stop_opt =
+    autoware::behavior_velocity_planner::util::generatePassingTimeReferencePath(
+      path_with_upstream_stop, associative_ids, closest_idx, last_stopline_idx, current_velocity,
+      true, 10.0);
+  ASSERT_TRUE(reference_path_with_stop_opt);
+  const auto & [reference_path_with_stop, upstream_stopline_with_stop] =
+    reference_path_with_stop_opt.value();
+  ASSERT_TRUE(upstream_stopline_with_stop);
+  EXPECT_EQ(upstream_stopline_with_stop.value(), 10);
+
+  // ego is assumed to stay at the upstream stopline, so it passes the intersection much later
+  const auto time_distance_array_with_stop =
+    autoware::behavior_velocity_planner::util::calcPassingTimeDistanceArray(
+      reference_path_with_stop, closest_idx, upstream_stopline_with_stop, 0.0, true,
+      minimum_ego_velocity, minimum_upstream_velocity);
+  EXPECT_NEAR(time_distance_array_with_stop.back().first, 401.9, 1e-6);
+  EXPECT_NEAR(time_distance_array_with_stop.back().second, 13.0, 1e-6);
+
+  // ego has already passed the intersection
+  EXPECT_FALSE(autoware::behavior_velocity_planner::util::generatePassingTimeReferencePath(
+    input_path, {200}, closest_idx, last_stopline_idx, current_velocity, true, 10.0));
+}
+
 /*
   TOOD(Mamoru Sobue): instantiating intersection_module and PlannerData is a messy
 class TestWithMap : public ::testing::Test
@@ -34,6 +34,7 @@
 #include <tf2_eigen/tf2_eigen.hpp>
 #endif
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -122,6 +123,8 @@ BehaviorVelocityPlannerNode::BehaviorVelocityPlannerNode(const rclcpp::NodeOptio
   planner_data_.is_simulation = declare_parameter<bool>("is_simulation");
 
   // Initialize PlannerManager
+  planner_manager_.setDecisionThreadNum(
+    static_cast<size_t>(std::max(declare_parameter<int>("decision_thread_num"), 0)));
   for (const auto & name : declare_parameter<std::vector<std::string>>("launch_modules")) {
     // workaround: Since ROS 2 can't get empty list, launcher set [''] on the parameter.
     if (name == "") {
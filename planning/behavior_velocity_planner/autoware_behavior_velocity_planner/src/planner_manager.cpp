@@ -16,8 +16,12 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
+#include <exception>
+#include <future>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace autoware::behavior_velocity_planner
 {
@@ -108,6 +112,16 @@ tier4_planning_msgs::msg::PathWithLaneId BehaviorVelocityPlannerManager::planPat
 
   for (const auto & plugin : scene_manager_plugins_) {
     plugin->updateSceneModuleInstances(planner_data, input_path_msg);
+  }
+
+  prepareLaneletMap(*planner_data);
+
+  // decision phase of the two-phase planning, which only reads the input path. NOTE: the decisions
+  // see the unmodified input_path_msg, i.e. without the velocity and the stop points inserted by
+  // the other modules, even by the ones registered earlier.
+  decideVelocity(input_path_msg);
+
+  for (const auto & plugin : scene_manager_plugins_) {
     plugin->plan(&output_path_msg);
     const auto firstStopPathPointIndex = plugin->getFirstStopPathPointIndex();
 
@@ -125,6 +139,81 @@ tier4_planning_msgs::msg::PathWithLaneId BehaviorVelocityPlannerManager::planPat
   return output_path_msg;
 }
 
+void BehaviorVelocityPlannerManager::setDecisionThreadNum(const size_t thread_num)
+{
+  decision_thread_num_ = thread_num;
+  // the calling thread makes the decisions of the first thread
+  decision_thread_pool_ = std::make_unique<ThreadPool>(std::max<size_t>(thread_num, 1) - 1);
+}
+
+void BehaviorVelocityPlannerManager::prepareLaneletMap(const PlannerData & planner_data)
+{
+  if (decision_thread_num_ < 2 || !planner_data.route_handler_) {
+    return;
+  }
+  const auto lanelet_map = planner_data.route_handler_->getLaneletMapPtr();
+  if (!lanelet_map || lanelet_map == prepared_lanelet_map_) {
+    return;
+  }
+  // NOTE: the centerline of a lanelet is calculated and cached on its first access, which is not
+  // thread-safe. It is calculated for all the lanelets of a new map here, so that the scene modules
+  // only read it in the parallel decision phase.
+  for (const auto & lanelet : lanelet_map->laneletLayer) {
+    static_cast<void>(lanelet.centerline());
+  }
+  prepared_lanelet_map_ = lanelet_map;
+}
+
+void BehaviorVelocityPlannerManager::decideVelocity(
+  const tier4_planning_msgs::msg::PathWithLaneId & input_path_msg)
+{
+  std::vector<std::shared_ptr<PluginInterface>> two_phase_plugins;
+  for (const auto & plugin : scene_manager_plugins_) {
+    if (plugin->isTwoPhasePlanningSupported()) {
+      two_phase_plugins.push_back(plugin);
+    }
+  }
+
+  // NOTE: each plugin is processed by a single thread since the scene modules of the same plugin
+  // share the manager's resources such as the time keeper.
+  const size_t thread_num =
+    std::min(std::max<size_t>(decision_thread_num_, 1), two_phase_plugins.size());
+  const auto decide = [&](const size_t thread_idx) {
+    for (size_t i = thread_idx; i < two_phase_plugins.size(); i += thread_num) {
+      two_phase_plugins.at(i)->decideVelocity(input_path_msg);
+    }
+  };
+
+  std::vector<std::future<void>> futures;
+  for (size_t thread_idx = 1; thread_idx < thread_num; ++thread_idx) {
+    futures.push_back(
+      decision_thread_pool_->submit([&decide, thread_idx]() { decide(thread_idx); }));
+  }
+
+  // NOTE: the tasks refer to the local variables, so all of them are finished before an exception
+  // is rethrown
+  std::exception_ptr exception;
+  try {
+    if (0 < thread_num) {
+      decide(0);
+    }
+  } catch (...) {
+    exception = std::current_exception();
+  }
+  for (auto & future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      if (!exception) {
+        exception = std::current_exception();
+      }
+    }
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
 diagnostic_msgs::msg::DiagnosticStatus BehaviorVelocityPlannerManager::getStopReasonDiag() const
 {
   return stop_reason_diag_;
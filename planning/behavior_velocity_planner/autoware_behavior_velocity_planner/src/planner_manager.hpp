@@ -15,6 +15,8 @@
 #ifndef PLANNER_MANAGER_HPP_
 #define PLANNER_MANAGER_HPP_
 
+#include "thread_pool.hpp"
+
 #include <autoware/behavior_velocity_planner_common/plugin_interface.hpp>
 #include <autoware/behavior_velocity_planner_common/plugin_wrapper.hpp>
 #include <pluginlib/class_loader.hpp>
@@ -52,10 +54,25 @@ public:
 
   diagnostic_msgs::msg::DiagnosticStatus getStopReasonDiag() const;
 
+  /**
+   * @brief Set the number of threads for the decision phase of the two-phase planning.
+   * @param thread_num the decision is made on the calling thread if it is 0 or 1.
+   */
+  void setDecisionThreadNum(const size_t thread_num);
+
 private:
+  size_t decision_thread_num_{0};
+  // workers of the decision phase except for the calling thread
+  std::unique_ptr<ThreadPool> decision_thread_pool_;
+  // the map whose lazily calculated lanelet attributes are already calculated
+  lanelet::LaneletMapConstPtr prepared_lanelet_map_;
+
   diagnostic_msgs::msg::DiagnosticStatus stop_reason_diag_;
   pluginlib::ClassLoader<PluginInterface> plugin_loader_;
   std::vector<std::shared_ptr<PluginInterface>> scene_manager_plugins_;
+
+  void prepareLaneletMap(const PlannerData & planner_data);
+  void decideVelocity(const tier4_planning_msgs::msg::PathWithLaneId & input_path_msg);
 };
 }  // namespace autoware::behavior_velocity_planner
 
@@ -0,0 +1,65 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THREAD_POOL_HPP_
+#define THREAD_POOL_HPP_
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace autoware::behavior_velocity_planner
+{
+/**
+ * @brief Fixed size pool of worker threads used for the decision phase of the scene modules.
+ *
+ * The workers are kept for the lifetime of the pool, so that no thread is created in a planning
+ * cycle. When the pool has no worker, the task is executed on the calling thread.
+ */
+class ThreadPool
+{
+public:
+  explicit ThreadPool(const size_t num_threads);
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool(ThreadPool &&) = delete;
+  ThreadPool & operator=(const ThreadPool &) = delete;
+  ThreadPool & operator=(ThreadPool &&) = delete;
+  ~ThreadPool();
+
+  /**
+   * @brief Queue a task. The exception thrown by the task is rethrown by the returned future.
+   */
+  std::future<void> submit(std::function<void()> func);
+
+  size_t size() const { return workers_.size(); }
+
+private:
+  void workerLoop();
+
+  std::vector<std::thread> workers_;
+  std::queue<std::packaged_task<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stop_{false};
+};
+}  // namespace autoware::behavior_velocity_planner
+
+#endif  // THREAD_POOL_HPP_
@@ -36,6 +36,8 @@ public:
     const tier4_planning_msgs::msg::PathWithLaneId & path) = 0;
   virtual std::optional<int> getFirstStopPathPointIndex() = 0;
   virtual const char * getModuleName() = 0;
+  virtual bool isTwoPhasePlanningSupported() const = 0;
+  virtual void decideVelocity(const tier4_planning_msgs::msg::PathWithLaneId & path) = 0;
 };
 
 }  // namespace autoware::behavior_velocity_planner
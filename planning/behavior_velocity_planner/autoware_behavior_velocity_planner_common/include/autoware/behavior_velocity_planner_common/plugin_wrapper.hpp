@@ -43,6 +43,14 @@ public:
     return scene_manager_->getFirstStopPathPointIndex();
   }
   const char * getModuleName() override { return scene_manager_->getModuleName(); }
+  bool isTwoPhasePlanningSupported() const override
+  {
+    return scene_manager_->isTwoPhasePlanningSupported();
+  }
+  void decideVelocity(const tier4_planning_msgs::msg::PathWithLaneId & path) override
+  {
+    scene_manager_->decideVelocity(path);
+  }
 
 private:
   std::unique_ptr<T> scene_manager_;
@@ -79,6 +79,17 @@ struct ObjectOfInterest
   }
 };
 
+/**
+ * @brief Velocity request decided in the decision phase of the two-phase planning.
+ * @details The velocity is limited from the point to the end of the path. Zero velocity means a
+ * stop at the point.
+ */
+struct VelocityRequest
+{
+  geometry_msgs::msg::Point point;
+  double velocity{0.0};
+};
+
 class SceneModuleInterface
 {
 public:
@@ -88,6 +99,25 @@ public:
 
   virtual bool modifyPathVelocity(PathWithLaneId * path, StopReason * stop_reason) = 0;
 
+  /**
+   * @brief Decision phase of the two-phase planning, which returns the velocity requests instead of
+   * modifying the path. It is called in parallel with the modules of the other managers, so that it
+   * must not modify anything other than the state of this module. It has to be implemented only if
+   * the manager of this module supports the two-phase planning.
+   */
+  virtual std::vector<VelocityRequest> decideVelocity(
+    [[maybe_unused]] const PathWithLaneId & path, [[maybe_unused]] StopReason * stop_reason)
+  {
+    return {};
+  }
+
+  /**
+   * @brief Apply phase of the two-phase planning, which inserts the velocity requests to the path
+   * and updates the first stop path point index.
+   */
+  void applyVelocityRequests(
+    const std::vector<VelocityRequest> & velocity_requests, PathWithLaneId * path);
+
   virtual visualization_msgs::msg::MarkerArray createDebugMarkerArray() = 0;
   virtual std::vector<autoware::motion_utils::VirtualWall> createVirtualWalls() = 0;
 
@@ -181,7 +211,27 @@ public:
 
   virtual void plan(tier4_planning_msgs::msg::PathWithLaneId * path) { modifyPathVelocity(path); }
 
+  /**
+   * @brief Whether the modules of this manager implement SceneModuleInterface::decideVelocity().
+   * @details If true, the decision of the modules is made by decideVelocity() of this manager,
+   * which may run in parallel with the other managers, and plan() only applies the decided velocity
+   * requests to the path.
+   */
+  virtual bool isTwoPhasePlanningSupported() const { return false; }
+
+  /**
+   * @brief Decision phase of the two-phase planning. It only reads the path and the planner data,
+   * and does not publish anything, so that it can run in parallel with the other managers.
+   */
+  virtual void decideVelocity(const tier4_planning_msgs::msg::PathWithLaneId & path);
+
 protected:
+  struct SceneModuleDecision
+  {
+    StopReason stop_reason;
+    std::vector<VelocityRequest> velocity_requests;
+  };
+
   virtual void modifyPathVelocity(tier4_planning_msgs::msg::PathWithLaneId * path);
 
   virtual void launchNewModules(const tier4_planning_msgs::msg::PathWithLaneId & path) = 0;
@@ -210,6 +260,9 @@ protected:
   autoware::motion_utils::VirtualWallMarkerCreator virtual_wall_marker_creator_;
 
   std::optional<int> first_stop_path_point_index_;
+  // decisions of the scene modules for the two-phase planning, whose key is the module ID
+  std::unordered_map<int64_t, SceneModuleDecision> scene_module_decisions_;
+  bool is_decided_{false};
   rclcpp::Node & node_;
   rclcpp::Clock::SharedPtr clock_;
   // Debug
@@ -239,6 +292,8 @@ public:
 
   void plan(tier4_planning_msgs::msg::PathWithLaneId * path) override;
 
+  void decideVelocity(const tier4_planning_msgs::msg::PathWithLaneId & path) override;
+
 protected:
   RTCInterface rtc_interface_;
   std::unordered_map<int64_t, UUID> map_uuid_;
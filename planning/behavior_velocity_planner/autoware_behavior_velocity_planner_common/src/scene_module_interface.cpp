@@ -22,6 +22,8 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace autoware::behavior_velocity_planner
 {
@@ -48,6 +50,28 @@ size_t SceneModuleInterface::findEgoSegmentIndex(
     points, p->current_odometry->pose, p->ego_nearest_dist_threshold);
 }
 
+void SceneModuleInterface::applyVelocityRequests(
+  const std::vector<VelocityRequest> & velocity_requests, PathWithLaneId * path)
+{
+  first_stop_path_point_index_ = static_cast<int>(path->points.size()) - 1;
+  for (const auto & velocity_request : velocity_requests) {
+    constexpr double stop_velocity = 1e-3;
+    if (stop_velocity < velocity_request.velocity) {
+      planning_utils::insertDecelPoint(
+        velocity_request.point, *path, static_cast<float>(velocity_request.velocity));
+      continue;
+    }
+
+    const auto stop_pose = planning_utils::insertStopPoint(velocity_request.point, *path);
+    if (!stop_pose) {
+      continue;
+    }
+    const auto stop_idx = static_cast<int>(
+      autoware::motion_utils::findNearestIndex(path->points, stop_pose->position));
+    first_stop_path_point_index_ = std::min(*first_stop_path_point_index_, stop_idx);
+  }
+}
+
 SceneModuleManagerInterface::SceneModuleManagerInterface(
   rclcpp::Node & node, [[maybe_unused]] const char * module_name)
 : node_(node), clock_(node.get_clock()), logger_(node.get_logger())
@@ -117,12 +141,25 @@ void SceneModuleManagerInterface::modifyPathVelocity(
   tier4_v2x_msgs::msg::InfrastructureCommandArray infrastructure_command_array;
   infrastructure_command_array.stamp = clock_->now();
 
+  if (isTwoPhasePlanningSupported() && !is_decided_) {
+    decideVelocity(*path);
+  }
+
   first_stop_path_point_index_ = static_cast<int>(path->points.size()) - 1;
   for (const auto & scene_module : scene_modules_) {
     tier4_planning_msgs::msg::StopReason stop_reason;
-    scene_module->resetVelocityFactor();
-    scene_module->setPlannerData(planner_data_);
-    scene_module->modifyPathVelocity(path, &stop_reason);
+    if (isTwoPhasePlanningSupported()) {
+      // the decision has already been made in decideVelocity()
+      const auto decision = scene_module_decisions_.find(scene_module->getModuleId());
+      if (decision != scene_module_decisions_.end()) {
+        stop_reason = decision->second.stop_reason;
+        scene_module->applyVelocityRequests(decision->second.velocity_requests, path);
+      }
+    } else {
+      scene_module->resetVelocityFactor();
+      scene_module->setPlannerData(planner_data_);
+      scene_module->modifyPathVelocity(path, &stop_reason);
+    }
 
     // The velocity factor must be called after modifyPathVelocity.
     const auto velocity_factor = scene_module->getVelocityFactor();
@@ -163,6 +200,25 @@ void SceneModuleManagerInterface::modifyPathVelocity(
   pub_virtual_wall_->publish(virtual_wall_marker_creator_.create_markers(clock_->now()));
   processing_time_publisher_->publish<Float64Stamped>(
     std::string(getModuleName()) + "/processing_time_ms", stop_watch.toc("Total"));
+
+  scene_module_decisions_.clear();
+  is_decided_ = false;
+}
+
+void SceneModuleManagerInterface::decideVelocity(
+  const tier4_planning_msgs::msg::PathWithLaneId & path)
+{
+  universe_utils::ScopedTimeTrack st("SceneModuleManagerInterface::decideVelocity", *time_keeper_);
+
+  scene_module_decisions_.clear();
+  for (const auto & scene_module : scene_modules_) {
+    SceneModuleDecision decision;
+    scene_module->resetVelocityFactor();
+    scene_module->setPlannerData(planner_data_);
+    decision.velocity_requests = scene_module->decideVelocity(path, &decision.stop_reason);
+    scene_module_decisions_.emplace(scene_module->getModuleId(), std::move(decision));
+  }
+  is_decided_ = true;
 }
 
 void SceneModuleManagerInterface::deleteExpiredModules(
@@ -211,12 +267,22 @@ SceneModuleManagerInterfaceWithRTC::SceneModuleManagerInterfaceWithRTC(
 
 void SceneModuleManagerInterfaceWithRTC::plan(tier4_planning_msgs::msg::PathWithLaneId * path)
 {
-  setActivation();
+  // NOTE: the activation is set in decideVelocity() for the two-phase planning
+  if (!isTwoPhasePlanningSupported()) {
+    setActivation();
+  }
   modifyPathVelocity(path);
   sendRTC(path->header.stamp);
   publishObjectsOfInterestMarker();
 }
 
+void SceneModuleManagerInterfaceWithRTC::decideVelocity(
+  const tier4_planning_msgs::msg::PathWithLaneId & path)
+{
+  setActivation();
+  SceneModuleManagerInterface::decideVelocity(path);
+}
+
 void SceneModuleManagerInterfaceWithRTC::sendRTC(const Time & stamp)
 {
   for (const auto & scene_module : scene_modules_) {
@@ -41,6 +41,8 @@ public:
 
   const char * getModuleName() override { return "stop_line"; }
 
+  bool isTwoPhasePlanningSupported() const override { return true; }
+
 private:
   StopLineModule::PlannerParam planner_param_;
 
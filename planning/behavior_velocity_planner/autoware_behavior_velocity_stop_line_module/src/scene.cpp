@@ -41,29 +41,38 @@ StopLineModule::StopLineModule(
 }
 
 bool StopLineModule::modifyPathVelocity(PathWithLaneId * path, StopReason * stop_reason)
+{
+  const auto velocity_requests = decideVelocity(*path, stop_reason);
+  applyVelocityRequests(velocity_requests, path);
+  return true;
+}
+
+std::vector<VelocityRequest> StopLineModule::decideVelocity(
+  const PathWithLaneId & path, StopReason * stop_reason)
 {
   universe_utils::ScopedTimeTrack st(
     std::string(__func__) + " (lane_id:=" + std::to_string(module_id_) + ")", *getTimeKeeper());
   debug_data_ = DebugData();
-  if (path->points.empty()) return true;
+  if (path.points.empty()) return {};
   const auto base_link2front = planner_data_->vehicle_info_.max_longitudinal_offset_m;
   debug_data_.base_link2front = base_link2front;
-  first_stop_path_point_index_ = static_cast<int>(path->points.size()) - 1;
   *stop_reason = planning_utils::initializeStopReason(StopReason::STOP_LINE);
 
+  std::vector<VelocityRequest> velocity_requests;
+
   const LineString2d stop_line = planning_utils::extendLine(
     stop_line_[0], stop_line_[1], planner_data_->stop_line_extend_length);
 
   time_keeper_->start_track("createTargetPoint");
   // Calculate stop pose and insert index
   const auto stop_point = arc_lane_utils::createTargetPoint(
-    *path, stop_line, planner_param_.stop_margin,
+    path, stop_line, planner_param_.stop_margin,
     planner_data_->vehicle_info_.max_longitudinal_offset_m);
   time_keeper_->end_track("createTargetPoint");
   // If no collision found, do nothing
   if (!stop_point) {
     RCLCPP_DEBUG_THROTTLE(logger_, *clock_, 5000 /* ms */, "is no collision");
-    return true;
+    return {};
   }
 
   const auto stop_point_idx = stop_point->first;
@@ -78,20 +87,17 @@ bool StopLineModule::modifyPathVelocity(PathWithLaneId * path, StopReason * stop
   time_keeper_->start_track(
     "calcSegmentIndexFromPointIndex & findEgoSegmentIndex & calcSignedArcLength");
   const size_t stop_line_seg_idx = planning_utils::calcSegmentIndexFromPointIndex(
-    path->points, stop_pose.position, stop_point_idx);
-  const size_t current_seg_idx = findEgoSegmentIndex(path->points);
+    path.points, stop_pose.position, stop_point_idx);
+  const size_t current_seg_idx = findEgoSegmentIndex(path.points);
   const double signed_arc_dist_to_stop_point = autoware::motion_utils::calcSignedArcLength(
-    path->points, planner_data_->current_odometry->pose.position, current_seg_idx,
+    path.points, planner_data_->current_odometry->pose.position, current_seg_idx,
     stop_pose.position, stop_line_seg_idx);
   time_keeper_->end_track(
     "calcSegmentIndexFromPointIndex & findEgoSegmentIndex & calcSignedArcLength");
   switch (state_) {
     case State::APPROACH: {
       // Insert stop pose
-      planning_utils::insertStopPoint(stop_pose.position, stop_line_seg_idx, *path);
-
-      // Update first stop index
-      first_stop_path_point_index_ = static_cast<int>(stop_point_idx);
+      velocity_requests.push_back(VelocityRequest{stop_pose.position, 0.0});
       debug_data_.stop_pose = stop_pose;
 
       // Get stop point and stop factor
@@ -101,7 +107,7 @@ bool StopLineModule::modifyPathVelocity(PathWithLaneId * path, StopReason * stop
         stop_factor.stop_factor_points.push_back(getCenterOfStopLine(stop_line_));
         planning_utils::appendStopReason(stop_factor, stop_reason);
         velocity_factor_.set(
-          path->points, planner_data_->current_odometry->pose, stop_pose,
+          path.points, planner_data_->current_odometry->pose, stop_pose,
           VelocityFactor::APPROACHING);
       }
 
@@ -126,7 +132,7 @@ bool StopLineModule::modifyPathVelocity(PathWithLaneId * path, StopReason * stop
     case State::STOPPED: {
       // Change state after vehicle departure
       const auto stopped_pose = autoware::motion_utils::calcLongitudinalOffsetPose(
-        path->points, planner_data_->current_odometry->pose.position, 0.0);
+        path.points, planner_data_->current_odometry->pose.position, 0.0);
 
       if (!stopped_pose) {
         break;
@@ -134,10 +140,10 @@ bool StopLineModule::modifyPathVelocity(PathWithLaneId * path, StopReason * stop
 
       SegmentIndexWithPose ego_pos_on_path;
       ego_pos_on_path.pose = stopped_pose.value();
-      ego_pos_on_path.index = findEgoSegmentIndex(path->points);
+      ego_pos_on_path.index = findEgoSegmentIndex(path.points);
 
       // Insert stop pose
-      planning_utils::insertStopPoint(ego_pos_on_path.pose.position, ego_pos_on_path.index, *path);
+      velocity_requests.push_back(VelocityRequest{ego_pos_on_path.pose.position, 0.0});
 
       debug_data_.stop_pose = stop_pose;
 
@@ -148,7 +154,7 @@ bool StopLineModule::modifyPathVelocity(PathWithLaneId * path, StopReason * stop
         stop_factor.stop_factor_points.push_back(getCenterOfStopLine(stop_line_));
         planning_utils::appendStopReason(stop_factor, stop_reason);
         velocity_factor_.set(
-          path->points, planner_data_->current_odometry->pose, stop_pose, VelocityFactor::STOPPED);
+          path.points, planner_data_->current_odometry->pose, stop_pose, VelocityFactor::STOPPED);
       }
 
       const auto elapsed_time = (clock_->now() - *stopped_time_).seconds();
@@ -174,7 +180,7 @@ bool StopLineModule::modifyPathVelocity(PathWithLaneId * path, StopReason * stop
     }
   }
 
-  return true;
+  return velocity_requests;
 }
 
 geometry_msgs::msg::Point StopLineModule::getCenterOfStopLine(
@@ -14,7 +14,7 @@
 
 #include "occupancy_grid_utils.hpp"
 
-#include <autoware_grid_map_utils/polygon_iterator.hpp>
+#include <autoware_grid_map_utils/polygon_rasterizer.hpp>
 #include <grid_map_core/Polygon.hpp>
 #include <grid_map_core/iterators/GridMapIterator.hpp>
 #include <grid_map_cv/GridMapCvConverter.hpp>
@@ -22,6 +22,8 @@
 #include <opencv2/imgproc.hpp>
 #include <opencv2/opencv.hpp>
 
+#include <vector>
+
 namespace autoware::motion_velocity_planner::obstacle_velocity_limiter
 {
 void maskPolygons(grid_map::GridMap & grid_map, const ObstacleMasks & obstacle_masks)
@@ -33,21 +35,24 @@ void maskPolygons(grid_map::GridMap & grid_map, const ObstacleMasks & obstacle_m
   };
 
   auto & layer = grid_map["layer"];
+  std::vector<autoware::grid_map_utils::Span> spans;
 
   if (!obstacle_masks.positive_mask.outer().empty()) {
     const auto layer_copy = grid_map["layer"];
     layer.setConstant(0.0);
-    grid_map::Position position;
-    for (autoware::grid_map_utils::PolygonIterator iterator(
-           grid_map, convert(obstacle_masks.positive_mask));
-         !iterator.isPastEnd(); ++iterator)
-      layer((*iterator)(0), (*iterator)(1)) = layer_copy((*iterator)(0), (*iterator)(1));
+    autoware::grid_map_utils::rasterizePolygon(
+      grid_map, convert(obstacle_masks.positive_mask), spans);
+    for (const auto & span : spans) {
+      const auto nb_cols = span.col_end - span.col_begin;
+      layer.row(span.row).segment(span.col_begin, nb_cols) =
+        layer_copy.row(span.row).segment(span.col_begin, nb_cols);
+    }
   }
 
-  for (const auto & negative_mask : obstacle_masks.negative_masks)
-    for (autoware::grid_map_utils::PolygonIterator iterator(grid_map, convert(negative_mask));
-         !iterator.isPastEnd(); ++iterator)
-      layer((*iterator)(0), (*iterator)(1)) = 0.0;
+  for (const auto & negative_mask : obstacle_masks.negative_masks) {
+    autoware::grid_map_utils::rasterizePolygon(grid_map, convert(negative_mask), spans);
+    autoware::grid_map_utils::setValue(layer, spans, 0.0);
+  }
 }
 
 void threshold(grid_map::GridMap & grid_map, const double threshold)
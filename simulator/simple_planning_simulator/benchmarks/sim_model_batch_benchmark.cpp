@@ -0,0 +1,144 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ament_index_cpp/get_package_share_directory.hpp"
+#include "simple_planning_simulator/vehicle_model/sim_model.hpp"
+#include "simple_planning_simulator/vehicle_model/sim_model_batch.hpp"
+#include "simple_planning_simulator/vehicle_model/sim_model_delay_steer_acc_geared_batch.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// same parameters as simple_planning_simulator_default.param.yaml
+constexpr double dt = 0.02;
+constexpr double vel_lim = 50.0;
+constexpr double steer_lim = 1.0;
+constexpr double vel_rate_lim = 7.0;
+constexpr double steer_rate_lim = 5.0;
+constexpr double wheelbase = 4.0;
+constexpr double acc_time_delay = 0.1;
+constexpr double acc_time_constant = 0.1;
+constexpr double vel_time_delay = 0.1;
+constexpr double vel_time_constant = 0.1;
+constexpr double steer_time_delay = 0.24;
+constexpr double steer_time_constant = 0.27;
+constexpr double steer_dead_band = 0.0;
+constexpr double steer_bias = 0.0;
+}  // namespace
+
+// Print the throughput of each vehicle model stepped by the batch rollout, in simulated seconds
+// per wall second.
+int main(int argc, char * argv[])
+{
+  size_t num_instances = 1000;
+  size_t num_steps = 500;
+  size_t num_threads = 0;
+  if (argc > 1) num_instances = std::stoul(argv[1]);
+  if (argc > 2) num_steps = std::stoul(argv[2]);
+  if (argc > 3) num_threads = std::stoul(argv[3]);
+  std::cout << "instances: " << num_instances << ", steps: " << num_steps
+            << ", threads: " << num_threads << " (0 means the number of hardware threads)"
+            << std::endl;
+
+  const std::string share_dir =
+    ament_index_cpp::get_package_share_directory("simple_planning_simulator");
+  const std::string acceleration_map_path = share_dir + "/param/acceleration_map.csv";
+  const std::string actuation_map_dir = share_dir + "/test/actuation_cmd_map/";
+
+  const std::vector<std::pair<std::string, SimModelBatch::ModelFactory>> factories{
+    {"IDEAL_STEER_VEL", [] { return std::make_shared<SimModelIdealSteerVel>(wheelbase); }},
+    {"IDEAL_STEER_ACC", [] { return std::make_shared<SimModelIdealSteerAcc>(wheelbase); }},
+    {"IDEAL_STEER_ACC_GEARED",
+     [] { return std::make_shared<SimModelIdealSteerAccGeared>(wheelbase); }},
+    {"DELAY_STEER_VEL",
+     [] {
+       return std::make_shared<SimModelDelaySteerVel>(
+         vel_lim, steer_lim, vel_rate_lim, steer_rate_lim, wheelbase, dt, vel_time_delay,
+         vel_time_constant, steer_time_delay, steer_time_constant, steer_dead_band, steer_bias);
+     }},
+    {"DELAY_STEER_ACC",
+     [] {
+       return std::make_shared<SimModelDelaySteerAcc>(
+         vel_lim, steer_lim, vel_rate_lim, steer_rate_lim, wheelbase, dt, acc_time_delay,
+         acc_time_constant, steer_time_delay, steer_time_constant, steer_dead_band, steer_bias,
+         1.0, 1.0);
+     }},
+    {"DELAY_STEER_ACC_GEARED",
+     [] {
+       return std::make_shared<SimModelDelaySteerAccGeared>(
+         vel_lim, steer_lim, vel_rate_lim, steer_rate_lim, wheelbase, dt, acc_time_delay,
+         acc_time_constant, steer_time_delay, steer_time_constant, steer_dead_band, steer_bias,
+         1.0, 1.0);
+     }},
+    {"DELAY_STEER_ACC_GEARED_WO_FALL_GUARD",
+     [] {
+       return std::make_shared<SimModelDelaySteerAccGearedWoFallGuard>(
+         vel_lim, steer_lim, vel_rate_lim, steer_rate_lim, wheelbase, dt, acc_time_delay,
+         acc_time_constant, steer_time_delay, steer_time_constant, steer_dead_band, steer_bias,
+         1.0, 1.0);
+     }},
+    {"DELAY_STEER_MAP_ACC_GEARED",
+     [&] {
+       return std::make_shared<SimModelDelaySteerMapAccGeared>(
+         vel_lim, steer_lim, vel_rate_lim, steer_rate_lim, wheelbase, dt, acc_time_delay,
+         acc_time_constant, steer_time_delay, steer_time_constant, steer_bias,
+         acceleration_map_path);
+     }},
+    {"ACTUATION_CMD",
+     [&] {
+       return std::make_shared<SimModelActuationCmd>(
+         vel_lim, steer_lim, vel_rate_lim, steer_rate_lim, wheelbase, dt, acc_time_delay,
+         acc_time_constant, acc_time_delay, acc_time_constant, steer_time_delay,
+         steer_time_constant, steer_bias, true, true, true, actuation_map_dir + "accel_map.csv",
+         actuation_map_dir + "brake_map.csv", actuation_map_dir + "steer_map.csv");
+     }},
+  };
+
+  const auto print_throughput = [&](const std::string & name, const auto & update) {
+    const auto start = std::chrono::steady_clock::now();
+    update();
+    const double wall_time =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double simulated_time = static_cast<double>(num_instances * num_steps) * dt;
+    std::cout << name << ": " << simulated_time / wall_time << " simulated s / wall s"
+              << std::endl;
+  };
+
+  for (const auto & [name, factory] : factories) {
+    SimModelBatch batch(num_instances, factory, num_threads);
+    Eigen::VectorXd input = Eigen::VectorXd::Zero(batch.at(0).getDimU());
+    input(0) = 1.0;
+    for (size_t i = 0; i < num_instances; ++i) {
+      batch.at(i).setInput(input);
+    }
+    print_throughput(name, [&] { batch.update(dt, num_steps); });
+  }
+
+  SimModelDelaySteerAccGearedBatch soa_batch(
+    num_instances, vel_lim, steer_lim, vel_rate_lim, steer_rate_lim, wheelbase, dt, acc_time_delay,
+    acc_time_constant, steer_time_delay, steer_time_constant, steer_dead_band, steer_bias, 1.0, 1.0,
+    num_threads);
+  for (size_t i = 0; i < num_instances; ++i) {
+    soa_batch.setInput(i, 1.0, 0.1);
+  }
+  print_throughput("DELAY_STEER_ACC_GEARED (SoA)", [&] { soa_batch.update(dt, num_steps); });
+
+  return 0;
+}
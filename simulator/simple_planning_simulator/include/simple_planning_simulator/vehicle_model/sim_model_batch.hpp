@@ -0,0 +1,81 @@
+// Copyright 2024 The Autoware Foundation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_BATCH_HPP_
+#define SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_BATCH_HPP_
+
+#include "simple_planning_simulator/vehicle_model/sim_model_interface.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @class SimModelBatch
+ * @brief headless engine to step many instances of any vehicle model in lockstep
+ *
+ * The instances are independent of each other, so that each thread steps its own instances for
+ * all the steps without synchronization. This works with every SimModelInterface, while
+ * SimModelDelaySteerAccGearedBatch is faster for the model it supports.
+ */
+class SimModelBatch
+{
+public:
+  using ModelFactory = std::function<std::shared_ptr<SimModelInterface>()>;
+
+  /**
+   * @brief constructor
+   * @param [in] num_instances number of vehicle model instances
+   * @param [in] factory function to create a vehicle model instance
+   * @param [in] num_threads number of threads (0 means the number of hardware threads)
+   */
+  SimModelBatch(const size_t num_instances, const ModelFactory & factory, size_t num_threads = 0);
+
+  /**
+   * @brief get number of instances
+   */
+  size_t size() const { return models_.size(); }
+
+  /**
+   * @brief get vehicle model instance to set input and gear or to get state
+   * @param [in] index index of instance
+   */
+  SimModelInterface & at(const size_t index) { return *models_.at(index); }
+
+  /**
+   * @brief update all the instances with the current inputs
+   * @param [in] dt delta time [s]
+   * @param [in] num_steps number of steps
+   */
+  void update(const double dt, const size_t num_steps);
+
+private:
+  friend class SimModelDelaySteerAccGearedBatch;
+
+  std::vector<std::shared_ptr<SimModelInterface>> models_;
+  const size_t num_threads_;
+
+  /**
+   * @brief split [0, size) into contiguous ranges and run func(begin, end) for each range in
+   * parallel
+   * @param [in] size number of elements
+   * @param [in] num_threads number of threads (0 means the number of hardware threads)
+   * @param [in] func function to process the range [begin, end)
+   */
+  static void runInParallel(
+    const size_t size, const size_t num_threads,
+    const std::function<void(const size_t, const size_t)> & func);
+};
+
+#endif  // SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_BATCH_HPP_
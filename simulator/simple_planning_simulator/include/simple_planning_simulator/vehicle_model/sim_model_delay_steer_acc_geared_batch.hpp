@@ -0,0 +1,152 @@
+// Copyright 2024 The Autoware Foundation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_DELAY_STEER_ACC_GEARED_BATCH_HPP_
+#define SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_DELAY_STEER_ACC_GEARED_BATCH_HPP_
+
+#include <Eigen/Core>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class SimModelDelaySteerAccGearedBatch
+ * @brief many instances of SimModelDelaySteerAccGeared stepped in lockstep
+ *
+ * The states are stored as a structure of arrays with a fixed number of state variables, so that
+ * the same operation is applied to contiguous memory across the instances and can be vectorized
+ * by the compiler. The delay buffers are ring buffers sharing the head index since all the
+ * instances are stepped together. The instances are split among threads.
+ * The result is the same as stepping each SimModelDelaySteerAccGeared with the same parameters.
+ */
+class SimModelDelaySteerAccGearedBatch
+{
+public:
+  using State = Eigen::Matrix<double, 6, 1>;
+
+  /**
+   * @brief constructor
+   * @param [in] num_instances number of vehicle model instances
+   * @param [in] vx_lim velocity limit [m/s]
+   * @param [in] steer_lim steering limit [rad]
+   * @param [in] vx_rate_lim acceleration limit [m/ss]
+   * @param [in] steer_rate_lim steering angular velocity limit [rad/ss]
+   * @param [in] wheelbase vehicle wheelbase length [m]
+   * @param [in] dt delta time information to set input buffer for delay
+   * @param [in] acc_delay time delay for accel command [s]
+   * @param [in] acc_time_constant time constant for 1D model of accel dynamics
+   * @param [in] steer_delay time delay for steering command [s]
+   * @param [in] steer_time_constant time constant for 1D model of steering dynamics
+   * @param [in] steer_dead_band dead band for steering angle [rad]
+   * @param [in] steer_bias steering bias [rad]
+   * @param [in] debug_acc_scaling_factor scaling factor for accel command
+   * @param [in] debug_steer_scaling_factor scaling factor for steering command
+   * @param [in] num_threads number of threads (0 means the number of hardware threads)
+   */
+  SimModelDelaySteerAccGearedBatch(
+    size_t num_instances, double vx_lim, double steer_lim, double vx_rate_lim,
+    double steer_rate_lim, double wheelbase, double dt, double acc_delay, double acc_time_constant,
+    double steer_delay, double steer_time_constant, double steer_dead_band, double steer_bias,
+    double debug_acc_scaling_factor, double debug_steer_scaling_factor, size_t num_threads = 0);
+
+  /**
+   * @brief get number of instances
+   */
+  size_t size() const { return num_instances_; }
+
+  /**
+   * @brief get state vector of instance
+   * @param [in] index index of instance
+   */
+  State getState(const size_t index) const;
+
+  /**
+   * @brief set state vector of instance
+   * @param [in] index index of instance
+   * @param [in] state state vector (x, y, yaw, vx, steer, accx)
+   */
+  void setState(const size_t index, const State & state);
+
+  /**
+   * @brief set input of instance
+   * @param [in] index index of instance
+   * @param [in] acc_des desired acceleration [m/ss]
+   * @param [in] steer_des desired steering angle [rad]
+   */
+  void setInput(const size_t index, const double acc_des, const double steer_des);
+
+  /**
+   * @brief set gear of instance
+   * @param [in] index index of instance
+   * @param [in] gear gear command defined in autoware_vehicle_msgs/GearCommand
+   */
+  void setGear(const size_t index, const uint8_t gear);
+
+  /**
+   * @brief update all the instances with the current inputs
+   * @param [in] dt delta time [s]
+   * @param [in] num_steps number of steps
+   */
+  void update(const double dt, const size_t num_steps);
+
+private:
+  enum IDX {
+    X = 0,
+    Y,
+    YAW,
+    VX,
+    STEER,
+    ACCX,
+  };
+  static constexpr size_t dim_x = 6;
+
+  //!< @brief allowed direction of velocity for the gear: 1 forward, -1 backward, 0 stop
+  enum class GearDirection : int8_t { BACKWARD = -1, STOP = 0, FORWARD = 1 };
+
+  const size_t num_instances_;
+  const size_t num_threads_;
+
+  const double vx_lim_;                      //!< @brief velocity limit [m/s]
+  const double vx_rate_lim_;                 //!< @brief acceleration limit [m/ss]
+  const double steer_lim_;                   //!< @brief steering limit [rad]
+  const double steer_rate_lim_;              //!< @brief steering angular velocity limit [rad/s]
+  const double wheelbase_;                   //!< @brief vehicle wheelbase length [m]
+  const double acc_time_constant_;           //!< @brief time constant for accel dynamics
+  const double steer_time_constant_;         //!< @brief time constant for steering dynamics
+  const double steer_dead_band_;             //!< @brief dead band for steering angle [rad]
+  const double steer_bias_;                  //!< @brief steering angle bias [rad]
+  const double debug_acc_scaling_factor_;    //!< @brief scaling factor for accel command
+  const double debug_steer_scaling_factor_;  //!< @brief scaling factor for steering command
+
+  std::array<std::vector<double>, dim_x> state_;  //!< @brief state variables of all instances
+  std::vector<double> acc_des_;                   //!< @brief accel command of all instances
+  std::vector<double> steer_des_;                 //!< @brief steering command of all instances
+  std::vector<GearDirection> gear_direction_;     //!< @brief gear of all instances
+
+  //!< @brief delay buffers of [queue size][num instances]
+  std::vector<double> acc_input_queue_;
+  std::vector<double> steer_input_queue_;
+  size_t acc_input_queue_size_;
+  size_t steer_input_queue_size_;
+  size_t acc_input_queue_head_{0};
+  size_t steer_input_queue_head_{0};
+
+  /**
+   * @brief update instances in [begin, end)
+   */
+  void updateRange(const size_t begin, const size_t end, const double dt, const size_t num_steps);
+};
+
+#endif  // SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_DELAY_STEER_ACC_GEARED_BATCH_HPP_
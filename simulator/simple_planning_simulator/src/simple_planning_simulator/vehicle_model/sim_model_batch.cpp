@@ -0,0 +1,69 @@
+// Copyright 2024 The Autoware Foundation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "simple_planning_simulator/vehicle_model/sim_model_batch.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+void SimModelBatch::runInParallel(
+  const size_t size, const size_t num_threads,
+  const std::function<void(const size_t, const size_t)> & func)
+{
+  const size_t hardware_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  const size_t threads = std::min(num_threads == 0 ? hardware_threads : num_threads, size);
+  if (threads <= 1) {
+    func(0, size);
+    return;
+  }
+
+  // the calling thread processes the last range
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  const size_t chunk_size = (size + threads - 1) / threads;
+  for (size_t begin = 0; begin < size; begin += chunk_size) {
+    const size_t end = std::min(begin + chunk_size, size);
+    if (end == size) {
+      func(begin, end);
+    } else {
+      workers.emplace_back(func, begin, end);
+    }
+  }
+  for (auto & worker : workers) {
+    worker.join();
+  }
+}
+
+SimModelBatch::SimModelBatch(
+  const size_t num_instances, const ModelFactory & factory, size_t num_threads)
+: num_threads_(num_threads)
+{
+  models_.reserve(num_instances);
+  for (size_t i = 0; i < num_instances; ++i) {
+    models_.push_back(factory());
+  }
+}
+
+void SimModelBatch::update(const double dt, const size_t num_steps)
+{
+  // step each instance for all the steps at once to keep its state in the cache
+  runInParallel(models_.size(), num_threads_, [&](const size_t begin, const size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      for (size_t step = 0; step < num_steps; ++step) {
+        models_[i]->update(dt);
+      }
+    }
+  });
+}
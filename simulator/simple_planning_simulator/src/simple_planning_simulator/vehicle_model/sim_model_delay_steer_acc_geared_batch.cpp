@@ -0,0 +1,223 @@
+// Copyright 2024 The Autoware Foundation.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "simple_planning_simulator/vehicle_model/sim_model_delay_steer_acc_geared_batch.hpp"
+
+#include "autoware_vehicle_msgs/msg/gear_command.hpp"
+#include "simple_planning_simulator/vehicle_model/sim_model_batch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+constexpr double MIN_TIME_CONSTANT = 0.03;  // same as SimModelDelaySteerAccGeared
+
+inline double sat(const double val, const double u, const double l)
+{
+  return std::max(std::min(val, u), l);
+}
+}  // namespace
+
+SimModelDelaySteerAccGearedBatch::SimModelDelaySteerAccGearedBatch(
+  size_t num_instances, double vx_lim, double steer_lim, double vx_rate_lim,
+  double steer_rate_lim, double wheelbase, double dt, double acc_delay, double acc_time_constant,
+  double steer_delay, double steer_time_constant, double steer_dead_band, double steer_bias,
+  double debug_acc_scaling_factor, double debug_steer_scaling_factor, size_t num_threads)
+: num_instances_(num_instances),
+  num_threads_(num_threads),
+  vx_lim_(vx_lim),
+  vx_rate_lim_(vx_rate_lim),
+  steer_lim_(steer_lim),
+  steer_rate_lim_(steer_rate_lim),
+  wheelbase_(wheelbase),
+  acc_time_constant_(std::max(acc_time_constant, MIN_TIME_CONSTANT)),
+  steer_time_constant_(std::max(steer_time_constant, MIN_TIME_CONSTANT)),
+  steer_dead_band_(steer_dead_band),
+  steer_bias_(steer_bias),
+  debug_acc_scaling_factor_(std::max(debug_acc_scaling_factor, 0.0)),
+  debug_steer_scaling_factor_(std::max(debug_steer_scaling_factor, 0.0)),
+  acc_input_queue_size_(static_cast<size_t>(std::round(acc_delay / dt))),
+  steer_input_queue_size_(static_cast<size_t>(std::round(steer_delay / dt)))
+{
+  for (auto & state : state_) {
+    state.assign(num_instances_, 0.0);
+  }
+  acc_des_.assign(num_instances_, 0.0);
+  steer_des_.assign(num_instances_, 0.0);
+  gear_direction_.assign(num_instances_, GearDirection::FORWARD);
+  acc_input_queue_.assign(acc_input_queue_size_ * num_instances_, 0.0);
+  steer_input_queue_.assign(steer_input_queue_size_ * num_instances_, 0.0);
+}
+
+SimModelDelaySteerAccGearedBatch::State SimModelDelaySteerAccGearedBatch::getState(
+  const size_t index) const
+{
+  State state;
+  for (size_t j = 0; j < dim_x; ++j) {
+    state(j) = state_[j].at(index);
+  }
+  return state;
+}
+
+void SimModelDelaySteerAccGearedBatch::setState(const size_t index, const State & state)
+{
+  for (size_t j = 0; j < dim_x; ++j) {
+    state_[j].at(index) = state(j);
+  }
+}
+
+void SimModelDelaySteerAccGearedBatch::setInput(
+  const size_t index, const double acc_des, const double steer_des)
+{
+  acc_des_.at(index) = acc_des;
+  steer_des_.at(index) = steer_des;
+}
+
+void SimModelDelaySteerAccGearedBatch::setGear(const size_t index, const uint8_t gear)
+{
+  using autoware_vehicle_msgs::msg::GearCommand;
+  GearDirection direction = GearDirection::STOP;  // including 'gear == GearCommand::PARK'
+  if (
+    gear == GearCommand::DRIVE || gear == GearCommand::DRIVE_2 || gear == GearCommand::DRIVE_3 ||
+    gear == GearCommand::DRIVE_4 || gear == GearCommand::DRIVE_5 || gear == GearCommand::DRIVE_6 ||
+    gear == GearCommand::DRIVE_7 || gear == GearCommand::DRIVE_8 || gear == GearCommand::DRIVE_9 ||
+    gear == GearCommand::DRIVE_10 || gear == GearCommand::DRIVE_11 ||
+    gear == GearCommand::DRIVE_12 || gear == GearCommand::DRIVE_13 ||
+    gear == GearCommand::DRIVE_14 || gear == GearCommand::DRIVE_15 ||
+    gear == GearCommand::DRIVE_16 || gear == GearCommand::DRIVE_17 ||
+    gear == GearCommand::DRIVE_18 || gear == GearCommand::LOW || gear == GearCommand::LOW_2) {
+    direction = GearDirection::FORWARD;
+  } else if (gear == GearCommand::REVERSE || gear == GearCommand::REVERSE_2) {
+    direction = GearDirection::BACKWARD;
+  }
+  gear_direction_.at(index) = direction;
+}
+
+void SimModelDelaySteerAccGearedBatch::update(const double dt, const size_t num_steps)
+{
+  SimModelBatch::runInParallel(
+    num_instances_, num_threads_,
+    [&](const size_t begin, const size_t end) { updateRange(begin, end, dt, num_steps); });
+
+  // the heads are shared by all the instances since they are stepped together
+  if (acc_input_queue_size_ > 0) {
+    acc_input_queue_head_ = (acc_input_queue_head_ + num_steps) % acc_input_queue_size_;
+  }
+  if (steer_input_queue_size_ > 0) {
+    steer_input_queue_head_ = (steer_input_queue_head_ + num_steps) % steer_input_queue_size_;
+  }
+}
+
+void SimModelDelaySteerAccGearedBatch::updateRange(
+  const size_t begin, const size_t end, const double dt, const size_t num_steps)
+{
+  double * const x = state_[IDX::X].data();
+  double * const y = state_[IDX::Y].data();
+  double * const yaw = state_[IDX::YAW].data();
+  double * const vx = state_[IDX::VX].data();
+  double * const steer = state_[IDX::STEER].data();
+  double * const accx = state_[IDX::ACCX].data();
+
+  // derivative of the states with the time delay steering model
+  const auto calc_model = [&](const std::array<double, dim_x> & s, const double acc_des,
+                              const double steer_rate, std::array<double, dim_x> & d_s) {
+    const double vel = sat(s[IDX::VX], vx_lim_, -vx_lim_);
+    const double acc = sat(s[IDX::ACCX], vx_rate_lim_, -vx_rate_lim_);
+    d_s[IDX::X] = vel * std::cos(s[IDX::YAW]);
+    d_s[IDX::Y] = vel * std::sin(s[IDX::YAW]);
+    d_s[IDX::YAW] = vel * std::tan(s[IDX::STEER]) / wheelbase_;
+    d_s[IDX::VX] = acc;
+    d_s[IDX::STEER] = steer_rate;
+    d_s[IDX::ACCX] = -(acc - acc_des) / acc_time_constant_;
+  };
+
+  for (size_t step = 0; step < num_steps; ++step) {
+    const size_t acc_slot =
+      acc_input_queue_size_ > 0 ? (acc_input_queue_head_ + step) % acc_input_queue_size_ : 0;
+    const size_t steer_slot =
+      steer_input_queue_size_ > 0 ? (steer_input_queue_head_ + step) % steer_input_queue_size_ : 0;
+    double * const acc_queue = acc_input_queue_.data() + acc_slot * num_instances_;
+    double * const steer_queue = steer_input_queue_.data() + steer_slot * num_instances_;
+
+    for (size_t i = begin; i < end; ++i) {
+      // delay the inputs
+      double delayed_acc_des = acc_des_[i];
+      if (acc_input_queue_size_ > 0) {
+        std::swap(delayed_acc_des, acc_queue[i]);
+      }
+      double delayed_steer_des = steer_des_[i];
+      if (steer_input_queue_size_ > 0) {
+        std::swap(delayed_steer_des, steer_queue[i]);
+      }
+
+      const double acc_des =
+        sat(delayed_acc_des, vx_rate_lim_, -vx_rate_lim_) * debug_acc_scaling_factor_;
+      const double steer_des =
+        sat(delayed_steer_des, steer_lim_, -steer_lim_) * debug_steer_scaling_factor_;
+
+      // NOTE: the steer rate is calculated from the measured steering angle before the update, so
+      // that it is the same in all the stages of Runge-Kutta.
+      const double steer_diff = steer[i] + steer_bias_ - steer_des;
+      double steer_diff_with_dead_band = 0.0;
+      if (steer_diff > steer_dead_band_) {
+        steer_diff_with_dead_band = steer_diff - steer_dead_band_;
+      } else if (steer_diff < -steer_dead_band_) {
+        steer_diff_with_dead_band = steer_diff + steer_dead_band_;
+      }
+      const double steer_rate =
+        sat(-steer_diff_with_dead_band / steer_time_constant_, steer_rate_lim_, -steer_rate_lim_);
+
+      // update with Runge-Kutta methods
+      const std::array<double, dim_x> prev_state{x[i], y[i], yaw[i], vx[i], steer[i], accx[i]};
+      std::array<double, dim_x> k1, k2, k3, k4, tmp;
+      calc_model(prev_state, acc_des, steer_rate, k1);
+      for (size_t j = 0; j < dim_x; ++j) tmp[j] = prev_state[j] + k1[j] * 0.5 * dt;
+      calc_model(tmp, acc_des, steer_rate, k2);
+      for (size_t j = 0; j < dim_x; ++j) tmp[j] = prev_state[j] + k2[j] * 0.5 * dt;
+      calc_model(tmp, acc_des, steer_rate, k3);
+      for (size_t j = 0; j < dim_x; ++j) tmp[j] = prev_state[j] + k3[j] * dt;
+      calc_model(tmp, acc_des, steer_rate, k4);
+      std::array<double, dim_x> state;
+      for (size_t j = 0; j < dim_x; ++j) {
+        state[j] =
+          prev_state[j] + 1.0 / 6.0 * (k1[j] + 2.0 * k2[j] + 2.0 * k3[j] + k4[j]) * dt;
+      }
+
+      // take velocity limit explicitly
+      state[IDX::VX] = std::max(-vx_lim_, std::min(state[IDX::VX], vx_lim_));
+
+      // consider gear
+      const auto direction = gear_direction_[i];
+      const bool is_stop = direction == GearDirection::STOP ||
+                           (direction == GearDirection::FORWARD && state[IDX::VX] < 0.0) ||
+                           (direction == GearDirection::BACKWARD && state[IDX::VX] > 0.0);
+      if (is_stop) {
+        state[IDX::VX] = 0.0;
+        state[IDX::X] = prev_state[IDX::X];
+        state[IDX::Y] = prev_state[IDX::Y];
+        state[IDX::YAW] = prev_state[IDX::YAW];
+        state[IDX::ACCX] = (state[IDX::VX] - prev_state[IDX::VX]) / std::max(dt, 1.0e-5);
+      }
+
+      x[i] = state[IDX::X];
+      y[i] = state[IDX::Y];
+      yaw[i] = state[IDX::YAW];
+      vx[i] = state[IDX::VX];
+      steer[i] = state[IDX::STEER];
+      accx[i] = state[IDX::ACCX];
+    }
+  }
+}
@@ -0,0 +1,125 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+#include "simple_planning_simulator/vehicle_model/sim_model.hpp"
+#include "simple_planning_simulator/vehicle_model/sim_model_batch.hpp"
+#include "simple_planning_simulator/vehicle_model/sim_model_delay_steer_acc_geared_batch.hpp"
+
+#include "autoware_vehicle_msgs/msg/gear_command.hpp"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+using autoware_vehicle_msgs::msg::GearCommand;
+
+namespace
+{
+// same parameters as simple_planning_simulator_default.param.yaml
+constexpr double dt = 0.02;
+constexpr double vel_lim = 50.0;
+constexpr double steer_lim = 1.0;
+constexpr double vel_rate_lim = 7.0;
+constexpr double steer_rate_lim = 5.0;
+constexpr double wheelbase = 4.0;
+constexpr double acc_time_delay = 0.1;
+constexpr double acc_time_constant = 0.1;
+constexpr double steer_time_delay = 0.24;
+constexpr double steer_time_constant = 0.27;
+constexpr double steer_dead_band = 0.0;
+constexpr double steer_bias = 0.0;
+
+std::shared_ptr<SimModelInterface> createDelaySteerAccGeared()
+{
+  return std::make_shared<SimModelDelaySteerAccGeared>(
+    vel_lim, steer_lim, vel_rate_lim, steer_rate_lim, wheelbase, dt, acc_time_delay,
+    acc_time_constant, steer_time_delay, steer_time_constant, steer_dead_band, steer_bias, 1.0, 1.0);
+}
+
+// input of i-th instance at the step, which depends on the instance to check the independence
+std::pair<double, double> createInput(const size_t i, const size_t step)
+{
+  const double acc = (step < 200 ? 1.0 : -2.0) * (1.0 + 0.01 * static_cast<double>(i));
+  const double steer = 0.3 * std::sin(0.02 * static_cast<double>(step + i));
+  return {acc, steer};
+}
+}  // namespace
+
+TEST(TestSimModelBatch, DelaySteerAccGearedBatchMatchesSingleModel)
+{
+  constexpr size_t num_instances = 7;
+  constexpr size_t num_steps = 400;
+
+  SimModelBatch batch(num_instances, createDelaySteerAccGeared, 3);
+  SimModelDelaySteerAccGearedBatch soa_batch(
+    num_instances, vel_lim, steer_lim, vel_rate_lim, steer_rate_lim, wheelbase, dt, acc_time_delay,
+    acc_time_constant, steer_time_delay, steer_time_constant, steer_dead_band, steer_bias, 1.0, 1.0,
+    3);
+
+  for (size_t i = 0; i < num_instances; ++i) {
+    // the instances in reverse stop while the accel command is positive
+    const uint8_t gear = (i % 2 == 0) ? GearCommand::DRIVE : GearCommand::REVERSE;
+    batch.at(i).setGear(gear);
+    soa_batch.setGear(i, gear);
+  }
+
+  for (size_t step = 0; step < num_steps; ++step) {
+    for (size_t i = 0; i < num_instances; ++i) {
+      const auto [acc, steer] = createInput(i, step);
+      Eigen::VectorXd input(2);
+      input << acc, steer;
+      batch.at(i).setInput(input);
+      soa_batch.setInput(i, acc, steer);
+    }
+    batch.update(dt, 1);
+    soa_batch.update(dt, 1);
+  }
+
+  for (size_t i = 0; i < num_instances; ++i) {
+    Eigen::VectorXd expected;
+    batch.at(i).getState(expected);
+    const auto actual = soa_batch.getState(i);
+    for (int j = 0; j < 6; ++j) {
+      EXPECT_NEAR(actual(j), expected(j), 1e-9) << "instance " << i << ", state " << j;
+    }
+  }
+}
+
+TEST(TestSimModelBatch, MultipleStepsPerUpdate)
+{
+  constexpr size_t num_instances = 5;
+  SimModelDelaySteerAccGearedBatch one_step(
+    num_instances, vel_lim, steer_lim, vel_rate_lim, steer_rate_lim, wheelbase, dt, acc_time_delay,
+    acc_time_constant, steer_time_delay, steer_time_constant, steer_dead_band, steer_bias, 1.0, 1.0,
+    1);
+  SimModelDelaySteerAccGearedBatch many_steps(
+    num_instances, vel_lim, steer_lim, vel_rate_lim, steer_rate_lim, wheelbase, dt, acc_time_delay,
+    acc_time_constant, steer_time_delay, steer_time_constant, steer_dead_band, steer_bias, 1.0, 1.0,
+    2);
+  for (size_t i = 0; i < num_instances; ++i) {
+    const auto [acc, steer] = createInput(i, 0);
+    one_step.setInput(i, acc, steer);
+    many_steps.setInput(i, acc, steer);
+  }
+
+  for (size_t step = 0; step < 37; ++step) {
+    one_step.update(dt, 1);
+  }
+  many_steps.update(dt, 37);
+
+  for (size_t i = 0; i < num_instances; ++i) {
+    EXPECT_TRUE(one_step.getState(i).isApprox(many_steps.getState(i)));
+  }
+}
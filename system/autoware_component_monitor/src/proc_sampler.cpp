@@ -0,0 +1,164 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "proc_sampler.hpp"
+
+#include "unit_conversions.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace autoware::component_monitor
+{
+namespace
+{
+/**
+ * @brief Find the value of a "Key: value" line of a procfs file, such as /proc/meminfo.
+ *
+ * @return The first number after the key, or std::nullopt if the key is not found.
+ */
+std::optional<std::uint64_t> find_value(const std::string & text, const char * key)
+{
+  std::size_t pos = 0;
+  const std::string key_str{key};
+  while (pos < text.size()) {
+    if (text.compare(pos, key_str.size(), key_str) == 0) {
+      return std::strtoull(text.c_str() + pos + key_str.size(), nullptr, 10);
+    }
+    pos = text.find('\n', pos);
+    if (pos == std::string::npos) break;
+    ++pos;
+  }
+  return std::nullopt;
+}
+
+float to_cores(const std::uint64_t jiffies, const double clock_ticks_per_sec, const double elapsed)
+{
+  if (elapsed <= 0.0) return 0.0f;
+  return static_cast<float>(static_cast<double>(jiffies) / clock_ticks_per_sec / elapsed);
+}
+}  // namespace
+
+ProcSampler::ProcSampler(const pid_t pid, std::string proc_root)
+: pid_(pid),
+  proc_root_(std::move(proc_root)),
+  pid_dir_(proc_root_ + "/" + std::to_string(pid)),
+  clock_ticks_per_sec_(static_cast<double>(sysconf(_SC_CLK_TCK)))
+{
+  buffer_.reserve(4096);
+}
+
+ProcessUsage ProcSampler::sample()
+{
+  ProcessUsage usage;
+
+  const double uptime_sec = read_uptime_sec();
+  const auto jiffies = read_cpu_jiffies(pid_dir_ + "/stat");
+  if (!jiffies) {
+    throw std::runtime_error("Failed to read the CPU times of the process " + std::to_string(pid_));
+  }
+
+  if (prev_uptime_sec_ && *jiffies >= prev_process_jiffies_) {
+    usage.cpu_cores_utilized = to_cores(
+      *jiffies - prev_process_jiffies_, clock_ticks_per_sec_, uptime_sec - *prev_uptime_sec_);
+  }
+
+  read_meminfo(usage);
+  read_status(usage);
+
+  prev_uptime_sec_ = uptime_sec;
+  prev_process_jiffies_ = *jiffies;
+  return usage;
+}
+
+bool ProcSampler::read_file(const std::string & path)
+{
+  buffer_.clear();
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return false;
+
+  char chunk[4096];
+  ssize_t read_size = 0;
+  while ((read_size = ::read(fd, chunk, sizeof(chunk))) > 0) {
+    buffer_.append(chunk, static_cast<std::size_t>(read_size));
+  }
+  ::close(fd);
+  return read_size == 0;
+}
+
+double ProcSampler::read_uptime_sec()
+{
+  // /proc/uptime : "12345.67 54321.00"
+  if (!read_file(proc_root_ + "/uptime")) {
+    throw std::runtime_error("Failed to read " + proc_root_ + "/uptime");
+  }
+  return std::strtod(buffer_.c_str(), nullptr);
+}
+
+std::optional<std::uint64_t> ProcSampler::read_cpu_jiffies(const std::string & stat_path)
+{
+  // /proc/PID/stat : "PID (COMM) STATE PPID ... UTIME STIME ..."
+  // COMM may contain spaces and parentheses, so that the fields are counted from the last ')'.
+  if (!read_file(stat_path)) return std::nullopt;
+
+  const auto name_begin = buffer_.find('(');
+  const auto name_end = buffer_.rfind(')');
+  if (name_begin == std::string::npos || name_end == std::string::npos || name_end < name_begin) {
+    return std::nullopt;
+  }
+
+  // utime and stime are 14th and 15th fields, which are 11th and 12th after the STATE field.
+  constexpr int utime_index = 11;
+  const char * cursor = buffer_.c_str() + name_end + 1;
+  for (int i = 0; i < utime_index; ++i) {
+    while (*cursor == ' ') ++cursor;
+    while (*cursor != ' ' && *cursor != '\0') ++cursor;
+  }
+  if (*cursor == '\0') return std::nullopt;
+
+  char * end = nullptr;
+  const std::uint64_t utime = std::strtoull(cursor, &end, 10);
+  const std::uint64_t stime = std::strtoull(end, nullptr, 10);
+  return utime + stime;
+}
+
+void ProcSampler::read_meminfo(ProcessUsage & usage)
+{
+  // /proc/meminfo : "MemTotal:       65532208 kB"
+  if (!read_file(proc_root_ + "/meminfo")) {
+    throw std::runtime_error("Failed to read " + proc_root_ + "/meminfo");
+  }
+  usage.total_memory_bytes =
+    unit_conversions::kib_to_bytes(find_value(buffer_, "MemTotal:").value_or(0));
+  usage.free_memory_bytes =
+    unit_conversions::kib_to_bytes(find_value(buffer_, "MemFree:").value_or(0));
+}
+
+void ProcSampler::read_status(ProcessUsage & usage)
+{
+  // /proc/PID/status : "VmRSS:     1234 kB"
+  if (!read_file(pid_dir_ + "/status")) {
+    throw std::runtime_error("Failed to read " + pid_dir_ + "/status");
+  }
+  usage.process_memory_bytes =
+    unit_conversions::kib_to_bytes(find_value(buffer_, "VmRSS:").value_or(0));
+}
+}  // namespace autoware::component_monitor
@@ -0,0 +1,79 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROC_SAMPLER_HPP_
+#define PROC_SAMPLER_HPP_
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace autoware::component_monitor
+{
+struct ProcessUsage
+{
+  float cpu_cores_utilized{0.0f};
+  std::uint64_t process_memory_bytes{0};
+  std::uint64_t total_memory_bytes{0};
+  std::uint64_t free_memory_bytes{0};
+};
+
+/**
+ * @brief Samples the resource usage of a process by reading procfs directly.
+ *
+ * @details Only the files needed by ResourceUsageReport are read on each sample:
+ * - /proc/uptime : elapsed time between the samples
+ * - /proc/meminfo : MemTotal and MemFree
+ * - /proc/PID/stat : utime and stime of the process
+ * - /proc/PID/status : VmRSS of the process
+ *
+ * The CPU usage is calculated from the differences of the jiffies between two consecutive samples,
+ * so that it is zero on the first sample.
+ */
+class ProcSampler
+{
+public:
+  explicit ProcSampler(const pid_t pid, std::string proc_root = "/proc");
+
+  /**
+   * @brief Sample the resource usage of the process.
+   *
+   * @return The resource usage.
+   * @throw std::runtime_error if the process information cannot be read.
+   */
+  ProcessUsage sample();
+
+private:
+  pid_t pid_;
+  std::string proc_root_;
+  std::string pid_dir_;
+  double clock_ticks_per_sec_;
+
+  std::optional<double> prev_uptime_sec_;
+  std::uint64_t prev_process_jiffies_{0};
+
+  // buffer reused for reading the files
+  std::string buffer_;
+
+  bool read_file(const std::string & path);
+  double read_uptime_sec();
+  std::optional<std::uint64_t> read_cpu_jiffies(const std::string & stat_path);
+  void read_meminfo(ProcessUsage & usage);
+  void read_status(ProcessUsage & usage);
+};
+}  // namespace autoware::component_monitor
+
+#endif  // PROC_SAMPLER_HPP_
@@ -0,0 +1,145 @@
+// Copyright 2024 The Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "proc_sampler.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace autoware::component_monitor
+{
+namespace
+{
+void write_file(const std::filesystem::path & path, const std::string & content)
+{
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream ofs(path);
+  ofs << content;
+}
+
+std::string make_stat(const pid_t pid, const std::string & name, const int utime, const int stime)
+{
+  return std::to_string(pid) + " (" + name + ") S 1 100 100 0 -1 4194560 4000 0 0 0 " +
+         std::to_string(utime) + " " + std::to_string(stime) + " 0 0 20 0 3 0 12345 0 0\n";
+}
+
+class ProcSamplerTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    root_ = std::filesystem::temp_directory_path() /
+            ("test_proc_sampler_" + std::to_string(getpid()));
+    write_file(
+      root_ / "meminfo", "MemTotal:       65532208 kB\nMemFree:        35117428 kB\n"
+                         "MemAvailable:   45520816 kB\n");
+    write_file(
+      root_ / "42" / "status", "Name:\tcontainer\nVmHWM:\t    2048 kB\nVmRSS:\t    1024 kB\n");
+  }
+
+  void TearDown() override { std::filesystem::remove_all(root_); }
+
+  void set_state(const double uptime, const int utime, const int stime)
+  {
+    write_file(root_ / "uptime", std::to_string(uptime) + " 0.00\n");
+    // name with spaces and parentheses
+    write_file(root_ / "42" / "stat", make_stat(42, "cont (1) ainer", utime, stime));
+  }
+
+  std::filesystem::path root_;
+};
+}  // namespace
+
+TEST_F(ProcSamplerTest, ReadsMemory)
+{
+  set_state(100.0, 0, 0);
+  ProcSampler sampler(42, root_.string());
+  const auto usage = sampler.sample();
+
+  EXPECT_EQ(usage.total_memory_bytes, 65532208ULL * 1024ULL);
+  EXPECT_EQ(usage.free_memory_bytes, 35117428ULL * 1024ULL);
+  EXPECT_EQ(usage.process_memory_bytes, 1024ULL * 1024ULL);
+}
+
+TEST_F(ProcSamplerTest, CalculatesCpuUsageFromJiffyDifference)
+{
+  const double ticks = static_cast<double>(sysconf(_SC_CLK_TCK));
+
+  set_state(100.0, 0, 0);
+  ProcSampler sampler(42, root_.string());
+  EXPECT_FLOAT_EQ(sampler.sample().cpu_cores_utilized, 0.0f);
+
+  // 2 seconds elapsed, 1 second in user mode and 2 seconds in kernel mode
+  set_state(102.0, static_cast<int>(ticks), static_cast<int>(2 * ticks));
+  EXPECT_FLOAT_EQ(sampler.sample().cpu_cores_utilized, 1.5f);
+}
+
+TEST_F(ProcSamplerTest, ThrowsIfProcessDoesNotExist)
+{
+  set_state(100.0, 0, 0);
+  ProcSampler sampler(7, root_.string());
+  EXPECT_THROW(sampler.sample(), std::runtime_error);
+}
+
+TEST(ProcSampler, SamplesCurrentProcess)
+{
+  ProcSampler sampler(getpid());
+  const auto usage = sampler.sample();
+  EXPECT_GT(usage.total_memory_bytes, 0U);
+  EXPECT_GT(usage.process_memory_bytes, 0U);
+}
+
+// Compares the cost of a sample with running `top`, which was used before ProcSampler.
+// Run with --gtest_also_run_disabled_tests.
+TEST(ProcSampler, DISABLED_BenchmarkSamplingCost)
+{
+  constexpr int iterations = 100;
+  const auto pid = getpid();
+
+  ProcSampler sampler(pid);
+  const auto sampler_start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    sampler.sample();
+  }
+  const auto sampler_time = std::chrono::duration<double, std::micro>(
+                              std::chrono::steady_clock::now() - sampler_start)
+                              .count() /
+                            iterations;
+
+  const std::string cmd = "top -b -n 1 -E k -p " + std::to_string(pid);
+  const auto top_start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    FILE * pipe = popen(cmd.c_str(), "r");
+    ASSERT_NE(pipe, nullptr);
+    char buffer[4096];
+    while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
+    }
+    pclose(pipe);
+  }
+  const auto top_time =
+    std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - top_start)
+      .count() /
+    iterations;
+
+  std::cout << "ProcSampler::sample : " << sampler_time << " [us/sample]" << std::endl;
+  std::cout << "top                 : " << top_time << " [us/sample]" << std::endl;
+}
+}  // namespace autoware::component_monitor
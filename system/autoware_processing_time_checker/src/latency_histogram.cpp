@@ -0,0 +1,132 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace autoware::processing_time_checker
+{
+SlidingWindowHistogram::SlidingWindowHistogram(const size_t num_slices)
+: slices_(std::max<size_t>(num_slices, 1)), window_counts_(bucket_count, 0)
+{
+  for (auto & slice : slices_) {
+    slice.counts.assign(bucket_count, 0);
+  }
+}
+
+size_t SlidingWindowHistogram::to_bucket_index(const uint64_t value_us)
+{
+  const uint64_t value = std::min<uint64_t>(value_us, (1ULL << max_value_bits) - 1);
+  if (value < sub_bucket_count) {
+    return static_cast<size_t>(value);
+  }
+
+  // shift the value so that it fits in [sub_bucket_half_count, sub_bucket_count)
+  const int msb = 63 - __builtin_clzll(value);
+  const int shift = msb - (sub_bucket_bits - 1);
+  return static_cast<size_t>(
+    (shift + 1) * sub_bucket_half_count + ((value >> shift) - sub_bucket_half_count));
+}
+
+double SlidingWindowHistogram::to_bucket_value_ms(const size_t bucket_index)
+{
+  if (bucket_index < sub_bucket_count) {
+    return static_cast<double>(bucket_index) * 1e-3;
+  }
+
+  // middle of the bucket
+  const int shift = static_cast<int>(bucket_index / sub_bucket_half_count) - 1;
+  const uint64_t sub_bucket = bucket_index % sub_bucket_half_count + sub_bucket_half_count;
+  const uint64_t lower_us = sub_bucket << shift;
+  const uint64_t upper_us = ((sub_bucket + 1) << shift) - 1;
+  return static_cast<double>(lower_us + upper_us) * 0.5 * 1e-3;
+}
+
+void SlidingWindowHistogram::record(const double latency_ms)
+{
+  if (!std::isfinite(latency_ms) || latency_ms < 0.0) {
+    return;
+  }
+
+  const auto value_us = static_cast<uint64_t>(std::llround(latency_ms * 1e3));
+  const size_t index = to_bucket_index(value_us);
+
+  auto & slice = slices_.at(current_slice_);
+  ++slice.counts[index];
+  ++slice.total_count;
+  slice.max_us = std::max(slice.max_us, value_us);
+
+  ++window_counts_[index];
+  ++window_total_count_;
+}
+
+void SlidingWindowHistogram::advance()
+{
+  current_slice_ = (current_slice_ + 1) % slices_.size();
+
+  // remove the oldest slice from the window
+  auto & slice = slices_.at(current_slice_);
+  if (slice.total_count > 0) {
+    for (size_t i = 0; i < bucket_count; ++i) {
+      window_counts_[i] -= slice.counts[i];
+    }
+    window_total_count_ -= slice.total_count;
+    std::fill(slice.counts.begin(), slice.counts.end(), 0);
+  }
+  slice.total_count = 0;
+  slice.max_us = 0;
+}
+
+double SlidingWindowHistogram::get_percentile_ms(const double percentile) const
+{
+  // the smallest value whose cumulative count reaches the percentile
+  const auto target_count = static_cast<uint64_t>(
+    std::ceil(percentile * 1e-2 * static_cast<double>(window_total_count_)));
+  uint64_t cumulative_count = 0;
+  for (size_t i = 0; i < bucket_count; ++i) {
+    cumulative_count += window_counts_[i];
+    if (cumulative_count >= std::max<uint64_t>(target_count, 1)) {
+      return to_bucket_value_ms(i);
+    }
+  }
+  return 0.0;
+}
+
+LatencyStatistics SlidingWindowHistogram::get_statistics() const
+{
+  LatencyStatistics statistics;
+  statistics.count = window_total_count_;
+  if (window_total_count_ == 0) {
+    return statistics;
+  }
+
+  uint64_t max_us = 0;
+  for (const auto & slice : slices_) {
+    max_us = std::max(max_us, slice.max_us);
+  }
+
+  statistics.p50_ms = get_percentile_ms(50.0);
+  statistics.p99_ms = get_percentile_ms(99.0);
+  statistics.p999_ms = get_percentile_ms(99.9);
+  // the max is recorded exactly, and the percentiles should not exceed it
+  statistics.max_ms = static_cast<double>(max_us) * 1e-3;
+  statistics.p50_ms = std::min(statistics.p50_ms, statistics.max_ms);
+  statistics.p99_ms = std::min(statistics.p99_ms, statistics.max_ms);
+  statistics.p999_ms = std::min(statistics.p999_ms, statistics.max_ms);
+  return statistics;
+}
+}  // namespace autoware::processing_time_checker
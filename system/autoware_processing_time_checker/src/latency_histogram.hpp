@@ -0,0 +1,89 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LATENCY_HISTOGRAM_HPP_
+#define LATENCY_HISTOGRAM_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autoware::processing_time_checker
+{
+struct LatencyStatistics
+{
+  uint64_t count{0};
+  double p50_ms{0.0};
+  double p99_ms{0.0};
+  double p999_ms{0.0};
+  double max_ms{0.0};
+};
+
+/**
+ * @brief Log-linear (HDR style) histogram of latencies over a sliding window.
+ *
+ * Latencies are recorded in microseconds. Each power of 2 range is split into 64 linear
+ * sub-buckets, so that the relative error of a percentile is less than 1/64 from 1 us up to about
+ * 12 days, with a fixed memory footprint. The window is split into slices. advance() drops the
+ * oldest slice, and the statistics always cover the latest num_slices slices.
+ */
+class SlidingWindowHistogram
+{
+public:
+  explicit SlidingWindowHistogram(const size_t num_slices);
+
+  /**
+   * @brief Record a latency to the current slice.
+   */
+  void record(const double latency_ms);
+
+  /**
+   * @brief Start a new slice, discarding the oldest one.
+   */
+  void advance();
+
+  /**
+   * @brief Get the percentiles and the max latency over the window.
+   */
+  LatencyStatistics get_statistics() const;
+
+private:
+  static constexpr int sub_bucket_bits = 7;
+  static constexpr uint64_t sub_bucket_count = 1ULL << sub_bucket_bits;
+  static constexpr uint64_t sub_bucket_half_count = sub_bucket_count / 2;
+  static constexpr int max_value_bits = 40;
+  static constexpr size_t bucket_count =
+    (max_value_bits - sub_bucket_bits + 2) * sub_bucket_half_count;
+
+  static size_t to_bucket_index(const uint64_t value_us);
+  static double to_bucket_value_ms(const size_t bucket_index);
+  double get_percentile_ms(const double percentile) const;
+
+  struct Slice
+  {
+    std::vector<uint32_t> counts;
+    uint64_t total_count{0};
+    uint64_t max_us{0};
+  };
+
+  std::vector<Slice> slices_;
+  size_t current_slice_{0};
+
+  // sum of the counts of all the slices
+  std::vector<uint64_t> window_counts_;
+  uint64_t window_total_count_{0};
+};
+}  // namespace autoware::processing_time_checker
+
+#endif  // LATENCY_HISTOGRAM_HPP_
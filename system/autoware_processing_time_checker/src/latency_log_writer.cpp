@@ -0,0 +1,113 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "latency_log_writer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace autoware::processing_time_checker
+{
+namespace
+{
+constexpr char magic[4] = {'P', 'T', 'C', 'L'};
+constexpr uint32_t version = 1;
+constexpr char name_record_type = 'N';
+constexpr char snapshot_record_type = 'S';
+
+// the values are written in little-endian regardless of the host byte order
+template <typename T>
+void write_value(std::ofstream & ofs, const T & value)
+{
+  static_assert(std::is_integral_v<T>);
+  const auto bits = static_cast<std::make_unsigned_t<T>>(value);
+  char bytes[sizeof(T)];
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    bytes[i] = static_cast<char>((bits >> (8 * i)) & 0xFF);
+  }
+  ofs.write(bytes, sizeof(T));
+}
+
+void write_value(std::ofstream & ofs, const float value)
+{
+  static_assert(sizeof(float) == sizeof(uint32_t));
+  uint32_t bits{};
+  std::memcpy(&bits, &value, sizeof(value));
+  write_value(ofs, bits);
+}
+}  // namespace
+
+LatencyLogWriter::LatencyLogWriter(const std::string & file_path)
+: ofs_(file_path, std::ios::binary | std::ios::trunc)
+{
+  if (!ofs_) {
+    throw std::runtime_error("Failed to open the latency log: " + file_path);
+  }
+  ofs_.write(magic, sizeof(magic));
+  write_value(ofs_, version);
+}
+
+uint16_t LatencyLogWriter::get_name_id(const std::string & name)
+{
+  const auto itr = name_id_map_.find(name);
+  if (itr != name_id_map_.end()) {
+    return itr->second;
+  }
+
+  const auto name_id = static_cast<uint16_t>(name_id_map_.size());
+  const auto name_length = static_cast<uint16_t>(
+    std::min<size_t>(name.size(), std::numeric_limits<uint16_t>::max()));
+  write_value(ofs_, name_record_type);
+  write_value(ofs_, name_id);
+  write_value(ofs_, name_length);
+  ofs_.write(name.data(), name_length);
+
+  name_id_map_.emplace(name, name_id);
+  return name_id;
+}
+
+void LatencyLogWriter::write(
+  const int64_t stamp_ns,
+  const std::vector<std::pair<std::string, LatencyStatistics>> & statistics_list)
+{
+  // the name records have to be written before the snapshot record refers to them
+  std::vector<uint16_t> name_ids;
+  name_ids.reserve(statistics_list.size());
+  for (const auto & [name, statistics] : statistics_list) {
+    name_ids.push_back(get_name_id(name));
+  }
+
+  write_value(ofs_, snapshot_record_type);
+  write_value(ofs_, stamp_ns);
+  write_value(ofs_, static_cast<uint16_t>(statistics_list.size()));
+  for (size_t i = 0; i < statistics_list.size(); ++i) {
+    const auto & statistics = statistics_list.at(i).second;
+    write_value(ofs_, name_ids.at(i));
+    write_value(
+      ofs_, static_cast<uint32_t>(
+              std::min<uint64_t>(statistics.count, std::numeric_limits<uint32_t>::max())));
+    write_value(ofs_, static_cast<float>(statistics.p50_ms));
+    write_value(ofs_, static_cast<float>(statistics.p99_ms));
+    write_value(ofs_, static_cast<float>(statistics.p999_ms));
+    write_value(ofs_, static_cast<float>(statistics.max_ms));
+  }
+  ofs_.flush();
+}
+}  // namespace autoware::processing_time_checker
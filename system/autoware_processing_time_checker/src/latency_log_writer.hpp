@@ -0,0 +1,58 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LATENCY_LOG_WRITER_HPP_
+#define LATENCY_LOG_WRITER_HPP_
+
+#include "latency_histogram.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace autoware::processing_time_checker
+{
+/**
+ * @brief Write the latency statistics to a compact binary log for offline comparison.
+ *
+ * The format is described in the README. Each name is written once, and the following snapshots
+ * refer to it by its ID.
+ */
+class LatencyLogWriter
+{
+public:
+  /**
+   * @throw std::runtime_error if the file cannot be opened
+   */
+  explicit LatencyLogWriter(const std::string & file_path);
+
+  /**
+   * @brief Write the statistics of all the entries at the stamp.
+   */
+  void write(
+    const int64_t stamp_ns,
+    const std::vector<std::pair<std::string, LatencyStatistics>> & statistics_list);
+
+private:
+  uint16_t get_name_id(const std::string & name);
+
+  std::ofstream ofs_;
+  std::unordered_map<std::string, uint16_t> name_id_map_{};
+};
+}  // namespace autoware::processing_time_checker
+
+#endif  // LATENCY_LOG_WRITER_HPP_
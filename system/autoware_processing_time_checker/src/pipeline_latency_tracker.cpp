@@ -0,0 +1,68 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pipeline_latency_tracker.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+namespace autoware::processing_time_checker
+{
+PipelineLatencyTracker::PipelineLatencyTracker(
+  const size_t num_stages, const size_t max_pending_stamps)
+: num_stages_(num_stages), max_pending_stamps_(std::max<size_t>(max_pending_stamps, 1))
+{
+}
+
+std::optional<PipelineLatency> PipelineLatencyTracker::on_published(
+  const size_t stage_index, const int64_t header_stamp_ns, const int64_t published_stamp_ns)
+{
+  if (stage_index >= num_stages_) {
+    return std::nullopt;
+  }
+
+  auto itr = pending_stamps_.find(header_stamp_ns);
+  if (itr == pending_stamps_.end()) {
+    // the oldest stamp is unlikely to be completed since some stages dropped it
+    if (pending_stamps_.size() >= max_pending_stamps_) {
+      pending_stamps_.erase(pending_stamps_.begin());
+    }
+    itr = pending_stamps_.emplace(header_stamp_ns, std::vector<std::optional<int64_t>>(num_stages_))
+            .first;
+  }
+  itr->second.at(stage_index) = published_stamp_ns;
+
+  const auto & published_stamps = itr->second;
+  const bool is_completed = std::all_of(
+    published_stamps.begin(), published_stamps.end(),
+    [](const auto & published_stamp) { return published_stamp.has_value(); });
+  if (!is_completed) {
+    return std::nullopt;
+  }
+
+  PipelineLatency latency;
+  latency.stage_ms.reserve(num_stages_);
+  int64_t previous_stamp_ns = header_stamp_ns;
+  for (const auto & published_stamp : published_stamps) {
+    latency.stage_ms.push_back(static_cast<double>(*published_stamp - previous_stamp_ns) * 1e-6);
+    previous_stamp_ns = *published_stamp;
+  }
+  latency.total_ms = static_cast<double>(previous_stamp_ns - header_stamp_ns) * 1e-6;
+
+  // the stamps older than the completed one will never be completed since the stages are in order
+  pending_stamps_.erase(pending_stamps_.begin(), std::next(itr));
+  return latency;
+}
+}  // namespace autoware::processing_time_checker
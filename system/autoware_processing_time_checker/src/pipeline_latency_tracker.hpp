@@ -0,0 +1,61 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PIPELINE_LATENCY_TRACKER_HPP_
+#define PIPELINE_LATENCY_TRACKER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace autoware::processing_time_checker
+{
+struct PipelineLatency
+{
+  double total_ms{0.0};
+  // latency from the previous stage, or from the header stamp for the first stage
+  std::vector<double> stage_ms{};
+};
+
+/**
+ * @brief Match the published times of the stages of a pipeline by the header stamp.
+ *
+ * Each stage publishes the time when it published a message whose header stamp is inherited from
+ * the input of the pipeline. When all the stages have published the same header stamp, the
+ * end-to-end latency and the latency of each stage are computed.
+ */
+class PipelineLatencyTracker
+{
+public:
+  explicit PipelineLatencyTracker(const size_t num_stages, const size_t max_pending_stamps = 100);
+
+  /**
+   * @brief Register the published time of a stage.
+   * @return the latency of the pipeline if all the stages have been published for the stamp
+   */
+  std::optional<PipelineLatency> on_published(
+    const size_t stage_index, const int64_t header_stamp_ns, const int64_t published_stamp_ns);
+
+private:
+  const size_t num_stages_;
+  const size_t max_pending_stamps_;
+
+  // header stamp - published stamp of each stage
+  std::map<int64_t, std::vector<std::optional<int64_t>>> pending_stamps_{};
+};
+}  // namespace autoware::processing_time_checker
+
+#endif  // PIPELINE_LATENCY_TRACKER_HPP_
@@ -16,8 +16,13 @@
 
 #include <rclcpp/rclcpp.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace autoware::processing_time_checker
@@ -34,6 +39,33 @@ std::string get_last_name(const std::string & str)
 {
   return str.substr(str.find_last_of("/") + 1);
 }
+
+std::string remove_published_time_suffix(const std::string & str)
+{
+  const std::string suffix = "/debug/published_time";
+  if (
+    str.size() > suffix.size() &&
+    str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0) {
+    return str.substr(0, str.size() - suffix.size());
+  }
+  return str;
+}
+
+void add_statistics(
+  const std::string & name, const LatencyStatistics & statistics, DiagnosticStatus & status)
+{
+  const auto add_key_value = [&](const std::string & key, const std::string & value) {
+    diagnostic_msgs::msg::KeyValue key_value;
+    key_value.key = name + "/" + key;
+    key_value.value = value;
+    status.values.push_back(key_value);
+  };
+  add_key_value("count", std::to_string(statistics.count));
+  add_key_value("p50", std::to_string(statistics.p50_ms));
+  add_key_value("p99", std::to_string(statistics.p99_ms));
+  add_key_value("p99.9", std::to_string(statistics.p999_ms));
+  add_key_value("max", std::to_string(statistics.max_ms));
+}
 }  // namespace
 
 ProcessingTimeChecker::ProcessingTimeChecker(const rclcpp::NodeOptions & node_options)
@@ -42,6 +74,14 @@ ProcessingTimeChecker::ProcessingTimeChecker(const rclcpp::NodeOptions & node_op
   const double update_rate = declare_parameter<double>("update_rate");
   const auto processing_time_topic_name_list =
     declare_parameter<std::vector<std::string>>("processing_time_topic_name_list");
+  const double window_duration = declare_parameter<double>("window_duration");
+  const auto pipeline_names = declare_parameter<std::vector<std::string>>("pipeline_names");
+  const auto binary_log_path = declare_parameter<std::string>("binary_log_path");
+
+  // the window is split into a fixed number of slices so that the memory does not depend on it
+  constexpr size_t num_slices = 10;
+  ticks_per_slice_ = static_cast<size_t>(
+    std::max(1.0, std::round(window_duration * update_rate / static_cast<double>(num_slices))));
 
   for (const auto & processing_time_topic_name : processing_time_topic_name_list) {
     std::optional<std::string> module_name{std::nullopt};
@@ -65,6 +105,7 @@ ProcessingTimeChecker::ProcessingTimeChecker(const rclcpp::NodeOptions & node_op
     // register module name
     if (module_name) {
       module_name_map_.insert_or_assign(processing_time_topic_name, *module_name);
+      processing_time_histogram_map_.try_emplace(*module_name, num_slices);
     } else {
       throw std::invalid_argument("The format of the processing time topic name is not correct.");
     }
@@ -80,10 +121,44 @@ ProcessingTimeChecker::ProcessingTimeChecker(const rclcpp::NodeOptions & node_op
         processing_time_topic_name, 1,
         [this, &module_name]([[maybe_unused]] const Float64Stamped & msg) {
           processing_time_map_.insert_or_assign(module_name, msg.data);
+          processing_time_histogram_map_.at(module_name).record(msg.data);
         }));
     // clang-format on
   }
 
+  // create pipelines whose stages are matched by the header stamp of the published time
+  for (const auto & pipeline_name : pipeline_names) {
+    if (pipeline_name.empty()) {
+      continue;
+    }
+    const auto published_time_topic_name_list =
+      declare_parameter<std::vector<std::string>>("pipelines." + pipeline_name);
+    if (published_time_topic_name_list.empty()) {
+      throw std::invalid_argument("The pipeline " + pipeline_name + " has no stage.");
+    }
+
+    std::vector<std::string> stage_names;
+    for (const auto & published_time_topic_name : published_time_topic_name_list) {
+      stage_names.push_back(remove_published_time_suffix(published_time_topic_name));
+    }
+    const size_t num_stages = stage_names.size();
+    pipelines_.push_back(std::make_unique<Pipeline>(Pipeline{
+      pipeline_name, stage_names, PipelineLatencyTracker(num_stages),
+      SlidingWindowHistogram(num_slices),
+      std::vector<SlidingWindowHistogram>(num_stages, SlidingWindowHistogram(num_slices))}));
+
+    auto & pipeline = *pipelines_.back();
+    for (size_t i = 0; i < num_stages; ++i) {
+      published_time_subscribers_.push_back(create_subscription<PublishedTime>(
+        published_time_topic_name_list.at(i), 10,
+        [this, &pipeline, i](const PublishedTime & msg) { on_published_time(pipeline, i, msg); }));
+    }
+  }
+
+  if (!binary_log_path.empty()) {
+    latency_log_writer_ = std::make_unique<LatencyLogWriter>(binary_log_path);
+  }
+
   diag_pub_ = create_publisher<DiagnosticArray>("~/metrics", 1);
 
   const auto period_ns = rclcpp::Rate(update_rate).period();
@@ -91,6 +166,22 @@ ProcessingTimeChecker::ProcessingTimeChecker(const rclcpp::NodeOptions & node_op
     this, get_clock(), period_ns, std::bind(&ProcessingTimeChecker::on_timer, this));
 }
 
+void ProcessingTimeChecker::on_published_time(
+  Pipeline & pipeline, const size_t stage_index, const PublishedTime & msg)
+{
+  const auto latency = pipeline.tracker.on_published(
+    stage_index, rclcpp::Time(msg.header.stamp).nanoseconds(),
+    rclcpp::Time(msg.published_stamp).nanoseconds());
+  if (!latency) {
+    return;
+  }
+
+  pipeline.total_histogram.record(latency->total_ms);
+  for (size_t i = 0; i < latency->stage_ms.size(); ++i) {
+    pipeline.stage_histograms.at(i).record(latency->stage_ms.at(i));
+  }
+}
+
 void ProcessingTimeChecker::on_timer()
 {
   // create diagnostic status
@@ -108,13 +199,74 @@ void ProcessingTimeChecker::on_timer()
     status.values.push_back(key_value);
   }
 
+  // create diagnostic status of the statistics over the window
+  std::vector<std::pair<std::string, LatencyStatistics>> statistics_list;
+  DiagnosticStatus statistics_status;
+  statistics_status.level = statistics_status.OK;
+  statistics_status.name = "processing_time_statistics";
+  for (const auto & [module_name, histogram] : processing_time_histogram_map_) {
+    statistics_list.emplace_back(module_name, histogram.get_statistics());
+    add_statistics(module_name, statistics_list.back().second, statistics_status);
+  }
+
+  // create diagnostic status of the pipeline latency
+  DiagnosticStatus pipeline_status;
+  pipeline_status.level = pipeline_status.OK;
+  pipeline_status.name = "pipeline_latency";
+  for (const auto & pipeline : pipelines_) {
+    statistics_list.emplace_back(pipeline->name, pipeline->total_histogram.get_statistics());
+    add_statistics(pipeline->name, statistics_list.back().second, pipeline_status);
+
+    // the critical stage is the one with the largest tail latency
+    std::optional<size_t> critical_stage_index{std::nullopt};
+    double critical_stage_p99_ms = 0.0;
+    for (size_t i = 0; i < pipeline->stage_names.size(); ++i) {
+      const auto stage_name = pipeline->name + "/" + pipeline->stage_names.at(i);
+      statistics_list.emplace_back(stage_name, pipeline->stage_histograms.at(i).get_statistics());
+      const auto & stage_statistics = statistics_list.back().second;
+      add_statistics(stage_name, stage_statistics, pipeline_status);
+      if (0 < stage_statistics.count && critical_stage_p99_ms <= stage_statistics.p99_ms) {
+        critical_stage_index = i;
+        critical_stage_p99_ms = stage_statistics.p99_ms;
+      }
+    }
+
+    diagnostic_msgs::msg::KeyValue key_value;
+    key_value.key = pipeline->name + "/critical_stage";
+    key_value.value = critical_stage_index ? pipeline->stage_names.at(*critical_stage_index) : "";
+    pipeline_status.values.push_back(key_value);
+  }
+
   // create diagnostic array
   DiagnosticArray diag_msg;
   diag_msg.header.stamp = now();
   diag_msg.status.push_back(status);
+  diag_msg.status.push_back(statistics_status);
+  if (!pipelines_.empty()) {
+    diag_msg.status.push_back(pipeline_status);
+  }
 
   // publish
   diag_pub_->publish(diag_msg);
+
+  if (latency_log_writer_) {
+    latency_log_writer_->write(rclcpp::Time(diag_msg.header.stamp).nanoseconds(), statistics_list);
+  }
+
+  // slide the window
+  if (++tick_count_ < ticks_per_slice_) {
+    return;
+  }
+  tick_count_ = 0;
+  for (auto & [module_name, histogram] : processing_time_histogram_map_) {
+    histogram.advance();
+  }
+  for (auto & pipeline : pipelines_) {
+    pipeline->total_histogram.advance();
+    for (auto & stage_histogram : pipeline->stage_histograms) {
+      stage_histogram.advance();
+    }
+  }
 }
 }  // namespace autoware::processing_time_checker
 
@@ -15,17 +15,24 @@
 #ifndef PROCESSING_TIME_CHECKER_HPP_
 #define PROCESSING_TIME_CHECKER_HPP_
 
+#include "latency_histogram.hpp"
+#include "latency_log_writer.hpp"
+#include "pipeline_latency_tracker.hpp"
+
 #include <rclcpp/rclcpp.hpp>
 
+#include "autoware_internal_msgs/msg/published_time.hpp"
 #include "diagnostic_msgs/msg/diagnostic_array.hpp"
 #include "tier4_debug_msgs/msg/float64_stamped.hpp"
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace autoware::processing_time_checker
 {
+using autoware_internal_msgs::msg::PublishedTime;
 using diagnostic_msgs::msg::DiagnosticArray;
 using diagnostic_msgs::msg::DiagnosticStatus;
 using tier4_debug_msgs::msg::Float64Stamped;
@@ -36,7 +43,17 @@ public:
   explicit ProcessingTimeChecker(const rclcpp::NodeOptions & node_options);
 
 private:
+  struct Pipeline
+  {
+    std::string name;
+    std::vector<std::string> stage_names;
+    PipelineLatencyTracker tracker;
+    SlidingWindowHistogram total_histogram;
+    std::vector<SlidingWindowHistogram> stage_histograms;
+  };
+
   void on_timer();
+  void on_published_time(Pipeline & pipeline, const size_t stage_index, const PublishedTime & msg);
 
   rclcpp::TimerBase::SharedPtr timer_;
 
@@ -47,6 +64,17 @@ private:
   std::unordered_map<std::string, std::string> module_name_map_{};
   // module name - processing time
   std::unordered_map<std::string, double> processing_time_map_{};
+  // module name - processing time over the window
+  std::unordered_map<std::string, SlidingWindowHistogram> processing_time_histogram_map_{};
+
+  std::vector<std::unique_ptr<Pipeline>> pipelines_;
+  std::vector<rclcpp::Subscription<PublishedTime>::SharedPtr> published_time_subscribers_;
+
+  std::unique_ptr<LatencyLogWriter> latency_log_writer_;
+
+  // the histograms move to the next slice every this number of timer ticks
+  size_t ticks_per_slice_{1};
+  size_t tick_count_{0};
 };
 }  // namespace autoware::processing_time_checker
 
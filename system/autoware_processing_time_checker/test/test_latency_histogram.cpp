@@ -0,0 +1,98 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "latency_histogram.hpp"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+namespace autoware::processing_time_checker
+{
+TEST(SlidingWindowHistogram, Empty)
+{
+  const SlidingWindowHistogram histogram(10);
+  const auto statistics = histogram.get_statistics();
+  EXPECT_EQ(statistics.count, 0U);
+  EXPECT_DOUBLE_EQ(statistics.p50_ms, 0.0);
+  EXPECT_DOUBLE_EQ(statistics.max_ms, 0.0);
+}
+
+TEST(SlidingWindowHistogram, Percentiles)
+{
+  SlidingWindowHistogram histogram(10);
+  for (int i = 1; i <= 1000; ++i) {
+    histogram.record(static_cast<double>(i));
+  }
+
+  // the relative error of the percentiles is less than 1/64
+  const auto statistics = histogram.get_statistics();
+  EXPECT_EQ(statistics.count, 1000U);
+  EXPECT_NEAR(statistics.p50_ms, 500.0, 500.0 / 64.0);
+  EXPECT_NEAR(statistics.p99_ms, 990.0, 990.0 / 64.0);
+  EXPECT_NEAR(statistics.p999_ms, 999.0, 999.0 / 64.0);
+  EXPECT_DOUBLE_EQ(statistics.max_ms, 1000.0);
+  EXPECT_LE(statistics.p999_ms, statistics.max_ms);
+}
+
+TEST(SlidingWindowHistogram, SmallValuesAreExact)
+{
+  SlidingWindowHistogram histogram(10);
+  histogram.record(0.05);
+  histogram.record(0.1);
+  histogram.record(0.12);
+
+  const auto statistics = histogram.get_statistics();
+  EXPECT_EQ(statistics.count, 3U);
+  EXPECT_DOUBLE_EQ(statistics.p50_ms, 0.1);
+  EXPECT_DOUBLE_EQ(statistics.p99_ms, 0.12);
+  EXPECT_DOUBLE_EQ(statistics.max_ms, 0.12);
+}
+
+TEST(SlidingWindowHistogram, IgnoreInvalidValues)
+{
+  SlidingWindowHistogram histogram(10);
+  histogram.record(-1.0);
+  histogram.record(std::numeric_limits<double>::quiet_NaN());
+  histogram.record(std::numeric_limits<double>::infinity());
+  EXPECT_EQ(histogram.get_statistics().count, 0U);
+}
+
+TEST(SlidingWindowHistogram, WindowExpiry)
+{
+  SlidingWindowHistogram histogram(3);
+  histogram.record(100.0);
+  histogram.advance();
+  histogram.record(10.0);
+  histogram.advance();
+
+  // both slices are still in the window
+  auto statistics = histogram.get_statistics();
+  EXPECT_EQ(statistics.count, 2U);
+  EXPECT_DOUBLE_EQ(statistics.max_ms, 100.0);
+
+  // the slice of 100 ms is dropped
+  histogram.advance();
+  statistics = histogram.get_statistics();
+  EXPECT_EQ(statistics.count, 1U);
+  EXPECT_DOUBLE_EQ(statistics.max_ms, 10.0);
+  EXPECT_NEAR(statistics.p99_ms, 10.0, 10.0 / 64.0);
+
+  // the slice of 10 ms is dropped
+  histogram.advance();
+  statistics = histogram.get_statistics();
+  EXPECT_EQ(statistics.count, 0U);
+  EXPECT_DOUBLE_EQ(statistics.max_ms, 0.0);
+}
+}  // namespace autoware::processing_time_checker
@@ -0,0 +1,147 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "latency_log_writer.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware::processing_time_checker
+{
+namespace
+{
+// read the little-endian values written by LatencyLogWriter
+class LogReader
+{
+public:
+  explicit LogReader(const std::string & file_path)
+  {
+    std::ifstream ifs(file_path, std::ios::binary);
+    bytes_.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+  }
+
+  uint64_t read_uint(const size_t size)
+  {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i) {
+      value |= static_cast<uint64_t>(static_cast<unsigned char>(bytes_.at(offset_ + i))) << (8 * i);
+    }
+    offset_ += size;
+    return value;
+  }
+
+  char read_char() { return static_cast<char>(read_uint(1)); }
+
+  float read_float()
+  {
+    const auto bits = static_cast<uint32_t>(read_uint(4));
+    float value{};
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  std::string read_string(const size_t size)
+  {
+    std::string str(bytes_.begin() + offset_, bytes_.begin() + offset_ + size);
+    offset_ += size;
+    return str;
+  }
+
+  bool at_end() const { return offset_ == bytes_.size(); }
+
+private:
+  std::vector<char> bytes_;
+  size_t offset_{0};
+};
+
+std::string get_log_path()
+{
+  return (std::filesystem::temp_directory_path() /
+          ("test_latency_log_writer_" + std::to_string(getpid()) + ".bin"))
+    .string();
+}
+}  // namespace
+
+TEST(LatencyLogWriter, Format)
+{
+  const auto log_path = get_log_path();
+  {
+    LatencyLogWriter writer(log_path);
+    LatencyStatistics statistics;
+    statistics.count = 3;
+    statistics.p50_ms = 1.5;
+    statistics.p99_ms = 2.5;
+    statistics.p999_ms = 3.5;
+    statistics.max_ms = 4.0;
+    writer.write(123456789, {{"planning", statistics}});
+    statistics.count = 4;
+    writer.write(223456789, {{"control", statistics}, {"planning", statistics}});
+  }
+
+  LogReader reader(log_path);
+  // header
+  EXPECT_EQ(reader.read_string(4), "PTCL");
+  EXPECT_EQ(reader.read_uint(4), 1U);
+
+  // name record before the first snapshot
+  EXPECT_EQ(reader.read_char(), 'N');
+  EXPECT_EQ(reader.read_uint(2), 0U);
+  EXPECT_EQ(reader.read_uint(2), 8U);
+  EXPECT_EQ(reader.read_string(8), "planning");
+
+  EXPECT_EQ(reader.read_char(), 'S');
+  EXPECT_EQ(reader.read_uint(8), 123456789U);
+  EXPECT_EQ(reader.read_uint(2), 1U);
+  EXPECT_EQ(reader.read_uint(2), 0U);
+  EXPECT_EQ(reader.read_uint(4), 3U);
+  EXPECT_FLOAT_EQ(reader.read_float(), 1.5F);
+  EXPECT_FLOAT_EQ(reader.read_float(), 2.5F);
+  EXPECT_FLOAT_EQ(reader.read_float(), 3.5F);
+  EXPECT_FLOAT_EQ(reader.read_float(), 4.0F);
+
+  // only the new name is written
+  EXPECT_EQ(reader.read_char(), 'N');
+  EXPECT_EQ(reader.read_uint(2), 1U);
+  EXPECT_EQ(reader.read_uint(2), 7U);
+  EXPECT_EQ(reader.read_string(7), "control");
+
+  EXPECT_EQ(reader.read_char(), 'S');
+  EXPECT_EQ(reader.read_uint(8), 223456789U);
+  EXPECT_EQ(reader.read_uint(2), 2U);
+  EXPECT_EQ(reader.read_uint(2), 1U);
+  EXPECT_EQ(reader.read_uint(4), 4U);
+  reader.read_string(16);
+  EXPECT_EQ(reader.read_uint(2), 0U);
+  EXPECT_EQ(reader.read_uint(4), 4U);
+  reader.read_string(16);
+  EXPECT_TRUE(reader.at_end());
+
+  std::filesystem::remove(log_path);
+}
+
+TEST(LatencyLogWriter, ThrowIfNotOpened)
+{
+  EXPECT_THROW(LatencyLogWriter("/nonexistent_directory/latency.bin"), std::runtime_error);
+}
+}  // namespace autoware::processing_time_checker
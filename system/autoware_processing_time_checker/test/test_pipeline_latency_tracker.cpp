@@ -0,0 +1,79 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pipeline_latency_tracker.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+namespace autoware::processing_time_checker
+{
+namespace
+{
+constexpr int64_t ms = 1000000;
+}  // namespace
+
+TEST(PipelineLatencyTracker, Latency)
+{
+  PipelineLatencyTracker tracker(3);
+
+  // the stages may be received in any order
+  EXPECT_FALSE(tracker.on_published(1, 100 * ms, 130 * ms));
+  EXPECT_FALSE(tracker.on_published(0, 100 * ms, 110 * ms));
+  const auto latency = tracker.on_published(2, 100 * ms, 160 * ms);
+  ASSERT_TRUE(latency);
+  EXPECT_DOUBLE_EQ(latency->total_ms, 60.0);
+  ASSERT_EQ(latency->stage_ms.size(), 3U);
+  EXPECT_DOUBLE_EQ(latency->stage_ms.at(0), 10.0);
+  EXPECT_DOUBLE_EQ(latency->stage_ms.at(1), 20.0);
+  EXPECT_DOUBLE_EQ(latency->stage_ms.at(2), 30.0);
+}
+
+TEST(PipelineLatencyTracker, InvalidStage)
+{
+  PipelineLatencyTracker tracker(1);
+  EXPECT_FALSE(tracker.on_published(1, 100 * ms, 110 * ms));
+  EXPECT_TRUE(tracker.on_published(0, 100 * ms, 110 * ms));
+}
+
+TEST(PipelineLatencyTracker, MatchByHeaderStamp)
+{
+  PipelineLatencyTracker tracker(2);
+  EXPECT_FALSE(tracker.on_published(0, 100 * ms, 110 * ms));
+  EXPECT_FALSE(tracker.on_published(0, 200 * ms, 205 * ms));
+
+  const auto latency_200 = tracker.on_published(1, 200 * ms, 230 * ms);
+  ASSERT_TRUE(latency_200);
+  EXPECT_DOUBLE_EQ(latency_200->total_ms, 30.0);
+  EXPECT_DOUBLE_EQ(latency_200->stage_ms.at(0), 5.0);
+
+  // the older stamp is dropped when a newer one is completed
+  EXPECT_FALSE(tracker.on_published(1, 100 * ms, 240 * ms));
+}
+
+TEST(PipelineLatencyTracker, DropOldestPendingStamp)
+{
+  PipelineLatencyTracker tracker(2, 2);
+  EXPECT_FALSE(tracker.on_published(0, 100 * ms, 110 * ms));
+  EXPECT_FALSE(tracker.on_published(0, 200 * ms, 210 * ms));
+  // the stamp 100 ms is dropped to keep 2 pending stamps
+  EXPECT_FALSE(tracker.on_published(0, 300 * ms, 310 * ms));
+
+  EXPECT_FALSE(tracker.on_published(1, 100 * ms, 120 * ms));
+  const auto latency = tracker.on_published(1, 300 * ms, 320 * ms);
+  ASSERT_TRUE(latency);
+  EXPECT_DOUBLE_EQ(latency->total_ms, 20.0);
+}
+}  // namespace autoware::processing_time_checker
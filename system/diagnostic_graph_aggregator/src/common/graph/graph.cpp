@@ -20,6 +20,8 @@
 #include "units.hpp"
 
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace diagnostic_graph_aggregator
 {
@@ -33,20 +35,37 @@ void Graph::create(const std::string & file, const std::string & id)
   for (const auto & diag : diags_) names_[diag->name()] = diag.get();
   for (const auto & node : nodes_) units_.push_back(node.get());
   for (const auto & diag : diags_) units_.push_back(diag.get());
+  for (const auto & unit : units_) unit->initialize_changes(&changes_);
 
   id_ = id;
 }
 
 void Graph::update(const rclcpp::Time & stamp)
 {
-  for (const auto & diag : diags_) diag->on_time(stamp);
+  // Only the diags whose deadline has passed can time out.
+  std::vector<DiagUnit *> expired;
+  const auto end = deadlines_.lower_bound({stamp.nanoseconds(), nullptr});
+  for (auto iter = deadlines_.begin(); iter != end; ++iter) expired.push_back(iter->second);
+  deadlines_.erase(deadlines_.begin(), end);
+
+  for (const auto & diag : expired) {
+    diag->on_time(stamp);
+    const auto deadline = diag->deadline();
+    if (deadline) deadlines_.emplace(deadline->nanoseconds(), diag);
+  }
 }
 
 bool Graph::update(const rclcpp::Time & stamp, const DiagnosticStatus & status)
 {
   const auto iter = names_.find(status.name);
   if (iter == names_.end()) return false;
-  iter->second->on_diag(stamp, status);
+
+  const auto diag = iter->second;
+  const auto prev_deadline = diag->deadline();
+  if (prev_deadline) deadlines_.erase({prev_deadline->nanoseconds(), diag});
+  diag->on_diag(stamp, status);
+  const auto curr_deadline = diag->deadline();
+  if (curr_deadline) deadlines_.emplace(curr_deadline->nanoseconds(), diag);
   return true;
 }
 
@@ -72,6 +91,20 @@ DiagGraphStatus Graph::create_status(const rclcpp::Time & stamp) const
   return msg;
 }
 
+DiagnosticArray Graph::create_delta(const rclcpp::Time & stamp)
+{
+  // The units without path cannot be identified, so they are only included in the full status.
+  DiagnosticArray msg;
+  msg.header.stamp = stamp;
+  for (const auto & unit : changes_) {
+    auto status = unit->create_diagnostic();
+    if (!status.name.empty()) msg.status.push_back(std::move(status));
+    unit->clear_changed();
+  }
+  changes_.clear();
+  return msg;
+}
+
 // For unique_ptr members.
 Graph::Graph() = default;
 Graph::~Graph() = default;
@@ -19,9 +19,12 @@
 
 #include <rclcpp/rclcpp.hpp>
 
+#include <cstdint>
 #include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace diagnostic_graph_aggregator
@@ -38,6 +41,7 @@ public:
   const auto & units() const { return units_; }
   DiagGraphStruct create_struct(const rclcpp::Time & stamp) const;
   DiagGraphStatus create_status(const rclcpp::Time & stamp) const;
+  DiagnosticArray create_delta(const rclcpp::Time & stamp);
 
   Graph();   // For unique_ptr members.
   ~Graph();  // For unique_ptr members.
@@ -50,6 +54,11 @@ private:
   std::vector<BaseUnit *> units_;
   std::unordered_map<std::string, DiagUnit *> names_;
   std::string id_;
+
+  // The diags ordered by the deadline to check the timeout without scanning all of them.
+  std::set<std::pair<int64_t, DiagUnit *>> deadlines_;
+  // The units whose status changed since the last delta.
+  std::vector<BaseUnit *> changes_;
 };
 
 }  // namespace diagnostic_graph_aggregator
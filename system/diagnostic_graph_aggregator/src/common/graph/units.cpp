@@ -47,6 +47,20 @@ BaseUnit::BaseUnit(const UnitLoader & unit)
   parents_ = unit.parents();
 }
 
+void BaseUnit::initialize_changes(std::vector<BaseUnit *> * changes)
+{
+  changes_ = changes;
+  changed_ = false;
+}
+
+void BaseUnit::mark_changed()
+{
+  // Register this unit only once until the changes are consumed.
+  if (changed_) return;
+  changed_ = true;
+  if (changes_) changes_->push_back(this);
+}
+
 bool BaseUnit::update()
 {
   // Update the level of this unit.
@@ -56,14 +70,13 @@ bool BaseUnit::update()
   const auto curr_level = level();
   if (curr_level == prev_level_) return false;
   prev_level_ = curr_level;
+  mark_changed();
 
-  // If the level changes, the parents also need to be updated.
-  bool result = false;
+  // If the level changes, the parents also need to be updated. Only the ancestors are evaluated.
   for (const auto & link : parents_) {
-    const auto unit = link->parent();
-    result = result || unit->update();
+    link->parent()->update();
   }
-  return result;
+  return true;
 }
 
 NodeUnit::NodeUnit(const UnitLoader & unit) : BaseUnit(unit)
@@ -82,6 +95,14 @@ void NodeUnit::initialize_status()
   if (child_links().size() == 0) update();
 }
 
+DiagnosticStatus NodeUnit::create_diagnostic() const
+{
+  DiagnosticStatus status;
+  status.level = status_.level;
+  status.name = struct_.path;
+  return status;
+}
+
 LeafUnit::LeafUnit(const UnitLoader & unit) : BaseUnit(unit)
 {
   const auto diag_node = unit.data().required("node").text();
@@ -103,6 +124,17 @@ void LeafUnit::initialize_status()
   if (child_links().size() == 0) update();
 }
 
+DiagnosticStatus LeafUnit::create_diagnostic() const
+{
+  DiagnosticStatus status;
+  status.level = status_.level;
+  status.name = struct_.name;
+  status.message = status_.message;
+  status.hardware_id = status_.hardware_id;
+  status.values = status_.values;
+  return status;
+}
+
 DiagUnit::DiagUnit(const UnitLoader & unit) : LeafUnit(unit)
 {
   timeout_ = unit.data().optional("timeout").real(1.0);
@@ -116,10 +148,22 @@ void DiagUnit::update_status()
 bool DiagUnit::on_diag(const rclcpp::Time & stamp, const DiagnosticStatus & status)
 {
   last_updated_time_ = stamp;
+
+  // The level change is detected by update, but the other fields need to be compared here.
+  // clang-format off
+  const bool is_same =
+    status_.level == status.level &&
+    status_.message == status.message &&
+    status_.hardware_id == status.hardware_id &&
+    status_.values == status.values;
+  // clang-format on
+  if (is_same) return false;
+
   status_.level = status.level;
   status_.message = status.message;
   status_.hardware_id = status.hardware_id;
   status_.values = status.values;
+  mark_changed();
   return update();
 }
 
@@ -132,11 +176,18 @@ bool DiagUnit::on_time(const rclcpp::Time & stamp)
       last_updated_time_ = std::nullopt;
       status_ = DiagLeafStatus();
       status_.level = DiagnosticStatus::STALE;
+      mark_changed();
     }
   }
   return update();
 }
 
+std::optional<rclcpp::Time> DiagUnit::deadline() const
+{
+  if (!last_updated_time_) return std::nullopt;
+  return last_updated_time_.value() + rclcpp::Duration::from_seconds(timeout_);
+}
+
 MaxUnit::MaxUnit(const UnitLoader & unit) : NodeUnit(unit)
 {
   links_ = unit.children();
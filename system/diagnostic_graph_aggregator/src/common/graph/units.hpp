@@ -57,17 +57,23 @@ public:
   virtual std::string type() const = 0;
   virtual std::vector<UnitLink *> child_links() const = 0;
   virtual bool is_leaf() const = 0;
+  virtual DiagnosticStatus create_diagnostic() const = 0;
   size_t index() const { return index_; }
   size_t parent_size() const { return parents_.size(); }
+  void initialize_changes(std::vector<BaseUnit *> * changes);
+  void clear_changed() { changed_ = false; }
 
 protected:
   bool update();
+  void mark_changed();
 
 private:
   virtual void update_status() = 0;
   size_t index_;
   std::vector<UnitLink *> parents_;
   std::optional<DiagnosticLevel> prev_level_;
+  std::vector<BaseUnit *> * changes_ = nullptr;
+  bool changed_ = false;
 };
 
 class NodeUnit : public BaseUnit
@@ -77,6 +83,7 @@ public:
   void initialize_struct();
   void initialize_status();
   bool is_leaf() const override { return false; }
+  DiagnosticStatus create_diagnostic() const override;
   DiagNodeStruct create_struct() const { return struct_; }
   DiagNodeStatus create_status() const { return status_; }
   DiagnosticLevel level() const override { return status_.level; }
@@ -94,6 +101,7 @@ public:
   void initialize_struct();
   void initialize_status();
   bool is_leaf() const override { return true; }
+  DiagnosticStatus create_diagnostic() const override;
   DiagLeafStruct create_struct() const { return struct_; }
   DiagLeafStatus create_status() const { return status_; }
   DiagnosticLevel level() const override { return status_.level; }
@@ -113,6 +121,7 @@ public:
   std::vector<UnitLink *> child_links() const override { return {}; }
   bool on_time(const rclcpp::Time & stamp);
   bool on_diag(const rclcpp::Time & stamp, const DiagnosticStatus & status);
+  std::optional<rclcpp::Time> deadline() const;
 
 private:
   void update_status() override;
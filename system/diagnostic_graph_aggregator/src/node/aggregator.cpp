@@ -14,6 +14,7 @@
 
 #include "aggregator.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -50,6 +51,14 @@ AggregatorNode::AggregatorNode(const rclcpp::NodeOptions & options) : Node("aggr
     pub_struct_ = create_publisher<DiagGraphStruct>("/diagnostics_graph/struct", qos_struct);
     pub_status_ = create_publisher<DiagGraphStatus>("/diagnostics_graph/status", qos_status);
 
+    // The defaults keep the previous behavior for the existing parameter files.
+    const auto full_status_interval = declare_parameter<int64_t>("full_status_interval", 1);
+    full_status_interval_ = std::max<int64_t>(1, full_status_interval);
+    full_status_count_ = 0;
+    if (declare_parameter<bool>("use_status_delta", false)) {
+      pub_delta_ = create_publisher<DiagnosticArray>("/diagnostics_graph/status_delta", qos_status);
+    }
+
     const auto rate = rclcpp::Rate(declare_parameter<double>("rate"));
     timer_ = rclcpp::create_timer(this, get_clock(), rate.period(), [this]() { on_timer(); });
   }
@@ -77,8 +86,10 @@ void AggregatorNode::on_timer()
   const auto stamp = now();
   graph_.update(stamp);
 
-  // Publish status.
-  pub_status_->publish(graph_.create_status(stamp));
+  // Publish the changed units every cycle and all units periodically.
+  if (pub_delta_) pub_delta_->publish(graph_.create_delta(stamp));
+  if (full_status_count_ == 0) pub_status_->publish(graph_.create_status(stamp));
+  full_status_count_ = (full_status_count_ + 1) % full_status_interval_;
   pub_unknown_->publish(create_unknown_diags(stamp));
   if (modes_) modes_->update(stamp);
 }
@@ -41,11 +41,14 @@ private:
   rclcpp::Publisher<DiagnosticArray>::SharedPtr pub_unknown_;
   rclcpp::Publisher<DiagGraphStruct>::SharedPtr pub_struct_;
   rclcpp::Publisher<DiagGraphStatus>::SharedPtr pub_status_;
+  rclcpp::Publisher<DiagnosticArray>::SharedPtr pub_delta_;
   DiagnosticArray create_unknown_diags(const rclcpp::Time & stamp);
   void on_timer();
   void on_diag(const DiagnosticArray & msg);
 
   std::unordered_map<std::string, DiagnosticStatus> unknown_diags_;
+  int64_t full_status_interval_;
+  int64_t full_status_count_;
 };
 
 }  // namespace diagnostic_graph_aggregator
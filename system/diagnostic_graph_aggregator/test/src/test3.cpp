@@ -0,0 +1,100 @@
+// Copyright 2023 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "graph/graph.hpp"
+#include "utils.hpp"
+
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+#include <diagnostic_msgs/msg/diagnostic_status.hpp>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+
+using namespace diagnostic_graph_aggregator;  // NOLINT(build/namespaces)
+
+using diagnostic_msgs::msg::DiagnosticArray;
+using diagnostic_msgs::msg::DiagnosticStatus;
+
+constexpr auto OK = DiagnosticStatus::OK;
+constexpr auto ERROR = DiagnosticStatus::ERROR;
+constexpr auto STALE = DiagnosticStatus::STALE;
+
+DiagnosticStatus create_status(const std::string & name, uint8_t level)
+{
+  DiagnosticStatus status;
+  status.name = name;
+  status.level = level;
+  return status;
+}
+
+using Levels = std::map<std::string, uint8_t>;
+
+Levels create_levels(const DiagnosticArray & array)
+{
+  Levels levels;
+  for (const auto & status : array.status) levels[status.name] = status.level;
+  return levels;
+}
+
+TEST(GraphDelta, ChangedUnitsOnly)
+{
+  const auto stamp = rclcpp::Time(1, 0);
+  Graph graph;
+  graph.create(resource("test2/and.yaml"));
+  EXPECT_TRUE(graph.create_delta(stamp).status.empty());
+
+  // Only one input is changed, so the output does not change.
+  graph.update(stamp, create_status("test: input-0", OK));
+  EXPECT_EQ(create_levels(graph.create_delta(stamp)), (Levels{{"test: input-0", OK}}));
+
+  // The output changes when all the inputs become OK.
+  graph.update(stamp, create_status("test: input-1", OK));
+  const auto levels = create_levels(graph.create_delta(stamp));
+  EXPECT_EQ(levels, (Levels{{"test: input-1", OK}, {"output", OK}}));
+
+  // The same status does not change anything.
+  graph.update(stamp, create_status("test: input-0", OK));
+  graph.update(stamp, create_status("test: input-1", OK));
+  EXPECT_TRUE(graph.create_delta(stamp).status.empty());
+
+  // The message change is included even if the level does not change.
+  auto status = create_status("test: input-0", OK);
+  status.message = "changed";
+  graph.update(stamp, status);
+  const auto delta = graph.create_delta(stamp);
+  ASSERT_EQ(delta.status.size(), 1u);
+  EXPECT_EQ(delta.status[0].message, "changed");
+}
+
+TEST(GraphDelta, Timeout)
+{
+  Graph graph;
+  graph.create(resource("test2/and.yaml"));
+  graph.update(rclcpp::Time(1, 0), create_status("test: input-0", OK));
+  graph.update(rclcpp::Time(1, 500000000), create_status("test: input-1", OK));
+  graph.create_delta(rclcpp::Time(1, 500000000));
+
+  // The default timeout is 1.0 second, so only input-0 times out.
+  const auto stamp1 = rclcpp::Time(2, 200000000);
+  graph.update(stamp1);
+  const auto levels1 = create_levels(graph.create_delta(stamp1));
+  EXPECT_EQ(levels1, (Levels{{"test: input-0", STALE}, {"output", ERROR}}));
+
+  const auto stamp2 = rclcpp::Time(2, 700000000);
+  graph.update(stamp2);
+  const auto levels2 = create_levels(graph.create_delta(stamp2));
+  EXPECT_EQ(levels2, (Levels{{"test: input-1", STALE}}));
+}
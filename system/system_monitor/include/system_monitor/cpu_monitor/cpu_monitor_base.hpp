@@ -20,6 +20,8 @@
 #ifndef SYSTEM_MONITOR__CPU_MONITOR__CPU_MONITOR_BASE_HPP_
 #define SYSTEM_MONITOR__CPU_MONITOR__CPU_MONITOR_BASE_HPP_
 
+#include "system_monitor/cpu_monitor/cpu_stat_sampler.hpp"
+
 #include <diagnostic_updater/diagnostic_updater.hpp>
 
 #include <tier4_external_api_msgs/msg/cpu_status.hpp>
@@ -102,12 +104,17 @@ protected:
 
   /**
    * @brief convert Cpu Usage To diagnostic Level
-   * @param [cpu_name] mpstat cpu name
+   * @param [cpu_name] cpu name, "all" or core index
    * @param [usage] cpu usage value
    * @return DiagStatus::OK or WARN or ERROR
    */
   virtual int CpuUsageToLevel(const std::string & cpu_name, float usage);
 
+  /**
+   * @brief sample CPU statistics on the timer
+   */
+  void onUsageTimer();
+
   /**
    * @brief check CPU load average
    * @param [out] stat diagnostic message passed directly to diagnostic publish calls
@@ -141,7 +148,10 @@ protected:
   std::vector<cpu_freq_info> freqs_;        //!< @brief CPU list for frequency
   std::vector<int> usage_warn_check_cnt_;   //!< @brief CPU list for usage over warn check counter
   std::vector<int> usage_error_check_cnt_;  //!< @brief CPU list for usage over error check counter
-  bool mpstat_exists_;                      //!< @brief flag if mpstat exists
+
+  CpuStatSampler cpu_stat_sampler_;           //!< @brief sampler of /proc/stat
+  rclcpp::TimerBase::SharedPtr usage_timer_;  //!< @brief timer to sample CPU statistics
+  rclcpp::CallbackGroup::SharedPtr usage_timer_callback_group_;  //!< @brief callback group
 
   float usage_warn_;       //!< @brief CPU usage(%) to generate warning
   float usage_error_;      //!< @brief CPU usage(%) to generate error
@@ -0,0 +1,119 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file cpu_stat_sampler.hpp
+ * @brief CPU statistics sampler reading /proc/stat
+ */
+
+#ifndef SYSTEM_MONITOR__CPU_MONITOR__CPU_STAT_SAMPLER_HPP_
+#define SYSTEM_MONITOR__CPU_MONITOR__CPU_STAT_SAMPLER_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief CPU usage of a core in percent
+ */
+struct CpuStatistics
+{
+  std::string name_;    //!< @brief cpu name, "all" or core index
+  float usr_{0.0f};     //!< @brief user time excluding guest time
+  float nice_{0.0f};    //!< @brief niced user time excluding guest time
+  float sys_{0.0f};     //!< @brief system time including irq and softirq
+  float iowait_{0.0f};  //!< @brief I/O wait time
+  float steal_{0.0f};   //!< @brief time stolen by the hypervisor
+  float idle_{0.0f};    //!< @brief idle time
+};
+
+/**
+ * @brief CPU usage of all cores between the last two samples
+ */
+struct CpuStatSnapshot
+{
+  std::vector<CpuStatistics> cpus_;  //!< @brief "all" followed by each core
+  std::string error_;                //!< @brief error message if /proc/stat cannot be read
+};
+
+/**
+ * @brief Sampler calculating the CPU usage from the differences of the /proc/stat counters.
+ * @note sample() is expected to be called from a single timer, and getSnapshot() can be called from
+ * any thread at any time. The snapshot is replaced as a whole, so that the readers never wait for
+ * the sampling.
+ */
+class CpuStatSampler
+{
+public:
+  /**
+   * @brief constructor
+   * @param [in] stat_path path to the kernel/system statistics file
+   * @note The first sample is taken in the constructor. It contains the average usage since boot.
+   */
+  explicit CpuStatSampler(const std::string & stat_path = "/proc/stat");
+
+  /**
+   * @brief read /proc/stat and update the snapshot
+   */
+  void sample();
+
+  /**
+   * @brief get the latest snapshot
+   * @return CPU usage between the last two samples
+   */
+  std::shared_ptr<const CpuStatSnapshot> getSnapshot() const;
+
+protected:
+  /**
+   * @brief cumulative time counters of a cpu line of /proc/stat in USER_HZ
+   */
+  struct CpuTimes
+  {
+    std::string name_;
+    uint64_t user_{0};
+    uint64_t nice_{0};
+    uint64_t system_{0};
+    uint64_t idle_{0};
+    uint64_t iowait_{0};
+    uint64_t irq_{0};
+    uint64_t softirq_{0};
+    uint64_t steal_{0};
+    uint64_t guest_{0};
+    uint64_t guest_nice_{0};
+  };
+
+  /**
+   * @brief read cpu lines of /proc/stat
+   * @param [out] times counters of "all" followed by each core
+   * @return empty string on success, otherwise error message
+   */
+  std::string readCpuTimes(std::vector<CpuTimes> & times) const;
+
+  /**
+   * @brief calculate the usage between two counters
+   * @param [in] prev previous counters
+   * @param [in] curr current counters
+   * @return usage in percent
+   */
+  static CpuStatistics calculateUsage(const CpuTimes & prev, const CpuTimes & curr);
+
+  std::string stat_path_;             //!< @brief path to /proc/stat
+  std::vector<CpuTimes> prev_times_;  //!< @brief counters of the previous sample
+
+  // latest snapshot, accessed only with std::atomic_load and std::atomic_store
+  std::shared_ptr<const CpuStatSnapshot> snapshot_;
+};
+
+#endif  // SYSTEM_MONITOR__CPU_MONITOR__CPU_STAT_SAMPLER_HPP_
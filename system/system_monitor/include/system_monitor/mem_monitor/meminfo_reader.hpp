@@ -0,0 +1,59 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file meminfo_reader.hpp
+ * @brief Memory statistics reader of /proc/meminfo
+ */
+
+#ifndef SYSTEM_MONITOR__MEM_MONITOR__MEMINFO_READER_HPP_
+#define SYSTEM_MONITOR__MEM_MONITOR__MEMINFO_READER_HPP_
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief Memory usage in bytes, the same values as `free -tb`
+ */
+struct MemoryUsage
+{
+  size_t mem_total_{0};       //!< @brief total physical memory
+  size_t mem_used_{0};        //!< @brief total - free - buff/cache
+  size_t mem_free_{0};        //!< @brief unused physical memory
+  size_t mem_shared_{0};      //!< @brief memory used by tmpfs
+  size_t mem_buff_cache_{0};  //!< @brief buffers, page cache and reclaimable slab
+  size_t mem_available_{0};   //!< @brief estimate of the memory available without swapping
+  size_t swap_total_{0};      //!< @brief total swap
+  size_t swap_used_{0};       //!< @brief total - free of swap
+  size_t swap_free_{0};       //!< @brief unused swap
+};
+
+/**
+ * @brief read /proc/meminfo
+ * @param [in] meminfo_path path to the memory statistics file
+ * @param [out] meminfo sizes in bytes, or counts for the entries without unit
+ * @return empty string on success, otherwise error message
+ */
+std::string readMeminfo(
+  const std::string & meminfo_path, std::unordered_map<std::string, size_t> & meminfo);
+
+/**
+ * @brief calculate the memory usage from the entries of /proc/meminfo
+ * @param [in] meminfo sizes in bytes, and a missing entry is regarded as 0
+ * @return memory usage
+ */
+MemoryUsage calculateMemoryUsage(const std::unordered_map<std::string, size_t> & meminfo);
+
+#endif  // SYSTEM_MONITOR__MEM_MONITOR__MEMINFO_READER_HPP_
@@ -22,20 +22,16 @@
 #include "system_monitor/system_monitor_utility.hpp"
 
 #include <boost/filesystem.hpp>
-#include <boost/process.hpp>
-#include <boost/property_tree/json_parser.hpp>
-#include <boost/property_tree/ptree.hpp>
 #include <boost/thread.hpp>
 
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <chrono>
 #include <regex>
 #include <string>
 
-namespace bp = boost::process;
 namespace fs = boost::filesystem;
-namespace pt = boost::property_tree;
 
 CPUMonitorBase::CPUMonitorBase(const std::string & node_name, const rclcpp::NodeOptions & options)
 : Node(node_name, options),
@@ -44,7 +40,6 @@ CPUMonitorBase::CPUMonitorBase(const std::string & node_name, const rclcpp::Node
   num_cores_(0),
   temps_(),
   freqs_(),
-  mpstat_exists_(false),
   usage_warn_(declare_parameter<float>("usage_warn", 0.96)),
   usage_error_(declare_parameter<float>("usage_error", 0.96)),
   usage_warn_count_(declare_parameter<int>("usage_warn_count", 1)),
@@ -56,9 +51,13 @@ CPUMonitorBase::CPUMonitorBase(const std::string & node_name, const rclcpp::Node
   usage_warn_check_cnt_.resize(num_cores_ + 2);   // 2 = all + dummy
   usage_error_check_cnt_.resize(num_cores_ + 2);  // 2 = all + dummy
 
-  // Check if command exists
-  fs::path p = bp::search_path("mpstat");
-  mpstat_exists_ = (p.empty()) ? false : true;
+  // Sample CPU statistics on its own timer, so that checkUsage never blocks
+  const double usage_sampling_period = declare_parameter<double>("usage_sampling_period", 1.0);
+  usage_timer_callback_group_ =
+    this->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  usage_timer_ = rclcpp::create_timer(
+    this, get_clock(), std::chrono::duration<double>(usage_sampling_period),
+    std::bind(&CPUMonitorBase::onUsageTimer, this), usage_timer_callback_group_);
 
   updater_.setHardwareID(hostname_);
   updater_.add("CPU Temperature", this, &CPUMonitorBase::checkTemp);
@@ -127,49 +126,13 @@ void CPUMonitorBase::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & st
   tier4_external_api_msgs::msg::CpuUsage cpu_usage;
   using CpuStatus = tier4_external_api_msgs::msg::CpuStatus;
 
-  if (!mpstat_exists_) {
-    stat.summary(DiagStatus::ERROR, "mpstat error");
-    stat.add(
-      "mpstat", "Command 'mpstat' not found, but can be installed with: sudo apt install sysstat");
-    cpu_usage.all.status = CpuStatus::STALE;
-    publishCpuUsage(cpu_usage);
-    return;
-  }
-
-  // Get CPU Usage
-
-  // boost::process create file descriptor without O_CLOEXEC required for multithreading.
-  // So create file descriptor with O_CLOEXEC and pass it to boost::process.
-  int out_fd[2];
-  if (pipe2(out_fd, O_CLOEXEC) != 0) {
-    stat.summary(DiagStatus::ERROR, "pipe2 error");
-    stat.add("pipe2", strerror(errno));
-    cpu_usage.all.status = CpuStatus::STALE;
-    publishCpuUsage(cpu_usage);
-    return;
-  }
-  bp::pipe out_pipe{out_fd[0], out_fd[1]};
-  bp::ipstream is_out{std::move(out_pipe)};
-
-  int err_fd[2];
-  if (pipe2(err_fd, O_CLOEXEC) != 0) {
-    stat.summary(DiagStatus::ERROR, "pipe2 error");
-    stat.add("pipe2", strerror(errno));
-    cpu_usage.all.status = CpuStatus::STALE;
-    publishCpuUsage(cpu_usage);
-    return;
-  }
-  bp::pipe err_pipe{err_fd[0], err_fd[1]};
-  bp::ipstream is_err{std::move(err_pipe)};
-
-  bp::child c("mpstat -P ALL 1 1 -o JSON", bp::std_out > is_out, bp::std_err > is_err);
-  c.wait();
-
-  if (c.exit_code() != 0) {
-    std::ostringstream os;
-    is_err >> os.rdbuf();
-    stat.summary(DiagStatus::ERROR, "mpstat error");
-    stat.add("mpstat", os.str().c_str());
+  // Get CPU Usage sampled from /proc/stat
+  const auto snapshot = cpu_stat_sampler_.getSnapshot();
+  if (!snapshot->error_.empty()) {
+    stat.summary(DiagStatus::ERROR, "stat error");
+    stat.add("stat", snapshot->error_);
+    std::fill(usage_warn_check_cnt_.begin(), usage_warn_check_cnt_.end(), 0);
+    std::fill(usage_error_check_cnt_.begin(), usage_error_check_cnt_.end(), 0);
     cpu_usage.all.status = CpuStatus::STALE;
     publishCpuUsage(cpu_usage);
     return;
@@ -178,96 +141,42 @@ void CPUMonitorBase::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & st
   int level = DiagStatus::OK;
   int whole_level = DiagStatus::OK;
 
-  pt::ptree pt;
-  try {
-    // Analyze JSON output
-    read_json(is_out, pt);
-
-    for (const pt::ptree::value_type & child1 : pt.get_child("sysstat.hosts")) {
-      const pt::ptree & hosts = child1.second;
-
-      for (const pt::ptree::value_type & child2 : hosts.get_child("statistics")) {
-        const pt::ptree & statistics = child2.second;
-
-        for (const pt::ptree::value_type & child3 : statistics.get_child("cpu-load")) {
-          const pt::ptree & cpu_load = child3.second;
-          bool get_cpu_name = false;
-
-          CpuStatus cpu_status;
-
-          std::string cpu_name;
-          float usr{0.0};
-          float nice{0.0};
-          float sys{0.0};
-          float iowait{0.0};
-          float idle{0.0};
-          float usage{0.0};
-          float total{0.0};
-
-          if (boost::optional<std::string> v = cpu_load.get_optional<std::string>("cpu")) {
-            cpu_name = v.get();
-            get_cpu_name = true;
-          }
-          if (boost::optional<float> v = cpu_load.get_optional<float>("usr")) {
-            usr = v.get();
-            cpu_status.usr = usr;
-          }
-          if (boost::optional<float> v = cpu_load.get_optional<float>("nice")) {
-            nice = v.get();
-            cpu_status.nice = nice;
-          }
-          if (boost::optional<float> v = cpu_load.get_optional<float>("sys")) {
-            sys = v.get();
-            cpu_status.sys = sys;
-          }
-          if (boost::optional<float> v = cpu_load.get_optional<float>("idle")) {
-            idle = v.get();
-            cpu_status.idle = idle;
-          }
-
-          total = 100.0 - iowait - idle;
-          usage = total * 1e-2;
-          if (get_cpu_name) {
-            level = CpuUsageToLevel(cpu_name, usage);
-          } else {
-            level = CpuUsageToLevel(std::string("err"), usage);
-          }
-
-          cpu_status.total = total;
-          cpu_status.status = level;
-
-          stat.add(fmt::format("CPU {}: status", cpu_name), load_dict_.at(level));
-          stat.addf(fmt::format("CPU {}: total", cpu_name), "%.2f%%", total);
-          stat.addf(fmt::format("CPU {}: usr", cpu_name), "%.2f%%", usr);
-          stat.addf(fmt::format("CPU {}: nice", cpu_name), "%.2f%%", nice);
-          stat.addf(fmt::format("CPU {}: sys", cpu_name), "%.2f%%", sys);
-          stat.addf(fmt::format("CPU {}: idle", cpu_name), "%.2f%%", idle);
-
-          if (usage_avg_ == true) {
-            if (cpu_name == "all") {
-              whole_level = level;
-            }
-          } else {
-            whole_level = std::max(whole_level, level);
-          }
-
-          if (cpu_name == "all") {
-            cpu_usage.all = cpu_status;
-          } else {
-            cpu_usage.cpus.push_back(cpu_status);
-          }
-        }
+  for (const auto & cpu : snapshot->cpus_) {
+    CpuStatus cpu_status;
+    cpu_status.usr = cpu.usr_;
+    cpu_status.nice = cpu.nice_;
+    cpu_status.sys = cpu.sys_;
+    cpu_status.idle = cpu.idle_;
+
+    const float total = 100.0 - cpu.iowait_ - cpu.idle_;
+    const float usage = total * 1e-2;
+    level = CpuUsageToLevel(cpu.name_, usage);
+
+    cpu_status.total = total;
+    cpu_status.status = level;
+
+    stat.add(fmt::format("CPU {}: status", cpu.name_), load_dict_.at(level));
+    stat.addf(fmt::format("CPU {}: total", cpu.name_), "%.2f%%", total);
+    stat.addf(fmt::format("CPU {}: usr", cpu.name_), "%.2f%%", cpu.usr_);
+    stat.addf(fmt::format("CPU {}: nice", cpu.name_), "%.2f%%", cpu.nice_);
+    stat.addf(fmt::format("CPU {}: sys", cpu.name_), "%.2f%%", cpu.sys_);
+    stat.addf(fmt::format("CPU {}: iowait", cpu.name_), "%.2f%%", cpu.iowait_);
+    stat.addf(fmt::format("CPU {}: steal", cpu.name_), "%.2f%%", cpu.steal_);
+    stat.addf(fmt::format("CPU {}: idle", cpu.name_), "%.2f%%", cpu.idle_);
+
+    if (usage_avg_ == true) {
+      if (cpu.name_ == "all") {
+        whole_level = level;
       }
+    } else {
+      whole_level = std::max(whole_level, level);
+    }
+
+    if (cpu.name_ == "all") {
+      cpu_usage.all = cpu_status;
+    } else {
+      cpu_usage.cpus.push_back(cpu_status);
     }
-  } catch (const std::exception & e) {
-    stat.summary(DiagStatus::ERROR, "mpstat exception");
-    stat.add("mpstat", e.what());
-    std::fill(usage_warn_check_cnt_.begin(), usage_warn_check_cnt_.end(), 0);
-    std::fill(usage_error_check_cnt_.begin(), usage_error_check_cnt_.end(), 0);
-    cpu_usage.all.status = CpuStatus::STALE;
-    cpu_usage.cpus.clear();
-    publishCpuUsage(cpu_usage);
-    return;
   }
 
   stat.summary(whole_level, load_dict_.at(whole_level));
@@ -279,6 +188,11 @@ void CPUMonitorBase::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & st
   SystemMonitorUtility::stopMeasurement(t_start, stat);
 }
 
+void CPUMonitorBase::onUsageTimer()
+{
+  cpu_stat_sampler_.sample();
+}
+
 int CPUMonitorBase::CpuUsageToLevel(const std::string & cpu_name, float usage)
 {
   // cpu name to counter index
@@ -290,7 +204,7 @@ int CPUMonitorBase::CpuUsageToLevel(const std::string & cpu_name, float usage)
     }
     idx = num + 1;
   } catch (std::exception &) {
-    if (cpu_name == std::string("all")) {  // mpstat output "all"
+    if (cpu_name == std::string("all")) {  // total of all cores
       idx = 0;
     } else {
       idx = num_cores_ + 1;
@@ -0,0 +1,140 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file cpu_stat_sampler.cpp
+ * @brief CPU statistics sampler reading /proc/stat
+ */
+
+#include "system_monitor/cpu_monitor/cpu_stat_sampler.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+CpuStatSampler::CpuStatSampler(const std::string & stat_path)
+: stat_path_(stat_path), snapshot_(std::make_shared<CpuStatSnapshot>())
+{
+  sample();
+}
+
+void CpuStatSampler::sample()
+{
+  auto snapshot = std::make_shared<CpuStatSnapshot>();
+
+  std::vector<CpuTimes> curr_times;
+  snapshot->error_ = readCpuTimes(curr_times);
+
+  if (snapshot->error_.empty()) {
+    // Before the first sample, the counters since boot are used as they are
+    if (prev_times_.size() != curr_times.size()) {
+      prev_times_.assign(curr_times.size(), CpuTimes{});
+    }
+    snapshot->cpus_.reserve(curr_times.size());
+    for (size_t i = 0; i < curr_times.size(); ++i) {
+      snapshot->cpus_.push_back(calculateUsage(prev_times_[i], curr_times[i]));
+    }
+    prev_times_ = std::move(curr_times);
+  }
+
+  std::atomic_store(&snapshot_, std::shared_ptr<const CpuStatSnapshot>(std::move(snapshot)));
+}
+
+std::shared_ptr<const CpuStatSnapshot> CpuStatSampler::getSnapshot() const
+{
+  return std::atomic_load(&snapshot_);
+}
+
+std::string CpuStatSampler::readCpuTimes(std::vector<CpuTimes> & times) const
+{
+  std::ifstream ifs(stat_path_, std::ios::in);
+  if (!ifs) {
+    return stat_path_ + ": " + strerror(errno);
+  }
+
+  /*
+   Example of /proc/stat
+   cpu  user nice system idle iowait irq softirq steal guest guest_nice
+   cpu  10132153 290696 3084719 46828483 16683 0 25195 0 175628 0
+   cpu0 1393280 32966 572056 13343292 6130 0 17875 0 23933 0
+   intr 1462898 ...
+   */
+  std::string line;
+  while (std::getline(ifs, line)) {
+    if (line.compare(0, 3, "cpu") != 0) {
+      break;
+    }
+
+    std::istringstream iss(line);
+    std::string name;
+    CpuTimes t;
+    iss >> name >> t.user_ >> t.nice_ >> t.system_ >> t.idle_;
+    if (!iss) {
+      return stat_path_ + ": format error";
+    }
+    // The other columns are appended by newer kernels, e.g., steal in Linux 2.6.11, guest in
+    // 2.6.24 and guest_nice in 2.6.33. The missing ones are left as 0.
+    iss >> t.iowait_ >> t.irq_ >> t.softirq_ >> t.steal_ >> t.guest_ >> t.guest_nice_;
+
+    // "cpu" is the total of all cores, and "cpuN" is core N
+    t.name_ = (name == "cpu") ? "all" : name.substr(3);
+    times.push_back(t);
+  }
+
+  if (times.empty()) {
+    return stat_path_ + ": format error";
+  }
+  return "";
+}
+
+CpuStatistics CpuStatSampler::calculateUsage(const CpuTimes & prev, const CpuTimes & curr)
+{
+  // The counters may go backwards when a core is brought back online
+  const auto diff = [](uint64_t c, uint64_t p) {
+    return c > p ? static_cast<double>(c - p) : 0.0;
+  };
+
+  // user and nice include guest and guest_nice, respectively
+  const double user =
+    std::max(diff(curr.user_, prev.user_) - diff(curr.guest_, prev.guest_), 0.0);
+  const double nice =
+    std::max(diff(curr.nice_, prev.nice_) - diff(curr.guest_nice_, prev.guest_nice_), 0.0);
+  const double system = diff(curr.system_, prev.system_) + diff(curr.irq_, prev.irq_) +
+                        diff(curr.softirq_, prev.softirq_);
+  const double iowait = diff(curr.iowait_, prev.iowait_);
+  const double steal = diff(curr.steal_, prev.steal_);
+  const double idle = diff(curr.idle_, prev.idle_);
+  const double guest = diff(curr.guest_, prev.guest_) + diff(curr.guest_nice_, prev.guest_nice_);
+  const double total = user + nice + system + iowait + steal + idle + guest;
+
+  CpuStatistics usage;
+  usage.name_ = curr.name_;
+  if (total <= 0.0) {
+    usage.idle_ = 100.0f;
+    return usage;
+  }
+  usage.usr_ = static_cast<float>(user / total * 1e2);
+  usage.nice_ = static_cast<float>(nice / total * 1e2);
+  usage.sys_ = static_cast<float>(system / total * 1e2);
+  usage.iowait_ = static_cast<float>(iowait / total * 1e2);
+  usage.steal_ = static_cast<float>(steal / total * 1e2);
+  usage.idle_ = static_cast<float>(idle / total * 1e2);
+  return usage;
+}
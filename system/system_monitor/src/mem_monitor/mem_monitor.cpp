@@ -19,14 +19,18 @@
 
 #include "system_monitor/mem_monitor/mem_monitor.hpp"
 
+#include "system_monitor/mem_monitor/meminfo_reader.hpp"
 #include "system_monitor/system_monitor_utility.hpp"
 
 #include <boost/process.hpp>
 
 #include <fmt/format.h>
 
+#include <cerrno>
+#include <cstring>
+#include <sstream>
 #include <string>
-#include <vector>
+#include <unordered_map>
 
 namespace bp = boost::process;
 
@@ -56,100 +60,43 @@ void MemMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
   const auto t_start = SystemMonitorUtility::startMeasurement();
 
   // Get total amount of free and used memory
-
-  // boost::process create file descriptor without O_CLOEXEC required for multithreading.
-  // So create file descriptor with O_CLOEXEC and pass it to boost::process.
-  int out_fd[2];
-  if (pipe2(out_fd, O_CLOEXEC) != 0) {
-    stat.summary(DiagStatus::ERROR, "pipe2 error");
-    stat.add("pipe2", strerror(errno));
-    return;
-  }
-  bp::pipe out_pipe{out_fd[0], out_fd[1]};
-  bp::ipstream is_out{std::move(out_pipe)};
-
-  int err_fd[2];
-  if (pipe2(err_fd, O_CLOEXEC) != 0) {
-    stat.summary(DiagStatus::ERROR, "pipe2 error");
-    stat.add("pipe2", strerror(errno));
+  std::unordered_map<std::string, size_t> meminfo;
+  const std::string error_str = readMeminfo("/proc/meminfo", meminfo);
+  if (!error_str.empty()) {
+    stat.summary(DiagStatus::ERROR, "meminfo error");
+    stat.add("meminfo", error_str);
     return;
   }
-  bp::pipe err_pipe{err_fd[0], err_fd[1]};
-  bp::ipstream is_err{std::move(err_pipe)};
-
-  bp::child c("free -tb", bp::std_out > is_out, bp::std_err > is_err);
-  c.wait();
-  if (c.exit_code() != 0) {
-    std::ostringstream os;
-    is_err >> os.rdbuf();
-    stat.summary(DiagStatus::ERROR, "free error");
-    stat.add("free", os.str().c_str());
-    return;
-  }
-
-  std::string line;
-  int index = 0;
-  std::vector<std::string> list;
-  float usage;
-  size_t mem_total = 0;
-  size_t mem_shared = 0;
-  size_t mem_available = 0;
-  size_t used_plus = 0;
-
-  /*
-   Output example of `free -tb`
-
-             list[0]     list[1]     list[2]     list[3]     list[4]     list[5]     list[6]
-   index 0 |               total        used        free      shared  buff/cache   available
-   index 1 | Mem:       32809744    12554780    13090376      292840     7164588    19622092
-   index 2 | Swap:      33554428     1767680    31786748
-   index 3 | Total:     66364172    14322460    44877124
-  */
-  while (std::getline(is_out, line) && !line.empty()) {
-    // Skip header
-    if (index <= 0) {
-      ++index;
-      continue;
-    }
-
-    boost::split(list, line, boost::is_space(), boost::token_compress_on);
-
-    // Physical memory
-    if (index == 1) {
-      mem_total = std::atoll(list[1].c_str());
-      mem_shared = std::atoll(list[4].c_str());
-      mem_available = std::atoll(list[6].c_str());
-
-      // available divided by total is available memory including calculation for buff/cache,
-      // so the subtraction of this from 1 gives real usage.
-      usage = 1.0f - static_cast<double>(mem_available) / mem_total;
-      stat.addf(fmt::format("{} usage", list[0]), "%.2f%%", usage * 1e+2);
-    }
-
-    stat.add(fmt::format("{} total", list[0]), toHumanReadable(list[1]));
-    stat.add(fmt::format("{} used", list[0]), toHumanReadable(list[2]));
-    stat.add(fmt::format("{} free", list[0]), toHumanReadable(list[3]));
-
-    // Add an additional information for physical memory
-    if (index == 1) {
-      stat.add(fmt::format("{} shared", list[0]), toHumanReadable(list[4]));
-      stat.add(fmt::format("{} buff/cache", list[0]), toHumanReadable(list[5]));
-      stat.add(fmt::format("{} available", list[0]), toHumanReadable(list[6]));
-    } else if (index == 3) {
-      // Total:used + Mem:shared
-      used_plus = std::atoll(list[2].c_str()) + mem_shared;
-      double giga = static_cast<double>(used_plus) / (1024 * 1024 * 1024);
-      stat.add(fmt::format("{} used+", list[0]), fmt::format("{:.1f}{}", giga, "G"));
-    } else {
-      /* nothing */
-    }
-    ++index;
-  }
+  const auto usage = calculateMemoryUsage(meminfo);
+
+  // available divided by total is available memory including calculation for buff/cache,
+  // so the subtraction of this from 1 gives real usage.
+  const float usage_ratio = 1.0f - static_cast<double>(usage.mem_available_) / usage.mem_total_;
+  stat.addf("Mem: usage", "%.2f%%", usage_ratio * 1e+2);
+  stat.add("Mem: total", toHumanReadable(std::to_string(usage.mem_total_)));
+  stat.add("Mem: used", toHumanReadable(std::to_string(usage.mem_used_)));
+  stat.add("Mem: free", toHumanReadable(std::to_string(usage.mem_free_)));
+  stat.add("Mem: shared", toHumanReadable(std::to_string(usage.mem_shared_)));
+  stat.add("Mem: buff/cache", toHumanReadable(std::to_string(usage.mem_buff_cache_)));
+  stat.add("Mem: available", toHumanReadable(std::to_string(usage.mem_available_)));
+
+  stat.add("Swap: total", toHumanReadable(std::to_string(usage.swap_total_)));
+  stat.add("Swap: used", toHumanReadable(std::to_string(usage.swap_used_)));
+  stat.add("Swap: free", toHumanReadable(std::to_string(usage.swap_free_)));
+
+  stat.add("Total: total", toHumanReadable(std::to_string(usage.mem_total_ + usage.swap_total_)));
+  stat.add("Total: used", toHumanReadable(std::to_string(usage.mem_used_ + usage.swap_used_)));
+  stat.add("Total: free", toHumanReadable(std::to_string(usage.mem_free_ + usage.swap_free_)));
+
+  // Total:used + Mem:shared
+  const size_t used_plus = usage.mem_used_ + usage.swap_used_ + usage.mem_shared_;
+  const double giga = static_cast<double>(used_plus) / (1024 * 1024 * 1024);
+  stat.add("Total: used+", fmt::format("{:.1f}{}", giga, "G"));
 
   int level;
-  if (mem_total > used_plus) {
+  if (usage.mem_total_ > used_plus) {
     level = DiagStatus::OK;
-  } else if (mem_available >= available_size_) {
+  } else if (usage.mem_available_ >= available_size_) {
     level = DiagStatus::WARN;
   } else {
     level = DiagStatus::ERROR;
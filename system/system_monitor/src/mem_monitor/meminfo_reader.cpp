@@ -0,0 +1,86 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * @file meminfo_reader.cpp
+ * @brief Memory statistics reader of /proc/meminfo
+ */
+
+#include "system_monitor/mem_monitor/meminfo_reader.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+std::string readMeminfo(
+  const std::string & meminfo_path, std::unordered_map<std::string, size_t> & meminfo)
+{
+  std::ifstream ifs(meminfo_path, std::ios::in);
+  if (!ifs) {
+    return meminfo_path + ": " + strerror(errno);
+  }
+
+  /*
+   Example of /proc/meminfo
+   MemTotal:       32809744 kB
+   MemFree:        13090376 kB
+   MemAvailable:   19622092 kB
+   HugePages_Total:       0
+   */
+  std::string line;
+  while (std::getline(ifs, line)) {
+    std::istringstream iss(line);
+    std::string key;
+    size_t value;
+    std::string unit;
+    if (!(iss >> key >> value) || key.empty() || key.back() != ':') {
+      continue;
+    }
+    key.pop_back();
+    iss >> unit;
+    meminfo[key] = (unit == "kB") ? value * 1024 : value;
+  }
+
+  if (meminfo.find("MemTotal") == meminfo.end() || meminfo.at("MemTotal") == 0) {
+    return meminfo_path + ": format error";
+  }
+  return "";
+}
+
+MemoryUsage calculateMemoryUsage(const std::unordered_map<std::string, size_t> & meminfo)
+{
+  const auto get = [&meminfo](const std::string & key) -> size_t {
+    const auto itr = meminfo.find(key);
+    return itr != meminfo.end() ? itr->second : 0;
+  };
+
+  // Calculate the same values as `free -tb`
+  MemoryUsage usage;
+  usage.mem_total_ = get("MemTotal");
+  usage.mem_free_ = get("MemFree");
+  usage.mem_shared_ = get("Shmem");
+  usage.mem_buff_cache_ = get("Buffers") + get("Cached") + get("SReclaimable");
+  usage.mem_available_ = get("MemAvailable");
+  usage.mem_used_ = usage.mem_total_ > usage.mem_free_ + usage.mem_buff_cache_
+                      ? usage.mem_total_ - usage.mem_free_ - usage.mem_buff_cache_
+                      : 0;
+  usage.swap_total_ = get("SwapTotal");
+  usage.swap_free_ = get("SwapFree");
+  usage.swap_used_ =
+    usage.swap_total_ > usage.swap_free_ ? usage.swap_total_ - usage.swap_free_ : 0;
+  return usage;
+}
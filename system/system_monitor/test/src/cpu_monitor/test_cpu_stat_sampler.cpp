@@ -0,0 +1,165 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "system_monitor/cpu_monitor/cpu_stat_sampler.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+class CpuStatSamplerTestSuite : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    stat_path_ = ::testing::TempDir() + "test_cpu_stat_" + std::to_string(getpid());
+  }
+
+  void TearDown() override { std::remove(stat_path_.c_str()); }
+
+  void writeStat(const std::string & content)
+  {
+    std::ofstream ofs(stat_path_);
+    ofs << content;
+  }
+
+  std::string stat_path_;
+};
+
+TEST_F(CpuStatSamplerTestSuite, usageFromDeltas)
+{
+  // user nice system idle iowait irq softirq steal guest guest_nice
+  writeStat(
+    "cpu  1000 100 500 8000 100 0 0 0 0 0\n"
+    "cpu0 1000 100 500 8000 100 0 0 0 0 0\n"
+    "intr 1462898\n");
+  CpuStatSampler sampler(stat_path_);
+
+  writeStat(
+    "cpu  1300 150 600 8250 50 20 30 50 100 0\n"
+    "cpu0 1000 100 500 8100 100 0 0 0 0 0\n"
+    "intr 1462898\n");
+  sampler.sample();
+
+  const auto snapshot = sampler.getSnapshot();
+  EXPECT_TRUE(snapshot->error_.empty());
+  ASSERT_EQ(snapshot->cpus_.size(), 2U);
+
+  // the iowait counter went backwards, so that its delta is 0
+  // user 200 without guest, nice 50, system 150 with irq and softirq, steal 50, idle 250 and
+  // guest 100, i.e. 800 in total
+  const auto & all = snapshot->cpus_.at(0);
+  EXPECT_EQ(all.name_, "all");
+  EXPECT_FLOAT_EQ(all.usr_, 25.0f);
+  EXPECT_FLOAT_EQ(all.nice_, 6.25f);
+  EXPECT_FLOAT_EQ(all.sys_, 18.75f);
+  EXPECT_FLOAT_EQ(all.iowait_, 0.0f);
+  EXPECT_FLOAT_EQ(all.steal_, 6.25f);
+  EXPECT_FLOAT_EQ(all.idle_, 31.25f);
+
+  const auto & cpu0 = snapshot->cpus_.at(1);
+  EXPECT_EQ(cpu0.name_, "0");
+  EXPECT_FLOAT_EQ(cpu0.usr_, 0.0f);
+  EXPECT_FLOAT_EQ(cpu0.idle_, 100.0f);
+}
+
+TEST_F(CpuStatSamplerTestSuite, firstSampleSinceBoot)
+{
+  writeStat("cpu  100 0 100 800 0 0 0 0 0 0\n");
+  CpuStatSampler sampler(stat_path_);
+
+  const auto snapshot = sampler.getSnapshot();
+  ASSERT_EQ(snapshot->cpus_.size(), 1U);
+  EXPECT_FLOAT_EQ(snapshot->cpus_.at(0).usr_, 10.0f);
+  EXPECT_FLOAT_EQ(snapshot->cpus_.at(0).sys_, 10.0f);
+  EXPECT_FLOAT_EQ(snapshot->cpus_.at(0).idle_, 80.0f);
+}
+
+TEST_F(CpuStatSamplerTestSuite, counterReset)
+{
+  writeStat("cpu  1000 0 1000 8000 0 0 0 0 0 0\n");
+  CpuStatSampler sampler(stat_path_);
+
+  // all the counters went backwards, e.g., when a core is brought back online
+  writeStat("cpu  10 0 10 80 0 0 0 0 0 0\n");
+  sampler.sample();
+  auto snapshot = sampler.getSnapshot();
+  ASSERT_EQ(snapshot->cpus_.size(), 1U);
+  EXPECT_FLOAT_EQ(snapshot->cpus_.at(0).usr_, 0.0f);
+  EXPECT_FLOAT_EQ(snapshot->cpus_.at(0).idle_, 100.0f);
+
+  // the next sample is relative to the reset counters
+  writeStat("cpu  60 0 10 130 0 0 0 0 0 0\n");
+  sampler.sample();
+  snapshot = sampler.getSnapshot();
+  EXPECT_FLOAT_EQ(snapshot->cpus_.at(0).usr_, 50.0f);
+  EXPECT_FLOAT_EQ(snapshot->cpus_.at(0).idle_, 50.0f);
+}
+
+TEST_F(CpuStatSamplerTestSuite, coreAdded)
+{
+  writeStat("cpu  100 0 0 100 0 0 0 0 0 0\ncpu0 100 0 0 100 0 0 0 0 0 0\n");
+  CpuStatSampler sampler(stat_path_);
+
+  // the counters since boot are used when the number of cores changes
+  writeStat(
+    "cpu  300 0 0 300 0 0 0 0 0 0\ncpu0 200 0 0 200 0 0 0 0 0 0\n"
+    "cpu1 100 0 0 300 0 0 0 0 0 0\n");
+  sampler.sample();
+  const auto snapshot = sampler.getSnapshot();
+  ASSERT_EQ(snapshot->cpus_.size(), 3U);
+  EXPECT_EQ(snapshot->cpus_.at(2).name_, "1");
+  EXPECT_FLOAT_EQ(snapshot->cpus_.at(2).usr_, 25.0f);
+}
+
+TEST_F(CpuStatSamplerTestSuite, missingColumns)
+{
+  // kernels older than 2.5.41 have neither iowait nor steal
+  writeStat("cpu  100 0 100 800\n");
+  CpuStatSampler sampler(stat_path_);
+
+  writeStat("cpu  200 0 200 1400\n");
+  sampler.sample();
+  const auto snapshot = sampler.getSnapshot();
+  EXPECT_TRUE(snapshot->error_.empty());
+  ASSERT_EQ(snapshot->cpus_.size(), 1U);
+  EXPECT_FLOAT_EQ(snapshot->cpus_.at(0).usr_, 12.5f);
+  EXPECT_FLOAT_EQ(snapshot->cpus_.at(0).sys_, 12.5f);
+  EXPECT_FLOAT_EQ(snapshot->cpus_.at(0).iowait_, 0.0f);
+  EXPECT_FLOAT_EQ(snapshot->cpus_.at(0).steal_, 0.0f);
+  EXPECT_FLOAT_EQ(snapshot->cpus_.at(0).idle_, 75.0f);
+}
+
+TEST_F(CpuStatSamplerTestSuite, formatError)
+{
+  writeStat("cpu  100 0\n");
+  CpuStatSampler sampler(stat_path_);
+  EXPECT_FALSE(sampler.getSnapshot()->error_.empty());
+  EXPECT_TRUE(sampler.getSnapshot()->cpus_.empty());
+
+  writeStat("intr 1462898\n");
+  sampler.sample();
+  EXPECT_FALSE(sampler.getSnapshot()->error_.empty());
+}
+
+TEST_F(CpuStatSamplerTestSuite, fileNotFound)
+{
+  CpuStatSampler sampler(stat_path_ + "_not_found");
+  const auto snapshot = sampler.getSnapshot();
+  EXPECT_FALSE(snapshot->error_.empty());
+  EXPECT_TRUE(snapshot->cpus_.empty());
+}
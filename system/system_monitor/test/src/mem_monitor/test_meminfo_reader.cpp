@@ -0,0 +1,111 @@
+// Copyright 2024 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "system_monitor/mem_monitor/meminfo_reader.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+class MeminfoReaderTestSuite : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    meminfo_path_ = ::testing::TempDir() + "test_meminfo_" + std::to_string(getpid());
+  }
+
+  void TearDown() override { std::remove(meminfo_path_.c_str()); }
+
+  void writeMeminfo(const std::string & content)
+  {
+    std::ofstream ofs(meminfo_path_);
+    ofs << content;
+  }
+
+  std::string meminfo_path_;
+};
+
+TEST_F(MeminfoReaderTestSuite, readAndCalculate)
+{
+  writeMeminfo(
+    "MemTotal:       32000000 kB\n"
+    "MemFree:        10000000 kB\n"
+    "MemAvailable:   20000000 kB\n"
+    "Buffers:          500000 kB\n"
+    "Cached:          6000000 kB\n"
+    "SwapCached:            0 kB\n"
+    "SwapTotal:       8000000 kB\n"
+    "SwapFree:        7000000 kB\n"
+    "Shmem:            300000 kB\n"
+    "SReclaimable:     500000 kB\n"
+    "HugePages_Total:       0\n"
+    "Hugepagesize:       2048 kB\n");
+
+  std::unordered_map<std::string, size_t> meminfo;
+  ASSERT_EQ(readMeminfo(meminfo_path_, meminfo), "");
+  EXPECT_EQ(meminfo.at("MemTotal"), 32000000UL * 1024);
+  EXPECT_EQ(meminfo.at("HugePages_Total"), 0UL);
+  EXPECT_EQ(meminfo.at("Hugepagesize"), 2048UL * 1024);
+
+  constexpr size_t kb = 1024;
+  const auto usage = calculateMemoryUsage(meminfo);
+  EXPECT_EQ(usage.mem_total_, 32000000 * kb);
+  EXPECT_EQ(usage.mem_free_, 10000000 * kb);
+  EXPECT_EQ(usage.mem_shared_, 300000 * kb);
+  EXPECT_EQ(usage.mem_buff_cache_, 7000000 * kb);
+  EXPECT_EQ(usage.mem_used_, 15000000 * kb);
+  EXPECT_EQ(usage.mem_available_, 20000000 * kb);
+  EXPECT_EQ(usage.swap_total_, 8000000 * kb);
+  EXPECT_EQ(usage.swap_used_, 1000000 * kb);
+  EXPECT_EQ(usage.swap_free_, 7000000 * kb);
+}
+
+TEST_F(MeminfoReaderTestSuite, missingEntries)
+{
+  // e.g., without swap and SReclaimable
+  writeMeminfo("MemTotal: 1000 kB\nMemFree: 1200 kB\nCached: 100 kB\n");
+
+  std::unordered_map<std::string, size_t> meminfo;
+  ASSERT_EQ(readMeminfo(meminfo_path_, meminfo), "");
+  const auto usage = calculateMemoryUsage(meminfo);
+  EXPECT_EQ(usage.mem_total_, 1000UL * 1024);
+  EXPECT_EQ(usage.mem_buff_cache_, 100UL * 1024);
+  // free + buff/cache exceeds total
+  EXPECT_EQ(usage.mem_used_, 0UL);
+  EXPECT_EQ(usage.mem_available_, 0UL);
+  EXPECT_EQ(usage.swap_total_, 0UL);
+  EXPECT_EQ(usage.swap_used_, 0UL);
+}
+
+TEST_F(MeminfoReaderTestSuite, formatError)
+{
+  writeMeminfo("MemFree: 1000 kB\nmalformed line\n");
+  std::unordered_map<std::string, size_t> meminfo;
+  EXPECT_NE(readMeminfo(meminfo_path_, meminfo), "");
+
+  writeMeminfo("MemTotal: 0 kB\n");
+  meminfo.clear();
+  EXPECT_NE(readMeminfo(meminfo_path_, meminfo), "");
+}
+
+TEST_F(MeminfoReaderTestSuite, fileNotFound)
+{
+  std::unordered_map<std::string, size_t> meminfo;
+  EXPECT_NE(readMeminfo(meminfo_path_ + "_not_found", meminfo), "");
+}